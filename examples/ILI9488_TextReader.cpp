@@ -11,6 +11,7 @@
 #include "joystick.hpp"
 #include "hybrid_font_system.hpp"
 #include "hybrid_font_renderer.hpp"
+#include "text_run_renderer.hpp"
 #include "rw_sd.hpp"
 #include "pin_config.hpp"
 #include "pico/stdlib.h"
@@ -41,6 +42,13 @@ using namespace pico_ili9488_gfx;
 #define TITLE_CONTENT_SPACING 15 // 标题与内容间距
 #define CONTENT_FOOTER_SPACING 25 // 内容与页脚间距
 
+// 主循环每次空闲时预取的下一页字形数（每个字形约几十微秒）
+#define PREFETCH_GLYPHS_PER_TICK 8
+
+// 正文颜色（RGB666，0xRRGGBB），暖白字黑底；抗锯齿字体按这对颜色混合边缘
+#define TEXT_COLOR_666 0xF0E8D8
+#define BACKGROUND_COLOR_666 0x000000
+
 // 默认文本文件路径
 #define TEXT_FILE_PATH "/Stone.txt"
 
@@ -63,6 +71,11 @@ private:
     // 存储每页的起始字节位置
     std::vector<size_t> page_start_positions_;
     
+    // 已读出并预取了字形的下一页（翻页时不必再读SD卡）
+    int prefetched_page_;
+    std::string prefetched_text_;
+    int pending_prefetch_page_;     // 等待空闲时读出的页，-1 = 无
+    
     // 从文件路径中提取文件名 (静态函数)
     static std::string extract_filename_from_path(const std::string& path) {
         std::string full_path = path;
@@ -137,6 +150,7 @@ private:
             sleep_ms(2000);
         } else {
             printf("[SUCCESS] 混合字体系统初始化成功\n");
+            font_manager_.get_line_renderer().set_colors_rgb666(TEXT_COLOR_666, BACKGROUND_COLOR_666);
             font_manager_.print_status();
             joystick_.set_rgb_color(JOYSTICK_LED_GREEN);
             sleep_ms(1000);
@@ -319,15 +333,13 @@ private:
         return true;
     }
     
-    bool load_page_content(int page_num) {
-        printf("[加载页面] 正在加载第 %d 页内容...\n", page_num + 1);
-        
-        // 检查页面范围
-        if (page_num < 0 || page_num >= total_pages_ || page_num >= static_cast<int>(page_start_positions_.size() - 1)) {
-            printf("[ERROR] 页面号超出范围: %d (总页数: %d)\n", page_num, total_pages_);
-            return false;
-        }
-        
+    bool is_valid_page(int page_num) const {
+        return page_num >= 0 && page_num < total_pages_ && 
+               page_num < static_cast<int>(page_start_positions_.size() - 1);
+    }
+    
+    // 读出一页的原始文本
+    bool read_page_text(int page_num, std::string& accumulated_text) {
         // 打开文件
         auto file_handle = sd_.open_file(TEXT_FILE_PATH, "r");
         if (!file_handle.is_ok()) {
@@ -352,13 +364,11 @@ private:
             return false;
         }
         
-        current_page_content_.clear();
-        
         const size_t BUFFER_SIZE = 1024;
-        std::string accumulated_text;
+        accumulated_text.clear();
         size_t bytes_read = 0;
         
-        // 读取当前页的内容
+        // 读取该页的内容
         while (bytes_read < (end_pos - start_pos)) {
             size_t remaining_bytes = end_pos - start_pos - bytes_read;
             size_t read_size = std::min(BUFFER_SIZE, remaining_bytes);
@@ -380,6 +390,29 @@ private:
             bytes_read += data.size();
         }
         
+        handle.close();
+        return true;
+    }
+    
+    bool load_page_content(int page_num) {
+        printf("[加载页面] 正在加载第 %d 页内容...\n", page_num + 1);
+        
+        // 检查页面范围
+        if (!is_valid_page(page_num)) {
+            printf("[ERROR] 页面号超出范围: %d (总页数: %d)\n", page_num, total_pages_);
+            return false;
+        }
+        
+        std::string accumulated_text;
+        if (page_num == prefetched_page_) {
+            accumulated_text.swap(prefetched_text_);
+            prefetched_page_ = -1;
+        } else if (!read_page_text(page_num, accumulated_text)) {
+            return false;
+        }
+        
+        current_page_content_.clear();
+        
         // 处理读取的内容，按行分割并换行
         size_t pos = 0;
         while (pos < accumulated_text.size()) {
@@ -407,8 +440,6 @@ private:
             pos = newline_pos + 1;
         }
         
-        handle.close();
-        
         printf("[SUCCESS] 第 %d 页加载完成，包含 %zu 行\n", page_num + 1, current_page_content_.size());
         return true;
     }
@@ -472,6 +503,9 @@ private:
             return lines;
         }
         
+        // 行宽逐字符累加（前进宽度 + 字距调整），不必每加一个字符就重新测量整行
+        hybrid_font::GlyphMetrics& metrics = font_manager_.get_metrics();
+        hybrid_font::GlyphMetrics::LineWidth line_width;
         std::string current_line;
         size_t pos = 0;
         
@@ -482,21 +516,20 @@ private:
                 std::string chinese_char = text.substr(pos, char_len);
                 
                 // 测试加上这个中文字符后的宽度
-                std::string test_line = current_line + chinese_char;
-                int test_width = font_manager_.get_string_width(test_line);
+                hybrid_font::GlyphMetrics::LineWidth test_width = metrics.append(line_width, chinese_char.c_str());
                 
-                if (test_width <= max_width) {
+                if (test_width.width <= max_width) {
                     // 可以放在当前行
-                    current_line = test_line;
+                    current_line += chinese_char;
+                    line_width = test_width;
                 } else {
                     // 放不下，需要换行
                     if (!current_line.empty()) {
                         lines.push_back(current_line);
-                        current_line = chinese_char;
-                    } else {
-                        // 当前行为空，强制放入
-                        current_line = chinese_char;
                     }
+                    // 当前行为空时强制放入
+                    current_line = chinese_char;
+                    line_width = metrics.append(hybrid_font::GlyphMetrics::LineWidth(), chinese_char.c_str());
                 }
                 
                 pos += char_len;
@@ -517,25 +550,26 @@ private:
                 
                 // 计算加上这个英文单词后的行宽度
                 std::string test_line = current_line;
+                hybrid_font::GlyphMetrics::LineWidth test_width = line_width;
                 if (!test_line.empty() && !word.empty() && word[0] != ' ') {
                     test_line += " ";
+                    test_width = metrics.append(test_width, ' ');
                 }
                 test_line += word;
+                test_width = metrics.append(test_width, word.c_str());
                 
-                int test_width = font_manager_.get_string_width(test_line);
-                
-                if (test_width <= max_width) {
+                if (test_width.width <= max_width) {
                     // 这个词可以放在当前行
                     current_line = test_line;
+                    line_width = test_width;
                 } else {
                     // 这个词放不下，需要换行 - 绝不截断
                     if (!current_line.empty()) {
                         lines.push_back(current_line);
-                        current_line = word;
-                    } else {
-                        // 当前行为空但词太长，仍然完整放入 - 绝不截断
-                        current_line = word;
                     }
+                    // 当前行为空但词太长，仍然完整放入 - 绝不截断
+                    current_line = word;
+                    line_width = metrics.append(hybrid_font::GlyphMetrics::LineWidth(), word.c_str());
                 }
                 
                 // 移动到下一个位置
@@ -555,8 +589,14 @@ private:
     }
 
     void show_static_page(int page, const std::string& tip = "") {
+        uint64_t page_start = time_us_64();
+        // 正文走整行渲染器，只用Flash字形缓存；彩色字形缓存只服务页眉页脚
+        ili9488_font::FlashFontCache& glyph_cache = font_manager_.get_font_source().get_flash_source().get_cache();
+        glyph_cache.reset_cache_stats();
+        font_manager_.get_color_cache().reset_stats();
+        
         // 清屏
-        display_.fillScreenRGB666(0x000000);
+        display_.fillScreenRGB666(BACKGROUND_COLOR_666);
         
         draw_header();
         
@@ -585,8 +625,8 @@ private:
                 continue;
             }
             
-            // 绘制非空行
-            font_manager_.draw_string(display_, SIDE_MARGIN, y, line_text, true);
+            // 绘制非空行：整行光栅化后一个窗口发送
+            font_manager_.get_line_renderer().draw_line(display_, SIDE_MARGIN, y, line_text);
             y += LINE_HEIGHT;
             lines_drawn++;
             prev_line_empty = false;
@@ -597,8 +637,47 @@ private:
             }
         }
         
-        printf("[显示] 第 %d 页绘制了 %d 行文本\n", page + 1, lines_drawn);
         draw_footer(page, tip);
+        
+        ili9488_font::GlyphCacheStats body = glyph_cache.get_cache_stats();
+        uint32_t lookups = body.hits + body.misses;
+        uint32_t body_rate = lookups ? (uint32_t)((uint64_t)body.hits * 1000 / lookups) : 0;
+        uint32_t ui_rate = font_manager_.get_color_cache().hit_rate_permille();
+        printf("[显示] 第 %d 页绘制了 %d 行文本, 用时 %lu ms, 正文字形缓存命中率 %lu.%lu%% (未命中 %lu), 页眉页脚彩色缓存命中率 %lu.%lu%%\n", 
+               page + 1, lines_drawn, (unsigned long)((time_us_64() - page_start) / 1000),
+               (unsigned long)(body_rate / 10), (unsigned long)(body_rate % 10), (unsigned long)body.misses,
+               (unsigned long)(ui_rate / 10), (unsigned long)(ui_rate % 10));
+        
+        // 下一页留到主循环空闲时再读SD卡，不拖慢本次翻页
+        pending_prefetch_page_ = page + 1;
+    }
+
+    // 读出一页并把它的字形排入后台预取（由 run_idle_prefetch 在空闲时调用）
+    void prefetch_page(int page_num) {
+        if (!is_valid_page(page_num) || page_num == prefetched_page_) {
+            return;
+        }
+        
+        prefetched_page_ = -1;
+        if (!read_page_text(page_num, prefetched_text_)) {
+            return;
+        }
+        prefetched_page_ = page_num;
+        
+        int queued = font_manager_.prefetch_text(prefetched_text_);
+        printf("[预取] 第 %d 页: %d 个字形待读入\n", page_num + 1, queued);
+    }
+
+    // 主循环空闲时调用：先从SD卡读出待预取的下一页，之后每次把几个字形读入缓存
+    void run_idle_prefetch() {
+        if (pending_prefetch_page_ >= 0) {
+            const int page_num = pending_prefetch_page_;
+            pending_prefetch_page_ = -1;
+            prefetch_page(page_num);
+            return;  // 读SD卡已占用本轮空闲，字形留到下一轮
+        }
+        
+        font_manager_.run_prefetch(PREFETCH_GLYPHS_PER_TICK);
     }
 
     int estimate_total_pages() {
@@ -631,7 +710,7 @@ private:
     
     void display_error_screen(const std::string& error_msg) {
         // 清屏
-        display_.fillScreenRGB666(0x000000);
+        display_.fillScreenRGB666(BACKGROUND_COLOR_666);
         
         draw_header();
         
@@ -815,6 +894,9 @@ public:
             }
             last_button_state = button_pressed;
             
+            // 空闲时读出下一页并把它的字形读入缓存（每次只做一小步，不影响摇杆响应）
+            run_idle_prefetch();
+            
             sleep_ms(30);  // 主循环延迟
         }
     }
@@ -828,7 +910,9 @@ public:
         filename_(extract_filename_from_path(TEXT_FILE_PATH)),
         sd_ready_(false),
         file_position_(0),
-        file_size_(0) {
+        file_size_(0),
+        prefetched_page_(-1),
+        pending_prefetch_page_(-1) {
         
         // 初始化显示系统
         initialize_hardware();
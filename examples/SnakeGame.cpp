@@ -7,6 +7,8 @@
 #include "ili9488_driver.hpp"
 #include "ili9488_colors.hpp"
 #include "ili9488_font.hpp"
+#include "pico_ili9488_gfx.hpp"
+#include "ili9488_tilemap.hpp"
 
 // 竖屏模式 - ILI9488分辨率调整
 #define SCREEN_WIDTH 320
@@ -17,6 +19,16 @@
 #define GRID_WIDTH (SCREEN_WIDTH / GRID_SIZE)
 #define GRID_HEIGHT (SCREEN_HEIGHT / GRID_SIZE)
 
+// 网格单元图块（TileMap 中的索引）
+enum GridTile : uint8_t {
+    TILE_BG = 0,
+    TILE_BORDER,
+    TILE_SNAKE_HEAD,
+    TILE_SNAKE_BODY,
+    TILE_FOOD,
+    TILE_COUNT
+};
+
 // 游戏常量
 #define MAX_SNAKE_LENGTH 200
 #define INITIAL_SNAKE_LENGTH 3
@@ -68,54 +80,72 @@ struct GameState {
     uint32_t game_over_time;  // 游戏结束时间（毫秒）
 };
 
-// 绘制网格单元
-void drawGridCell(ili9488::ILI9488Driver& driver, int16_t grid_x, int16_t grid_y, uint32_t color666) {
-    int16_t pixel_x = grid_x * GRID_SIZE;
-    int16_t pixel_y = grid_y * GRID_SIZE;
-    driver.fillAreaRGB666(pixel_x, pixel_y, pixel_x + GRID_SIZE - 1, pixel_y + GRID_SIZE - 1, color666);
+// 网格画面：只记录单元变化，flush()时按行合并脏单元批量发送
+static uint16_t grid_tile_pixels[TILE_COUNT * GRID_SIZE * GRID_SIZE];
+static const ili9488::TileAtlas grid_tiles(GRID_SIZE, GRID_SIZE, TILE_COUNT, grid_tile_pixels);
+static ili9488::TileMap board;
+
+// 边框图块上直接用fillAreaRGB666(BORDER_COLOR)画分数，两者必须是同一种颜色
+static_assert(ili9488_colors::rgb565_to_wire666(ili9488_colors::rgb888_to_rgb565(BORDER_COLOR)) == BORDER_COLOR,
+              "border tile colour must survive RGB565");
+
+// 生成纯色图块
+void initGridTiles() {
+    const uint32_t colors[TILE_COUNT] = {
+        BG_COLOR, BORDER_COLOR, SNAKE_HEAD_COLOR, SNAKE_BODY_COLOR, FOOD_COLOR
+    };
+    for (uint8_t t = 0; t < TILE_COUNT; t++) {
+        // rgb666常量是线上格式0xRRGGBB（每字节高6位），按RGB888取高位即可
+        const uint16_t color = ili9488_colors::rgb888_to_rgb565(colors[t]);
+        for (uint16_t i = 0; i < GRID_SIZE * GRID_SIZE; i++) {
+            grid_tile_pixels[t * GRID_SIZE * GRID_SIZE + i] = color;
+        }
+    }
+    board.begin(&grid_tiles, GRID_WIDTH, GRID_HEIGHT);
+}
+
+// 设置网格单元
+void drawGridCell(int16_t grid_x, int16_t grid_y, uint8_t tile) {
+    board.setTile(grid_x, grid_y, tile);
 }
 
 // 清除网格单元
-void clearGridCell(ili9488::ILI9488Driver& driver, int16_t grid_x, int16_t grid_y) {
-    drawGridCell(driver, grid_x, grid_y, BG_COLOR);
+void clearGridCell(int16_t grid_x, int16_t grid_y) {
+    drawGridCell(grid_x, grid_y, TILE_BG);
 }
 
 // 绘制边框
-void drawBorder(ili9488::ILI9488Driver& driver) {
-    // 顶部边框
-    driver.fillAreaRGB666(0, 0, SCREEN_WIDTH - 1, GRID_SIZE - 1, BORDER_COLOR);
-    // 底部边框
-    driver.fillAreaRGB666(0, SCREEN_HEIGHT - GRID_SIZE, SCREEN_WIDTH - 1, SCREEN_HEIGHT - 1, BORDER_COLOR);
-    // 左边框
-    driver.fillAreaRGB666(0, 0, GRID_SIZE - 1, SCREEN_HEIGHT - 1, BORDER_COLOR);
-    // 右边框
-    driver.fillAreaRGB666(SCREEN_WIDTH - GRID_SIZE, 0, SCREEN_WIDTH - 1, SCREEN_HEIGHT - 1, BORDER_COLOR);
+void drawBorder() {
+    board.fillRect(0, 0, GRID_WIDTH, 1, TILE_BORDER);                 // 顶部边框
+    board.fillRect(0, GRID_HEIGHT - 1, GRID_WIDTH, 1, TILE_BORDER);   // 底部边框
+    board.fillRect(0, 0, 1, GRID_HEIGHT, TILE_BORDER);                // 左边框
+    board.fillRect(GRID_WIDTH - 1, 0, 1, GRID_HEIGHT, TILE_BORDER);   // 右边框
 }
 
 // 绘制蛇
-void drawSnake(ili9488::ILI9488Driver& driver, const Snake& snake) {
+void drawSnake(const Snake& snake) {
     // 绘制蛇头
     if (snake.length > 0) {
-        drawGridCell(driver, snake.segments[0].x, snake.segments[0].y, SNAKE_HEAD_COLOR);
+        drawGridCell(snake.segments[0].x, snake.segments[0].y, TILE_SNAKE_HEAD);
     }
     
     // 绘制蛇身
     for (uint16_t i = 1; i < snake.length; i++) {
-        drawGridCell(driver, snake.segments[i].x, snake.segments[i].y, SNAKE_BODY_COLOR);
+        drawGridCell(snake.segments[i].x, snake.segments[i].y, TILE_SNAKE_BODY);
     }
 }
 
 // 清除蛇尾
-void clearSnakeTail(ili9488::ILI9488Driver& driver, const Position& tail_pos) {
-    clearGridCell(driver, tail_pos.x, tail_pos.y);
+void clearSnakeTail(const Position& tail_pos) {
+    clearGridCell(tail_pos.x, tail_pos.y);
 }
 
 // 绘制食物
-void drawFood(ili9488::ILI9488Driver& driver, const Position& food_pos) {
+void drawFood(const Position& food_pos) {
     printf("Drawing food at grid (%d, %d), pixel (%d, %d)\n", 
            food_pos.x, food_pos.y, 
            food_pos.x * GRID_SIZE, food_pos.y * GRID_SIZE);
-    drawGridCell(driver, food_pos.x, food_pos.y, FOOD_COLOR);
+    drawGridCell(food_pos.x, food_pos.y, TILE_FOOD);
 }
 
 // 生成随机食物位置
@@ -330,6 +360,9 @@ void drawPaused(ili9488::ILI9488Driver& driver) {
 void clearPaused(ili9488::ILI9488Driver& driver) {
     // 只清除暂停文字区域 - 使用与drawPaused相同的区域
     driver.fillAreaRGB666(70, 220, 250, 270, BG_COLOR);
+    
+    // 被文字覆盖的网格单元在下次flush时重绘
+    board.invalidateArea(70, 220, 181, 51);
 }
 
 // 更新倒计时数字（只更新数字部分）
@@ -374,6 +407,18 @@ void drawWaitingToRestart(ili9488::ILI9488Driver& driver, uint16_t final_score)
                      BG_COLOR);
 }
 
+// 重绘整个游戏画面（网格整屏发送，再叠加分数）
+void drawGame(ili9488::ILI9488_UI& gfx, ili9488::ILI9488Driver& driver, const GameState& game_state) {
+    board.fill(TILE_BG);
+    drawBorder();
+    drawSnake(game_state.snake);
+    drawFood(game_state.food);
+    board.invalidateAll();
+    board.flush(gfx);
+    board.resetStats();     // 统计只计增量帧
+    drawScore(driver, game_state.score);
+}
+
 int main() {
     stdio_init_all();
     printf("Snake Game for ILI9488 - Landscape Mode\n");
@@ -391,6 +436,8 @@ int main() {
     
     // 设置为竖屏模式
     lcd_driver.setRotation(ili9488::Rotation::Portrait_180);
+    pico_ili9488_gfx::PicoILI9488GFX<ili9488::ILI9488Driver> gfx(lcd_driver, SCREEN_WIDTH, SCREEN_HEIGHT);
+    initGridTiles();
     
     // 初始化摇杆
     Joystick joystick;
@@ -429,11 +476,7 @@ int main() {
     game_state.game_started = true;  // 直接开始游戏，不需要再次按键
     
     // 绘制初始游戏画面
-    lcd_driver.fillScreenRGB666(BG_COLOR);
-    drawBorder(lcd_driver);
-    drawSnake(lcd_driver, game_state.snake);
-    drawFood(lcd_driver, game_state.food);
-    drawScore(lcd_driver, game_state.score);
+    drawGame(gfx, lcd_driver, game_state);
     
     // 游戏变量
     uint32_t last_move_time = to_ms_since_boot(get_absolute_time());  // 立即开始计时
@@ -460,11 +503,7 @@ int main() {
                 // 重新开始游戏
                 initializeGame(game_state);
                 game_state.game_started = true;  // 直接开始游戏
-                lcd_driver.fillScreenRGB666(BG_COLOR);
-                drawBorder(lcd_driver);
-                drawSnake(lcd_driver, game_state.snake);
-                drawFood(lcd_driver, game_state.food);
-                drawScore(lcd_driver, game_state.score);
+                drawGame(gfx, lcd_driver, game_state);
                 last_move_time = current_time;
             } else if (!game_state.game_started) {
                 // 开始游戏
@@ -476,35 +515,9 @@ int main() {
                 if (game_state.game_paused) {
                     drawPaused(lcd_driver);
                 } else {
-                    // 清除暂停文字并重绘可能被覆盖的游戏元素
+                    // 清除暂停文字，被覆盖的网格单元随后重绘
                     clearPaused(lcd_driver);
-                    
-                    // 重绘可能被暂停文字覆盖的游戏元素
-                    // 检查蛇身是否在暂停文字区域内并重绘
-                    for (uint16_t i = 0; i < game_state.snake.length; i++) {
-                        int16_t pixel_x = game_state.snake.segments[i].x * GRID_SIZE;
-                        int16_t pixel_y = game_state.snake.segments[i].y * GRID_SIZE;
-                        
-                        // 检查是否在暂停文字区域内 (70, 220, 250, 270)
-                        if (pixel_x < 250 && pixel_x + GRID_SIZE > 70 && 
-                            pixel_y < 270 && pixel_y + GRID_SIZE > 220) {
-                            if (i == 0) {
-                                drawGridCell(lcd_driver, game_state.snake.segments[i].x, 
-                                           game_state.snake.segments[i].y, SNAKE_HEAD_COLOR);
-                            } else {
-                                drawGridCell(lcd_driver, game_state.snake.segments[i].x, 
-                                           game_state.snake.segments[i].y, SNAKE_BODY_COLOR);
-                            }
-                        }
-                    }
-                    
-                    // 检查食物是否在暂停文字区域内并重绘
-                    int16_t food_pixel_x = game_state.food.x * GRID_SIZE;
-                    int16_t food_pixel_y = game_state.food.y * GRID_SIZE;
-                    if (food_pixel_x < 250 && food_pixel_x + GRID_SIZE > 70 && 
-                        food_pixel_y < 270 && food_pixel_y + GRID_SIZE > 220) {
-                        drawFood(lcd_driver, game_state.food);
-                    }
+                    board.flush(gfx);
                 }
             }
         }
@@ -596,6 +609,11 @@ int main() {
                 game_state.game_over = true;
                 game_state.game_over_time = current_time;
                 drawGameOver(lcd_driver, game_state.score);  // 显示完整的游戏结束画面
+                
+                const ili9488::TileMap::Stats& stats = board.stats();
+                printf("Grid updates: %lu frames, %lu cells, %lu bytes (%lu bytes/frame)\n",
+                       (unsigned long)stats.flushes, (unsigned long)stats.cells, (unsigned long)stats.bytes,
+                       (unsigned long)(stats.flushes ? stats.bytes / stats.flushes : 0));
                 last_displayed_countdown = 5;  // 初始化倒计时显示为5秒
             } else {
                 // 检查是否吃到食物（通过比较分数变化）
@@ -603,22 +621,29 @@ int main() {
                 
                 // 如果没有吃到食物，清除旧的蛇尾
                 if (!ate_food) {
-                    clearSnakeTail(lcd_driver, old_tail);
+                    clearSnakeTail(old_tail);
                 }
                 
                 // 绘制新的蛇头
-                drawGridCell(lcd_driver, game_state.snake.segments[0].x, 
-                           game_state.snake.segments[0].y, SNAKE_HEAD_COLOR);
+                drawGridCell(game_state.snake.segments[0].x, 
+                           game_state.snake.segments[0].y, TILE_SNAKE_HEAD);
                 
                 // 如果蛇身长度大于1，将原来的头部变成身体
                 if (game_state.snake.length > 1) {
-                    drawGridCell(lcd_driver, game_state.snake.segments[1].x, 
-                               game_state.snake.segments[1].y, SNAKE_BODY_COLOR);
+                    drawGridCell(game_state.snake.segments[1].x, 
+                               game_state.snake.segments[1].y, TILE_SNAKE_BODY);
                 }
                 
-                // 如果吃到食物，绘制新食物和更新分数
+                // 如果吃到食物，绘制新食物
+                if (ate_food) {
+                    drawFood(game_state.food);
+                }
+                
+                // 只发送本帧变化的单元（蛇头、旧头、蛇尾、食物）
+                board.flush(gfx);
+                
+                // 分数显示在顶部边框上，网格刷新后再绘制
                 if (ate_food) {
-                    drawFood(lcd_driver, game_state.food);
                     drawScore(lcd_driver, game_state.score);
                 }
             }
@@ -8,7 +8,6 @@
 #include <memory>
 #include <array>
 #include <vector>
-#include <cmath>
 #include <string_view>
 #include <functional>
 
@@ -18,8 +17,10 @@
 // Modern C++ ILI9488 driver includes
 #include "ili9488_driver.hpp"
 #include "pico_ili9488_gfx.hpp"
+#include "pico_ili9488_widgets.hpp"
 #include "ili9488_colors.hpp"
 #include "ili9488_font.hpp"
+#include "ili9488_fixed.hpp"
 
 // 统一引脚配置
 #include "pin_config.hpp"
@@ -27,6 +28,13 @@
 using namespace ili9488;
 using namespace ili9488_colors;
 
+namespace fx = ili9488::fixed;
+
+// Integer sine wave: base + amp * sin(angle), all in fixed point (no soft-float)
+static inline int32_t fixedWave(int32_t base, int32_t amp, fx::angle_t angle) {
+    return base + ((amp * fx::sin_raw(angle)) >> 15);
+}
+
 // Demo scene interface
 class DemoScene {
 public:
@@ -56,11 +64,13 @@ public:
         
         // Radial lines
         for (int angle = 0; angle < 360; angle += 15) {
-            float rad = angle * M_PI / 180.0f;
-            int x1 = center_x + 50 * cos(rad);
-            int y1 = center_y + 50 * sin(rad);
-            int x2 = center_x + 140 * cos(rad);
-            int y2 = center_y + 140 * sin(rad);
+            const fx::angle_t a = fx::deg_to_angle(angle);
+            const fx::PolarOffset inner = fx::polar(50, a);
+            const fx::PolarOffset outer = fx::polar(140, a);
+            int x1 = center_x + inner.dx;
+            int y1 = center_y + inner.dy;
+            int x2 = center_x + outer.dx;
+            int y2 = center_y + outer.dy;
             
             uint16_t color = hsvToRgb565(angle, 255, 200);
             gfx.drawLine(x1, y1, x2, y2, color);
@@ -133,8 +143,8 @@ private:
 class AnimatedSpritesDemo : public DemoScene {
 private:
     struct Sprite {
-        float x, y;
-        float vx, vy;
+        fx::q16_16 x, y;
+        fx::q16_16 vx, vy;
         uint16_t color;
         uint8_t size;
         uint8_t type;
@@ -148,10 +158,10 @@ public:
         sprites_.reserve(20);
         for (int i = 0; i < 20; ++i) {
             Sprite sprite{
-                .x = static_cast<float>(rand() % 320),
-                .y = static_cast<float>(rand() % 480),
-                .vx = (rand() % 40 - 20) / 10.0f,
-                .vy = (rand() % 40 - 20) / 10.0f,
+                .x = fx::q16_16::from_int(rand() % 320),
+                .y = fx::q16_16::from_int(rand() % 480),
+                .vx = fx::q16_16::from_ratio(rand() % 40 - 20, 10),
+                .vy = fx::q16_16::from_ratio(rand() % 40 - 20, 10),
                 .color = static_cast<uint16_t>(rand() & 0xFFFF),
                 .size = static_cast<uint8_t>(5 + rand() % 15),
                 .type = static_cast<uint8_t>(rand() % 3)
@@ -173,27 +183,29 @@ public:
                 sprite.y += sprite.vy;
                 
                 // Bounce off walls
-                if (sprite.x <= 0 || sprite.x >= driver.getWidth() - sprite.size) {
+                const fx::q16_16 max_x = fx::q16_16::from_int(driver.getWidth() - sprite.size);
+                const fx::q16_16 max_y = fx::q16_16::from_int(driver.getHeight() - sprite.size);
+                if (sprite.x <= fx::q16_16() || sprite.x >= max_x) {
                     sprite.vx = -sprite.vx;
-                    sprite.x = std::clamp(sprite.x, 0.0f, static_cast<float>(driver.getWidth() - sprite.size));
+                    sprite.x = std::clamp(sprite.x, fx::q16_16(), max_x);
                 }
-                if (sprite.y <= 0 || sprite.y >= driver.getHeight() - sprite.size) {
+                if (sprite.y <= fx::q16_16() || sprite.y >= max_y) {
                     sprite.vy = -sprite.vy;
-                    sprite.y = std::clamp(sprite.y, 0.0f, static_cast<float>(driver.getHeight() - sprite.size));
+                    sprite.y = std::clamp(sprite.y, fx::q16_16(), max_y);
                 }
                 
                 // Draw sprite based on type
                 switch (sprite.type) {
                     case 0: // Circle
-                        gfx.fillCircle(static_cast<int>(sprite.x), static_cast<int>(sprite.y), 
+                        gfx.fillCircle(sprite.x.to_int(), sprite.y.to_int(), 
                                      sprite.size, sprite.color);
                         break;
                     case 1: // Rectangle
-                        gfx.fillRect(static_cast<int>(sprite.x), static_cast<int>(sprite.y), 
+                        gfx.fillRect(sprite.x.to_int(), sprite.y.to_int(), 
                                    sprite.size, sprite.size, sprite.color);
                         break;
                     case 2: // Triangle
-                        drawTriangleSprite(gfx, static_cast<int>(sprite.x), static_cast<int>(sprite.y), 
+                        drawTriangleSprite(gfx, sprite.x.to_int(), sprite.y.to_int(), 
                                          sprite.size, sprite.color);
                         break;
                 }
@@ -220,27 +232,93 @@ private:
     }
 };
 
+// Rotating and zooming image demo (affine blitter)
+class RotoZoomDemo : public DemoScene {
+private:
+    static constexpr int16_t TEX_SIZE = 64;   // Power of two: eligible for the interpolator path
+    std::array<uint16_t, TEX_SIZE * TEX_SIZE> texture_{};
+    
+public:
+    RotoZoomDemo() {
+        // Dial face: coloured rings, a white pointer and transparent corners (colour key)
+        for (int16_t y = 0; y < TEX_SIZE; ++y) {
+            for (int16_t x = 0; x < TEX_SIZE; ++x) {
+                const int32_t dx = x - TEX_SIZE / 2, dy = y - TEX_SIZE / 2;
+                const uint32_t r = fx::hypot(dx, dy);
+                uint16_t color = rgb565::MAGENTA;    // Key colour
+                if (r < TEX_SIZE / 2) {
+                    color = ((r / 4) & 1) ? rgb565::NAVY : rgb565::CYAN;
+                    if (dx >= 0 && dy > -3 && dy < 3) color = rgb565::WHITE;
+                }
+                texture_[y * TEX_SIZE + x] = color;
+            }
+        }
+    }
+    
+    void render(ILI9488Driver& driver, pico_ili9488_gfx::PicoILI9488GFX<ILI9488Driver>& gfx) override {
+        printf("Rendering rotozoom...\n");
+        
+        gfx.clearScreenFast(rgb565::BLACK);
+        const ili9488::Sprite dial(TEX_SIZE, TEX_SIZE, texture_.data(), rgb565::MAGENTA);
+        const fx::q16_16 center = fx::q16_16::from_int(TEX_SIZE / 2);
+        const fx::q16_16 cx = fx::q16_16::from_int(driver.getWidth() / 2);
+        const fx::q16_16 cy = fx::q16_16::from_int(driver.getHeight() / 2);
+        
+        int16_t prev_x0 = 0, prev_y0 = 0, prev_x1 = 0, prev_y1 = 0;
+        for (int frame = 0; frame < 180; ++frame) {
+            // Zoom oscillates between 1x and 4x while the dial turns
+            const fx::q16_16 scale = fx::q16_16::from_raw(fx::q16_16::ONE * 5 / 2 +
+                                                          (fx::sin_raw(frame * 728) * 3));
+            const auto matrix = ili9488::AffineMatrix::rotateScale(
+                center, center, static_cast<fx::angle_t>(frame * 364), scale, cx, cy);
+            
+            // Erase the previous frame's bounding box, then draw the new frame
+            int16_t x0, y0, x1, y1;
+            matrix.bounds(TEX_SIZE, TEX_SIZE, x0, y0, x1, y1);
+            if (frame > 0) {
+                gfx.fillRectFast(prev_x0, prev_y0, prev_x1 - prev_x0, prev_y1 - prev_y0, rgb565::BLACK);
+            }
+            
+            gfx.drawBitmapTransformed(dial, matrix, frame < 90 ? ili9488::Sampling::Nearest
+                                                               : ili9488::Sampling::Bilinear);
+            prev_x0 = x0; prev_y0 = y0; prev_x1 = x1; prev_y1 = y1;
+            sleep_ms(20);
+        }
+    }
+    
+    std::string_view getName() const override { return "Rotate & Zoom"; }
+    uint32_t getDurationMs() const override { return 6000; }
+};
+
 // Fractal explorer demo
 class FractalExplorerDemo : public DemoScene {
+private:
+    // Q8.24 keeps |z|^2 of an escaping orbit (< ~41) in range with ample precision
+    static constexpr int JULIA_FRAC_BITS = 24;
+    
+    static constexpr int32_t toJuliaFixed(double value) {
+        return static_cast<int32_t>(value * (1 << JULIA_FRAC_BITS));
+    }
+    
 public:
     void render(ILI9488Driver& driver, pico_ili9488_gfx::PicoILI9488GFX<ILI9488Driver>& /* gfx */) override {
         printf("Rendering fractal explorer...\n");
         
-        // Julia Set parameters
-        const double zoom_start = 100.0;
-        const double zoom_end = 1000.0;
+        // Julia Set parameters (Q8.24 fixed point, folded at compile time)
+        const int32_t zoom_start = 100;
+        const int32_t zoom_end = 1000;
         const int frames = 60;
         
         for (int frame = 0; frame < frames; ++frame) {
-            double zoom = zoom_start + (zoom_end - zoom_start) * frame / frames;
-            double offset_x = -0.7;
-            double offset_y = 0.0;
+            int32_t zoom = zoom_start + (zoom_end - zoom_start) * frame / frames;
+            constexpr int32_t offset_x = toJuliaFixed(-0.7);
+            constexpr int32_t offset_y = toJuliaFixed(0.0);
             
-            renderJuliaSet(driver, offset_x, offset_y, zoom, -0.8, 0.156);
+            renderJuliaSet(driver, offset_x, offset_y, zoom, toJuliaFixed(-0.8), toJuliaFixed(0.156));
             
             // Draw zoom level
             char zoom_text[32];
-            snprintf(zoom_text, sizeof(zoom_text), "Zoom: %.0fx", zoom);
+            snprintf(zoom_text, sizeof(zoom_text), "Zoom: %ldx", (long)zoom);
             driver.drawString(10, driver.getHeight() - 20, zoom_text, rgb888::YELLOW, rgb888::BLACK);
             
             sleep_ms(100);
@@ -251,22 +329,27 @@ public:
     uint32_t getDurationMs() const override { return 8000; }
     
 private:
-    void renderJuliaSet(ILI9488Driver& driver, double offset_x, double offset_y, 
-                       double zoom, double cx, double cy) {
+    void renderJuliaSet(ILI9488Driver& driver, int32_t offset_x, int32_t offset_y, 
+                       int32_t zoom, int32_t cx, int32_t cy) {
         const int max_iter = 50;
         const uint16_t width = driver.getWidth();
         const uint16_t height = driver.getHeight();
+        const int32_t escape = 4 << JULIA_FRAC_BITS;
+        const int32_t step = (1 << JULIA_FRAC_BITS) / zoom;
         
         for (uint16_t py = 0; py < height; py += 2) { // Skip every other line for speed
             for (uint16_t px = 0; px < width; px += 2) { // Skip every other pixel
-                double x = (px - width / 2.0) / zoom + offset_x;
-                double y = (py - height / 2.0) / zoom + offset_y;
+                int32_t x = (px - width / 2) * step + offset_x;
+                int32_t y = (py - height / 2) * step + offset_y;
                 
                 int iteration = 0;
-                while (x*x + y*y <= 4.0 && iteration < max_iter) {
-                    double xtemp = x*x - y*y + cx;
-                    y = 2*x*y + cy;
-                    x = xtemp;
+                int32_t x2 = fx::mulq<JULIA_FRAC_BITS>(x, x);
+                int32_t y2 = fx::mulq<JULIA_FRAC_BITS>(y, y);
+                while (x2 + y2 <= escape && iteration < max_iter) {
+                    y = 2 * fx::mulq<JULIA_FRAC_BITS>(x, y) + cy;
+                    x = x2 - y2 + cx;
+                    x2 = fx::mulq<JULIA_FRAC_BITS>(x, x);
+                    y2 = fx::mulq<JULIA_FRAC_BITS>(y, y);
                     iteration++;
                 }
                 
@@ -294,126 +377,125 @@ private:
 class InteractiveDashboardDemo : public DemoScene {
 public:
     void render(ILI9488Driver& driver, pico_ili9488_gfx::PicoILI9488GFX<ILI9488Driver>& gfx) override {
+        using pico_ili9488_gfx::Gauge;
+        using pico_ili9488_gfx::ProgressBar;
+        using pico_ili9488_gfx::Sparkline;
+        using Bar = ProgressBar<ILI9488Driver>;
+        
         printf("Rendering interactive dashboard...\n");
         
+        // Static chrome is drawn once; the widgets below only repaint what changed
+        gfx.clearScreenFast(rgb565::NAVY);
+        gfx.fillRectFast(0, 0, driver.getWidth(), 30, rgb565::DARKBLUE);
+        driver.drawString(10, 8, "System Dashboard", rgb888::WHITE, rgb888::DARKBLUE);
+        
+        Gauge<ILI9488Driver> cpu(gfx, 60, 80, 50, 0, 100, rgb565::RED, rgb565::DARKGRAY, rgb565::NAVY);
+        Gauge<ILI9488Driver> ram(gfx, 200, 80, 50, 0, 100, rgb565::GREEN, rgb565::DARKGRAY, rgb565::NAVY);
+        Gauge<ILI9488Driver> temp(gfx, 60, 200, 50, 0, 100, rgb565::ORANGE, rgb565::DARKGRAY, rgb565::NAVY);
+        GaugeLabel cpu_label{60, 80, 50, "CPU", rgb565::RED};
+        GaugeLabel ram_label{200, 80, 50, "RAM", rgb565::GREEN};
+        GaugeLabel temp_label{60, 200, 50, "TEMP", rgb565::ORANGE};
+        
+        // Network activity
+        const int net_x = 200, net_y = 200;
+        driver.drawString(net_x, net_y - 15, "Network", rgb888::WHITE, rgb888::NAVY);
+        gfx.drawRect(net_x - 1, net_y - 1, 62, 52, rgb565::WHITE);
+        gfx.drawRect(net_x + 79, net_y - 1, 62, 52, rgb565::WHITE);
+        driver.drawString(net_x + 5, net_y + 55, "DOWN", rgb888::GREEN, rgb888::NAVY);
+        driver.drawString(net_x + 85, net_y + 55, "UP", rgb888::RED, rgb888::NAVY);
+        Bar down(gfx, net_x, net_y, 60, 50, rgb565::GREEN, rgb565::NAVY, 50, Bar::Orientation::BottomToTop);
+        Bar up(gfx, net_x + 80, net_y, 60, 50, rgb565::RED, rgb565::NAVY, 50, Bar::Orientation::BottomToTop);
+        
+        // Status bars (static values, drawn once)
+        drawStatusBars(driver, gfx, 10, 320);
+        
+        // Real-time graph: 1px white frame around a sweep-style sparkline
+        const int graph_x = 10, graph_y = 380;
+        driver.drawString(graph_x, graph_y - 15, "Performance Graph", rgb888::WHITE, rgb888::NAVY);
+        gfx.drawRect(graph_x, graph_y, 300, 80, rgb565::WHITE);
+        Sparkline<ILI9488Driver, 2> graph(gfx, graph_x + 1, graph_y + 1, 298, 78, 0, 100,
+                                          {rgb565::RED, rgb565::GREEN}, rgb565::BLACK, rgb565::DARKGRAY);
+        
+        // Pre-fill the graph so it starts with a full trace, as the old full-repaint version did
+        for (int i = -297; i <= 0; ++i) {
+            graph.push({fixedWave(40, 20, i * 1043), fixedWave(30, 15, i * 1565 + fx::ANGLE_90)});
+        }
+        
+        uint64_t busy_us = 0;
         for (int frame = 0; frame < 120; ++frame) {
-            gfx.clearScreenFast(rgb565::NAVY);
-            
-            // Title bar
-            gfx.fillRect(0, 0, driver.getWidth(), 30, rgb565::DARKBLUE);
-            driver.drawString(10, 8, "System Dashboard", rgb888::WHITE, rgb888::DARKBLUE);
-            
-            // CPU usage gauge
-            drawGauge(driver, gfx, 60, 80, 50, "CPU", (50 + 30 * sin(frame * 0.1)), rgb565::RED);
+            const absolute_time_t frame_start = get_absolute_time();
             
-            // Memory usage gauge
-            drawGauge(driver, gfx, 200, 80, 50, "RAM", (60 + 20 * cos(frame * 0.15)), rgb565::GREEN);
+            // (binary angle steps: 1043 ~ 0.1 rad, 1565 ~ 0.15 rad, 834 ~ 0.08 rad)
+            updateGauge(driver, cpu, cpu_label, fixedWave(50, 30, frame * 1043));
+            updateGauge(driver, ram, ram_label, fixedWave(60, 20, frame * 1565 + fx::ANGLE_90));
+            updateGauge(driver, temp, temp_label, fixedWave(40, 15, frame * 834));
             
-            // Temperature gauge
-            drawGauge(driver, gfx, 60, 200, 50, "TEMP", (40 + 15 * sin(frame * 0.08)), rgb565::ORANGE);
+            down.setValue(fixedWave(20, 15, frame * 2086));                 // ~0.2 rad/frame
+            up.setValue(fixedWave(15, 10, frame * 2608 + fx::ANGLE_90));   // ~0.25 rad/frame
+            down.update();
+            up.update();
             
-            // Network activity
-            drawNetworkActivity(driver, gfx, 200, 200, frame);
-            
-            // Status bars
-            drawStatusBars(driver, gfx, 10, 320);
-            
-            // Real-time graph
-            drawRealtimeGraph(driver, gfx, 10, 380, frame);
+            graph.push({fixedWave(40, 20, frame * 1043), fixedWave(30, 15, frame * 1565 + fx::ANGLE_90)});
             
+            busy_us += absolute_time_diff_us(frame_start, get_absolute_time());
             sleep_ms(100);
         }
+        
+        printf("Dashboard: average update %lu us/frame\n", (unsigned long)(busy_us / 120));
     }
     
     std::string_view getName() const override { return "Interactive Dashboard"; }
     uint32_t getDurationMs() const override { return 12000; }
     
 private:
-    void drawGauge(ILI9488Driver& driver, pico_ili9488_gfx::PicoILI9488GFX<ILI9488Driver>& gfx,
-                   int cx, int cy, int radius, const char* label, float percentage, uint16_t color) {
-        // Gauge background
-        gfx.drawCircle(cx, cy, radius, rgb565::DARKGRAY);
-        gfx.drawCircle(cx, cy, radius - 5, rgb565::DARKGRAY);
-        
-        // Gauge fill
-        float angle = (percentage / 100.0f) * 270.0f - 135.0f; // -135 to +135 degrees
-        float rad = angle * M_PI / 180.0f;
-        
-        int x1 = cx + (radius - 10) * cos(rad);
-        int y1 = cy + (radius - 10) * sin(rad);
-        
-        gfx.drawLine(cx, cy, x1, y1, color);
-        
-        // Label and value
-        driver.drawString(cx - 20, cy + radius + 10, label, rgb888::WHITE, rgb888::NAVY);
-        
-        char value_text[16];
-        snprintf(value_text, sizeof(value_text), "%.0f%%", percentage);
-        driver.drawString(cx - 15, cy + radius + 25, value_text, rgb888::from_rgb565(color), rgb888::NAVY);
-    }
+    struct GaugeLabel {
+        int cx, cy, radius;
+        const char* text;
+        uint16_t color;
+        int32_t shown = -1;     ///< Value currently printed, -1 before the first draw
+    };
     
-    void drawNetworkActivity(ILI9488Driver& driver, pico_ili9488_gfx::PicoILI9488GFX<ILI9488Driver>& gfx,
-                           int x, int y, int frame) {
-        driver.drawString(x, y - 15, "Network", rgb888::WHITE, rgb888::NAVY);
+    void updateGauge(ILI9488Driver& driver, pico_ili9488_gfx::Gauge<ILI9488Driver>& gauge,
+                     GaugeLabel& label, int32_t percentage) {
+        gauge.setValue(percentage);
+        gauge.update();
         
-        // Download indicator
-        int down_activity = 20 + 15 * sin(frame * 0.2);
-        gfx.fillRect(x, y, 60, down_activity, rgb565::GREEN);
-        gfx.drawRect(x, y, 60, 50, rgb565::WHITE);
-        driver.drawString(x + 5, y + 55, "DOWN", rgb888::GREEN, rgb888::NAVY);
+        if (label.shown < 0) {
+            driver.drawString(label.cx - 20, label.cy + label.radius + 10, label.text, rgb888::WHITE, rgb888::NAVY);
+        }
         
-        // Upload indicator  
-        int up_activity = 15 + 10 * cos(frame * 0.25);
-        gfx.fillRect(x + 80, y, 60, up_activity, rgb565::RED);
-        gfx.drawRect(x + 80, y, 60, 50, rgb565::WHITE);
-        driver.drawString(x + 85, y + 55, "UP", rgb888::RED, rgb888::NAVY);
+        // Text is only re-rendered when the printed value changes
+        if (label.shown != percentage) {
+            char value_text[16];
+            snprintf(value_text, sizeof(value_text), "%ld%% ", (long)percentage);
+            driver.drawString(label.cx - 15, label.cy + label.radius + 25, value_text,
+                              rgb888::from_rgb565(label.color), rgb888::NAVY);
+            label.shown = percentage;
+        }
     }
     
     void drawStatusBars(ILI9488Driver& driver, pico_ili9488_gfx::PicoILI9488GFX<ILI9488Driver>& gfx,
                        int x, int y) {
         const char* labels[] = {"Power", "Signal", "Battery"};
         uint16_t colors[] = {rgb565::YELLOW, rgb565::CYAN, rgb565::GREEN};
-        float values[] = {85.0f, 70.0f, 92.0f};
+        int values[] = {85, 70, 92};
         
         for (int i = 0; i < 3; ++i) {
             int bar_y = y + i * 25;
             
             driver.drawString(x, bar_y, labels[i], rgb888::WHITE, rgb888::NAVY);
             
-            // Background bar
-            gfx.fillRect(x + 60, bar_y, 200, 15, rgb565::DARKGRAY);
-            
-            // Value bar
-            int bar_width = static_cast<int>(200 * values[i] / 100.0f);
-            gfx.fillRect(x + 60, bar_y, bar_width, 15, colors[i]);
+            pico_ili9488_gfx::ProgressBar<ILI9488Driver> bar(gfx, x + 60, bar_y, 200, 15,
+                                                             colors[i], rgb565::DARKGRAY);
+            bar.setValue(values[i]);
+            bar.update();
             
             // Percentage text
             char percent_text[8];
-            snprintf(percent_text, sizeof(percent_text), "%.0f%%", values[i]);
+            snprintf(percent_text, sizeof(percent_text), "%d%%", values[i]);
             driver.drawString(x + 270, bar_y, percent_text, rgb888::WHITE, rgb888::NAVY);
         }
     }
-    
-    void drawRealtimeGraph(ILI9488Driver& driver, pico_ili9488_gfx::PicoILI9488GFX<ILI9488Driver>& gfx,
-                          int x, int y, int frame) {
-        driver.drawString(x, y - 15, "Performance Graph", rgb888::WHITE, rgb888::NAVY);
-        
-        // Graph background
-        gfx.fillRect(x, y, 300, 80, rgb565::BLACK);
-        gfx.drawRect(x, y, 300, 80, rgb565::WHITE);
-        
-        // Draw graph data
-        for (int i = 0; i < 299; ++i) {
-            float value1 = 40 + 20 * sin((frame - i) * 0.1);
-            float value2 = 30 + 15 * cos((frame - i) * 0.15);
-            
-            int y1 = y + 80 - static_cast<int>(value1 * 80 / 100);
-            int y2 = y + 80 - static_cast<int>(value2 * 80 / 100);
-            
-            gfx.drawPixel(x + i, y1, rgb565::RED);
-            gfx.drawPixel(x + i, y2, rgb565::GREEN);
-        }
-    }
 };
 
 // Demo manager class
@@ -426,6 +508,7 @@ public:
     DemoManager() {
         scenes_.push_back(std::make_unique<GeometricPatternsDemo>());
         scenes_.push_back(std::make_unique<AnimatedSpritesDemo>());
+        scenes_.push_back(std::make_unique<RotoZoomDemo>());
         scenes_.push_back(std::make_unique<FractalExplorerDemo>());
         scenes_.push_back(std::make_unique<InteractiveDashboardDemo>());
     }
@@ -27,6 +27,10 @@
 #include "pico_ili9488_gfx.hpp"
 #include "ili9488_colors.hpp"
 #include "ili9488_font.hpp"
+#include "ili9488_fixed.hpp"
+#include "qoi_decoder.hpp"
+#include "ili9488_compositor.hpp"
+#include "ili9488_console.hpp"
 
 // 统一引脚配置
 #include "pin_config.hpp"
@@ -360,7 +364,7 @@ public:
                 // Calculate distance from center
                 int dx = px - center_x;
                 int dy = py - center_y;
-                uint16_t distance = sqrt(dx*dx + dy*dy);
+                uint16_t distance = ili9488::fixed::isqrt(dx*dx + dy*dy);
                 
                 if (distance <= max_radius) {
                     uint8_t intensity = 255 - (255 * distance) / max_radius;
@@ -422,6 +426,205 @@ public:
         driver_.fillScreen(rgb565::BLACK);
         sleep_ms(500);
     }
+    
+    // Benchmark: QOI decode straight to the panel
+    void benchmarkQoiDecode() {
+        printf("\n=== QOI Decode Benchmark ===\n");
+        
+        // Encode a procedural test card in RAM (stands in for a file on SD)
+        const uint16_t w = driver_.getWidth();
+        const uint16_t h = driver_.getHeight() / 2;
+        std::vector<uint8_t> qoi;
+        encodeQoiTestImage(qoi, w, h);
+        printf("Test image: %ux%u, %zu bytes QOI (%.1f%% of RGB888)\n",
+               w, h, qoi.size(), 100.0f * qoi.size() / (w * h * 3));
+        
+        static ili9488_image::QoiDecoder decoder;
+        const int iterations = 5;
+        
+        PerformanceTimer timer;
+        timer.start();
+        for (int i = 0; i < iterations; i++) {
+            ili9488_image::MemorySource source(qoi.data(), qoi.size());
+            auto status = decoder.decode(source, gfx_, 0, (i & 1) ? h : 0);
+            if (status != ili9488_image::ImageStatus::Ok) {
+                printf("Decode failed: %s\n", ili9488_image::statusName(status));
+                return;
+            }
+        }
+        uint32_t elapsed_us = timer.getElapsedUs();
+        
+        const uint64_t pixels = static_cast<uint64_t>(w) * h * iterations;
+        printf("QOI decode+display: %lu ms (%d images), %lu pixels/s\n",
+               (unsigned long)(elapsed_us / 1000), iterations,
+               (unsigned long)(pixels * 1000000ULL / (elapsed_us ? elapsed_us : 1)));
+        sleep_ms(1000);
+    }
+
+    void benchmarkCompositor() {
+        printf("\n=== Scanline Compositor Benchmark ===\n");
+        
+        // 16x16 procedural tiles: 4 shades of checkerboard
+        constexpr uint8_t TILE = 16;
+        constexpr uint16_t TILE_COUNT = 4;
+        static uint16_t tile_pixels[TILE_COUNT * TILE * TILE];
+        for (uint16_t t = 0; t < TILE_COUNT; t++) {
+            for (uint16_t i = 0; i < TILE * TILE; i++) {
+                const bool odd = ((i / TILE) / 4 + (i % TILE) / 4) & 1;
+                tile_pixels[t * TILE * TILE + i] = odd ? color565(40 * t, 60, 120) : color565(20, 30 + 40 * t, 60);
+            }
+        }
+        static const TileAtlas atlas(TILE, TILE, TILE_COUNT, tile_pixels);
+        
+        constexpr uint16_t MAP_COLS = 40, MAP_ROWS = 40;
+        static uint8_t map[MAP_COLS * MAP_ROWS];
+        for (uint16_t i = 0; i < MAP_COLS * MAP_ROWS; i++) {
+            map[i] = static_cast<uint8_t>((i * 7 + i / MAP_COLS) % TILE_COUNT);
+        }
+        
+        // 24x24 ball sprite with a colour key
+        constexpr int16_t BALL = 24;
+        static uint16_t ball_pixels[BALL * BALL];
+        for (int16_t y = 0; y < BALL; y++) {
+            for (int16_t x = 0; x < BALL; x++) {
+                const int16_t dx = 2 * x - BALL + 1, dy = 2 * y - BALL + 1;
+                ball_pixels[y * BALL + x] = (dx * dx + dy * dy <= BALL * BALL) ? rgb565::YELLOW : rgb565::MAGENTA;
+            }
+        }
+        const Sprite ball(BALL, BALL, ball_pixels, rgb565::MAGENTA);
+        
+        static ScanlineCompositor scene;
+        scene.clearSprites();
+        scene.setTileMap(&atlas, map, MAP_COLS, MAP_ROWS);
+        
+        constexpr int SPRITES = 16;
+        int16_t px[SPRITES], py[SPRITES], vx[SPRITES], vy[SPRITES];
+        int handles[SPRITES];
+        for (int i = 0; i < SPRITES; i++) {
+            px[i] = (i * 37) % (gfx_.width() - BALL);
+            py[i] = (i * 71) % (gfx_.height() - BALL);
+            vx[i] = (i & 1) ? 3 : -2;
+            vy[i] = (i & 2) ? 2 : -3;
+            handles[i] = scene.addSprite(ball, px[i], py[i]);
+        }
+        
+        const int frames = 60;
+        PerformanceTimer timer;
+        timer.start();
+        for (int f = 0; f < frames; f++) {
+            scene.setScroll(f * 2, f);
+            for (int i = 0; i < SPRITES; i++) {
+                px[i] += vx[i];
+                py[i] += vy[i];
+                if (px[i] < 0 || px[i] > gfx_.width() - BALL) vx[i] = -vx[i];
+                if (py[i] < 0 || py[i] > gfx_.height() - BALL) vy[i] = -vy[i];
+                scene.moveSprite(handles[i], px[i], py[i]);
+            }
+            scene.render(gfx_);
+        }
+        uint32_t elapsed_us = timer.getElapsedUs();
+        
+        printf("Compositor: %d full-screen frames, %d sprites: %lu ms, %.1f fps (last frame %lu us)\n",
+               frames, SPRITES, (unsigned long)(elapsed_us / 1000),
+               frames * 1000000.0f / (elapsed_us ? elapsed_us : 1),
+               (unsigned long)scene.stats().last_frame_us);
+        sleep_ms(1000);
+    }
+
+    void benchmarkConsole() {
+        printf("\n=== Text Console Benchmark ===\n");
+        
+        static TextConsole console;
+        if (!console.begin(gfx_, 16)) {
+            printf("Console: begin failed\n");
+            return;
+        }
+        gfx_.fillRect(0, 0, gfx_.width(), 16, rgb565::BLUE);
+        gfx_.drawString(4, 0, "Console benchmark (fixed area)", rgb565::WHITE, rgb565::BLUE, 1);
+        console.flush();
+        console.resetStats();
+        
+        // Log lines as fast as possible, flushing every 8 lines like a main loop would
+        const int lines = 2000;
+        uint32_t bytes = 0;
+        PerformanceTimer timer;
+        timer.start();
+        for (int i = 0; i < lines; i++) {
+            console.setTextColor(i % 10 == 0 ? 14 : 7, 0);
+            console.printf("[%6lu] sample %4d value=%08x\n", (unsigned long)time_us_32(), i, (unsigned)(i * 2654435761u));
+            if ((i & 7) == 7) {
+                console.flush();
+                bytes += console.stats().last_bytes;
+            }
+        }
+        console.flush();
+        bytes += console.stats().last_bytes;
+        uint32_t elapsed_us = timer.getElapsedUs();
+        
+        const TextConsole::Stats& stats = console.stats();
+        printf("Console: %d lines in %lu ms (%.0f lines/s), %lu KB sent, %s scroll (%lu rows), %lu dropped\n",
+               lines, (unsigned long)(elapsed_us / 1000), lines * 1000000.0f / (elapsed_us ? elapsed_us : 1),
+               (unsigned long)(bytes / 1024), console.hardwareScroll() ? "hardware" : "redraw",
+               (unsigned long)(stats.hardware_scrolls + stats.redraw_scrolls), (unsigned long)stats.dropped);
+        sleep_ms(1000);
+        
+        // Back to an unscrolled screen for the following tests
+        gfx_.setScrollMargins(0, 0);
+    }
+
+private:
+    // Minimal QOI encoder (RGB) for the test card
+    static void encodeQoiTestImage(std::vector<uint8_t>& out, uint16_t w, uint16_t h) {
+        auto put32 = [&out](uint32_t v) {
+            for (int shift = 24; shift >= 0; shift -= 8) out.push_back(static_cast<uint8_t>(v >> shift));
+        };
+        out.clear();
+        out.insert(out.end(), {'q', 'o', 'i', 'f'});
+        put32(w);
+        put32(h);
+        out.push_back(3);
+        out.push_back(0);
+        
+        uint32_t index[64] = {};
+        uint32_t prev = 0xFF000000u;
+        uint8_t run = 0;
+        for (uint16_t y = 0; y < h; y++) {
+            for (uint16_t x = 0; x < w; x++) {
+                // Smooth ramps with colour bars: a typical UI-asset mix
+                const uint8_t r = static_cast<uint8_t>((x * 255) / w);
+                const uint8_t g = static_cast<uint8_t>((y * 255) / h);
+                const uint8_t b = ((x / 40) & 1) ? 200 : 40;
+                const uint32_t px = 0xFF000000u | (r << 16) | (g << 8) | b;
+                
+                if (px == prev) {
+                    if (++run == 62) { out.push_back(0xC0 | (run - 1)); run = 0; }
+                    continue;
+                }
+                if (run) { out.push_back(0xC0 | (run - 1)); run = 0; }
+                
+                const uint8_t hash = (r * 3 + g * 5 + b * 7 + 255 * 11) & 63;
+                if (index[hash] == px) {
+                    out.push_back(hash);
+                } else {
+                    index[hash] = px;
+                    const int dr = static_cast<int8_t>(r - ((prev >> 16) & 0xFF));
+                    const int dg = static_cast<int8_t>(g - ((prev >> 8) & 0xFF));
+                    const int db = static_cast<int8_t>(b - (prev & 0xFF));
+                    if (dr >= -2 && dr <= 1 && dg >= -2 && dg <= 1 && db >= -2 && db <= 1) {
+                        out.push_back(0x40 | ((dr + 2) << 4) | ((dg + 2) << 2) | (db + 2));
+                    } else if (dg >= -32 && dg <= 31 && dr - dg >= -8 && dr - dg <= 7 && db - dg >= -8 && db - dg <= 7) {
+                        out.push_back(0x80 | (dg + 32));
+                        out.push_back(((dr - dg + 8) << 4) | (db - dg + 8));
+                    } else {
+                        out.insert(out.end(), {0xFE, r, g, b});
+                    }
+                }
+                prev = px;
+            }
+        }
+        if (run) out.push_back(0xC0 | (run - 1));
+        out.insert(out.end(), {0, 0, 0, 0, 0, 0, 0, 1});
+    }
 };
 
 // Advanced graphics demonstrations
@@ -457,24 +660,32 @@ public:
     void mandelbrotFractal() {
         printf("\n=== Mandelbrot Fractal Demo ===\n");
         
-        constexpr double zoom = 200.0;
-        constexpr double offset_x = -0.5;
-        constexpr double offset_y = 0.0;
+        // Q8.24 fixed point: no soft-float on the FPU-less RP2040
+        namespace fx = ili9488::fixed;
+        constexpr int FRAC = 24;
+        constexpr int32_t zoom = 200;
+        constexpr int32_t offset_x = -(1 << FRAC) / 2;   // -0.5
+        constexpr int32_t offset_y = 0;
+        constexpr int32_t step = (1 << FRAC) / zoom;
+        constexpr int32_t escape = 4 << FRAC;
         constexpr int max_iter = 50;
         
         for (uint16_t py = 0; py < driver_.getHeight(); ++py) {
             for (uint16_t px = 0; px < driver_.getWidth(); ++px) {
-                double x0 = (px - driver_.getWidth() / 2.0) / zoom + offset_x;
-                double y0 = (py - driver_.getHeight() / 2.0) / zoom + offset_y;
+                const int32_t x0 = (px - driver_.getWidth() / 2) * step + offset_x;
+                const int32_t y0 = (py - driver_.getHeight() / 2) * step + offset_y;
                 
-                double x = 0.0;
-                double y = 0.0;
+                int32_t x = 0;
+                int32_t y = 0;
+                int32_t x2 = 0;
+                int32_t y2 = 0;
                 int iteration = 0;
                 
-                while (x*x + y*y <= 4.0 && iteration < max_iter) {
-                    double xtemp = x*x - y*y + x0;
-                    y = 2*x*y + y0;
-                    x = xtemp;
+                while (x2 + y2 <= escape && iteration < max_iter) {
+                    y = 2 * fx::mulq<FRAC>(x, y) + y0;
+                    x = x2 - y2 + x0;
+                    x2 = fx::mulq<FRAC>(x, x);
+                    y2 = fx::mulq<FRAC>(y, y);
                     iteration++;
                 }
                 
@@ -505,23 +716,32 @@ public:
     void plasmaEffect() {
         printf("\n=== Plasma Effect Demo ===\n");
         
+        // Binary angles (65536 = 2*pi): 1 rad ~ 10430, so 0.01 rad ~ 104, 0.1 rad ~ 1043
+        namespace fx = ili9488::fixed;
+        auto channel = [](fx::angle_t angle) -> uint8_t {
+            const int32_t s = fx::sin_raw(angle);
+            return s > 0 ? static_cast<uint8_t>((255 * s) >> 15) : 0;
+        };
+        
         for (int frame = 0; frame < 120; ++frame) {
+            const int32_t time = frame * 1043;
             for (uint16_t y = 0; y < driver_.getHeight(); ++y) {
                 for (uint16_t x = 0; x < driver_.getWidth(); ++x) {
-                    double dx = x - driver_.getWidth() / 2.0;
-                    double dy = y - driver_.getHeight() / 2.0;
-                    double distance = sqrt(dx*dx + dy*dy);
+                    const int32_t dx = x - driver_.getWidth() / 2;
+                    const int32_t dy = y - driver_.getHeight() / 2;
+                    // distance * 0.02 rad: isqrt of (d^2 << 8) gives distance in 1/16 px
+                    const int32_t distance16 = fx::isqrt(static_cast<uint32_t>(dx*dx + dy*dy) << 8);
                     
-                    double time = frame * 0.1;
-                    double value = sin(distance * 0.02 + time) + 
-                                  sin(x * 0.01 + time * 1.5) +
-                                  sin(y * 0.01 + time * 2.0);
+                    const int32_t value = fx::sin_raw(static_cast<fx::angle_t>(((distance16 * 209) >> 4) + time)) +
+                                          fx::sin_raw(static_cast<fx::angle_t>(x * 104 + (time * 3) / 2)) +
+                                          fx::sin_raw(static_cast<fx::angle_t>(y * 104 + time * 2));
                     
-                    value = (value + 3.0) / 6.0; // Normalize to 0-1
+                    // Normalize -3..3 (scaled by 32768) to 0..pi as a binary angle
+                    const fx::angle_t phase = static_cast<fx::angle_t>((value + 3 * 32768) / 6);
                     
-                    uint8_t r = static_cast<uint8_t>(255 * sin(value * M_PI));
-                    uint8_t g = static_cast<uint8_t>(255 * sin(value * M_PI + M_PI/3));
-                    uint8_t b = static_cast<uint8_t>(255 * sin(value * M_PI + 2*M_PI/3));
+                    uint8_t r = channel(phase);
+                    uint8_t g = channel(static_cast<fx::angle_t>(phase + 0x2AAB));   // + pi/3
+                    uint8_t b = channel(static_cast<fx::angle_t>(phase + 0x5555));   // + 2pi/3
                     
                     uint16_t color = rgb565::from_rgb888(r, g, b);
                     driver_.drawPixel(x, y, color);
@@ -576,6 +796,12 @@ int main() {
     benchmark.benchmarkDMATransfers();
     sleep_ms(1000);
     
+    benchmark.benchmarkQoiDecode();
+    
+    benchmark.benchmarkCompositor();
+    
+    benchmark.benchmarkConsole();
+    
     printf("\nBasic benchmarks completed, skipping complex graphics demos...\n");
     
     // Clear screen and show end message
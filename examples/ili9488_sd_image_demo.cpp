@@ -0,0 +1,181 @@
+/**
+ * @file ili9488_sd_image_demo.cpp
+ * @brief QOI slideshow and decode benchmark streaming from the SD card
+ * @note Every .qoi file in IMAGE_DIR is decoded straight from its open file
+ *       through ili9488_image::SdFileSource, so no image is ever resident in
+ *       RAM. Small files are decoded a second time from a RAM copy to split the
+ *       total time into SD read cost and decode + panel cost.
+ */
+
+#include <cstdio>
+#include <string>
+#include <vector>
+#include <algorithm>
+#include <cctype>
+
+#include "pico/stdlib.h"
+#include "hardware/spi.h"
+
+#include "ili9488_driver.hpp"
+#include "pico_ili9488_gfx.hpp"
+#include "ili9488_colors.hpp"
+#include "qoi_decoder.hpp"
+#include "sd_image_source.hpp"
+#include "rw_sd.hpp"
+
+// 统一引脚配置
+#include "pin_config.hpp"
+
+using namespace ili9488;
+using namespace ili9488_colors;
+
+// Directory scanned for images
+#define IMAGE_DIR "/images"
+
+// Files up to this size are also decoded from RAM for comparison
+#define RAM_COMPARE_MAX_BYTES (64 * 1024)
+
+// Time each image stays on screen in the slideshow
+#define SLIDE_DELAY_MS 2000
+
+namespace {
+
+// Keep the decoder's line buffers off the stack
+ili9488_image::QoiDecoder g_decoder;
+
+bool hasQoiExtension(const std::string& name) {
+    if (name.size() < 4) return false;
+    std::string ext = name.substr(name.size() - 4);
+    std::transform(ext.begin(), ext.end(), ext.begin(),
+                   [](unsigned char c) { return static_cast<char>(std::tolower(c)); });
+    return ext == ".qoi";
+}
+
+uint32_t ratePerSecond(uint64_t count, uint64_t elapsed_us) {
+    return static_cast<uint32_t>(count * 1000000ULL / (elapsed_us ? elapsed_us : 1));
+}
+
+/**
+ * @brief Decode one file from SD through SdFileSource and report the timing
+ * @return Decode time in microseconds, 0 on failure
+ */
+uint64_t decodeFromSd(MicroSD::RWSD& sd, const std::string& path,
+                      pico_ili9488_gfx::PicoILI9488GFX<ILI9488Driver>& gfx) {
+    auto file = sd.open_file(path, "r");
+    if (!file.is_ok()) {
+        printf("  open failed: %s\n",
+               MicroSD::StorageDevice::get_error_description(file.error_code()).c_str());
+        return 0;
+    }
+
+    ili9488_image::SdFileSource source(*file);
+    const uint64_t start = time_us_64();
+    const auto status = g_decoder.decode(source, gfx, 0, 0);
+    const uint64_t elapsed_us = time_us_64() - start;
+
+    if (status != ili9488_image::ImageStatus::Ok) {
+        printf("  decode failed: %s\n", ili9488_image::statusName(status));
+        return 0;
+    }
+
+    const auto& info = g_decoder.info();
+    printf("  %lux%lu, SD stream: %lu us, %lu KB/s, %lu pixels/s\n",
+           (unsigned long)info.width, (unsigned long)info.height,
+           (unsigned long)elapsed_us,
+           (unsigned long)(ratePerSecond(g_decoder.bytesRead(), elapsed_us) / 1024),
+           (unsigned long)ratePerSecond(g_decoder.pixelsDecoded(), elapsed_us));
+    return elapsed_us;
+}
+
+/**
+ * @brief Decode the same file from a RAM copy (no SD in the loop)
+ */
+void decodeFromRam(MicroSD::RWSD& sd, const std::string& path, uint64_t sd_us,
+                   pico_ili9488_gfx::PicoILI9488GFX<ILI9488Driver>& gfx) {
+    auto data = sd.read_file(path);
+    if (!data.is_ok()) {
+        printf("  RAM copy failed\n");
+        return;
+    }
+
+    ili9488_image::MemorySource source(data->data(), data->size());
+    const uint64_t start = time_us_64();
+    const auto status = g_decoder.decode(source, gfx, 0, 0);
+    const uint64_t elapsed_us = time_us_64() - start;
+    if (status != ili9488_image::ImageStatus::Ok) return;
+
+    printf("  RAM copy:  %lu us (SD read share %lu%%)\n",
+           (unsigned long)elapsed_us,
+           (unsigned long)(sd_us > elapsed_us ? (sd_us - elapsed_us) * 100 / sd_us : 0));
+}
+
+} // namespace
+
+int main() {
+    stdio_init_all();
+    printf("=== ILI9488 SD Image Demo (QOI) ===\n");
+
+    ILI9488Driver driver(ILI9488_GET_SPI_CONFIG());
+    pico_ili9488_gfx::PicoILI9488GFX<ILI9488Driver> gfx(driver, 320, 480);
+
+    if (!driver.initialize()) {
+        printf("Failed to initialize display!\n");
+        return -1;
+    }
+    driver.setRotation(Rotation::Portrait_180);
+    driver.fillScreen(rgb565::BLACK);
+    driver.setBacklight(true);
+
+    MicroSD::RWSD sd;
+    auto init_result = sd.initialize();
+    if (!init_result.is_ok()) {
+        printf("SD init failed: %s\n",
+               MicroSD::StorageDevice::get_error_description(init_result.error_code()).c_str());
+        gfx.drawString(10, 10, "SD card not found", rgb565::RED, rgb565::BLACK, 2);
+        return -1;
+    }
+
+    auto listing = sd.list_directory(IMAGE_DIR);
+    std::vector<std::string> images;
+    if (listing.is_ok()) {
+        for (const auto& entry : *listing) {
+            if (!entry.is_directory && hasQoiExtension(entry.name)) {
+                images.push_back(std::string(IMAGE_DIR) + "/" + entry.name);
+            }
+        }
+    }
+    std::sort(images.begin(), images.end());
+
+    if (images.empty()) {
+        printf("No .qoi files in %s\n", IMAGE_DIR);
+        gfx.drawString(10, 10, "No .qoi in " IMAGE_DIR, rgb565::YELLOW, rgb565::BLACK, 2);
+        return -1;
+    }
+    printf("%zu image(s) in %s\n", images.size(), IMAGE_DIR);
+
+    // First pass: benchmark every file
+    for (const auto& path : images) {
+        auto info = sd.get_file_info(path);
+        const size_t file_size = info.is_ok() ? info->size : 0;
+        printf("\n%s (%zu bytes)\n", path.c_str(), file_size);
+
+        driver.fillScreen(rgb565::BLACK);
+        const uint64_t sd_us = decodeFromSd(sd, path, gfx);
+        if (sd_us && file_size <= RAM_COMPARE_MAX_BYTES) {
+            decodeFromRam(sd, path, sd_us, gfx);
+        }
+        sleep_ms(SLIDE_DELAY_MS);
+    }
+
+    // Then loop as a slideshow
+    printf("\nSlideshow running\n");
+    while (true) {
+        for (const auto& path : images) {
+            driver.fillScreen(rgb565::BLACK);
+            decodeFromSd(sd, path, gfx);
+            sleep_ms(SLIDE_DELAY_MS);
+        }
+    }
+
+    return 0;
+}
@@ -0,0 +1,81 @@
+#pragma once
+
+#include <cstdint>
+
+#include "ili9488_colors.hpp"
+
+namespace hybrid_font {
+
+// RGB565 -> RGB666线上格式（0xRRGGBB，每字节高6位有效）
+using ili9488_colors::rgb565_to_wire666;
+
+/**
+ * @brief 前景/背景混合色阶
+ * 字形覆盖度0-3（0 = 背景，3 = 前景，1bpp字形只用0和3）对应的颜色，
+ * 预先算好RGB666线上字节和逐像素回退用的RGB565，绘制时每个像素只查表。
+ */
+struct BlendRamp {
+    static constexpr int LEVELS = 4;
+    
+    uint32_t fg = 0;                // RGB666（0xRRGGBB）
+    uint32_t bg = 0;
+    uint8_t wire[LEVELS][3] = {};   // 覆盖度 -> 线上字节
+    uint16_t rgb565[LEVELS] = {};   // 覆盖度 -> RGB565（drawPixel回退路径）
+    
+    /**
+     * @brief 计算色阶（每个通道在6位精度上线性混合）
+     * @param fg_color 前景色（RGB666）
+     * @param bg_color 背景色（RGB666）
+     */
+    static BlendRamp make(uint32_t fg_color, uint32_t bg_color) {
+        BlendRamp ramp;
+        ramp.fg = fg_color & 0xFCFCFC;
+        ramp.bg = bg_color & 0xFCFCFC;
+        for (int level = 0; level < LEVELS; level++) {
+            uint8_t c6[3];
+            for (int ch = 0; ch < 3; ch++) {
+                const int shift = 16 - ch * 8;
+                const int f = (ramp.fg >> (shift + 2)) & 0x3F;
+                const int b = (ramp.bg >> (shift + 2)) & 0x3F;
+                c6[ch] = static_cast<uint8_t>((b * (LEVELS - 1 - level) + f * level + 1) / (LEVELS - 1));
+                ramp.wire[level][ch] = static_cast<uint8_t>(c6[ch] << 2);
+            }
+            ramp.rgb565[level] = static_cast<uint16_t>(((c6[0] >> 1) << 11) | (c6[1] << 5) | (c6[2] >> 1));
+        }
+        return ramp;
+    }
+};
+
+/**
+ * @brief 最近使用的几组色阶（同一页文字通常只有一两对颜色）
+ */
+class BlendRampCache {
+public:
+    static constexpr int ENTRIES = 4;
+    
+    /**
+     * @brief 获取 (前景, 背景) 的色阶，没有时计算并替换最早的一组
+     * @return 色阶引用，在之后ENTRIES次未命中之前有效
+     */
+    const BlendRamp& get(uint32_t fg, uint32_t bg) {
+        fg &= 0xFCFCFC;
+        bg &= 0xFCFCFC;
+        for (int i = 0; i < count_; i++) {
+            if (ramps_[i].fg == fg && ramps_[i].bg == bg) {
+                return ramps_[i];
+            }
+        }
+        
+        const int slot = (count_ < ENTRIES) ? count_++ : next_;
+        next_ = (slot + 1) % ENTRIES;
+        ramps_[slot] = BlendRamp::make(fg, bg);
+        return ramps_[slot];
+    }
+
+private:
+    BlendRamp ramps_[ENTRIES];
+    int count_ = 0;
+    int next_ = 0;
+};
+
+} // namespace hybrid_font
@@ -0,0 +1,133 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include "hybrid_font_system.hpp"
+#include "blend_ramp.hpp"
+
+// 彩色字形缓存的内存预算（字节），每个槽存放一个16x16字形的RGB666线上数据（768字节）
+// 默认32个槽只够标题、按钮等少量反复出现的UI字符串；一页中文正文的不同字形远多于此，
+// 逐字形走本缓存会不停淘汰，正文应使用整行渲染器（TextRunRenderer）
+#ifndef HYBRID_FONT_COLOR_CACHE_BYTES
+#define HYBRID_FONT_COLOR_CACHE_BYTES 24576
+#endif
+
+namespace hybrid_font {
+
+/**
+ * @brief 已展开成RGB666线上字节的字形（只读视图）
+ */
+struct ColorGlyph {
+    const uint8_t* data = nullptr;  // width*height*3字节，逐行，可直接DMA发送
+    uint8_t width = 0;
+    uint8_t height = 0;
+    
+    bool empty() const { return data == nullptr; }
+    size_t size() const { return static_cast<size_t>(width) * height * 3; }
+};
+
+/**
+ * @brief 彩色字形缓存
+ * 以 (码点, 前景色, 背景色) 为键，缓存已展开为18bpp线上字节的字形
+ * （抗锯齿字形按色阶混合），绘制一个字形只需设置一次窗口 + 一次DMA突发传输。
+ * 开放寻址哈希 + 侵入式LRU链表，全部为固定数组，不分配内存。
+ *
+ * 返回的数据在该字形被淘汰前有效；最近使用的字形不会被下一次未命中淘汰
+ * （容量至少2个槽），所以上一个字形的DMA传输可以和下一个字形的查找重叠。
+ */
+class ColorGlyphCache {
+public:
+    static constexpr size_t BUDGET_BYTES = HYBRID_FONT_COLOR_CACHE_BYTES;
+    static constexpr size_t SLOT_BYTES = FontConfig::FLASH_FONT_WIDTH * FontConfig::FLASH_FONT_HEIGHT * 3;
+    static constexpr uint16_t SLOT_COUNT = static_cast<uint16_t>(BUDGET_BYTES / SLOT_BYTES);
+    static_assert(SLOT_COUNT >= 2 && SLOT_COUNT <= 1024, "HYBRID_FONT_COLOR_CACHE_BYTES must hold 2..1024 glyphs");
+    
+    /**
+     * @brief 缓存统计
+     */
+    struct Stats {
+        uint32_t hits = 0;          // 直接返回已展开的字形
+        uint32_t misses = 0;        // 展开后放入缓存
+        uint32_t evictions = 0;     // 淘汰的最久未使用字形
+        uint32_t uncached = 0;      // 字形大于槽（如24x24）或不存在，未缓存
+    };
+    
+    ColorGlyphCache();
+    
+    /**
+     * @brief 获取彩色字形，未命中时从字体源取位图并按色阶展开
+     * @param source 字体数据源
+     * @param char_code Unicode字符代码
+     * @param ramp 前景/背景色阶
+     * @return 彩色字形；字符不存在或字形大于槽时返回空
+     */
+    ColorGlyph get(const IFontDataSource& source, uint32_t char_code, const BlendRamp& ramp);
+    
+    /**
+     * @brief 清空缓存（字体源变化后调用）
+     */
+    void clear();
+    
+    /**
+     * @brief 把字形展开为RGB666线上字节（每个像素按覆盖度查色阶）
+     * @param glyph 字形视图
+     * @param ramp 前景/背景色阶
+     * @param dst 目标缓冲区，至少 width*height*3 字节
+     */
+    static void expand(const GlyphView& glyph, const BlendRamp& ramp, uint8_t* dst);
+    
+    const Stats& get_stats() const { return stats_; }
+    void reset_stats() { stats_ = Stats(); }
+    
+    /**
+     * @brief 命中率（千分比），没有查找时返回0
+     */
+    uint32_t hit_rate_permille() const;
+    
+    uint16_t get_cached_count() const { return used_slots_; }
+    
+    /**
+     * @brief 打印缓存统计
+     */
+    void print_stats() const;
+
+private:
+    static constexpr uint16_t HASH_SIZE = (SLOT_COUNT <= 32) ? 64 :
+                                          (SLOT_COUNT <= 64) ? 128 :
+                                          (SLOT_COUNT <= 128) ? 256 :
+                                          (SLOT_COUNT <= 256) ? 512 :
+                                          (SLOT_COUNT <= 512) ? 1024 : 2048;
+    static constexpr uint16_t NO_SLOT = 0xFFFF;
+    
+    struct Slot {
+        uint64_t key;               // 码点 | 前景色<<21 | 背景色<<39（颜色为18位）
+        uint16_t prev;              // 更近使用
+        uint16_t next;              // 更久未使用
+        uint8_t width;
+        uint8_t height;
+    };
+    
+    static uint64_t pack18(uint32_t color) {
+        return ((color >> 6) & 0x3F000) | ((color >> 4) & 0xFC0) | ((color >> 2) & 0x3F);
+    }
+    static uint64_t make_key(uint32_t char_code, const BlendRamp& ramp) {
+        return static_cast<uint64_t>(char_code & 0x1FFFFF) | (pack18(ramp.fg) << 21) | (pack18(ramp.bg) << 39);
+    }
+    static uint16_t hash_index(uint64_t key);
+    uint16_t find_slot(uint64_t key) const;
+    void hash_insert(uint16_t slot);
+    void hash_remove(uint64_t key);
+    void lru_unlink(uint16_t slot);
+    void lru_push_front(uint16_t slot);
+    
+    Slot slots_[SLOT_COUNT];
+    uint16_t hash_[HASH_SIZE];
+    uint16_t lru_head_;
+    uint16_t lru_tail_;
+    uint16_t used_slots_;
+    Stats stats_;
+    
+    uint8_t pixels_[SLOT_COUNT][SLOT_BYTES];
+};
+
+} // namespace hybrid_font
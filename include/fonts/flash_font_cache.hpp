@@ -4,6 +4,21 @@
 #include <cstdint>
 #include <cstddef>
 
+// 缓存的字形数量（24x24字形每个72字节，默认256个约18KB SRAM）
+#ifndef ILI9488_GLYPH_CACHE_SLOTS
+#define ILI9488_GLYPH_CACHE_SLOTS 256
+#endif
+
+// 每个缓存槽的位图字节数（解码后的字形必须放得下：1bpp 24x24 = 72，2bpp 24x24 = 144）
+#ifndef ILI9488_GLYPH_CACHE_SLOT_BYTES
+#define ILI9488_GLYPH_CACHE_SLOT_BYTES 72
+#endif
+
+// 后台预取队列长度（下一页的字形数，实际不超过缓存槽数的一半，当前页的字形不会被全部淘汰）
+#ifndef ILI9488_GLYPH_PREFETCH_QUEUE
+#define ILI9488_GLYPH_PREFETCH_QUEUE 128
+#endif
+
 namespace ili9488_font {
 
 // 字体文件头结构
@@ -12,16 +27,131 @@ struct FontHeader {
     uint16_t char_count;  // 字符数量
 };
 
+// 版本2字体文件头（前4字节与版本1相同）
+// 文件布局: 文件头 | [上下文模型] | [前进宽度] | [字距调整] | 索引 | 字形记录
+//   上下文模型: flags含FONT_FLAG_CONTEXT_MODEL时紧跟文件头，((1<<bpp)-1)*1024字节，
+//         每字节为该上下文下位为0的概率（1/256单位），GLYPH_CONTEXT记录使用
+//   前进宽度: flags含FONT_FLAG_ADVANCES时，uint8_t 前进宽度[glyph_count]（没有时为字形宽度）
+//   字距调整: flags含FONT_FLAG_KERNING时，uint16_t 对数，然后按 (左, 右) 升序的
+//         KerningPair[对数]，左右为字形序号
+//   索引: uint32_t 块基址[glyph_count/32 + 1]，然后 uint16_t 块内偏移[glyph_count + 1]
+//         字形i的记录从 data_offset + 块基址[i/32] + 块内偏移[i] 开始，到字形i+1的记录为止
+//   字形记录: 1字节编码 + 数据（见GlyphEncoding），解码后为逐行位图，
+//         每行 (width*bpp+7)/8 字节，高位在左，2bpp时每像素0-3表示覆盖度
+// 所有多字节字段为小端，生成工具: tools/font_v2_pack.py
+struct FontHeaderV2 {
+    uint16_t version;       // 2
+    uint16_t glyph_count;   // 字形数量
+    uint8_t width;          // 字形宽度（像素）
+    uint8_t height;         // 字形高度（像素）
+    uint8_t bpp;            // 每像素位数（1或2）
+    uint8_t flags;          // FONT_FLAG_*
+    uint32_t index_offset;  // 索引相对文件头的偏移
+    uint32_t data_offset;   // 字形记录区相对文件头的偏移
+};
+static_assert(sizeof(FontHeaderV2) == 16, "FontHeaderV2 must be 16 bytes");
+
+static constexpr uint8_t FONT_FLAG_CONTEXT_MODEL = 0x01;   // 文件头后有上下文模型
+static constexpr uint8_t FONT_FLAG_ADVANCES = 0x02;        // 有逐字形前进宽度
+static constexpr uint8_t FONT_FLAG_KERNING = 0x04;         // 有字距调整对
+static constexpr size_t FONT_CONTEXT_COUNT = 1024;          // 每个模型表的上下文数（10个相邻像素）
+
+// 版本2字形记录编码
+enum GlyphEncoding : uint8_t {
+    GLYPH_RAW = 0,          // 未压缩位图
+    GLYPH_RLE = 1,          // 逐像素游程：每字节 值<<6 | (长度-1)，按行连续，长度1-64
+    GLYPH_EMPTY = 2,        // 全部为0（空格等）
+    GLYPH_CONTEXT = 3       // 二进制算术编码，概率取自上下文模型（见decode_glyph）
+};
+
+// 字距调整对（6字节，小端）
+struct KerningPair {
+    uint16_t left;          // 左字形序号
+    uint16_t right;         // 右字形序号
+    int8_t adjust;          // 调整量（像素，负数为收紧）
+    uint8_t reserved;
+};
+static_assert(sizeof(KerningPair) == 6, "KerningPair must be 6 bytes");
+
+// 字形缓存统计
+struct GlyphCacheStats {
+    uint32_t hits;        // 命中（直接从SRAM返回）
+    uint32_t misses;      // 未命中（从Flash读取）
+    uint32_t evictions;   // 被淘汰的最久未使用字形
+    uint32_t prefetched;  // 后台预取读入的字形
+};
+
 // Flash字体缓存类
 class FlashFontCache {
 private:
     static constexpr size_t BYTES_PER_CHAR_16 = 32;  // 16x16字体每字符字节数
     static constexpr size_t BYTES_PER_CHAR_24 = 72;  // 24x24字体每字符字节数
+    static constexpr size_t SLOT_BYTES = ILI9488_GLYPH_CACHE_SLOT_BYTES;
+    static constexpr uint16_t V2_BLOCK_GLYPHS = 32;  // 版本2索引每块字形数
+    static_assert(SLOT_BYTES >= BYTES_PER_CHAR_24, "ILI9488_GLYPH_CACHE_SLOT_BYTES must hold a 1bpp 24x24 glyph");
+    
+    // LRU字形缓存：开放寻址哈希表（按码点查找）+ 侵入式双向链表（使用顺序）
+    // 全部为固定大小数组，查找和淘汰都不分配内存
+    static constexpr uint16_t CACHE_SLOTS = ILI9488_GLYPH_CACHE_SLOTS;
+    static constexpr uint16_t HASH_SIZE = (CACHE_SLOTS <= 128) ? 256 :
+                                          (CACHE_SLOTS <= 256) ? 512 :
+                                          (CACHE_SLOTS <= 512) ? 1024 :
+                                          (CACHE_SLOTS <= 1024) ? 2048 : 4096;
+    static constexpr uint16_t NO_SLOT = 0xFFFF;
+    static_assert(CACHE_SLOTS > 0 && CACHE_SLOTS <= 2048, "ILI9488_GLYPH_CACHE_SLOTS must be 1..2048");
+    
+    // 后台预取：码点队列 + 两个记录缓冲区（一个在传输时解码另一个）
+    static constexpr uint16_t PREFETCH_QUEUE = (ILI9488_GLYPH_PREFETCH_QUEUE < CACHE_SLOTS / 2) ? ILI9488_GLYPH_PREFETCH_QUEUE :
+                                               (CACHE_SLOTS / 2 > 0) ? CACHE_SLOTS / 2 : 1;
+    static constexpr size_t PREFETCH_BUFFER_WORDS = (SLOT_BYTES + 1 + 3 + 3) / 4;  // 编码字节 + 位图 + 对齐
+    
+    struct PrefetchBuffer {
+        uint32_t words[PREFETCH_BUFFER_WORDS];  // DMA按字写入
+        const uint8_t* record;              // 记录首字节（words内，记录过长时直接指向Flash）
+        uint32_t length;                    // 记录字节数
+        uint32_t code;                      // Unicode码点
+    };
+    
+    struct GlyphSlot {
+        uint32_t code;                      // Unicode码点
+        uint16_t prev;                      // 更近使用的槽（NO_SLOT = 链表头）
+        uint16_t next;                      // 更久未使用的槽（NO_SLOT = 链表尾）
+        uint8_t bitmap[SLOT_BYTES];         // 解码后的字形位图（16x16 1bpp只用前32字节）
+    };
     
     const uint8_t* flash_data_;     // Flash数据指针
     int font_size_;                 // 字体大小 (16 或 24)
     bool initialized_;              // 初始化状态
     
+    // 字形格式（版本1: font_size x font_size 1bpp；版本2: 取自文件头）
+    uint16_t version_;
+    uint8_t glyph_width_;
+    uint8_t glyph_height_;
+    uint8_t bpp_;
+    size_t glyph_bytes_;            // 解码后每字形字节数
+    uint16_t glyph_count_;          // 版本2: 字形数量
+    uint32_t index_offset_;         // 版本2: 索引偏移
+    uint32_t data_offset_;          // 版本2: 字形记录区偏移
+    const uint8_t* model_;          // 版本2: 上下文模型（没有时为nullptr）
+    const uint8_t* advances_;       // 版本2: 前进宽度表（没有时为nullptr）
+    const uint8_t* kerning_;        // 版本2: 字距调整对（没有时为nullptr）
+    uint16_t kerning_count_;
+    
+    mutable GlyphSlot slots_[CACHE_SLOTS];
+    mutable uint16_t hash_[HASH_SIZE];  // 槽号，NO_SLOT = 空
+    mutable uint16_t lru_head_;         // 最近使用
+    mutable uint16_t lru_tail_;         // 最久未使用（下一个被淘汰）
+    mutable uint16_t used_slots_;
+    mutable GlyphCacheStats stats_;
+    
+    uint32_t prefetch_queue_[PREFETCH_QUEUE];   // 环形队列
+    uint16_t prefetch_head_;
+    uint16_t prefetch_count_;
+    PrefetchBuffer prefetch_buffers_[2];
+    uint8_t prefetch_fill_;         // 正在传输（或下一个传输）的缓冲区
+    bool prefetch_in_flight_;       // prefetch_buffers_[prefetch_fill_]中有待解码的记录
+    int prefetch_dma_;              // 预取DMA通道，-1 = 未申请
+    
     // 私有构造函数（单例模式）
     FlashFontCache();
     
@@ -32,6 +162,36 @@ private:
     // 使用Unicode范围表查找字符偏移
     uint32_t get_char_offset(uint32_t unicode_code) const;
     
+    // 返回字形在缓存中的位图，未命中时从Flash读入（可能淘汰最久未使用的字形）
+    const uint8_t* lookup_glyph(uint32_t unicode_code) const;
+    
+    // 把字形（字体文件中的序号）读入/解码到dst
+    void load_glyph(uint32_t glyph_index, uint8_t* dst) const;
+    
+    // 字形记录在字体文件中的偏移和长度（版本1为定长位图）
+    bool glyph_record(uint32_t glyph_index, uint32_t& start, uint32_t& length) const;
+    bool decode_record(const uint8_t* record, uint32_t length, uint8_t* dst) const;
+    
+    // 取一个空闲槽（缓存满时淘汰最久未使用的字形），填好位图后插入
+    uint16_t take_slot() const;
+    void insert_slot(uint16_t slot, uint32_t unicode_code) const;
+    
+    // 预取：从队列取下一个未缓存的字形开始传输 / 等待传输 / 解码入缓存
+    bool start_prefetch();
+    void wait_prefetch();
+    bool finish_prefetch(const PrefetchBuffer& buffer);
+    
+    // 哈希表操作（线性探测）
+    static uint16_t hash_index(uint32_t unicode_code);
+    uint16_t find_slot(uint32_t unicode_code) const;
+    void hash_remove(uint32_t unicode_code) const;
+    
+    // LRU链表操作
+    void lru_unlink(uint16_t slot) const;
+    void lru_push_front(uint16_t slot) const;
+    
+    size_t bytes_per_char() const;
+    
 public:
     // 获取单例实例
     static FlashFontCache& get_instance();
@@ -45,9 +205,61 @@ public:
     // 获取字体大小
     int get_font_size() const;
     
-    // 从Flash中读取字符位图数据
+    // 字形格式：宽、高、每像素位数、每行字节数
+    int get_glyph_width() const;
+    int get_glyph_height() const;
+    int get_bits_per_pixel() const;
+    int get_glyph_stride() const;
+    
+    // 字符的前进宽度（像素）：字体有宽度表时查表，否则为字形宽度
+    int get_advance(uint32_t unicode_code) const;
+    
+    // 两个字符之间的字距调整（像素，通常为0或负数），字体没有字距表时返回0
+    int get_kerning(uint32_t left_code, uint32_t right_code) const;
+    
+    bool has_advances() const;
+    bool has_kerning() const;
+    
+    // 解码一个版本2字形记录（不经过缓存，可直接写入行缓冲区等）
+    // record指向编码字节，length为记录总长；model为上下文模型（没有时为nullptr）；
+    // dst至少 height*stride 字节
+    static bool decode_glyph(const uint8_t* record, size_t length, 
+                             int width, int height, int bpp, 
+                             const uint8_t* model, uint8_t* dst);
+    
+    // 获取字符位图指针（指向SRAM字形缓存，不复制）
+    // 该字形被后续的未命中淘汰前有效，未初始化时返回nullptr
+    const uint8_t* get_char_data(uint32_t char_code) const;
+    
+    // 读取字符位图数据（兼容接口，复制get_char_data()的数据）
     std::vector<uint8_t> get_char_bitmap(uint16_t char_code) const;
     
+    // 字形缓存统计
+    GlyphCacheStats get_cache_stats() const;
+    void reset_cache_stats();
+    
+    // 已缓存字形数 / 容量
+    uint16_t get_cached_glyph_count() const;
+    static constexpr uint16_t get_cache_capacity() { return CACHE_SLOTS; }
+    
+    // 清空字形缓存（Flash中的字体数据更新后调用）
+    void clear_cache();
+    
+    // 后台预取：把马上要用的字形（如下一页）排队，在空闲时用run_prefetch()读入缓存
+    // 记录经XIP流式接口由DMA读入SRAM（ILI9488_FONT_XIP_STREAM，否则直接从XIP复制），
+    // 不经过XIP缓存，不会把代码挤出XIP缓存；CPU只负责解码
+    // 已缓存的字形移到最近使用端；新加入队列时返回true
+    bool prefetch_glyph(uint32_t unicode_code);
+    
+    // 推进预取，最多读入max_glyphs个字形后返回（限制每次占用的时间），返回读入数
+    uint16_t run_prefetch(uint16_t max_glyphs);
+    
+    // 是否还有排队或正在传输的字形
+    bool is_prefetch_pending() const;
+    
+    // 放弃队列和正在进行的传输
+    void cancel_prefetch();
+    
     // 验证Flash中的字体文件头
     bool verify_font_header() const;
     
@@ -71,6 +283,9 @@ public:
     
     // 调试功能：打印Unicode范围信息
     void print_unicode_ranges() const;
+    
+    // 调试功能：打印字形缓存命中率
+    void print_cache_stats() const;
 };
 
 } // namespace ili9488_font 
\ No newline at end of file
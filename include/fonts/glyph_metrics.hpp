@@ -0,0 +1,115 @@
+#pragma once
+
+#include <cstdint>
+#include <memory>
+#include "hybrid_font_system.hpp"
+
+// 逐字符前进宽度缓存块数量（每块256字节，对应一个BMP页中宽度不统一的字符）
+#ifndef HYBRID_FONT_METRICS_BLOCKS
+#define HYBRID_FONT_METRICS_BLOCKS 8
+#endif
+
+namespace hybrid_font {
+
+/**
+ * @brief 字符宽度度量
+ * 换行和居中每个字符都要查前进宽度，这里把BMP的前进宽度按页（256个码点）
+ * 缓存在SRAM里：整页宽度相同（CJK、全角符号）只记一个值，宽度不同的页
+ * （拉丁、标点）第一次用到时整页读入一个块，块用完后该页直接查字体源。
+ * 字距调整不缓存，字体没有字距表时不查。
+ *
+ * LineWidth用于逐字符累加行宽，换行时每加一个字符只算一次前进宽度和字距，
+ * 不必重新测量整行。
+ */
+class GlyphMetrics {
+public:
+    static constexpr int BLOCK_COUNT = HYBRID_FONT_METRICS_BLOCKS;
+    
+    /**
+     * @brief 累加中的行宽
+     */
+    struct LineWidth {
+        int width = 0;          // 目前的宽度（像素）
+        uint32_t last = 0;      // 最后一个字符（0 = 空行），用于字距调整
+    };
+    
+    /**
+     * @brief 构造函数
+     * @param font_source 字体数据源
+     */
+    explicit GlyphMetrics(std::shared_ptr<IFontDataSource> font_source = nullptr);
+    
+    /**
+     * @brief 设置字体数据源（清空缓存）
+     * @param font_source 字体数据源
+     */
+    void set_font_source(std::shared_ptr<IFontDataSource> font_source);
+    
+    /**
+     * @brief 字符的前进宽度（像素）
+     * @param char_code Unicode字符代码
+     */
+    int advance(uint32_t char_code);
+    
+    /**
+     * @brief 两个字符之间的字距调整（像素）
+     */
+    int kerning(uint32_t left_code, uint32_t right_code) const;
+    
+    /**
+     * @brief 在行尾加一个字符
+     * @param line 当前行宽
+     * @param char_code Unicode字符代码
+     * @return 加上该字符后的行宽
+     */
+    LineWidth append(LineWidth line, uint32_t char_code);
+    
+    /**
+     * @brief 在行尾加一段UTF-8文本
+     * @return 加上该文本后的行宽
+     */
+    LineWidth append(LineWidth line, const char* text);
+    
+    /**
+     * @brief 加上一个字符后的宽度（不修改line）
+     */
+    int width_with(const LineWidth& line, uint32_t char_code) { return append(line, char_code).width; }
+    
+    /**
+     * @brief UTF-8字符串的宽度（前进宽度 + 字距调整）
+     */
+    int string_width(const char* text);
+    
+    /**
+     * @brief 清空宽度缓存（字体内容变化后调用）
+     */
+    void clear();
+    
+    /**
+     * @brief 打印缓存状态
+     */
+    void print_stats() const;
+
+private:
+    // 页状态：0 = 未读取，UNIFORM|宽度 = 整页相同，BLOCK|块号 = 逐字符，UNCACHED = 直接查字体源
+    static constexpr uint16_t PAGE_UNKNOWN = 0x000;
+    static constexpr uint16_t PAGE_UNIFORM = 0x100;
+    static constexpr uint16_t PAGE_BLOCK = 0x200;
+    static constexpr uint16_t PAGE_UNCACHED = 0x300;
+    static constexpr uint16_t PAGE_KIND_MASK = 0x300;
+    
+    /**
+     * @brief 读入一页的前进宽度，返回新的页状态
+     */
+    uint16_t load_page(uint32_t page);
+    
+    int source_advance(uint32_t char_code) const;
+    
+    std::shared_ptr<IFontDataSource> font_source_;
+    bool has_kerning_;
+    uint16_t page_state_[256];
+    uint8_t blocks_[BLOCK_COUNT][256];
+    int used_blocks_;
+};
+
+} // namespace hybrid_font
@@ -1,14 +1,29 @@
 #pragma once
 
 #include "hybrid_font_system.hpp"
+#include "color_glyph_cache.hpp"
+#include "blend_ramp.hpp"
+#include "glyph_metrics.hpp"
 #include <string>
 #include <memory>
+#include <type_traits>
 
 namespace hybrid_font {
 
+template<typename DisplayDriver>
+class TextRunRenderer;
+
+/**
+ * @brief 解码一个UTF-8字符
+ * @param str 字符串指针（会被修改，前进到下一个字符）
+ * @return Unicode字符代码；字符串结束或无效序列时返回0
+ */
+inline uint32_t decode_utf8(const char*& str);
+
 /**
  * @brief 字体渲染器模板类
  * 支持任意显示驱动类型，使用模板实现类型安全
+ * 抗锯齿（2bpp）字形按 (前景, 背景) 色阶混合，色阶每对颜色只计算一次
  */
 template<typename DisplayDriver>
 class FontRenderer {
@@ -31,6 +46,21 @@ public:
      */
     std::shared_ptr<IFontDataSource> get_font_source() const;
     
+    /**
+     * @brief 设置彩色字形缓存（nullptr = 不缓存，每次展开）
+     * @param cache 彩色字形缓存（生命周期需长于渲染器）
+     * @note 显示驱动提供窗口+DMA接口时（ILI9488Driver的setWindow/writeDMA，
+     *       或ILI9488_UI的setAddrWindow/writePixelDataAsync），每个字形只需
+     *       一次窗口设置和一次突发传输；否则逐像素绘制
+     */
+    void set_color_cache(ColorGlyphCache* cache);
+    
+    /**
+     * @brief 设置字符宽度缓存（nullptr = 每次向字体源查询前进宽度）
+     * @param metrics 字符宽度缓存（生命周期需长于渲染器，字体源应与渲染器相同）
+     */
+    void set_metrics(GlyphMetrics* metrics);
+    
     /**
      * @brief 绘制单个字符
      * @param display 显示驱动实例
@@ -41,6 +71,29 @@ public:
      */
     void draw_char(DisplayDriver& display, int x, int y, uint32_t char_code, bool color);
     
+    /**
+     * @brief 用指定颜色绘制单个字符
+     * @param display 显示驱动实例
+     * @param x X坐标
+     * @param y Y坐标
+     * @param char_code Unicode字符代码
+     * @param fg 前景色（RGB565）
+     * @param bg 背景色（RGB565）
+     */
+    void draw_char(DisplayDriver& display, int x, int y, uint32_t char_code, uint16_t fg, uint16_t bg);
+    
+    /**
+     * @brief 用RGB666颜色绘制单个字符
+     * @param display 显示驱动实例
+     * @param x X坐标
+     * @param y Y坐标
+     * @param char_code Unicode字符代码
+     * @param fg 前景色（RGB666，0xRRGGBB，与fillAreaRGB666相同）
+     * @param bg 背景色（RGB666）
+     * @note 逐像素回退路径（drawPixel）只有RGB565精度
+     */
+    void draw_char_rgb666(DisplayDriver& display, int x, int y, uint32_t char_code, uint32_t fg, uint32_t bg);
+    
     /**
      * @brief 绘制字符串
      * @param display 显示驱动实例
@@ -62,7 +115,29 @@ public:
     void draw_string(DisplayDriver& display, int x, int y, const char* text, bool color);
     
     /**
-     * @brief 计算字符串显示宽度
+     * @brief 用指定颜色绘制C风格字符串
+     * @param display 显示驱动实例
+     * @param x X坐标
+     * @param y Y坐标
+     * @param text C风格字符串
+     * @param fg 前景色（RGB565）
+     * @param bg 背景色（RGB565）
+     */
+    void draw_string(DisplayDriver& display, int x, int y, const char* text, uint16_t fg, uint16_t bg);
+    
+    /**
+     * @brief 用RGB666颜色绘制C风格字符串
+     * @param display 显示驱动实例
+     * @param x X坐标
+     * @param y Y坐标
+     * @param text C风格字符串
+     * @param fg 前景色（RGB666，0xRRGGBB）
+     * @param bg 背景色（RGB666）
+     */
+    void draw_string_rgb666(DisplayDriver& display, int x, int y, const char* text, uint32_t fg, uint32_t bg);
+    
+    /**
+     * @brief 计算字符串显示宽度（前进宽度 + 字距调整）
      * @param text 字符串
      * @return 显示宽度（像素）
      */
@@ -84,28 +159,47 @@ private:
     uint32_t decode_utf8_char(const char*& str) const;
     
     /**
-     * @brief 绘制ASCII字符（8x16）
-     * @param display 显示驱动实例
-     * @param x X坐标
-     * @param y Y坐标
-     * @param bitmap 位图数据
-     * @param color 颜色
+     * @brief 字符的前进宽度（有宽度缓存时查缓存）
+     */
+    int advance_of(uint32_t char_code) const;
+    
+    /**
+     * @brief 相邻字符的字距调整（left_code为0时返回0）
      */
-    void draw_ascii_char(DisplayDriver& display, int x, int y, 
-                        const std::vector<uint8_t>& bitmap, bool color);
+    int kerning_of(uint32_t left_code, uint32_t right_code) const;
     
     /**
-     * @brief 绘制Flash字符（16x16）
+     * @brief 逐像素绘制字形（显示驱动不支持窗口传输或字形超出屏幕时使用）
      * @param display 显示驱动实例
      * @param x X坐标
      * @param y Y坐标
-     * @param bitmap 位图数据
-     * @param color 颜色
+     * @param glyph 字形视图
+     * @param ramp 前景/背景色阶
+     */
+    void draw_glyph(DisplayDriver& display, int x, int y, const GlyphView& glyph, const BlendRamp& ramp);
+    
+    /**
+     * @brief 绘制字符（不等待传输结束，字符串内的字形传输与下一个字形的查找重叠）
+     */
+    void draw_char_async(DisplayDriver& display, int x, int y, uint32_t char_code, const BlendRamp& ramp);
+    
+    /**
+     * @brief 以一个窗口+一次突发传输发送线上字节，不支持时返回false
+     */
+    bool blit_wire(DisplayDriver& display, int x, int y, int w, int h, const uint8_t* data);
+    
+    /**
+     * @brief 等待上一个字形的传输结束
      */
-    void draw_flash_char(DisplayDriver& display, int x, int y, 
-                        const std::vector<uint8_t>& bitmap, bool color);
+    void wait_blit(DisplayDriver& display);
     
     std::shared_ptr<IFontDataSource> font_source_;
+    ColorGlyphCache* color_cache_ = nullptr;
+    GlyphMetrics* metrics_ = nullptr;
+    BlendRampCache ramps_;
+    
+    // 无缓存或字形大于缓存槽时的展开缓冲区（最大24x24）
+    uint8_t scratch_[24 * 24 * 3];
 };
 
 /**
@@ -207,6 +301,39 @@ public:
      */
     const HybridFontSource& get_font_source() const;
     
+    /**
+     * @brief 获取整行渲染器（一行文本一个窗口传输）
+     * @return 整行渲染器引用
+     */
+    TextRunRenderer<DisplayDriver>& get_line_renderer();
+    
+    /**
+     * @brief 获取彩色字形缓存（命中率统计）
+     * @return 彩色字形缓存引用
+     */
+    ColorGlyphCache& get_color_cache();
+    
+    /**
+     * @brief 获取字符宽度缓存（换行时逐字符累加行宽）
+     * @return 字符宽度缓存引用
+     */
+    GlyphMetrics& get_metrics();
+    
+    /**
+     * @brief 把文本用到的Flash字形加入后台预取队列（如下一页的内容）
+     * @param text UTF-8文本
+     * @return 新加入队列的字形数（已缓存的字形只移到最近使用端）
+     * @note 取代尚未完成的上一次预取；之后在空闲时反复调用run_prefetch()
+     */
+    int prefetch_text(const std::string& text);
+    
+    /**
+     * @brief 推进后台预取
+     * @param max_glyphs 本次最多读入的字形数（限制占用的CPU时间，不影响绘制）
+     * @return 本次读入的字形数
+     */
+    int run_prefetch(int max_glyphs = 8);
+    
     /**
      * @brief 打印字体系统状态信息
      */
@@ -215,10 +342,14 @@ public:
 private:
     std::shared_ptr<HybridFontSource> font_source_;
     std::unique_ptr<FontRenderer<DisplayDriver>> renderer_;
+    std::unique_ptr<ColorGlyphCache> color_cache_;
+    std::unique_ptr<GlyphMetrics> metrics_;
+    std::unique_ptr<TextRunRenderer<DisplayDriver>> line_renderer_;
     bool initialized_;
 };
 
 } // namespace hybrid_font
 
 // 包含模板实现
-#include "hybrid_font_renderer.inl" 
\ No newline at end of file
+#include "hybrid_font_renderer.inl"
+#include "text_run_renderer.hpp" 
\ No newline at end of file
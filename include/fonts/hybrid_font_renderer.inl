@@ -1,9 +1,87 @@
 #pragma once
 
 #include <cstdio>
+#include <utility>
 
 namespace hybrid_font {
 
+namespace detail {
+
+// ILI9488Driver风格: setWindow(x0, y0, x1, y1) + writeDMA() + waitDMAComplete()
+template<typename D, typename = void>
+struct has_driver_window : std::false_type {};
+
+template<typename D>
+struct has_driver_window<D, std::void_t<
+    decltype(std::declval<D&>().setWindow(0, 0, 0, 0)),
+    decltype(std::declval<D&>().writeDMA(static_cast<const uint8_t*>(nullptr), size_t(0))),
+    decltype(std::declval<D&>().writePixelData(static_cast<const uint8_t*>(nullptr), size_t(0))),
+    decltype(std::declval<D&>().waitDMAComplete()),
+    decltype(std::declval<D&>().getWidth()),
+    decltype(std::declval<D&>().getHeight())>> : std::true_type {};
+
+// ILI9488_UI风格: setAddrWindow(x, y, w, h) + writePixelDataAsync() + waitPixelData()
+template<typename D, typename = void>
+struct has_ui_window : std::false_type {};
+
+template<typename D>
+struct has_ui_window<D, std::void_t<
+    decltype(std::declval<D&>().setAddrWindow(0, 0, 0, 0)),
+    decltype(std::declval<D&>().writePixelDataAsync(static_cast<const uint8_t*>(nullptr), size_t(0))),
+    decltype(std::declval<D&>().waitPixelData()),
+    decltype(std::declval<D&>().width()),
+    decltype(std::declval<D&>().height())>> : std::true_type {};
+
+} // namespace detail
+
+// ============================================================================
+// UTF-8 解码
+// ============================================================================
+
+inline uint32_t decode_utf8(const char*& str) {
+    if (!*str) return 0;
+    
+    const uint8_t* s = reinterpret_cast<const uint8_t*>(str);
+    uint32_t codepoint = 0;
+    
+    if (s[0] < 0x80) {
+        // ASCII字符
+        codepoint = s[0];
+        str += 1;
+    } else if ((s[0] & 0xE0) == 0xC0) {
+        // 2字节UTF-8
+        if (s[1] && (s[1] & 0xC0) == 0x80) {
+            codepoint = ((s[0] & 0x1F) << 6) | (s[1] & 0x3F);
+            str += 2;
+        } else {
+            str += 1;
+        }
+    } else if ((s[0] & 0xF0) == 0xE0) {
+        // 3字节UTF-8
+        if (s[1] && s[2] && (s[1] & 0xC0) == 0x80 && (s[2] & 0xC0) == 0x80) {
+            codepoint = ((s[0] & 0x0F) << 12) | ((s[1] & 0x3F) << 6) | (s[2] & 0x3F);
+            str += 3;
+        } else {
+            str += 1;
+        }
+    } else if ((s[0] & 0xF8) == 0xF0) {
+        // 4字节UTF-8
+        if (s[1] && s[2] && s[3] && 
+            (s[1] & 0xC0) == 0x80 && (s[2] & 0xC0) == 0x80 && (s[3] & 0xC0) == 0x80) {
+            codepoint = ((s[0] & 0x07) << 18) | ((s[1] & 0x3F) << 12) | 
+                       ((s[2] & 0x3F) << 6) | (s[3] & 0x3F);
+            str += 4;
+        } else {
+            str += 1;
+        }
+    } else {
+        // 无效UTF-8序列
+        str += 1;
+    }
+    
+    return codepoint;
+}
+
 // ============================================================================
 // FontRenderer 模板实现
 // ============================================================================
@@ -16,6 +94,11 @@ FontRenderer<DisplayDriver>::FontRenderer(std::shared_ptr<IFontDataSource> font_
 template<typename DisplayDriver>
 void FontRenderer<DisplayDriver>::set_font_source(std::shared_ptr<IFontDataSource> font_source) {
     font_source_ = font_source;
+    
+    // 缓存的字形属于旧的字体源
+    if (color_cache_) {
+        color_cache_->clear();
+    }
 }
 
 template<typename DisplayDriver>
@@ -23,24 +106,117 @@ std::shared_ptr<IFontDataSource> FontRenderer<DisplayDriver>::get_font_source()
     return font_source_;
 }
 
+template<typename DisplayDriver>
+void FontRenderer<DisplayDriver>::set_color_cache(ColorGlyphCache* cache) {
+    color_cache_ = cache;
+}
+
+template<typename DisplayDriver>
+void FontRenderer<DisplayDriver>::set_metrics(GlyphMetrics* metrics) {
+    metrics_ = metrics;
+}
+
+template<typename DisplayDriver>
+int FontRenderer<DisplayDriver>::advance_of(uint32_t char_code) const {
+    return metrics_ ? metrics_->advance(char_code) : font_source_->get_advance(char_code);
+}
+
+template<typename DisplayDriver>
+int FontRenderer<DisplayDriver>::kerning_of(uint32_t left_code, uint32_t right_code) const {
+    if (left_code == 0) {
+        return 0;
+    }
+    return metrics_ ? metrics_->kerning(left_code, right_code) : font_source_->get_kerning(left_code, right_code);
+}
+
 template<typename DisplayDriver>
 void FontRenderer<DisplayDriver>::draw_char(DisplayDriver& display, int x, int y, 
                                            uint32_t char_code, bool color) {
+    // true=白色前景、黑色背景，false=相反
+    draw_char(display, x, y, char_code, 
+              static_cast<uint16_t>(color ? 0xFFFF : 0x0000), 
+              static_cast<uint16_t>(color ? 0x0000 : 0xFFFF));
+}
+
+template<typename DisplayDriver>
+void FontRenderer<DisplayDriver>::draw_char(DisplayDriver& display, int x, int y, 
+                                           uint32_t char_code, uint16_t fg, uint16_t bg) {
+    draw_char_rgb666(display, x, y, char_code, rgb565_to_wire666(fg), rgb565_to_wire666(bg));
+}
+
+template<typename DisplayDriver>
+void FontRenderer<DisplayDriver>::draw_char_rgb666(DisplayDriver& display, int x, int y, 
+                                                  uint32_t char_code, uint32_t fg, uint32_t bg) {
+    draw_char_async(display, x, y, char_code, ramps_.get(fg, bg));
+    wait_blit(display);
+}
+
+template<typename DisplayDriver>
+void FontRenderer<DisplayDriver>::draw_char_async(DisplayDriver& display, int x, int y, 
+                                                 uint32_t char_code, const BlendRamp& ramp) {
     if (!font_source_ || !font_source_->is_valid()) {
         return;
     }
     
-    std::vector<uint8_t> bitmap = font_source_->get_char_bitmap(char_code);
-    if (bitmap.empty()) {
+    // 优先使用已展开的彩色字形：一个窗口 + 一次突发传输
+    if (color_cache_) {
+        ColorGlyph colored = color_cache_->get(*font_source_, char_code, ramp);
+        if (!colored.empty() && blit_wire(display, x, y, colored.width, colored.height, colored.data)) {
+            return;
+        }
+    }
+    
+    // 字形视图直接指向字库/字形缓存，不分配内存
+    GlyphView glyph = font_source_->get_glyph(char_code);
+    if (glyph.empty()) {
         return;
     }
     
-    // 根据字符类型选择不同的绘制方法
-    // ASCII字符使用8x16绘制，其他字符使用16x16绘制
-    if (char_code >= FontConfig::ASCII_START && char_code <= FontConfig::ASCII_END) {
-        draw_ascii_char(display, x, y, bitmap, color);
+    if (static_cast<size_t>(glyph.width) * glyph.height * 3 <= sizeof(scratch_)) {
+        // 上一个字形可能还在从scratch_传输
+        wait_blit(display);
+        ColorGlyphCache::expand(glyph, ramp, scratch_);
+        if (blit_wire(display, x, y, glyph.width, glyph.height, scratch_)) {
+            return;
+        }
+    }
+    
+    draw_glyph(display, x, y, glyph, ramp);
+}
+
+template<typename DisplayDriver>
+bool FontRenderer<DisplayDriver>::blit_wire(DisplayDriver& display, int x, int y, int w, int h, 
+                                           const uint8_t* data) {
+    const size_t length = static_cast<size_t>(w) * h * 3;
+    if constexpr (detail::has_driver_window<DisplayDriver>::value) {
+        if (x < 0 || y < 0 || x + w > display.getWidth() || y + h > display.getHeight()) {
+            return false;
+        }
+        // 上一次DMA结束后才能改窗口
+        display.waitDMAComplete();
+        display.setWindow(x, y, x + w - 1, y + h - 1);
+        if (!display.writeDMA(data, length)) {
+            display.writePixelData(data, length);
+        }
+        return true;
+    } else if constexpr (detail::has_ui_window<DisplayDriver>::value) {
+        if (x < 0 || y < 0 || x + w > display.width() || y + h > display.height()) {
+            return false;
+        }
+        display.setAddrWindow(x, y, w, h);
+        display.writePixelDataAsync(data, length);
+        return true;
     } else {
-        draw_flash_char(display, x, y, bitmap, color);
+        return false;
+    }
+}
+
+template<typename DisplayDriver>
+void FontRenderer<DisplayDriver>::wait_blit(DisplayDriver& display) {
+    if constexpr (detail::has_driver_window<DisplayDriver>::value) {
+        display.waitDMAComplete();
+    } else if constexpr (detail::has_ui_window<DisplayDriver>::value) {
+        display.waitPixelData();
     }
 }
 
@@ -53,11 +229,28 @@ void FontRenderer<DisplayDriver>::draw_string(DisplayDriver& display, int x, int
 template<typename DisplayDriver>
 void FontRenderer<DisplayDriver>::draw_string(DisplayDriver& display, int x, int y, 
                                              const char* text, bool color) {
+    draw_string(display, x, y, text, 
+                static_cast<uint16_t>(color ? 0xFFFF : 0x0000), 
+                static_cast<uint16_t>(color ? 0x0000 : 0xFFFF));
+}
+
+template<typename DisplayDriver>
+void FontRenderer<DisplayDriver>::draw_string(DisplayDriver& display, int x, int y, 
+                                             const char* text, uint16_t fg, uint16_t bg) {
+    draw_string_rgb666(display, x, y, text, rgb565_to_wire666(fg), rgb565_to_wire666(bg));
+}
+
+template<typename DisplayDriver>
+void FontRenderer<DisplayDriver>::draw_string_rgb666(DisplayDriver& display, int x, int y, 
+                                                    const char* text, uint32_t fg, uint32_t bg) {
     if (!font_source_ || !font_source_->is_valid() || !text) {
         return;
     }
     
+    const BlendRamp& ramp = ramps_.get(fg, bg);
+    
     int current_x = x;
+    uint32_t previous = 0;
     const char* str = text;
     
     while (*str) {
@@ -66,15 +259,14 @@ void FontRenderer<DisplayDriver>::draw_string(DisplayDriver& display, int x, int
             break;
         }
         
-        draw_char(display, current_x, y, char_code, color);
+        current_x += kerning_of(previous, char_code);
+        draw_char_async(display, current_x, y, char_code, ramp);
         
-        // 计算字符宽度
-        if (char_code >= FontConfig::ASCII_START && char_code <= FontConfig::ASCII_END) {
-            current_x += FontConfig::ASCII_FONT_WIDTH;
-        } else {
-            current_x += FontConfig::FLASH_FONT_WIDTH;
-        }
+        current_x += advance_of(char_code);
+        previous = char_code;
     }
+    
+    wait_blit(display);
 }
 
 template<typename DisplayDriver>
@@ -88,7 +280,12 @@ int FontRenderer<DisplayDriver>::calculate_string_width(const char* text) const
         return 0;
     }
     
+    if (metrics_) {
+        return metrics_->string_width(text);
+    }
+    
     int width = 0;
+    uint32_t previous = 0;
     const char* str = text;
     
     while (*str) {
@@ -97,11 +294,8 @@ int FontRenderer<DisplayDriver>::calculate_string_width(const char* text) const
             break;
         }
         
-        if (char_code >= FontConfig::ASCII_START && char_code <= FontConfig::ASCII_END) {
-            width += FontConfig::ASCII_FONT_WIDTH;
-        } else {
-            width += FontConfig::FLASH_FONT_WIDTH;
-        }
+        width += kerning_of(previous, char_code) + advance_of(char_code);
+        previous = char_code;
     }
     
     return width;
@@ -109,91 +303,15 @@ int FontRenderer<DisplayDriver>::calculate_string_width(const char* text) const
 
 template<typename DisplayDriver>
 uint32_t FontRenderer<DisplayDriver>::decode_utf8_char(const char*& str) const {
-    if (!*str) return 0;
-    
-    const uint8_t* s = reinterpret_cast<const uint8_t*>(str);
-    uint32_t codepoint = 0;
-    
-    if (s[0] < 0x80) {
-        // ASCII字符
-        codepoint = s[0];
-        str += 1;
-    } else if ((s[0] & 0xE0) == 0xC0) {
-        // 2字节UTF-8
-        if (s[1] && (s[1] & 0xC0) == 0x80) {
-            codepoint = ((s[0] & 0x1F) << 6) | (s[1] & 0x3F);
-            str += 2;
-        } else {
-            str += 1;
-        }
-    } else if ((s[0] & 0xF0) == 0xE0) {
-        // 3字节UTF-8
-        if (s[1] && s[2] && (s[1] & 0xC0) == 0x80 && (s[2] & 0xC0) == 0x80) {
-            codepoint = ((s[0] & 0x0F) << 12) | ((s[1] & 0x3F) << 6) | (s[2] & 0x3F);
-            str += 3;
-        } else {
-            str += 1;
-        }
-    } else if ((s[0] & 0xF8) == 0xF0) {
-        // 4字节UTF-8
-        if (s[1] && s[2] && s[3] && 
-            (s[1] & 0xC0) == 0x80 && (s[2] & 0xC0) == 0x80 && (s[3] & 0xC0) == 0x80) {
-            codepoint = ((s[0] & 0x07) << 18) | ((s[1] & 0x3F) << 12) | 
-                       ((s[2] & 0x3F) << 6) | (s[3] & 0x3F);
-            str += 4;
-        } else {
-            str += 1;
-        }
-    } else {
-        // 无效UTF-8序列
-        str += 1;
-    }
-    
-    return codepoint;
+    return decode_utf8(str);
 }
 
 template<typename DisplayDriver>
-void FontRenderer<DisplayDriver>::draw_ascii_char(DisplayDriver& display, int x, int y, 
-                                                 const std::vector<uint8_t>& bitmap, bool color) {
-    if (bitmap.size() < FontConfig::ASCII_BYTES_PER_CHAR) {
-        return;
-    }
-    
-    // 定义颜色：true=白色，false=黑色
-    uint16_t foreground_color = color ? 0xFFFF : 0x0000;  // 白色或黑色
-    uint16_t background_color = color ? 0x0000 : 0xFFFF;  // 相反色
-    
-    for (int row = 0; row < FontConfig::ASCII_FONT_HEIGHT; row++) {
-        uint8_t line_data = bitmap[row];
-        for (int col = 0; col < FontConfig::ASCII_FONT_WIDTH; col++) {
-            if (line_data & (0x80 >> col)) {
-                display.drawPixel(x + col, y + row, foreground_color);
-            } else {
-                display.drawPixel(x + col, y + row, background_color);
-            }
-        }
-    }
-}
-
-template<typename DisplayDriver>
-void FontRenderer<DisplayDriver>::draw_flash_char(DisplayDriver& display, int x, int y, 
-                                                 const std::vector<uint8_t>& bitmap, bool color) {
-    if (bitmap.size() < FontConfig::FLASH_BYTES_PER_CHAR) {
-        return;
-    }
-    
-    // 定义颜色：true=白色，false=黑色
-    uint16_t foreground_color = color ? 0xFFFF : 0x0000;  // 白色或黑色
-    uint16_t background_color = color ? 0x0000 : 0xFFFF;  // 相反色
-    
-    for (int row = 0; row < FontConfig::FLASH_FONT_HEIGHT; row++) {
-        uint16_t line_data = (bitmap[row * 2] << 8) | bitmap[row * 2 + 1];
-        for (int col = 0; col < FontConfig::FLASH_FONT_WIDTH; col++) {
-            if (line_data & (0x8000 >> col)) {
-                display.drawPixel(x + col, y + row, foreground_color);
-            } else {
-                display.drawPixel(x + col, y + row, background_color);
-            }
+void FontRenderer<DisplayDriver>::draw_glyph(DisplayDriver& display, int x, int y, 
+                                            const GlyphView& glyph, const BlendRamp& ramp) {
+    for (int row = 0; row < glyph.height; row++) {
+        for (int col = 0; col < glyph.width; col++) {
+            display.drawPixel(x + col, y + row, ramp.rgb565[glyph.coverage(col, row)]);
         }
     }
 }
@@ -206,6 +324,12 @@ template<typename DisplayDriver>
 FontManager<DisplayDriver>::FontManager(uint32_t flash_address) : initialized_(false) {
     font_source_ = std::make_shared<HybridFontSource>(flash_address);
     renderer_ = std::make_unique<FontRenderer<DisplayDriver>>(font_source_);
+    color_cache_ = std::make_unique<ColorGlyphCache>();
+    renderer_->set_color_cache(color_cache_.get());
+    metrics_ = std::make_unique<GlyphMetrics>(font_source_);
+    renderer_->set_metrics(metrics_.get());
+    line_renderer_ = std::make_unique<TextRunRenderer<DisplayDriver>>(font_source_);
+    line_renderer_->set_metrics(metrics_.get());
     
     initialized_ = initialize(flash_address);
 }
@@ -220,6 +344,16 @@ bool FontManager<DisplayDriver>::initialize(uint32_t flash_address) {
         renderer_ = std::make_unique<FontRenderer<DisplayDriver>>(font_source_);
     }
     
+    if (!color_cache_) {
+        color_cache_ = std::make_unique<ColorGlyphCache>();
+    }
+    renderer_->set_color_cache(color_cache_.get());
+    
+    if (!metrics_) {
+        metrics_ = std::make_unique<GlyphMetrics>(font_source_);
+    }
+    renderer_->set_metrics(metrics_.get());
+    
     if (!font_source_->initialize(flash_address)) {
         printf("[FontManager] 字体源初始化失败\n");
         initialized_ = false;
@@ -228,6 +362,15 @@ bool FontManager<DisplayDriver>::initialize(uint32_t flash_address) {
     
     renderer_->set_font_source(font_source_);
     
+    // 字体重新加载后宽度表可能不同
+    metrics_->set_font_source(font_source_);
+    
+    if (!line_renderer_) {
+        line_renderer_ = std::make_unique<TextRunRenderer<DisplayDriver>>(font_source_);
+    }
+    line_renderer_->set_font_source(font_source_);
+    line_renderer_->set_metrics(metrics_.get());
+    
     printf("[FontManager] 字体管理器初始化完成\n");
     initialized_ = true;
     return true;
@@ -298,6 +441,53 @@ const HybridFontSource& FontManager<DisplayDriver>::get_font_source() const {
     return *font_source_;
 }
 
+template<typename DisplayDriver>
+TextRunRenderer<DisplayDriver>& FontManager<DisplayDriver>::get_line_renderer() {
+    return *line_renderer_;
+}
+
+template<typename DisplayDriver>
+ColorGlyphCache& FontManager<DisplayDriver>::get_color_cache() {
+    return *color_cache_;
+}
+
+template<typename DisplayDriver>
+GlyphMetrics& FontManager<DisplayDriver>::get_metrics() {
+    return *metrics_;
+}
+
+template<typename DisplayDriver>
+int FontManager<DisplayDriver>::prefetch_text(const std::string& text) {
+    if (!initialized_ || !font_source_) {
+        return 0;
+    }
+    
+    ili9488_font::FlashFontCache& cache = font_source_->get_flash_source().get_cache();
+    cache.cancel_prefetch();
+    
+    // ASCII字符使用内置字库，不需要预取
+    int queued = 0;
+    const char* str = text.c_str();
+    while (*str) {
+        const uint32_t char_code = decode_utf8(str);
+        if (char_code == 0) {
+            break;
+        }
+        if (!font_source_->should_use_ascii_font(char_code) && cache.prefetch_glyph(char_code)) {
+            queued++;
+        }
+    }
+    return queued;
+}
+
+template<typename DisplayDriver>
+int FontManager<DisplayDriver>::run_prefetch(int max_glyphs) {
+    if (!initialized_ || !font_source_ || max_glyphs <= 0) {
+        return 0;
+    }
+    return font_source_->get_flash_source().get_cache().run_prefetch(static_cast<uint16_t>(max_glyphs));
+}
+
 template<typename DisplayDriver>
 void FontManager<DisplayDriver>::print_status() const {
     printf("\n=== 字体管理器状态 ===\n");
@@ -312,6 +502,12 @@ void FontManager<DisplayDriver>::print_status() const {
     }
     
     printf("渲染器: %s\n", renderer_ ? "已创建" : "未创建");
+    if (color_cache_) {
+        color_cache_->print_stats();
+    }
+    if (metrics_) {
+        metrics_->print_stats();
+    }
     printf("=====================\n\n");
 }
 
@@ -25,6 +25,36 @@ struct FontConfig {
     static constexpr uint32_t FLASH_FONT_ADDRESS = 0x10100000;
 };
 
+/**
+ * @brief 字形位图视图（不拥有数据，按值返回，不分配内存）
+ * data指向内置ASCII字库或Flash字形缓存，每行stride字节，高位在左
+ * Flash字形的数据在之后的缓存未命中把它淘汰之前一直有效（至少可再查找
+ * 缓存容量-1个其他字形），绘制时直接使用，不要长期保存
+ */
+struct GlyphView {
+    const uint8_t* data = nullptr;
+    uint8_t width = 0;
+    uint8_t height = 0;
+    uint8_t stride = 0;     // 每行字节数
+    uint8_t bpp = 1;        // 每像素位数：1 = 单色，2 = 4级覆盖度（抗锯齿）
+    
+    bool empty() const { return data == nullptr; }
+    const uint8_t* row(int y) const { return data + y * stride; }
+    size_t size() const { return static_cast<size_t>(height) * stride; }
+    
+    // 像素覆盖度 0..(1<<bpp)-1
+    uint8_t level(int x, int y) const {
+        const int bit = x * bpp;
+        return static_cast<uint8_t>((row(y)[bit >> 3] >> (8 - bpp - (bit & 7))) & ((1 << bpp) - 1));
+    }
+    
+    // 单色绘制时像素是否为前景（2bpp覆盖度过半）
+    bool ink(int x, int y) const { return level(x, y) >= (bpp == 1 ? 1 : 2); }
+    
+    // 统一到0-3的覆盖度（1bpp为0或3），用作BlendRamp下标
+    uint8_t coverage(int x, int y) const { return bpp == 1 ? static_cast<uint8_t>(level(x, y) * 3) : level(x, y); }
+};
+
 /**
  * @brief 字体数据源抽象基类
  * 定义了字体数据源的统一接口
@@ -34,11 +64,19 @@ public:
     virtual ~IFontDataSource() = default;
     
     /**
-     * @brief 获取字符的位图数据
+     * @brief 获取字符的字形视图（不复制、不分配内存）
+     * @param char_code Unicode字符代码
+     * @return 字形视图，如果字符不支持则返回空视图
+     */
+    virtual GlyphView get_glyph(uint32_t char_code) const = 0;
+    
+    /**
+     * @brief 获取字符的位图数据（兼容接口，复制get_glyph()的数据）
      * @param char_code Unicode字符代码
      * @return 位图数据向量，如果字符不支持则返回空向量
+     * @note 每次调用都会分配内存，绘制路径请使用get_glyph()
      */
-    virtual std::vector<uint8_t> get_char_bitmap(uint32_t char_code) const = 0;
+    std::vector<uint8_t> get_char_bitmap(uint32_t char_code) const;
     
     /**
      * @brief 检查是否支持指定字符
@@ -47,6 +85,26 @@ public:
      */
     virtual bool is_char_supported(uint32_t char_code) const = 0;
     
+    /**
+     * @brief 获取字符的前进宽度（绘制下一个字符时笔位置移动的像素数）
+     * @param char_code Unicode字符代码
+     * @return 前进宽度（像素）；默认ASCII为8，其他为16
+     */
+    virtual int get_advance(uint32_t char_code) const;
+    
+    /**
+     * @brief 获取两个相邻字符之间的字距调整
+     * @param left_code 左边的字符
+     * @param right_code 右边的字符
+     * @return 加在右边字符笔位置上的像素数（通常为0或负数）
+     */
+    virtual int get_kerning(uint32_t left_code, uint32_t right_code) const;
+    
+    /**
+     * @brief 字体是否有字距调整数据（没有时不必逐对查询）
+     */
+    virtual bool has_kerning() const;
+    
     /**
      * @brief 获取字体宽度
      * @return 字体宽度（像素）
@@ -88,8 +146,9 @@ public:
     virtual ~ASCIIFontSource() = default;
     
     // IFontDataSource接口实现
-    std::vector<uint8_t> get_char_bitmap(uint32_t char_code) const override;
+    GlyphView get_glyph(uint32_t char_code) const override;
     bool is_char_supported(uint32_t char_code) const override;
+    int get_advance(uint32_t char_code) const override;
     int get_font_width() const override;
     int get_font_height() const override;
     int get_bytes_per_char() const override;
@@ -123,8 +182,11 @@ public:
     virtual ~FlashFontSource() = default;
     
     // IFontDataSource接口实现
-    std::vector<uint8_t> get_char_bitmap(uint32_t char_code) const override;
+    GlyphView get_glyph(uint32_t char_code) const override;
     bool is_char_supported(uint32_t char_code) const override;
+    int get_advance(uint32_t char_code) const override;
+    int get_kerning(uint32_t left_code, uint32_t right_code) const override;
+    bool has_kerning() const override;
     int get_font_width() const override;
     int get_font_height() const override;
     int get_bytes_per_char() const override;
@@ -173,8 +235,11 @@ public:
     virtual ~HybridFontSource() = default;
     
     // IFontDataSource接口实现
-    std::vector<uint8_t> get_char_bitmap(uint32_t char_code) const override;
+    GlyphView get_glyph(uint32_t char_code) const override;
     bool is_char_supported(uint32_t char_code) const override;
+    int get_advance(uint32_t char_code) const override;
+    int get_kerning(uint32_t left_code, uint32_t right_code) const override;
+    bool has_kerning() const override;
     int get_font_width() const override;
     int get_font_height() const override;
     int get_bytes_per_char() const override;
@@ -200,6 +265,12 @@ public:
      */
     const FlashFontSource& get_flash_source() const;
     
+    /**
+     * @brief 获取Flash字体数据源（可修改，用于预取字形）
+     * @return Flash字体数据源引用
+     */
+    FlashFontSource& get_flash_source();
+    
     /**
      * @brief 判断字符应该使用哪个字体源
      * @param char_code Unicode字符代码
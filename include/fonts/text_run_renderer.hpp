@@ -0,0 +1,182 @@
+#pragma once
+
+#include "hybrid_font_renderer.hpp"
+#include "blend_ramp.hpp"
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <string>
+
+namespace hybrid_font {
+
+/**
+ * @brief 整行文本渲染器模板类
+ * 把一整行UTF-8文本（8x16 ASCII与16x16 CJK混排）先光栅化到2bpp覆盖度行条，
+ * 再按每种颜色的色阶查表展开为RGB666线上字节，用一个窗口连续发送
+ * （每2行一次DMA，双缓冲）。一行只设置一次窗口，传输时间接近文本区域本身的线上时间。
+ *
+ * 支持抗锯齿（2bpp）字形、任意RGB666颜色、逐字形前进宽度与字距调整、字间距和
+ * 按字节范围指定的颜色区间（如高亮搜索词）。色阶在颜色设置时计算，绘制时每个像素只查表。
+ * 显示驱动不支持窗口传输时逐像素绘制。
+ */
+template<typename DisplayDriver>
+class TextRunRenderer {
+public:
+    static constexpr int MAX_WIDTH = 480;       // 行条最大宽度（像素）
+    static constexpr int MAX_HEIGHT = 24;       // 行条最大高度（支持24x24字体）
+    static constexpr int MAX_SPANS = 8;         // 颜色区间数量
+    static constexpr int ROWS_PER_CHUNK = 2;    // 每次DMA发送的像素行数
+    static constexpr int MAX_GLYPH_WIDTH = 64;  // 光栅化时单个字形的最大宽度
+    
+    /**
+     * @brief 颜色区间：UTF-8字节范围 [begin, end) 内的字符使用的颜色（RGB666）
+     */
+    struct ColorSpan {
+        size_t begin;
+        size_t end;
+        uint32_t fg;
+        uint32_t bg;
+    };
+    
+    /**
+     * @brief 构造函数
+     * @param font_source 字体数据源
+     */
+    explicit TextRunRenderer(std::shared_ptr<IFontDataSource> font_source = nullptr);
+    
+    /**
+     * @brief 设置字体数据源
+     * @param font_source 字体数据源
+     */
+    void set_font_source(std::shared_ptr<IFontDataSource> font_source);
+    
+    /**
+     * @brief 设置字符宽度缓存（nullptr = 每次向字体源查询前进宽度）
+     * @param metrics 字符宽度缓存（生命周期需长于渲染器，字体源应与渲染器相同）
+     */
+    void set_metrics(GlyphMetrics* metrics);
+    
+    /**
+     * @brief 设置默认颜色（颜色区间之外的字符和行尾空白）
+     * @param fg 前景色（RGB565）
+     * @param bg 背景色（RGB565）
+     */
+    void set_colors(uint16_t fg, uint16_t bg);
+    
+    /**
+     * @brief 设置默认颜色（RGB666，0xRRGGBB，与fillAreaRGB666相同）
+     * @param fg 前景色
+     * @param bg 背景色
+     */
+    void set_colors_rgb666(uint32_t fg, uint32_t bg);
+    
+    /**
+     * @brief 设置字间距（每个字符后额外的像素，可为负，重叠处字形按位或）
+     * @param spacing 字间距（像素）
+     */
+    void set_letter_spacing(int spacing);
+    
+    /**
+     * @brief 添加颜色区间（对之后的draw_line()有效，直到clear_spans()）
+     * @param begin 起始字节偏移
+     * @param end 结束字节偏移（不含）
+     * @param fg 前景色
+     * @param bg 背景色
+     * @return false如果区间已满
+     * @note 区间重叠时后添加的优先
+     */
+    bool add_span(size_t begin, size_t end, uint16_t fg, uint16_t bg);
+    
+    /**
+     * @brief 添加RGB666颜色区间
+     * @return false如果区间已满
+     */
+    bool add_span_rgb666(size_t begin, size_t end, uint32_t fg, uint32_t bg);
+    
+    /**
+     * @brief 清除所有颜色区间
+     */
+    void clear_spans();
+    
+    /**
+     * @brief 绘制一行文本
+     * @param display 显示驱动实例
+     * @param x X坐标
+     * @param y Y坐标
+     * @param text UTF-8文本
+     * @param width 行宽（像素），文本之后用背景色填满；0 = 文本宽度
+     * @return 绘制的宽度（像素）
+     * @note 放不下的字符被截断，不会折行
+     */
+    int draw_line(DisplayDriver& display, int x, int y, const char* text, int width = 0);
+    
+    int draw_line(DisplayDriver& display, int x, int y, const std::string& text, int width = 0);
+    
+    /**
+     * @brief 计算文本宽度（含字间距）
+     * @param text UTF-8文本
+     * @return 宽度（像素）
+     */
+    int measure(const char* text) const;
+    
+    int measure(const std::string& text) const;
+
+private:
+    // 4个1bpp像素 -> 4个2bpp覆盖度（0或3）
+    static constexpr uint8_t SPREAD_BITS[16] = {
+        0x00, 0x03, 0x0C, 0x0F, 0x30, 0x33, 0x3C, 0x3F,
+        0xC0, 0xC3, 0xCC, 0xCF, 0xF0, 0xF3, 0xFC, 0xFF
+    };
+    
+    /**
+     * @brief 字符的前进宽度（含字间距，至少1像素）
+     */
+    int advance_of(uint32_t char_code) const;
+    
+    /**
+     * @brief 相邻字符的字距调整，限制为不让左边字符的前进宽度小于1像素
+     * @param left_advance 左边字符的前进宽度（advance_of()）
+     */
+    int kerning_of(uint32_t left_code, uint32_t right_code, int left_advance) const;
+    
+    /**
+     * @brief 字节偏移处的颜色编号（0 = 默认颜色，i+1 = 第i个区间）
+     */
+    uint8_t color_at(size_t byte_offset) const;
+    
+    /**
+     * @brief 把文本光栅化到cover_/column_color_
+     * @return 文本宽度（像素）
+     */
+    int rasterize(const char* text, int limit, int height);
+    
+    /**
+     * @brief 把行条的若干像素行展开为线上字节
+     */
+    void expand_rows(int first_row, int rows, int width, uint8_t* dst) const;
+    
+    /**
+     * @brief 发送行条：一个窗口，双缓冲分块DMA
+     */
+    void send(DisplayDriver& display, int x, int y, int width, int height);
+    
+    std::shared_ptr<IFontDataSource> font_source_;
+    GlyphMetrics* metrics_ = nullptr;
+    int letter_spacing_ = 0;
+    
+    ColorSpan spans_[MAX_SPANS];
+    int span_count_ = 0;
+    
+    // 颜色编号（0 = 默认颜色，i+1 = 第i个区间） -> 色阶
+    BlendRamp ramps_[MAX_SPANS + 1];
+    
+    uint8_t cover_[MAX_HEIGHT][MAX_WIDTH / 4 + 2];      // 2bpp覆盖度行条，高位在左
+    uint8_t column_color_[MAX_WIDTH];                   // 每列的颜色编号
+    uint8_t row_cover_[MAX_GLYPH_WIDTH / 4];            // 1bpp字形行转换后的覆盖度
+    uint8_t wire_[2][MAX_WIDTH * 3 * ROWS_PER_CHUNK];   // 交替使用的线上字节缓冲区
+};
+
+} // namespace hybrid_font
+
+// 包含模板实现
+#include "text_run_renderer.inl"
@@ -0,0 +1,328 @@
+#pragma once
+
+#include <cstring>
+
+namespace hybrid_font {
+
+namespace detail {
+
+// 显示宽度/高度（不提供时按行条最大尺寸，不裁剪）
+template<typename D>
+int display_width(D& display) {
+    if constexpr (has_driver_window<D>::value) {
+        return display.getWidth();
+    } else if constexpr (has_ui_window<D>::value) {
+        return display.width();
+    } else {
+        return 0x7FFF;
+    }
+}
+
+template<typename D>
+int display_height(D& display) {
+    if constexpr (has_driver_window<D>::value) {
+        return display.getHeight();
+    } else if constexpr (has_ui_window<D>::value) {
+        return display.height();
+    } else {
+        return 0x7FFF;
+    }
+}
+
+} // namespace detail
+
+// ============================================================================
+// TextRunRenderer 模板实现
+// ============================================================================
+
+template<typename DisplayDriver>
+TextRunRenderer<DisplayDriver>::TextRunRenderer(std::shared_ptr<IFontDataSource> font_source) 
+    : font_source_(font_source) {
+    ramps_[0] = BlendRamp::make(0xFCFCFC, 0x000000);
+}
+
+template<typename DisplayDriver>
+void TextRunRenderer<DisplayDriver>::set_font_source(std::shared_ptr<IFontDataSource> font_source) {
+    font_source_ = font_source;
+}
+
+template<typename DisplayDriver>
+void TextRunRenderer<DisplayDriver>::set_metrics(GlyphMetrics* metrics) {
+    metrics_ = metrics;
+}
+
+template<typename DisplayDriver>
+void TextRunRenderer<DisplayDriver>::set_colors(uint16_t fg, uint16_t bg) {
+    set_colors_rgb666(rgb565_to_wire666(fg), rgb565_to_wire666(bg));
+}
+
+template<typename DisplayDriver>
+void TextRunRenderer<DisplayDriver>::set_colors_rgb666(uint32_t fg, uint32_t bg) {
+    ramps_[0] = BlendRamp::make(fg, bg);
+}
+
+template<typename DisplayDriver>
+void TextRunRenderer<DisplayDriver>::set_letter_spacing(int spacing) {
+    letter_spacing_ = spacing;
+}
+
+template<typename DisplayDriver>
+bool TextRunRenderer<DisplayDriver>::add_span(size_t begin, size_t end, uint16_t fg, uint16_t bg) {
+    return add_span_rgb666(begin, end, rgb565_to_wire666(fg), rgb565_to_wire666(bg));
+}
+
+template<typename DisplayDriver>
+bool TextRunRenderer<DisplayDriver>::add_span_rgb666(size_t begin, size_t end, uint32_t fg, uint32_t bg) {
+    if (span_count_ >= MAX_SPANS || begin >= end) {
+        return false;
+    }
+    
+    spans_[span_count_] = ColorSpan{begin, end, fg, bg};
+    ramps_[span_count_ + 1] = BlendRamp::make(fg, bg);
+    span_count_++;
+    return true;
+}
+
+template<typename DisplayDriver>
+void TextRunRenderer<DisplayDriver>::clear_spans() {
+    span_count_ = 0;
+}
+
+template<typename DisplayDriver>
+uint8_t TextRunRenderer<DisplayDriver>::color_at(size_t byte_offset) const {
+    // 后添加的区间优先
+    for (int i = span_count_ - 1; i >= 0; i--) {
+        if (byte_offset >= spans_[i].begin && byte_offset < spans_[i].end) {
+            return static_cast<uint8_t>(i + 1);
+        }
+    }
+    return 0;
+}
+
+template<typename DisplayDriver>
+int TextRunRenderer<DisplayDriver>::advance_of(uint32_t char_code) const {
+    int advance = metrics_ ? metrics_->advance(char_code) : font_source_->get_advance(char_code);
+    
+    // 负字间距最多让字符挨在一起重叠，不会倒退
+    advance += letter_spacing_;
+    return advance > 0 ? advance : 1;
+}
+
+template<typename DisplayDriver>
+int TextRunRenderer<DisplayDriver>::kerning_of(uint32_t left_code, uint32_t right_code, 
+                                              int left_advance) const {
+    if (left_code == 0) {
+        return 0;
+    }
+    
+    const int kerning = metrics_ ? metrics_->kerning(left_code, right_code) 
+                                 : font_source_->get_kerning(left_code, right_code);
+    return (left_advance + kerning) > 0 ? kerning : 1 - left_advance;
+}
+
+template<typename DisplayDriver>
+int TextRunRenderer<DisplayDriver>::measure(const std::string& text) const {
+    return measure(text.c_str());
+}
+
+template<typename DisplayDriver>
+int TextRunRenderer<DisplayDriver>::measure(const char* text) const {
+    if (!font_source_ || !font_source_->is_valid() || !text) {
+        return 0;
+    }
+    
+    int width = 0;
+    int count = 0;
+    uint32_t previous = 0;
+    int previous_advance = 0;
+    const char* str = text;
+    while (*str) {
+        uint32_t char_code = decode_utf8(str);
+        if (char_code == 0) {
+            break;
+        }
+        
+        const int advance = advance_of(char_code);
+        width += kerning_of(previous, char_code, previous_advance) + advance;
+        previous = char_code;
+        previous_advance = advance;
+        count++;
+    }
+    
+    // 最后一个字符后没有字间距
+    if (count > 0) {
+        width -= letter_spacing_;
+    }
+    return width > 0 ? width : 0;
+}
+
+template<typename DisplayDriver>
+int TextRunRenderer<DisplayDriver>::rasterize(const char* text, int limit, int height) {
+    for (int row = 0; row < height; row++) {
+        std::memset(cover_[row], 0, static_cast<size_t>(limit / 4 + 2));
+    }
+    std::memset(column_color_, 0, static_cast<size_t>(limit));
+    
+    int pen = 0;
+    int text_width = 0;
+    uint32_t previous = 0;
+    int previous_advance = 0;
+    uint8_t previous_color = 0;
+    const char* str = text;
+    while (*str) {
+        const size_t byte_offset = static_cast<size_t>(str - text);
+        uint32_t char_code = decode_utf8(str);
+        if (char_code == 0) {
+            break;
+        }
+        
+        const int kerning = kerning_of(previous, char_code, previous_advance);
+        GlyphView glyph = font_source_->get_glyph(char_code);
+        const int glyph_width = glyph.empty() ? 0 : glyph.width;
+        const int advance = advance_of(char_code);
+        const int cell_width = advance - letter_spacing_;
+        if (pen + kerning + (cell_width > glyph_width ? cell_width : glyph_width) > limit) {
+            break;  // 放不下，截断
+        }
+        
+        // 字距调整拉开的间隙属于左边的字符
+        for (int col = pen; col < pen + kerning; col++) {
+            column_color_[col] = previous_color;
+        }
+        pen += kerning;
+        
+        // 字形各行转成2bpp覆盖度（1bpp的每一位扩展为0或3），按字节移位或入行条
+        const int rows = glyph.height < height ? glyph.height : height;
+        const int shift = (pen & 3) << 1;
+        int row_bytes = (glyph_width * 2 + 7) / 8;
+        if (row_bytes > static_cast<int>(sizeof(row_cover_))) {
+            row_bytes = static_cast<int>(sizeof(row_cover_));
+        }
+        for (int row = 0; row < rows && glyph_width > 0; row++) {
+            const uint8_t* src = glyph.row(row);
+            if (glyph.bpp == 1) {
+                for (int b = 0; b < row_bytes; b++) {
+                    const uint8_t bits = src[b >> 1];
+                    row_cover_[b] = SPREAD_BITS[(b & 1) ? (bits & 0x0F) : (bits >> 4)];
+                }
+                src = row_cover_;
+            }
+            uint8_t* dst = cover_[row] + (pen >> 2);
+            for (int b = 0; b < row_bytes; b++) {
+                dst[b] |= src[b] >> shift;
+                if (shift) {
+                    dst[b + 1] |= static_cast<uint8_t>(src[b] << (8 - shift));
+                }
+            }
+        }
+        
+        // 字符本身和其后的字间距使用该字符的颜色
+        const uint8_t color = color_at(byte_offset);
+        const int color_end = (pen + advance) < limit ? (pen + advance) : limit;
+        for (int col = pen; col < color_end; col++) {
+            column_color_[col] = color;
+        }
+        
+        text_width = pen + cell_width;
+        pen += advance;
+        previous = char_code;
+        previous_advance = advance;
+        previous_color = color;
+    }
+    
+    return text_width;
+}
+
+template<typename DisplayDriver>
+void TextRunRenderer<DisplayDriver>::expand_rows(int first_row, int rows, int width, uint8_t* dst) const {
+    for (int row = first_row; row < first_row + rows; row++) {
+        const uint8_t* cover = cover_[row];
+        for (int col = 0; col < width; col++) {
+            const uint8_t* c = ramps_[column_color_[col]].wire[(cover[col >> 2] >> (6 - ((col & 3) << 1))) & 3];
+            dst[0] = c[0];
+            dst[1] = c[1];
+            dst[2] = c[2];
+            dst += 3;
+        }
+    }
+}
+
+template<typename DisplayDriver>
+void TextRunRenderer<DisplayDriver>::send(DisplayDriver& display, int x, int y, int width, int height) {
+    const size_t row_bytes = static_cast<size_t>(width) * 3;
+    
+    if constexpr (detail::has_driver_window<DisplayDriver>::value) {
+        // 一个窗口；第N块的展开与第N-1块的DMA重叠，缓冲区交替使用
+        display.waitDMAComplete();
+        display.setWindow(x, y, x + width - 1, y + height - 1);
+        int chunk = 0;
+        for (int row = 0; row < height; row += ROWS_PER_CHUNK, chunk ^= 1) {
+            const int rows = (height - row) < ROWS_PER_CHUNK ? (height - row) : ROWS_PER_CHUNK;
+            expand_rows(row, rows, width, wire_[chunk]);
+            display.waitDMAComplete();
+            if (!display.writeDMA(wire_[chunk], row_bytes * rows)) {
+                display.writePixelData(wire_[chunk], row_bytes * rows);
+            }
+        }
+        display.waitDMAComplete();
+    } else if constexpr (detail::has_ui_window<DisplayDriver>::value) {
+        display.setAddrWindow(x, y, width, height);
+        int chunk = 0;
+        for (int row = 0; row < height; row += ROWS_PER_CHUNK, chunk ^= 1) {
+            const int rows = (height - row) < ROWS_PER_CHUNK ? (height - row) : ROWS_PER_CHUNK;
+            expand_rows(row, rows, width, wire_[chunk]);
+            display.writePixelDataAsync(wire_[chunk], row_bytes * rows);
+        }
+        display.waitPixelData();
+    } else {
+        for (int row = 0; row < height; row++) {
+            for (int col = 0; col < width; col++) {
+                const int level = (cover_[row][col >> 2] >> (6 - ((col & 3) << 1))) & 3;
+                display.drawPixel(x + col, y + row, ramps_[column_color_[col]].rgb565[level]);
+            }
+        }
+    }
+}
+
+template<typename DisplayDriver>
+int TextRunRenderer<DisplayDriver>::draw_line(DisplayDriver& display, int x, int y, 
+                                              const std::string& text, int width) {
+    return draw_line(display, x, y, text.c_str(), width);
+}
+
+template<typename DisplayDriver>
+int TextRunRenderer<DisplayDriver>::draw_line(DisplayDriver& display, int x, int y, 
+                                              const char* text, int width) {
+    if (!font_source_ || !font_source_->is_valid() || !text) {
+        return 0;
+    }
+    
+    // 行条高度取最高的字形：混合字体中为ASCII 16与Flash字体实际字形高度中的较大者
+    int height = font_source_->get_font_height();
+    if (height > MAX_HEIGHT) {
+        height = MAX_HEIGHT;
+    }
+    
+    // 行条限制在显示区域内（左/上边界之外的部分不支持）
+    if (x < 0 || y < 0 || y + height > detail::display_height(display)) {
+        return 0;
+    }
+    int limit = (width > 0 && width < MAX_WIDTH) ? width : MAX_WIDTH;
+    if (limit > detail::display_width(display) - x) {
+        limit = detail::display_width(display) - x;
+    }
+    if (limit <= 0) {
+        return 0;
+    }
+    
+    const int text_width = rasterize(text, limit, height);
+    const int line_width = (width > 0) ? limit : text_width;
+    if (line_width <= 0) {
+        return 0;
+    }
+    
+    send(display, x, y, line_width, height);
+    return line_width;
+}
+
+} // namespace hybrid_font
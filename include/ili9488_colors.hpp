@@ -182,6 +182,42 @@ constexpr uint16_t rgb666_to_rgb565(uint32_t rgb666) {
     return rgb888_to_rgb565(rgb666_to_rgb888(rgb666));
 }
 
+/**
+ * @brief Convert RGB565 to ILI9488 wire format
+ * @param rgb565 16-bit RGB565 color
+ * @return 0xRRGGBB with the top 6 bits of each byte significant (the layout of
+ *         the rgb666 constants and fillAreaRGB666()); channel bits are replicated
+ *         before truncation, so full scale maps to 0xFC
+ */
+constexpr uint32_t rgb565_to_wire666(uint16_t rgb565) {
+    const uint32_t r5 = (rgb565 >> 11) & 0x1F;
+    const uint32_t g6 = (rgb565 >> 5) & 0x3F;
+    const uint32_t b5 = rgb565 & 0x1F;
+    return ((((r5 << 3) | (r5 >> 2)) & 0xFC) << 16) |
+           ((((g6 << 2) | (g6 >> 4)) & 0xFC) << 8) |
+           (((b5 << 3) | (b5 >> 2)) & 0xFC);
+}
+
+/**
+ * @brief Write an RGB565 color as 3 wire bytes (R, G, B) for the bulk transfer hooks
+ */
+inline void rgb565_to_wire(uint16_t rgb565, uint8_t* out) {
+    const uint32_t wire = rgb565_to_wire666(rgb565);
+    out[0] = static_cast<uint8_t>(wire >> 16);
+    out[1] = static_cast<uint8_t>(wire >> 8);
+    out[2] = static_cast<uint8_t>(wire);
+}
+
+/**
+ * @brief Convert a run of RGB565 pixels to wire bytes (3 per pixel)
+ */
+inline void rgb565_to_wire(const uint16_t* src, uint8_t* dst, int32_t count) {
+    while (count-- > 0) {
+        rgb565_to_wire(*src++, dst);
+        dst += 3;
+    }
+}
+
 /**
  * @brief Create RGB565 color from individual R, G, B components
  * @param r Red component (0-255)
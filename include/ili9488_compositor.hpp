@@ -0,0 +1,140 @@
+/**
+ * @file ili9488_compositor.hpp
+ * @brief Scanline compositor: tile-map background plus sprites, no framebuffer
+ * @note The scene is rebuilt one output line at a time. Each line is composed
+ *       in RGB565 (background tile rows copied as runs, then sprites in slot
+ *       order, colour key honoured), converted to RGB666 wire bytes into one of
+ *       two line buffers and sent with writePixelDataAsync() while the next
+ *       line is composed. The whole region goes out as a single window, every
+ *       pixel is written exactly once per frame, and RAM use is a few KB
+ *       regardless of the scene size.
+ */
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+#include "ili9488_sprite.hpp"
+#include "ili9488_ui.hpp"
+
+#ifndef ILI9488_COMPOSITOR_MAX_SPRITES
+#define ILI9488_COMPOSITOR_MAX_SPRITES 32
+#endif
+
+namespace ili9488 {
+
+/**
+ * @brief Line-buffer renderer for tile-map + sprite scenes
+ *
+ * Usage:
+ * @code
+ *   static ili9488::ScanlineCompositor scene;
+ *   scene.setTileMap(&tiles, level_map, 64, 32);        // 8-bit tile indices
+ *   int hero = scene.addSprite(hero_sprite, 100, 200);
+ *   for (;;) {
+ *       scene.setScroll(camera_x, 0);
+ *       scene.moveSprite(hero, hero_x, hero_y);
+ *       scene.render(gfx);                               // whole screen, one window
+ *   }
+ * @endcode
+ */
+class ScanlineCompositor {
+public:
+    static constexpr int16_t MAX_LINE_WIDTH = 480;
+    static constexpr uint8_t MAX_SPRITES = ILI9488_COMPOSITOR_MAX_SPRITES;
+
+    /**
+     * @brief Per-frame counters
+     */
+    struct Stats {
+        uint32_t lines = 0;             // Lines sent in the last frame
+        uint32_t sprite_spans = 0;      // Sprite row segments composited in the last frame
+        uint32_t last_frame_us = 0;     // Compose + transfer time of the last frame
+    };
+
+    // === Background ===
+
+    /**
+     * @brief Set the background tile map
+     * @param atlas Tile images (must outlive the compositor)
+     * @param map Tile indices, row-major, columns x rows; indices past the
+     *            atlas show the background colour
+     * @return false (and no tile layer) for a null or empty atlas or map
+     * @note The map wraps around in both directions when scrolled.
+     */
+    bool setTileMap(const TileAtlas* atlas, const uint8_t* map, uint16_t columns, uint16_t rows);
+
+    /**
+     * @brief Remove the tile map (the background becomes a solid colour)
+     */
+    void clearTileMap();
+
+    /**
+     * @brief Map pixel shown at the top-left corner of the screen
+     */
+    void setScroll(int32_t x, int32_t y) { scroll_x_ = x; scroll_y_ = y; }
+
+    /**
+     * @brief Colour used without a tile map and for out-of-range tiles (RGB565)
+     */
+    void setBackgroundColor(uint16_t color) { background_ = color; }
+
+    // === Sprites (later slots are drawn on top) ===
+
+    /**
+     * @brief Add a sprite in screen coordinates
+     * @return Sprite handle, or -1 if all MAX_SPRITES slots are in use
+     * @note The Sprite is copied; its pixel data must stay valid while it is in the scene.
+     */
+    int addSprite(const Sprite& sprite, int16_t x, int16_t y);
+
+    void moveSprite(int handle, int16_t x, int16_t y);
+    void setSpriteImage(int handle, const Sprite& sprite);
+    void showSprite(int handle, bool visible);
+    void removeSprite(int handle);
+    void clearSprites();
+
+    // === Output ===
+
+    /**
+     * @brief Compose and send the whole screen
+     */
+    void render(ILI9488_UI& display);
+
+    /**
+     * @brief Compose and send one screen region (clipped to the display)
+     */
+    void render(ILI9488_UI& display, int16_t x, int16_t y, int16_t w, int16_t h);
+
+    const Stats& stats() const { return stats_; }
+
+private:
+    struct SpriteSlot {
+        Sprite sprite;
+        int16_t x = 0;
+        int16_t y = 0;
+        bool used = false;
+        bool visible = false;
+    };
+
+    void composeBackground(uint16_t* line, int16_t x0, int16_t w, int16_t y) const;
+    uint32_t composeSprites(uint16_t* line, int16_t x0, int16_t w, int16_t y,
+                            const uint8_t* active, uint8_t active_count) const;
+
+    const TileAtlas* atlas_ = nullptr;
+    const uint8_t* map_ = nullptr;
+    uint16_t map_columns_ = 0;
+    uint16_t map_rows_ = 0;
+    int32_t scroll_x_ = 0;
+    int32_t scroll_y_ = 0;
+    uint16_t background_ = 0x0000;
+
+    SpriteSlot sprites_[MAX_SPRITES];
+    Stats stats_;
+
+    uint16_t compose_[MAX_LINE_WIDTH];              ///< Line being composed (RGB565)
+    uint8_t lines_[2][MAX_LINE_WIDTH * 3];          ///< Alternating wire-format lines
+};
+
+} // namespace ili9488
@@ -0,0 +1,185 @@
+/**
+ * @file ili9488_console.hpp
+ * @brief Text-mode console: character grid, per-cell damage, hardware scroll
+ * @note Text written to the console only goes into a ring buffer, so logging
+ *       never waits for the panel. flush() drains the buffer into a grid of
+ *       (character, attribute) cells, marking each cell that changes, then
+ *       sends the changed cells of every row as glyph bursts (one address
+ *       window per run, DMA). A newline at the bottom moves the ILI9488
+ *       vertical scroll start (VSCRSADD) by one text row instead of redrawing
+ *       the screen; only the freshly cleared row is sent.
+ */
+
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+
+#include "ili9488_ui.hpp"
+#include "ili9488_font.hpp"
+
+#ifndef ILI9488_CONSOLE_QUEUE_SIZE
+#define ILI9488_CONSOLE_QUEUE_SIZE 4096     // Queued characters (power of two, 2 bytes each)
+#endif
+
+namespace ili9488 {
+
+/**
+ * @brief Scrolling 8x16 text console over font::ILI9488_FONT
+ *
+ * Usage:
+ * @code
+ *   static ili9488::TextConsole console;
+ *   console.begin(gfx, 16);                      // keep a 16-line status bar on top
+ *   console.printf("boot %lu\n", count);         // any time, never touches the panel
+ *   console.setTextColor(12, 0);                 // palette indices: light red on black
+ *   console.write("error\n");
+ *   console.flush();                             // e.g. once per main-loop pass
+ * @endcode
+ *
+ * Hardware scrolling needs a portrait rotation (the panel scrolls along its
+ * 480-line axis); in landscape the console still works but redraws on scroll.
+ * The console owns the full-width band it was given: other drawing inside it
+ * is shifted by the hardware scroll.
+ */
+class TextConsole {
+public:
+    static constexpr int16_t CELL_WIDTH = font::FONT_WIDTH;
+    static constexpr int16_t CELL_HEIGHT = font::FONT_HEIGHT;
+    static constexpr uint16_t MAX_COLUMNS = 480 / CELL_WIDTH;
+    static constexpr uint16_t MAX_ROWS = 480 / CELL_HEIGHT;
+    static constexpr uint32_t QUEUE_SIZE = ILI9488_CONSOLE_QUEUE_SIZE;
+    static constexpr uint8_t PALETTE_SIZE = 16;
+
+    static_assert((QUEUE_SIZE & (QUEUE_SIZE - 1)) == 0, "ILI9488_CONSOLE_QUEUE_SIZE must be a power of two");
+    static_assert(MAX_COLUMNS <= 64, "one 64-bit dirty mask per row");
+
+    /**
+     * @brief Counters; the last_* fields describe the most recent flush()
+     * @note queued and dropped are counted by write(), which may run on the
+     *       other core; stats() returns a snapshot.
+     */
+    struct Stats {
+        uint32_t queued = 0;            // Characters accepted by write()
+        uint32_t dropped = 0;           // Characters lost because the queue was full
+        uint32_t lines = 0;             // Newlines processed
+        uint32_t hardware_scrolls = 0;  // Rows scrolled with the scroll registers
+        uint32_t redraw_scrolls = 0;    // Rows scrolled by redrawing the console
+        uint32_t last_cells = 0;        // Cells drawn by the last flush
+        uint32_t last_bytes = 0;        // Pixel bytes sent by the last flush
+        uint32_t last_flush_us = 0;     // Duration of the last flush
+    };
+
+    /**
+     * @brief Attach to a display and clear the console
+     * @param display Target (must outlive the console)
+     * @param top First screen line of the console band
+     * @param rows Text rows; 0 uses the rest of the screen
+     * @return false if the band does not fit on the display
+     * @note All lines outside the band are left alone (fixed scroll areas).
+     */
+    bool begin(ILI9488_UI& display, int16_t top = 0, uint16_t rows = 0);
+
+    // === Writing (queue only, safe to call from a second core) ===
+
+    /**
+     * @brief Queue text; '\n', '\r', '\t', '\b' and '\f' (clear) are interpreted
+     * @return Characters accepted (the rest was dropped because the queue was full)
+     */
+    size_t write(const char* text, size_t length);
+    size_t write(const char* text);
+    bool write(char c) { return write(&c, 1) == 1; }
+
+    /**
+     * @brief Formatted write (at most 255 characters per call)
+     */
+    int printf(const char* format, ...);
+
+    /**
+     * @brief Colours for text queued from now on (palette indices 0-15)
+     */
+    void setTextColor(uint8_t fg, uint8_t bg) { attr_ = static_cast<uint8_t>((fg & 0x0F) << 4 | (bg & 0x0F)); }
+
+    /**
+     * @brief Queue a clear screen
+     */
+    void clear() { write('\f'); }
+
+    // === Display side ===
+
+    /**
+     * @brief Apply queued text, scroll and draw the damaged cells
+     */
+    void flush();
+
+    /**
+     * @brief True if text is waiting in the queue
+     */
+    bool pending() const { return head_.load(std::memory_order_acquire) != tail_.load(std::memory_order_relaxed); }
+
+    /**
+     * @brief Change a palette entry (RGB565); cells using it are redrawn
+     */
+    void setPalette(uint8_t index, uint16_t color);
+
+    uint16_t columns() const { return columns_; }
+    uint16_t rows() const { return rows_; }
+    bool hardwareScroll() const { return hardware_scroll_; }
+    Stats stats() const;
+    void resetStats();
+
+private:
+    struct Cell {
+        uint8_t ch;
+        uint8_t attr;       ///< fg index << 4 | bg index
+    };
+
+    void putCell(uint16_t column, uint16_t row, uint8_t ch, uint8_t attr);
+    void clearRow(uint16_t row, uint8_t attr);
+    void newline(uint8_t attr);
+    void apply(uint8_t ch, uint8_t attr);
+    uint16_t physicalRow(uint16_t row) const { return static_cast<uint16_t>((scroll_row_ + row) % rows_); }
+    uint8_t tableSlot(uint8_t attr, uint8_t claimed);
+    uint16_t drawRun(uint16_t physical_row, uint16_t column, uint16_t count);
+    void markAllDirty();
+
+    ILI9488_UI* display_ = nullptr;
+    int16_t top_ = 0;
+    uint16_t columns_ = 0;
+    uint16_t rows_ = 0;
+    bool hardware_scroll_ = false;
+
+    // Cursor (screen rows), scroll position (physical row shown first)
+    uint16_t cursor_column_ = 0;
+    uint16_t cursor_row_ = 0;
+    uint16_t scroll_row_ = 0;
+    uint16_t shown_scroll_row_ = 0;
+
+    uint8_t attr_ = 0x70;
+    uint16_t palette_[PALETTE_SIZE];
+    Stats stats_;
+
+    Cell cells_[MAX_ROWS][MAX_COLUMNS];             ///< Indexed by physical row
+    uint64_t dirty_[MAX_ROWS];                      ///< One bit per cell
+
+    // Queue entries: character | attribute << 8
+    uint16_t queue_[QUEUE_SIZE];
+    std::atomic<uint32_t> head_{0};
+    std::atomic<uint32_t> tail_{0};
+
+    // Producer-side counters of Stats, written only by write()
+    std::atomic<uint32_t> queued_{0};
+    std::atomic<uint32_t> dropped_{0};
+
+    // Glyph expansion: 16 nibbles x 4 pixels of wire bytes for a few attributes
+    static constexpr uint8_t TABLE_CACHE = 4;
+    uint8_t tables_[TABLE_CACHE][16][12];
+    int16_t table_attr_[TABLE_CACHE];
+    uint8_t table_next_ = 0;
+
+    uint8_t lines_[2][MAX_COLUMNS * CELL_WIDTH * 3];    ///< Alternating wire-format buffers
+    uint8_t current_ = 0;
+};
+
+} // namespace ili9488
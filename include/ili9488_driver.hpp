@@ -142,6 +142,22 @@ public:
     void writePixelsRGB24(uint16_t x0, uint16_t y0, uint16_t x1, uint16_t y1,
                           const uint32_t* colors, size_t count);
 
+public:
+    // === Raw Window Access ===
+    
+    /**
+     * @brief Open a drawing window (CASET/PASET + RAMWR)
+     * @note Follow with writePixelData(); pixels fill the window row by row.
+     */
+    void setWindow(uint16_t x0, uint16_t y0, uint16_t x1, uint16_t y1);
+    
+    /**
+     * @brief Stream pre-formatted pixel data into the open window
+     * @param data Wire-format pixels (3 bytes per pixel, RGB666 left-aligned)
+     * @param length Number of bytes
+     */
+    void writePixelData(const uint8_t* data, size_t length);
+
 public:
     // === Area Fill Operations ===
     
@@ -211,6 +227,23 @@ public:
      */
     void setPartialArea(uint16_t x0, uint16_t y0, uint16_t x1, uint16_t y1);
     
+    /**
+     * @brief Define the hardware vertical scroll area (VSCRDEF)
+     * @param top_fixed Lines at the top of the screen that do not scroll
+     * @param bottom_fixed Lines at the bottom of the screen that do not scroll
+     * @return false in landscape rotations: the panel scrolls along its 480-line
+     *         axis, which is horizontal there
+     * @note Resets the scroll position (scrollTo(top_fixed)).
+     */
+    bool setScrollMargins(uint16_t top_fixed, uint16_t bottom_fixed);
+    
+    /**
+     * @brief Show line `line` at the top of the scroll area (VSCRSADD)
+     * @note Lines are in the current rotation's coordinates. The scroll area
+     *       wraps around, so content drawn at fixed y positions simply moves.
+     */
+    void scrollTo(uint16_t line);
+    
     /**
      * @brief Write data using DMA (non-blocking)
      * @return true if DMA transfer started successfully
@@ -0,0 +1,392 @@
+/**
+ * @file ili9488_fixed.hpp
+ * @brief Header-only fixed-point math library for the ILI9488 graphics stack
+ * @note The RP2040 has no FPU, so every float/double operation is a soft-float
+ *       library call. This header provides Q16.16 and Q1.15 types, a quarter-wave
+ *       sine table, atan2 and integer square roots so that gauges, arcs and demos
+ *       can run entirely on integer arithmetic. It has no Pico SDK dependencies and
+ *       builds unchanged on the host.
+ */
+
+#pragma once
+
+#include <cstdint>
+
+namespace ili9488 {
+namespace fixed {
+
+// === Binary Angles ===
+
+/**
+ * @brief Binary angle: the full circle is mapped onto 0..65535
+ * @note Wrap-around is free (uint16_t overflow), 0 points along +X and angles
+ *       grow towards +Y, which is clockwise on screen because Y grows downwards.
+ */
+using angle_t = uint16_t;
+
+constexpr angle_t ANGLE_0   = 0x0000;
+constexpr angle_t ANGLE_90  = 0x4000;
+constexpr angle_t ANGLE_180 = 0x8000;
+constexpr angle_t ANGLE_270 = 0xC000;
+
+/**
+ * @brief Convert integer degrees to a binary angle (any sign, any range)
+ */
+constexpr angle_t deg_to_angle(int32_t degrees) {
+    int32_t d = degrees % 360;
+    if (d < 0) d += 360;
+    return static_cast<angle_t>((static_cast<uint32_t>(d) << 16) / 360);
+}
+
+/**
+ * @brief Convert a binary angle back to integer degrees (0..359, rounded)
+ */
+constexpr int32_t angle_to_deg(angle_t angle) {
+    return static_cast<int32_t>(((static_cast<uint32_t>(angle) * 360u) + 0x8000u) >> 16) % 360;
+}
+
+// === Fixed-Point Types ===
+
+/**
+ * @brief Signed Q16.16 fixed-point number (range ±32768, resolution 1/65536)
+ */
+class q16_16 {
+public:
+    static constexpr int FRAC_BITS = 16;
+    static constexpr int32_t ONE = 1 << FRAC_BITS;
+
+    constexpr q16_16() : raw_(0) {}
+
+    static constexpr q16_16 from_raw(int32_t raw) { q16_16 q; q.raw_ = raw; return q; }
+    static constexpr q16_16 from_int(int32_t value) { return from_raw(value * ONE); }
+    static constexpr q16_16 from_float(float value) {
+        return from_raw(static_cast<int32_t>(value * ONE + (value < 0 ? -0.5f : 0.5f)));
+    }
+
+    /**
+     * @brief Exact ratio num/den without going through floating point
+     */
+    static constexpr q16_16 from_ratio(int32_t num, int32_t den) {
+        return from_raw(static_cast<int32_t>((static_cast<int64_t>(num) << FRAC_BITS) / den));
+    }
+
+    constexpr int32_t raw() const { return raw_; }
+    constexpr int32_t to_int() const { return raw_ >> FRAC_BITS; }          // floor
+    constexpr int32_t round() const { return (raw_ + (ONE >> 1)) >> FRAC_BITS; }
+    constexpr float to_float() const { return static_cast<float>(raw_) / ONE; }
+
+    constexpr q16_16 operator-() const { return from_raw(-raw_); }
+    constexpr q16_16 operator+(q16_16 o) const { return from_raw(raw_ + o.raw_); }
+    constexpr q16_16 operator-(q16_16 o) const { return from_raw(raw_ - o.raw_); }
+    constexpr q16_16 operator*(q16_16 o) const {
+        return from_raw(static_cast<int32_t>((static_cast<int64_t>(raw_) * o.raw_) >> FRAC_BITS));
+    }
+    constexpr q16_16 operator/(q16_16 o) const {
+        return from_raw(static_cast<int32_t>((static_cast<int64_t>(raw_) << FRAC_BITS) / o.raw_));
+    }
+    constexpr q16_16 operator*(int32_t k) const { return from_raw(raw_ * k); }
+    constexpr q16_16 operator/(int32_t k) const { return from_raw(raw_ / k); }
+
+    q16_16& operator+=(q16_16 o) { raw_ += o.raw_; return *this; }
+    q16_16& operator-=(q16_16 o) { raw_ -= o.raw_; return *this; }
+    q16_16& operator*=(q16_16 o) { *this = *this * o; return *this; }
+    q16_16& operator/=(q16_16 o) { *this = *this / o; return *this; }
+
+    constexpr bool operator==(q16_16 o) const { return raw_ == o.raw_; }
+    constexpr bool operator!=(q16_16 o) const { return raw_ != o.raw_; }
+    constexpr bool operator<(q16_16 o) const { return raw_ < o.raw_; }
+    constexpr bool operator<=(q16_16 o) const { return raw_ <= o.raw_; }
+    constexpr bool operator>(q16_16 o) const { return raw_ > o.raw_; }
+    constexpr bool operator>=(q16_16 o) const { return raw_ >= o.raw_; }
+
+private:
+    int32_t raw_;
+};
+
+/**
+ * @brief Signed Q1.15 fixed-point number (range [-1, 1), resolution 1/32768)
+ * @note Used for unit vectors and blend factors; products stay in 32 bits.
+ */
+class q1_15 {
+public:
+    static constexpr int FRAC_BITS = 15;
+    static constexpr int32_t ONE = 1 << FRAC_BITS;   // Not representable, used for scaling
+    static constexpr int16_t MAX_RAW = 0x7FFF;
+
+    constexpr q1_15() : raw_(0) {}
+
+    static constexpr q1_15 from_raw(int32_t raw) {
+        q1_15 q;
+        q.raw_ = static_cast<int16_t>(raw > MAX_RAW ? MAX_RAW : (raw < -ONE ? -ONE : raw));
+        return q;
+    }
+    static constexpr q1_15 from_float(float value) {
+        return from_raw(static_cast<int32_t>(value * ONE + (value < 0 ? -0.5f : 0.5f)));
+    }
+
+    constexpr int16_t raw() const { return raw_; }
+    constexpr float to_float() const { return static_cast<float>(raw_) / ONE; }
+    constexpr q16_16 to_q16_16() const { return q16_16::from_raw(static_cast<int32_t>(raw_) << 1); }
+
+    constexpr q1_15 operator-() const { return from_raw(-static_cast<int32_t>(raw_)); }
+    constexpr q1_15 operator+(q1_15 o) const { return from_raw(raw_ + o.raw_); }   // Saturating
+    constexpr q1_15 operator-(q1_15 o) const { return from_raw(raw_ - o.raw_); }   // Saturating
+    constexpr q1_15 operator*(q1_15 o) const {
+        return from_raw((static_cast<int32_t>(raw_) * o.raw_ + (1 << (FRAC_BITS - 1))) >> FRAC_BITS);
+    }
+
+    /**
+     * @brief Scale an integer by this factor (rounded)
+     */
+    constexpr int32_t scale(int32_t value) const {
+        return (value * static_cast<int32_t>(raw_) + (1 << (FRAC_BITS - 1))) >> FRAC_BITS;
+    }
+
+    constexpr bool operator==(q1_15 o) const { return raw_ == o.raw_; }
+    constexpr bool operator!=(q1_15 o) const { return raw_ != o.raw_; }
+    constexpr bool operator<(q1_15 o) const { return raw_ < o.raw_; }
+    constexpr bool operator>(q1_15 o) const { return raw_ > o.raw_; }
+
+private:
+    int16_t raw_;
+};
+
+/**
+ * @brief Multiply two fixed-point values with an arbitrary number of fraction bits
+ * @note Useful for formats other than Q16.16 (e.g. Q5.26 for fractal iteration).
+ */
+template<int FracBits>
+constexpr int32_t mulq(int32_t a, int32_t b) {
+    return static_cast<int32_t>((static_cast<int64_t>(a) * b) >> FracBits);
+}
+
+// === Lookup Tables ===
+
+namespace detail {
+
+// sin(i * 90° / 256) scaled by 32768, i = 0..256
+inline constexpr uint16_t SIN_QUARTER_LUT[257] = {
+        0,   201,   402,   603,   804,  1005,  1206,  1407,
+     1608,  1809,  2009,  2210,  2411,  2611,  2811,  3012,
+     3212,  3412,  3612,  3812,  4011,  4211,  4410,  4609,
+     4808,  5007,  5205,  5404,  5602,  5800,  5998,  6195,
+     6393,  6590,  6787,  6983,  7180,  7376,  7571,  7767,
+     7962,  8157,  8351,  8546,  8740,  8933,  9127,  9319,
+     9512,  9704,  9896, 10088, 10279, 10469, 10660, 10850,
+    11039, 11228, 11417, 11605, 11793, 11980, 12167, 12354,
+    12540, 12725, 12910, 13095, 13279, 13463, 13646, 13828,
+    14010, 14192, 14373, 14553, 14733, 14912, 15091, 15269,
+    15447, 15624, 15800, 15976, 16151, 16326, 16500, 16673,
+    16846, 17018, 17190, 17361, 17531, 17700, 17869, 18037,
+    18205, 18372, 18538, 18703, 18868, 19032, 19195, 19358,
+    19520, 19681, 19841, 20001, 20160, 20318, 20475, 20632,
+    20788, 20943, 21097, 21251, 21403, 21555, 21706, 21856,
+    22006, 22154, 22302, 22449, 22595, 22740, 22884, 23028,
+    23170, 23312, 23453, 23593, 23732, 23870, 24008, 24144,
+    24279, 24414, 24548, 24680, 24812, 24943, 25073, 25202,
+    25330, 25457, 25583, 25708, 25833, 25956, 26078, 26199,
+    26320, 26439, 26557, 26674, 26791, 26906, 27020, 27133,
+    27246, 27357, 27467, 27576, 27684, 27791, 27897, 28002,
+    28106, 28209, 28311, 28411, 28511, 28610, 28707, 28803,
+    28899, 28993, 29086, 29178, 29269, 29359, 29448, 29535,
+    29622, 29707, 29792, 29875, 29957, 30038, 30118, 30196,
+    30274, 30350, 30425, 30499, 30572, 30644, 30715, 30784,
+    30853, 30920, 30986, 31050, 31114, 31177, 31238, 31298,
+    31357, 31415, 31471, 31527, 31581, 31634, 31686, 31737,
+    31786, 31834, 31881, 31927, 31972, 32015, 32058, 32099,
+    32138, 32177, 32214, 32251, 32286, 32319, 32352, 32383,
+    32413, 32442, 32470, 32496, 32522, 32546, 32568, 32590,
+    32610, 32629, 32647, 32664, 32679, 32693, 32706, 32718,
+    32729, 32738, 32746, 32753, 32758, 32762, 32766, 32767,
+    32768
+};
+
+// atan(i / 256) as a binary angle, i = 0..256 (last entry is 45°)
+inline constexpr uint16_t ATAN_LUT[257] = {
+        0,    41,    81,   122,   163,   204,   244,   285,
+      326,   367,   407,   448,   489,   529,   570,   610,
+      651,   692,   732,   773,   813,   854,   894,   935,
+      975,  1015,  1056,  1096,  1136,  1177,  1217,  1257,
+     1297,  1337,  1377,  1417,  1457,  1497,  1537,  1577,
+     1617,  1656,  1696,  1736,  1775,  1815,  1854,  1894,
+     1933,  1973,  2012,  2051,  2090,  2129,  2168,  2207,
+     2246,  2285,  2324,  2363,  2401,  2440,  2478,  2517,
+     2555,  2594,  2632,  2670,  2708,  2746,  2784,  2822,
+     2860,  2897,  2935,  2973,  3010,  3047,  3085,  3122,
+     3159,  3196,  3233,  3270,  3307,  3344,  3380,  3417,
+     3453,  3490,  3526,  3562,  3599,  3635,  3670,  3706,
+     3742,  3778,  3813,  3849,  3884,  3920,  3955,  3990,
+     4025,  4060,  4095,  4129,  4164,  4199,  4233,  4267,
+     4302,  4336,  4370,  4404,  4438,  4471,  4505,  4539,
+     4572,  4605,  4639,  4672,  4705,  4738,  4771,  4803,
+     4836,  4869,  4901,  4933,  4966,  4998,  5030,  5062,
+     5094,  5125,  5157,  5188,  5220,  5251,  5282,  5313,
+     5344,  5375,  5406,  5437,  5467,  5498,  5528,  5559,
+     5589,  5619,  5649,  5679,  5708,  5738,  5768,  5797,
+     5826,  5856,  5885,  5914,  5943,  5972,  6000,  6029,
+     6058,  6086,  6114,  6142,  6171,  6199,  6227,  6254,
+     6282,  6310,  6337,  6365,  6392,  6419,  6446,  6473,
+     6500,  6527,  6554,  6580,  6607,  6633,  6660,  6686,
+     6712,  6738,  6764,  6790,  6815,  6841,  6867,  6892,
+     6917,  6943,  6968,  6993,  7018,  7043,  7068,  7092,
+     7117,  7141,  7166,  7190,  7214,  7238,  7262,  7286,
+     7310,  7334,  7358,  7381,  7405,  7428,  7451,  7475,
+     7498,  7521,  7544,  7566,  7589,  7612,  7635,  7657,
+     7679,  7702,  7724,  7746,  7768,  7790,  7812,  7834,
+     7856,  7877,  7899,  7920,  7942,  7963,  7984,  8005,
+     8026,  8047,  8068,  8089,  8110,  8131,  8151,  8172,
+     8192
+};
+
+} // namespace detail
+
+// === Trigonometry ===
+
+/**
+ * @brief Sine of a binary angle, scaled by 32768 (-32768..32768)
+ * @note Quarter-wave table with 6-bit linear interpolation; max error ~1/32768.
+ */
+constexpr int32_t sin_raw(angle_t angle) {
+    const uint32_t quadrant = angle >> 14;
+    uint32_t a = angle & 0x3FFF;
+    if (quadrant & 1) {
+        a = 0x4000 - a;                     // Mirror: 1..0x4000
+    }
+    const uint32_t index = a >> 6;          // 0..256
+    const uint32_t frac = a & 0x3F;
+    int32_t value = detail::SIN_QUARTER_LUT[index];
+    if (frac) {
+        value += ((static_cast<int32_t>(detail::SIN_QUARTER_LUT[index + 1]) - value) * static_cast<int32_t>(frac)) >> 6;
+    }
+    return (quadrant & 2) ? -value : value;
+}
+
+constexpr int32_t cos_raw(angle_t angle) {
+    return sin_raw(static_cast<angle_t>(angle + ANGLE_90));
+}
+
+/**
+ * @brief Sine as Q16.16 (exactly ±1.0 at the peaks)
+ */
+constexpr q16_16 sin_q16(angle_t angle) { return q16_16::from_raw(sin_raw(angle) << 1); }
+constexpr q16_16 cos_q16(angle_t angle) { return q16_16::from_raw(cos_raw(angle) << 1); }
+
+/**
+ * @brief Sine as Q1.15 (the +1.0 peak saturates to 0x7FFF)
+ */
+constexpr q1_15 sin_q15(angle_t angle) { return q1_15::from_raw(sin_raw(angle)); }
+constexpr q1_15 cos_q15(angle_t angle) { return q1_15::from_raw(cos_raw(angle)); }
+
+/**
+ * @brief Four-quadrant arctangent returning a binary angle
+ * @note Octant reduction plus a 257-entry atan table with linear interpolation;
+ *       max error is well below 0.01°. atan2(0, 0) returns 0.
+ */
+constexpr angle_t atan2(int32_t y, int32_t x) {
+    if (x == 0 && y == 0) {
+        return 0;
+    }
+
+    const uint32_t ax = static_cast<uint32_t>(x < 0 ? -static_cast<int64_t>(x) : x);
+    const uint32_t ay = static_cast<uint32_t>(y < 0 ? -static_cast<int64_t>(y) : y);
+    const bool swap = ay > ax;
+    const uint32_t num = swap ? ax : ay;
+    const uint32_t den = swap ? ay : ax;
+
+    // Ratio in 0..1 with 16 fractional bits: 8 bits index, 8 bits interpolation
+    const uint32_t ratio = static_cast<uint32_t>((static_cast<uint64_t>(num) << 16) / den);
+    const uint32_t index = ratio >> 8;
+    const uint32_t frac = ratio & 0xFF;
+    uint32_t a = detail::ATAN_LUT[index];
+    if (frac) {
+        a += ((detail::ATAN_LUT[index + 1] - a) * frac + 0x80) >> 8;
+    }
+
+    if (swap) a = ANGLE_90 - a;             // First octant -> first quadrant
+    if (x < 0) a = ANGLE_180 - a;           // Mirror into quadrant II
+    if (y < 0) a = 0x10000 - a;             // Mirror into quadrants III/IV
+    return static_cast<angle_t>(a);
+}
+
+// === Square Roots ===
+
+/**
+ * @brief Integer square root, floor(sqrt(value))
+ */
+constexpr uint32_t isqrt(uint32_t value) {
+    uint32_t result = 0;
+    uint32_t bit = 1u << 30;
+    while (bit > value) bit >>= 2;
+    while (bit) {
+        if (value >= result + bit) {
+            value -= result + bit;
+            result = (result >> 1) + bit;
+        } else {
+            result >>= 1;
+        }
+        bit >>= 2;
+    }
+    return result;
+}
+
+/**
+ * @brief 64-bit integer square root, floor(sqrt(value))
+ */
+constexpr uint32_t isqrt64(uint64_t value) {
+    uint64_t result = 0;
+    uint64_t bit = 1ull << 62;
+    while (bit > value) bit >>= 2;
+    while (bit) {
+        if (value >= result + bit) {
+            value -= result + bit;
+            result = (result >> 1) + bit;
+        } else {
+            result >>= 1;
+        }
+        bit >>= 2;
+    }
+    return static_cast<uint32_t>(result);
+}
+
+/**
+ * @brief Square root of a non-negative Q16.16 value
+ */
+constexpr q16_16 sqrt(q16_16 value) {
+    return value.raw() <= 0 ? q16_16() :
+        q16_16::from_raw(static_cast<int32_t>(isqrt64(static_cast<uint64_t>(value.raw()) << q16_16::FRAC_BITS)));
+}
+
+/**
+ * @brief Euclidean length of (dx, dy), rounded down
+ */
+constexpr uint32_t hypot(int32_t dx, int32_t dy) {
+    return isqrt64(static_cast<uint64_t>(static_cast<int64_t>(dx) * dx) +
+                   static_cast<uint64_t>(static_cast<int64_t>(dy) * dy));
+}
+
+// === Geometry Helpers ===
+
+/**
+ * @brief Rounded X/Y offsets of a point at distance @p radius and @p angle
+ */
+struct PolarOffset {
+    int16_t dx;
+    int16_t dy;
+};
+
+constexpr PolarOffset polar(int32_t radius, angle_t angle) {
+    return PolarOffset{
+        static_cast<int16_t>((radius * cos_raw(angle) + (1 << 14)) >> 15),
+        static_cast<int16_t>((radius * sin_raw(angle) + (1 << 14)) >> 15)
+    };
+}
+
+/**
+ * @brief Linear interpolation between two integers, t in Q16.16 (0..1)
+ */
+constexpr int32_t lerp(int32_t a, int32_t b, q16_16 t) {
+    return a + static_cast<int32_t>((static_cast<int64_t>(b - a) * t.raw()) >> q16_16::FRAC_BITS);
+}
+
+} // namespace fixed
+} // namespace ili9488
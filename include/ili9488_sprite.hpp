@@ -0,0 +1,132 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+namespace ili9488 {
+
+/**
+ * @brief Uncompressed RGB565 sprite with optional colour-key transparency
+ *
+ * Pixels are stored row-major. When @ref has_key is set, every pixel equal to
+ * @ref key is transparent and the blitter leaves the background untouched.
+ */
+struct Sprite {
+    int16_t width = 0;
+    int16_t height = 0;
+    const uint16_t* pixels = nullptr;
+    bool has_key = false;
+    uint16_t key = 0;
+
+    constexpr Sprite() = default;
+
+    constexpr Sprite(int16_t w, int16_t h, const uint16_t* data)
+        : width(w), height(h), pixels(data) {}
+
+    constexpr Sprite(int16_t w, int16_t h, const uint16_t* data, uint16_t key_color)
+        : width(w), height(h), pixels(data), has_key(true), key(key_color) {}
+
+    /**
+     * @brief Pointer to the first pixel of a row
+     */
+    constexpr const uint16_t* row(int16_t y) const { return pixels + static_cast<size_t>(y) * width; }
+};
+
+/**
+ * @brief Set of equally sized RGB565 tiles stored back to back
+ *
+ * Tile n occupies tile_width * tile_height pixels (row-major) starting at
+ * pixels + n * tile_width * tile_height, so a tile row is one contiguous run
+ * that can be copied straight into a line buffer.
+ */
+struct TileAtlas {
+    uint8_t tile_width = 0;
+    uint8_t tile_height = 0;
+    uint16_t tile_count = 0;
+    const uint16_t* pixels = nullptr;
+
+    constexpr TileAtlas() = default;
+
+    constexpr TileAtlas(uint8_t tw, uint8_t th, uint16_t count, const uint16_t* data)
+        : tile_width(tw), tile_height(th), tile_count(count), pixels(data) {}
+
+    /**
+     * @brief Pointer to the first pixel of one row of a tile
+     */
+    constexpr const uint16_t* tileRow(uint16_t tile, uint8_t row) const {
+        return pixels + (static_cast<size_t>(tile) * tile_height + row) * tile_width;
+    }
+};
+
+/**
+ * @brief Run-length encoded RGB565 sprite (opaque spans only)
+ *
+ * Stream of uint16_t words, produced by tools/sprite_rle.py:
+ * @code
+ *   [0]            magic (RLE_MAGIC)
+ *   [1]            width
+ *   [2]            height
+ *   [3 .. 3+h)     per-row word offset from the start of the stream, 0 = fully transparent row
+ *   row:           span_count, then span_count x { x, length, pixels[length] }
+ * @endcode
+ * Transparent pixels are simply not stored, so the blitter emits each opaque
+ * span as one window + burst and skips empty rows without touching them.
+ * Offsets are 16-bit, which limits a single sprite to 64K words (128 KB).
+ */
+class RleSprite {
+public:
+    static constexpr uint16_t RLE_MAGIC = 0x5253;   // 'RS'
+    static constexpr size_t HEADER_WORDS = 3;
+
+    /**
+     * @brief One opaque run inside a row
+     */
+    struct Span {
+        int16_t x;                  ///< Start column relative to the sprite origin
+        int16_t length;             ///< Number of pixels
+        const uint16_t* pixels;     ///< RGB565 pixels of the run
+    };
+
+    constexpr RleSprite() : data_(nullptr) {}
+    constexpr explicit RleSprite(const uint16_t* data) : data_(data) {}
+
+    /**
+     * @brief Check the stream header
+     */
+    constexpr bool isValid() const { return data_ != nullptr && data_[0] == RLE_MAGIC; }
+
+    constexpr int16_t width() const { return static_cast<int16_t>(data_[1]); }
+    constexpr int16_t height() const { return static_cast<int16_t>(data_[2]); }
+
+    /**
+     * @brief Number of opaque spans in a row (0 for a fully transparent row)
+     */
+    constexpr uint16_t spanCount(int16_t y) const {
+        const uint16_t offset = data_[HEADER_WORDS + y];
+        return offset ? data_[offset] : 0;
+    }
+
+    /**
+     * @brief Iterate the opaque spans of a row
+     * @param y Row index (0..height-1)
+     * @param fn Callable invoked as fn(const Span&) for each span, left to right
+     */
+    template<typename Fn>
+    void forEachSpan(int16_t y, Fn&& fn) const {
+        const uint16_t offset = data_[HEADER_WORDS + y];
+        if (offset == 0) return;
+
+        const uint16_t* p = data_ + offset;
+        uint16_t count = *p++;
+        while (count--) {
+            Span span{static_cast<int16_t>(p[0]), static_cast<int16_t>(p[1]), p + 2};
+            fn(span);
+            p += 2 + span.length;
+        }
+    }
+
+private:
+    const uint16_t* data_;
+};
+
+} // namespace ili9488
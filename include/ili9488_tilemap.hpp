@@ -0,0 +1,144 @@
+/**
+ * @file ili9488_tilemap.hpp
+ * @brief Tile grid with a dirty-cell bitmap, redrawn in row bursts
+ * @note Every cell holds an 8-bit tile index and one dirty bit. Changing a cell
+ *       only sets its bit; flush() then walks the bitmap row by row, merges
+ *       neighbouring dirty cells of a row into one address window and streams
+ *       their tile rows as RGB666 wire bytes (DMA, two alternating buffers).
+ *       Unchanged cells cost nothing, so grid games and text grids pay only for
+ *       what actually changed in a frame.
+ */
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+#include "ili9488_sprite.hpp"
+#include "ili9488_ui.hpp"
+
+#ifndef ILI9488_TILEMAP_MAX_CELLS
+#define ILI9488_TILEMAP_MAX_CELLS 2400      // 60 x 40 cells of 8x8 covers 480x320
+#endif
+
+namespace ili9488 {
+
+/**
+ * @brief Fixed grid of atlas tiles drawn incrementally
+ *
+ * Usage:
+ * @code
+ *   static const ili9488::TileAtlas tiles(16, 16, 4, tile_pixels);
+ *   static ili9488::TileMap board;
+ *   board.begin(&tiles, 20, 30);                 // 320x480 screen, everything dirty
+ *   board.setTile(5, 7, TILE_SNAKE);             // only marks the cell
+ *   board.flush(gfx);                            // sends the changed cells
+ *   printf("%lu bytes\n", (unsigned long)board.stats().last_bytes);
+ * @endcode
+ */
+class TileMap {
+public:
+    static constexpr uint16_t MAX_CELLS = ILI9488_TILEMAP_MAX_CELLS;
+    static constexpr int16_t MAX_LINE_WIDTH = 480;
+
+    /**
+     * @brief Flush counters; the last_* fields describe the most recent flush()
+     */
+    struct Stats {
+        uint32_t flushes = 0;           // flush() calls that sent something
+        uint32_t cells = 0;             // Cells sent in total
+        uint32_t bytes = 0;             // Pixel bytes sent in total
+        uint32_t last_cells = 0;        // Cells sent by the last flush
+        uint32_t last_bursts = 0;       // Address windows opened by the last flush
+        uint32_t last_bytes = 0;        // Pixel bytes sent by the last flush
+        uint32_t last_flush_us = 0;     // Duration of the last flush
+    };
+
+    /**
+     * @brief Set up the grid
+     * @param atlas Tile images (must outlive the map)
+     * @param columns Cells per row
+     * @param rows Cell rows
+     * @param x Screen position of the top-left cell
+     * @param y Screen position of the top-left cell
+     * @return false if the grid needs more than MAX_CELLS cells or the tiles
+     *         are wider than MAX_LINE_WIDTH
+     * @note All cells are set to tile 0 and marked dirty.
+     */
+    bool begin(const TileAtlas* atlas, uint16_t columns, uint16_t rows, int16_t x = 0, int16_t y = 0);
+
+    // === Cells ===
+
+    /**
+     * @brief Change one cell (marked dirty only if the tile differs)
+     */
+    void setTile(uint16_t column, uint16_t row, uint8_t tile);
+
+    uint8_t tile(uint16_t column, uint16_t row) const;
+
+    /**
+     * @brief Set a block of cells (clipped to the grid)
+     */
+    void fillRect(uint16_t column, uint16_t row, uint16_t w, uint16_t h, uint8_t tile);
+
+    void fill(uint8_t tile) { fillRect(0, 0, columns_, rows_, tile); }
+
+    /**
+     * @brief Colour for tile indices past the atlas (RGB565)
+     */
+    void setBackgroundColor(uint16_t color) { background_ = color; }
+
+    // === Dirty tracking ===
+
+    /**
+     * @brief Force a cell to be redrawn by the next flush()
+     */
+    void invalidate(uint16_t column, uint16_t row);
+
+    /**
+     * @brief Force every cell touching a screen rectangle to be redrawn
+     * @note Use after drawing an overlay (dialog, text) on top of the grid.
+     */
+    void invalidateArea(int16_t x, int16_t y, int16_t w, int16_t h);
+
+    void invalidateAll();
+
+    bool dirty() const { return dirty_count_ != 0; }
+
+    // === Output ===
+
+    /**
+     * @brief Send every dirty cell and clear the bitmap
+     * @return Pixel bytes sent
+     * @note Cells that are not completely on the display are dropped.
+     */
+    uint32_t flush(ILI9488_UI& display);
+
+    uint16_t columns() const { return columns_; }
+    uint16_t rows() const { return rows_; }
+    const Stats& stats() const { return stats_; }
+    void resetStats() { stats_ = Stats(); }
+
+private:
+    bool isDirty(uint32_t cell) const { return dirty_[cell >> 5] & (1u << (cell & 31)); }
+    void markDirty(uint32_t cell);
+    void clearDirty(uint32_t cell);
+    uint32_t nextDirty(uint32_t from, uint32_t end) const;
+    void sendBurst(ILI9488_UI& display, uint16_t row, uint16_t column, uint16_t count);
+
+    const TileAtlas* atlas_ = nullptr;
+    uint16_t columns_ = 0;
+    uint16_t rows_ = 0;
+    int16_t x_ = 0;
+    int16_t y_ = 0;
+    uint16_t background_ = 0x0000;
+    uint32_t dirty_count_ = 0;
+    uint8_t current_ = 0;
+    Stats stats_;
+
+    uint8_t tiles_[MAX_CELLS];
+    uint32_t dirty_[(MAX_CELLS + 31) / 32];         ///< One bit per cell, row-major
+    uint8_t lines_[2][MAX_LINE_WIDTH * 3];          ///< Alternating wire-format buffers
+};
+
+} // namespace ili9488
@@ -44,6 +44,49 @@ public:
      */
     virtual void writePixelRGB24(uint16_t x, uint16_t y, uint32_t color) = 0;
 
+public:
+    // === Bulk Transfer Hooks (override for streaming drivers) ===
+    
+    /**
+     * @brief Open a drawing window; following writePixelData() calls fill it row by row
+     * @note The default implementation keeps a software cursor and plots each pixel
+     *       with writePixelRGB24(). The window must lie inside the display.
+     */
+    virtual void setAddrWindow(int16_t x, int16_t y, int16_t w, int16_t h);
+    
+    /**
+     * @brief Stream pixels into the current window
+     * @param data Wire-format pixels (3 bytes per pixel: R, G, B, RGB666 left-aligned)
+     * @param length Number of bytes (multiple of 3)
+     */
+    virtual void writePixelData(const uint8_t* data, size_t length);
+    
+    /**
+     * @brief Start streaming pixels without waiting for the transfer to finish
+     * @note The buffer must stay untouched until the next writePixelDataAsync(),
+     *       waitPixelData(), setAddrWindow() or writePixelData() call.
+     *       The default implementation is synchronous.
+     */
+    virtual void writePixelDataAsync(const uint8_t* data, size_t length);
+    
+    /**
+     * @brief Wait until the last asynchronous pixel transfer has completed
+     */
+    virtual void waitPixelData();
+    
+    /**
+     * @brief Define a hardware vertical scroll area
+     * @param top_fixed Lines at the top that do not scroll
+     * @param bottom_fixed Lines at the bottom that do not scroll
+     * @return false if the display cannot scroll vertically (the default)
+     */
+    virtual bool setScrollMargins(int16_t top_fixed, int16_t bottom_fixed);
+    
+    /**
+     * @brief Show line y at the top of the scroll area; the area wraps around
+     */
+    virtual void scrollTo(int16_t y);
+
 public:
     // === Basic Drawing Functions ===
     
@@ -132,24 +175,107 @@ public:
      * @brief Draw an RGB888 bitmap
      */
     void drawBitmapRGB24(int16_t x, int16_t y, int16_t w, int16_t h, const uint32_t* bitmap);
+    
+    /**
+     * @brief Bit order of 1bpp bitmaps
+     */
+    enum class BitOrder {
+        MsbFirst,   // Bit 7 is the leftmost pixel (font/glyph data)
+        LsbFirst    // Bit 0 is the leftmost pixel (XBM)
+    };
+    
+    /**
+     * @brief Draw an opaque two-colour 1bpp bitmap
+     * @param bits Row-major bits, each row padded to a whole byte
+     * @note Bytes are expanded to wire pixels through a cached 256-entry
+     *       byte -> 8-pixel table, and the whole bitmap is one window.
+     */
+    void drawBitmap1bpp(int16_t x, int16_t y, int16_t w, int16_t h, const uint8_t* bits,
+                        uint16_t fg, uint16_t bg, BitOrder order = BitOrder::MsbFirst);
+    
+    /**
+     * @brief Draw a transparent 1bpp mask: set bits in fg, clear bits untouched
+     * @note Each run of set bits is sent as one span.
+     */
+    void drawMask1bpp(int16_t x, int16_t y, int16_t w, int16_t h, const uint8_t* bits,
+                      uint16_t fg, BitOrder order = BitOrder::MsbFirst);
+    
+    /**
+     * @brief Draw an XBM image (LSB-first bits), transparent background
+     */
+    void drawXBitmap(int16_t x, int16_t y, const uint8_t* bitmap, int16_t w, int16_t h, uint16_t color);
+
+public:
+    // === Gradients ===
+    
+    /**
+     * @brief Gradient shape for fillGradient()
+     */
+    enum class GradientShape {
+        Horizontal,     // color1 at the left edge, color2 at the right edge
+        Vertical,       // color1 at the top, color2 at the bottom
+        Diagonal,       // color1 at the top-left corner, color2 at the bottom-right
+        Radial          // color1 at the centre, color2 at the corners
+    };
+    
+    /**
+     * @brief Fill a rectangle with a gradient, interpolated in RGB888 and quantised to RGB666
+     * @param color1 Start color (RGB888)
+     * @param color2 End color (RGB888)
+     * @param shape Gradient geometry
+     * @param dither Apply 4x4 ordered (Bayer) dithering before quantising, which hides
+     *        the 64-level banding of long gradients
+     * @note The rectangle is one address window; scanlines are built into two
+     *       alternating line buffers and streamed with writePixelDataAsync(),
+     *       so the next line is computed while the previous one is on the bus.
+     */
+    void fillGradient(int16_t x, int16_t y, int16_t w, int16_t h,
+                      uint32_t color1, uint32_t color2,
+                      GradientShape shape, bool dither = true);
 
 public:
     // === Text Rendering Functions ===
     
     /**
-     * @brief Draw a character
+     * @brief Draw a character from the built-in 8x16 font
+     * @note Adafruit convention: bg == color draws transparently (set pixels only).
      */
     void drawChar(int16_t x, int16_t y, unsigned char c, uint16_t color, uint16_t bg, uint8_t size);
     
     /**
      * @brief Draw a character with separate X and Y scaling
+     * @note Opaque glyphs are sent as one window + burst; transparent glyphs as one
+     *       window per run of set pixels.
      */
     void drawChar(int16_t x, int16_t y, unsigned char c, uint16_t color, uint16_t bg, uint8_t size_x, uint8_t size_y);
     
     /**
-     * @brief Draw a string
+     * @brief Draw a string (8 * size pixels per character, '\n' advances 16 * size)
      */
     void drawString(int16_t x, int16_t y, const char* str, uint16_t color, uint16_t bg, uint8_t size);
+    
+    /**
+     * @brief Glyph effect used by drawStringEffect()
+     */
+    enum class TextEffect {
+        Outline,    // 1-pixel dilation in all eight directions
+        Shadow      // Glyph copy offset by (dx, dy)
+    };
+    
+    /**
+     * @brief Draw 8x16 text with an outline or drop shadow in a single pass
+     * @param effect Effect shape
+     * @param dx Shadow X offset (-8..8, ignored for Outline)
+     * @param dy Shadow Y offset (-8..8, ignored for Outline)
+     * @param color Glyph color (RGB565)
+     * @param effect_color Outline/shadow color (RGB565)
+     * @param bg Background color (RGB565), only used when opaque
+     * @param opaque true: each glyph cell (including its effect margin) is one
+     *        window + burst; false: one burst per run of glyph/effect pixels
+     * @note Effect masks are computed once per (glyph, effect) and cached.
+     */
+    void drawStringEffect(int16_t x, int16_t y, const char* str, TextEffect effect, int8_t dx, int8_t dy,
+                          uint16_t color, uint16_t effect_color, uint16_t bg, bool opaque);
 
 public:
     // === Screen Control Functions ===
@@ -201,6 +327,11 @@ protected:
      */
     void fillCircleHelper(int16_t x0, int16_t y0, int16_t r, uint8_t corners, int16_t delta, uint16_t color);
     
+    /**
+     * @brief Clip a rectangle and fill it through the bulk hooks (one window + burst)
+     */
+    void fillWindow(int16_t x, int16_t y, int16_t w, int16_t h, uint16_t color);
+    
     /**
      * @brief Swap two values
      */
@@ -214,6 +345,10 @@ protected:
     int16_t WIDTH;      ///< Display width as modified by current rotation
     int16_t HEIGHT;     ///< Display height as modified by current rotation
     uint8_t rotation_;  ///< Current rotation (0-3)
+    
+    // Software window used by the default setAddrWindow()/writePixelData()
+    int16_t win_x_ = 0, win_y_ = 0, win_w_ = 0, win_h_ = 0;
+    int16_t win_cx_ = 0, win_cy_ = 0;
 };
 
 // === Inline Implementations ===
@@ -0,0 +1,151 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+#include "image_source.hpp"
+#include "frame_pacer.hpp"
+#include "ili9488_ui.hpp"
+
+#ifndef ILI9488_ANIM_FRAME_BUFFER_SIZE
+#define ILI9488_ANIM_FRAME_BUFFER_SIZE 16384    // Per frame slot; larger frames are streamed
+#endif
+
+#ifndef ILI9488_ANIM_MAX_KEYFRAMES
+#define ILI9488_ANIM_MAX_KEYFRAMES 32
+#endif
+
+namespace ili9488_image {
+
+/**
+ * @brief Player for delta-encoded animations (.anm) stored on SD
+ *
+ * Each frame stores only the rectangles that changed since the previous one,
+ * as RGB666 wire bytes. Layout (little-endian, written by tools/anim_pack.py):
+ * @code
+ *   0   "DANM"
+ *   4   u8  version (1), u8 reserved
+ *   6   u16 header_size     offset of the first frame record
+ *   8   i16 x, y            window origin on screen
+ *   12  u16 width, height
+ *   16  u16 frame_count
+ *   18  u16 fps             tick rate
+ *   20  u16 total_ticks     length of one loop in ticks
+ *   22  u16 keyframe_count
+ *   24  keyframe_count x { u16 frame, u16 tick, u32 offset }
+ *   frame record:  u32 size (whole record), u16 tick, u16 rect_count,
+ *                  rect_count x { u16 x, y, w, h (window-relative), w*h*3 bytes }
+ * @endcode
+ * A keyframe redraws the whole window, so playback can restart from it.
+ * Identical frames are not stored: a frame simply stays up until the tick of
+ * the next record.
+ *
+ * Playback keeps one frame of read-ahead: while the rectangles of frame N go
+ * out with writePixelDataAsync(), frame N+1 is read into the other slot, so
+ * the card is read during DMA and while the frame is held. A FramePacer holds
+ * early frames until their tick; when playback falls more than a tick behind
+ * it drops forward to the latest keyframe already due (if the source can seek),
+ * otherwise it draws without waiting until it has caught up. Frames larger
+ * than a slot are streamed chunk by chunk without read-ahead.
+ *
+ * Usage:
+ * @code
+ *   static ili9488_image::DeltaAnimPlayer anim;     // 2 x 16 KB slots
+ *   auto file = sd.open_file("/ui/spinner.anm", "r");
+ *   ili9488_image::SdFileSource source(*file);
+ *   if (anim.open(source) == ili9488_image::ImageStatus::Ok) {
+ *       anim.play(gfx, 5);
+ *   }
+ * @endcode
+ */
+class DeltaAnimPlayer {
+public:
+    static constexpr size_t FRAME_BUFFER_SIZE = ILI9488_ANIM_FRAME_BUFFER_SIZE;
+    static constexpr uint16_t MAX_KEYFRAMES = ILI9488_ANIM_MAX_KEYFRAMES;
+    static constexpr size_t HEADER_SIZE = 24;
+    static constexpr size_t RECORD_HEADER_SIZE = 8;
+    static constexpr size_t RECT_HEADER_SIZE = 8;
+    
+    static_assert(FRAME_BUFFER_SIZE >= 1536, "ILI9488_ANIM_FRAME_BUFFER_SIZE is too small");
+    
+    /**
+     * @brief Animation header
+     */
+    struct Info {
+        int16_t x = 0;
+        int16_t y = 0;
+        uint16_t width = 0;
+        uint16_t height = 0;
+        uint16_t frame_count = 0;
+        uint16_t fps = 0;
+        uint16_t total_ticks = 0;
+        uint16_t keyframe_count = 0;    // Entries kept (at most MAX_KEYFRAMES)
+        uint16_t header_size = 0;
+    };
+    
+    /**
+     * @brief Playback counters, reset by open()
+     * @note late_frames uses FramePacer::waitForTick()'s threshold: a frame that
+     *       misses its deadline by less than one tick is absorbed by the next
+     *       wait and not counted.
+     */
+    struct Stats {
+        uint32_t frames = 0;            // Frames drawn
+        uint32_t dropped_frames = 0;    // Frames skipped by jumping to a keyframe
+        uint32_t late_frames = 0;       // Frames started a full tick (1 / fps) or more after their deadline
+        uint32_t streamed_frames = 0;   // Frames too large for a slot
+        uint32_t bytes = 0;             // Pixel bytes sent to the panel
+        uint32_t last_frame_us = 0;     // Transfer time of the last frame
+    };
+    
+    /**
+     * @brief Read the header and keyframe table
+     * @note The source must stay valid while playing.
+     */
+    ImageStatus open(ImageSource& source);
+    
+    /**
+     * @brief Play the animation
+     * @param loops Number of passes; repeating needs a seekable source
+     */
+    ImageStatus play(ili9488::ILI9488_UI& display, uint16_t loops = 1);
+    
+    const Info& info() const { return info_; }
+    const Stats& stats() const { return stats_; }
+
+private:
+    struct Keyframe {
+        uint16_t frame;
+        uint16_t tick;
+        uint32_t offset;
+    };
+    
+    /**
+     * @brief A frame record being read into a slot
+     */
+    struct Record {
+        uint32_t size = 0;          ///< Whole record, header included
+        uint32_t filled = 0;        ///< Bytes read so far
+        uint16_t tick = 0;
+        uint16_t rect_count = 0;
+        bool resident = false;      ///< Fits in a slot (false: streamed when drawn)
+    };
+    
+    size_t readFully(uint8_t* dst, size_t length);
+    ImageStatus beginRecord(Record& record, uint8_t* slot);
+    ImageStatus readAhead(Record& record, uint8_t* slot, uint32_t budget);
+    ImageStatus drawResident(ili9488::ILI9488_UI& display, const Record& record, const uint8_t* slot,
+                             Record* next, uint8_t* next_slot);
+    ImageStatus drawStreamed(ili9488::ILI9488_UI& display, const Record& record);
+    bool rectInWindow(uint16_t x, uint16_t y, uint16_t w, uint16_t h) const;
+    const Keyframe* keyframeToDropTo(uint16_t frame, uint32_t tick) const;
+    
+    ImageSource* source_ = nullptr;
+    Info info_;
+    Stats stats_;
+    Keyframe keyframes_[MAX_KEYFRAMES];
+    
+    alignas(4) uint8_t slots_[2][FRAME_BUFFER_SIZE];    ///< Current frame + read-ahead
+};
+
+} // namespace ili9488_image
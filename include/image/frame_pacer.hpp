@@ -0,0 +1,70 @@
+#pragma once
+
+#include <cstdint>
+#include "pico/time.h"
+
+namespace ili9488_image {
+
+/**
+ * @brief Fixed-rate frame clock for the animation players
+ *
+ * Frame times are expressed in ticks (1 / fps seconds) counted from an origin,
+ * so rounding never accumulates: tick n is due at origin + n * 1e6 / fps us.
+ * A rate of 0 disables pacing (every tick is due immediately).
+ */
+class FramePacer {
+public:
+    explicit FramePacer(uint16_t fps = 0) : fps_(fps) {}
+    
+    /**
+     * @brief Make tick 0 due now
+     */
+    void start() { origin_us_ = time_us_64(); }
+    
+    /**
+     * @brief Move the origin so that the given tick is due now (drop the backlog)
+     */
+    void rebase(uint32_t tick) { origin_us_ = time_us_64() - tickOffset(tick); }
+    
+    /**
+     * @brief Move the origin forward, e.g. by one loop length
+     */
+    void advance(uint32_t ticks) { origin_us_ += tickOffset(ticks); }
+    
+    /**
+     * @brief Whole ticks elapsed since the origin
+     */
+    uint32_t currentTick() const {
+        if (fps_ == 0) return UINT32_MAX;
+        const int64_t elapsed = static_cast<int64_t>(time_us_64() - origin_us_);
+        if (elapsed < 0) return 0;          // Origin moved ahead (next loop not started yet)
+        return static_cast<uint32_t>(static_cast<uint64_t>(elapsed) * fps_ / 1000000u);
+    }
+    
+    /**
+     * @brief Hold until a tick is due
+     * @return false if the tick's slot had already passed (no wait happened)
+     */
+    bool waitForTick(uint32_t tick) {
+        if (fps_ == 0) return true;
+        const uint64_t due = origin_us_ + tickOffset(tick);
+        const uint64_t now = time_us_64();
+        if (now < due) {
+            sleep_us(due - now);
+            return true;
+        }
+        return now - due < 1000000u / fps_;
+    }
+    
+    uint16_t fps() const { return fps_; }
+
+private:
+    uint64_t tickOffset(uint32_t tick) const {
+        return fps_ ? static_cast<uint64_t>(tick) * 1000000u / fps_ : 0;
+    }
+    
+    uint16_t fps_;
+    uint64_t origin_us_ = 0;
+};
+
+} // namespace ili9488_image
@@ -0,0 +1,141 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+
+namespace ili9488_image {
+
+/**
+ * @brief Decoder result
+ */
+enum class ImageStatus {
+    Ok,
+    ReadError,      // Source returned fewer bytes than the format requires
+    BadHeader,      // Not a file of the expected format
+    Unsupported,    // Valid file using a feature this decoder does not implement
+    TooLarge        // Image wider than the decoder's line buffers
+};
+
+/**
+ * @brief Get a short name for a decoder result
+ */
+inline const char* statusName(ImageStatus status) {
+    switch (status) {
+        case ImageStatus::Ok:          return "ok";
+        case ImageStatus::ReadError:   return "read error";
+        case ImageStatus::BadHeader:   return "bad header";
+        case ImageStatus::Unsupported: return "unsupported";
+        case ImageStatus::TooLarge:    return "too large";
+    }
+    return "unknown";
+}
+
+/**
+ * @brief Sequential byte source feeding the image decoders
+ *
+ * Decoders pull compressed data in fixed-size chunks, so an image never has to
+ * be resident in RAM. See sd_image_source.hpp for the SD card adapter.
+ */
+class ImageSource {
+public:
+    virtual ~ImageSource() = default;
+    
+    /**
+     * @brief Read up to length bytes
+     * @return Number of bytes read; 0 at end of data or on error
+     */
+    virtual size_t read(uint8_t* dst, size_t length) = 0;
+    
+    /**
+     * @brief Move to an absolute byte offset
+     * @return false if the source cannot seek (the default) or the offset is invalid
+     */
+    virtual bool seek(uint32_t /*offset*/) { return false; }
+};
+
+/**
+ * @brief Image source over a buffer in flash or RAM
+ */
+class MemorySource : public ImageSource {
+public:
+    MemorySource(const uint8_t* data, size_t size) : data_(data), size_(size), pos_(0) {}
+    
+    size_t read(uint8_t* dst, size_t length) override {
+        const size_t n = (size_ - pos_) < length ? (size_ - pos_) : length;
+        std::memcpy(dst, data_ + pos_, n);
+        pos_ += n;
+        return n;
+    }
+    
+    bool seek(uint32_t offset) override {
+        if (offset > size_) return false;
+        pos_ = offset;
+        return true;
+    }
+    
+    /**
+     * @brief Restart from the beginning of the buffer
+     */
+    void rewind() { pos_ = 0; }
+    
+private:
+    const uint8_t* data_;
+    size_t size_;
+    size_t pos_;
+};
+
+/**
+ * @brief Chunked reader used inside the decoders
+ *
+ * Keeps CHUNK bytes of the source buffered and hands them out one at a time.
+ */
+template<size_t CHUNK>
+class ChunkReader {
+public:
+    explicit ChunkReader(ImageSource& source) : source_(source) {}
+    
+    /**
+     * @brief Next byte, or 0 with eof() set once the source is exhausted
+     */
+    inline uint8_t next() {
+        if (pos_ == len_ && !refill()) return 0;
+        return buffer_[pos_++];
+    }
+    
+    /**
+     * @brief Copy the next length bytes; false if the source ran out
+     */
+    bool read(uint8_t* dst, size_t length) {
+        while (length > 0) {
+            if (pos_ == len_ && !refill()) return false;
+            const size_t n = (len_ - pos_) < length ? (len_ - pos_) : length;
+            std::memcpy(dst, buffer_ + pos_, n);
+            pos_ += n;
+            dst += n;
+            length -= n;
+        }
+        return true;
+    }
+    
+    bool eof() const { return eof_; }
+    uint32_t bytesRead() const { return total_; }
+    
+private:
+    bool refill() {
+        len_ = source_.read(buffer_, CHUNK);
+        pos_ = 0;
+        total_ += static_cast<uint32_t>(len_);
+        if (len_ == 0) eof_ = true;
+        return len_ > 0;
+    }
+    
+    ImageSource& source_;
+    uint8_t buffer_[CHUNK];
+    size_t pos_ = 0;
+    size_t len_ = 0;
+    uint32_t total_ = 0;
+    bool eof_ = false;
+};
+
+} // namespace ili9488_image
@@ -0,0 +1,144 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+#include "image_source.hpp"
+#include "ili9488_ui.hpp"
+
+#ifndef ILI9488_JPEG_MAX_WIDTH
+#define ILI9488_JPEG_MAX_WIDTH 480      // Must be a multiple of 16
+#endif
+
+namespace ili9488_image {
+
+/**
+ * @brief Baseline JPEG decoder streaming MCU rows to the panel
+ *
+ * Supports baseline/extended-Huffman 8-bit JPEGs (SOF0/SOF1) with one
+ * interleaved scan: greyscale, or YCbCr with 4:4:4, 4:2:2 or 4:2:0 sampling,
+ * including restart markers. Progressive and arithmetic-coded files are
+ * rejected with ImageStatus::Unsupported.
+ *
+ * - Huffman codes up to 8 bits are resolved with one table lookup
+ * - Full-size blocks use the integer AAN IDCT (dequantisation folded into
+ *   the AAN scale factors); 1/2, 1/4 and 1/8 scaling is done in the DCT
+ *   domain with a reduced 4x4 / 2x2 / DC-only inverse transform
+ * - Each MCU row is decoded into planar Y/Cb/Cr strips, then colour
+ *   converted line by line into RGB666 wire bytes and sent as one window,
+ *   lines alternating between two buffers so DMA overlaps conversion
+ *
+ * All working memory lives in the object (no heap): about 30 bytes per
+ * pixel of ILI9488_JPEG_MAX_WIDTH plus 8.5 KB of tables, ~23 KB for 480 and
+ * ~18 KB for 320. Keep the decoder static rather than on the stack.
+ */
+class JpegDecoder {
+public:
+    static constexpr uint16_t MAX_WIDTH = ILI9488_JPEG_MAX_WIDTH;
+    static constexpr size_t CHUNK_SIZE = 512;
+    
+    static_assert(MAX_WIDTH % 16 == 0, "ILI9488_JPEG_MAX_WIDTH must be a multiple of 16");
+    
+    /**
+     * @brief DCT-domain output scaling
+     */
+    enum class Scale : uint8_t {
+        Full = 0,
+        Half = 1,
+        Quarter = 2,
+        Eighth = 3
+    };
+    
+    /**
+     * @brief Frame header of the last decoded image
+     */
+    struct Info {
+        uint16_t width = 0;         // Source size
+        uint16_t height = 0;
+        uint8_t components = 0;     // 1 = greyscale, 3 = YCbCr
+        uint16_t out_width = 0;     // Size on screen after scaling
+        uint16_t out_height = 0;
+    };
+    
+    /**
+     * @brief Decode an image and draw it with its top-left corner at (x, y)
+     * @param scale Output scale; the image is drawn at ceil(size / 2^scale)
+     * @note Parts outside the display are clipped; decoding stops after the last
+     *       visible MCU row.
+     */
+    ImageStatus decode(ImageSource& source, ili9488::ILI9488_UI& display, int16_t x, int16_t y,
+                       Scale scale = Scale::Full);
+    
+    /**
+     * @brief Header of the last decoded image
+     */
+    const Info& info() const { return info_; }
+    
+private:
+    struct HuffTable {
+        uint16_t lookup[256];   ///< 8-bit lookahead: (length << 8) | symbol, 0 = longer code
+        int32_t maxcode[18];    ///< Largest code of each length, -1 if none
+        int32_t valoffset[17];  ///< values[] index = code + valoffset[length]
+        uint8_t values[256];
+        bool defined;
+    };
+    
+    struct Component {
+        uint8_t id;
+        uint8_t h, v;           ///< Sampling factors
+        uint8_t tq;             ///< Quantisation table
+        uint8_t td, ta;         ///< DC / AC Huffman tables
+        int16_t dc_pred;
+        uint32_t plane_offset;  ///< Start of this component's strip in planes_
+        uint16_t plane_stride;
+    };
+    
+    // Marker segments
+    ImageStatus readMarkers();
+    bool readDQT();
+    bool readDHT();
+    ImageStatus readSOF();
+    ImageStatus readSOS();
+    bool skipSegment();
+    uint16_t readU16();
+    
+    // Entropy decoding
+    void buildHuffTable(HuffTable& table, const uint8_t* counts);
+    inline uint8_t readScanByte();
+    inline void fillBits();
+    inline int32_t getBits(uint8_t count);
+    inline uint8_t decodeHuffman(const HuffTable& table);
+    bool decodeBlock(Component& comp, int16_t* block);
+    void processRestart();
+    
+    // Reconstruction
+    void prepareDequant(Scale scale);
+    void idctFull(const int16_t* block, const int32_t* dequant, uint8_t* out, uint16_t stride);
+    void idctReduced(const int16_t* block, const int32_t* dequant, uint8_t* out, uint16_t stride, uint8_t size);
+    void emitRows(ili9488::ILI9488_UI& display, int16_t x, int16_t y, int32_t out_row0, int32_t rows);
+    
+    ChunkReader<CHUNK_SIZE>* in_ = nullptr;
+    Info info_;
+    
+    uint16_t quant_[4][64];         ///< Natural order
+    bool quant_defined_[4];
+    HuffTable dc_tables_[4];        ///< Slots 2 and 3 only occur in SOF1 (extended) files
+    HuffTable ac_tables_[4];
+    Component comps_[3];
+    uint8_t num_comps_ = 0;
+    uint8_t hmax_ = 1, vmax_ = 1;
+    uint16_t restart_interval_ = 0;
+    
+    uint32_t bitbuf_ = 0;
+    int8_t bitcnt_ = 0;
+    uint8_t marker_ = 0;            ///< Marker hit inside entropy-coded data
+    uint16_t restarts_left_ = 0;
+    uint8_t next_restart_ = 0;
+    
+    uint8_t block_size_ = 8;        ///< Output pixels per block side (8 >> scale)
+    int32_t dequant_[3][64];
+    uint8_t planes_[MAX_WIDTH * 24];        ///< One MCU row of Y/Cb/Cr samples
+    uint8_t lines_[2][MAX_WIDTH * 3];       ///< Alternating scanlines in wire format
+};
+
+} // namespace ili9488_image
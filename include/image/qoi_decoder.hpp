@@ -0,0 +1,74 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+#include "image_source.hpp"
+#include "ili9488_ui.hpp"
+
+namespace ili9488_image {
+
+/**
+ * @brief Streaming QOI ("Quite OK Image") decoder
+ *
+ * Compressed bytes are pulled from an ImageSource in CHUNK_SIZE pieces and
+ * decoded straight into a scanline of panel wire bytes (RGB666), which is sent
+ * through the display's bulk hooks while the next line decodes into the other
+ * buffer. Memory use is O(width): two line buffers, the 64-entry colour index
+ * and the read chunk, about 3.5 KB in total. Alpha is ignored.
+ *
+ * Usage:
+ * @code
+ *   static ili9488_image::QoiDecoder qoi;   // keep off the stack
+ *   auto file = sd.open_file("/images/logo.qoi", "r");
+ *   ili9488_image::SdFileSource source(*file);
+ *   qoi.decode(source, gfx, 0, 0);
+ * @endcode
+ */
+class QoiDecoder {
+public:
+    static constexpr uint16_t MAX_WIDTH = 480;
+    static constexpr size_t CHUNK_SIZE = 512;
+    
+    /**
+     * @brief Image header
+     */
+    struct Info {
+        uint32_t width = 0;
+        uint32_t height = 0;
+        uint8_t channels = 0;       // 3 = RGB, 4 = RGBA
+        uint8_t colorspace = 0;     // 0 = sRGB, 1 = linear
+    };
+    
+    /**
+     * @brief Decode an image and draw it with its top-left corner at (x, y)
+     * @note Parts outside the display are clipped; decoding stops after the last
+     *       visible row.
+     */
+    ImageStatus decode(ImageSource& source, ili9488::ILI9488_UI& display, int16_t x, int16_t y);
+    
+    /**
+     * @brief Header of the last decoded image
+     */
+    const Info& info() const { return info_; }
+    
+    /**
+     * @brief Compressed bytes consumed by the last decode
+     */
+    uint32_t bytesRead() const { return bytes_read_; }
+    
+    /**
+     * @brief Pixels decoded by the last decode (including clipped ones)
+     */
+    uint32_t pixelsDecoded() const { return pixels_decoded_; }
+    
+private:
+    Info info_;
+    uint32_t bytes_read_ = 0;
+    uint32_t pixels_decoded_ = 0;
+    
+    uint32_t index_[64];                    ///< Previously seen colours, 0xAARRGGBB
+    uint8_t lines_[2][MAX_WIDTH * 3];       ///< Alternating scanlines in wire format
+};
+
+} // namespace ili9488_image
@@ -0,0 +1,121 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+#include "image_source.hpp"
+#include "ili9488_ui.hpp"
+
+#ifndef ILI9488_RAW666_BUFFER_SIZE
+#define ILI9488_RAW666_BUFFER_SIZE 3072     // Per ping-pong buffer, multiple of 1536
+#endif
+
+namespace ili9488_image {
+
+/**
+ * @brief Player for pre-rendered RGB666 wire-format images and animations
+ *
+ * The .r666 container stores the exact bytes the panel expects after RAMWR,
+ * so frames go from the card to the display without any per-pixel work:
+ * @code
+ *   0   "R666"          magic
+ *   4   u8  version     1
+ *   5   u8  reserved
+ *   6   u16 header_size frame data offset (tools/raw666_pack.py writes 512)
+ *   8   i16 x, y        window origin on screen
+ *   12  u16 width, height
+ *   16  u16 frame_count
+ *   18  u16 fps         playback rate, 0 = as fast as the buses allow
+ *   20  u32 frame_stride bytes per frame (width * height * 3, padded to 512)
+ *   24  reserved up to header_size
+ * @endcode
+ * All fields are little-endian. Sector-aligned frames let FatFs read whole
+ * clusters straight into the player's buffers without its sector cache.
+ *
+ * Each frame is one window: chunks are read into one buffer while the other
+ * is sent with writePixelDataAsync(), so SD reads and display DMA overlap and
+ * a full-screen frame takes about as long as the slower of the two buses.
+ *
+ * Usage:
+ * @code
+ *   static ili9488_image::Raw666Player player;     // 6 KB of buffers
+ *   auto file = sd.open_file("/ui/boot.r666", "r");
+ *   ili9488_image::SdFileSource source(*file);
+ *   if (player.open(source) == ili9488_image::ImageStatus::Ok) {
+ *       player.play(gfx);                           // paced at the file's fps
+ *   }
+ * @endcode
+ */
+class Raw666Player {
+public:
+    static constexpr size_t BUFFER_SIZE = ILI9488_RAW666_BUFFER_SIZE;
+    static constexpr size_t HEADER_SIZE = 24;
+    
+    // Whole pixels for the software window fallback, whole sectors for FatFs
+    static_assert(BUFFER_SIZE % 1536 == 0, "ILI9488_RAW666_BUFFER_SIZE must be a multiple of 1536");
+    
+    /**
+     * @brief Container header
+     */
+    struct Info {
+        int16_t x = 0;
+        int16_t y = 0;
+        uint16_t width = 0;
+        uint16_t height = 0;
+        uint16_t frame_count = 0;
+        uint16_t fps = 0;
+        uint16_t header_size = 0;
+        uint32_t frame_stride = 0;
+    };
+    
+    /**
+     * @brief Playback counters, reset by open()
+     */
+    struct Stats {
+        uint32_t frames = 0;            // Frames drawn
+        uint32_t late_frames = 0;       // Frames that missed their pacing deadline
+        uint32_t bytes = 0;             // Pixel bytes sent to the panel
+        uint32_t last_frame_us = 0;     // Read + transfer time of the last frame
+    };
+    
+    /**
+     * @brief Read and validate the container header
+     * @note The source must stay valid while frames are drawn.
+     */
+    ImageStatus open(ImageSource& source);
+    
+    /**
+     * @brief Draw the frame following the last one drawn (frame 0 after open())
+     */
+    ImageStatus drawNext(ili9488::ILI9488_UI& display);
+    
+    /**
+     * @brief Draw a given frame; needs a seekable source unless it is the next one
+     */
+    ImageStatus drawFrame(ili9488::ILI9488_UI& display, uint16_t index);
+    
+    /**
+     * @brief Play every frame, holding each one to keep the frame rate
+     * @param loops Number of passes over the animation
+     * @param fps Frame rate override, 0 = use the header's rate
+     * @note Repeating needs a seekable source. A frame that overruns its slot
+     *       is counted in Stats::late_frames and the schedule restarts from it.
+     */
+    ImageStatus play(ili9488::ILI9488_UI& display, uint16_t loops = 1, uint16_t fps = 0);
+    
+    const Info& info() const { return info_; }
+    const Stats& stats() const { return stats_; }
+
+private:
+    size_t readFully(uint8_t* dst, size_t length);
+    ImageStatus streamFrame(ili9488::ILI9488_UI& display);
+    
+    ImageSource* source_ = nullptr;
+    Info info_;
+    Stats stats_;
+    uint16_t next_frame_ = 0;
+    
+    alignas(4) uint8_t buffers_[2][BUFFER_SIZE];    ///< Ping-pong: one filling from SD, one on DMA
+};
+
+} // namespace ili9488_image
@@ -0,0 +1,30 @@
+#pragma once
+
+#include "image_source.hpp"
+#include "rw_sd.hpp"
+
+namespace ili9488_image {
+
+/**
+ * @brief Image source reading from an open file on the SD card
+ *
+ * Reads go straight into the decoder's chunk buffer (no per-read allocation).
+ */
+class SdFileSource : public ImageSource {
+public:
+    explicit SdFileSource(MicroSD::RWSD::FileHandle& file) : file_(file) {}
+    
+    size_t read(uint8_t* dst, size_t length) override {
+        auto result = file_.read(dst, length);
+        return result.is_ok() ? *result : 0;
+    }
+    
+    bool seek(uint32_t offset) override {
+        return file_.seek(offset).is_ok();
+    }
+    
+private:
+    MicroSD::RWSD::FileHandle& file_;
+};
+
+} // namespace ili9488_image
@@ -202,6 +202,7 @@ public:
         
         // 读取操作
         Result<std::vector<uint8_t>> read(size_t size);
+        Result<size_t> read(uint8_t* buffer, size_t size);    // 读入调用者缓冲区，无堆分配
         Result<size_t> read_text(std::string& text, size_t max_size);
         
         // 写入操作
@@ -1,6 +1,9 @@
 #pragma once
 
 #include "ili9488_ui.hpp"
+#include "ili9488_fixed.hpp"
+#include "ili9488_sprite.hpp"
+#include "ili9488_affine.hpp"
 
 namespace pico_ili9488_gfx {
 
@@ -46,6 +49,36 @@ public:
      * @param color RGB888 color value
      */
     void writePixelRGB24(uint16_t x, uint16_t y, uint32_t color) override;
+    
+    /**
+     * @brief Open a hardware drawing window (CASET/PASET/RAMWR)
+     */
+    void setAddrWindow(int16_t x, int16_t y, int16_t w, int16_t h) override;
+    
+    /**
+     * @brief Stream wire-format pixels straight to the panel
+     */
+    void writePixelData(const uint8_t* data, size_t length) override;
+    
+    /**
+     * @brief Stream pixels with DMA; returns as soon as the transfer has started
+     */
+    void writePixelDataAsync(const uint8_t* data, size_t length) override;
+    
+    /**
+     * @brief Wait for the DMA transfer started by writePixelDataAsync()
+     */
+    void waitPixelData() override;
+    
+    /**
+     * @brief Hardware vertical scroll area (portrait rotations only)
+     */
+    bool setScrollMargins(int16_t top_fixed, int16_t bottom_fixed) override;
+    
+    /**
+     * @brief Move the hardware scroll position
+     */
+    void scrollTo(int16_t y) override;
 
 public:
     // === Enhanced Drawing Functions ===
@@ -55,13 +88,49 @@ public:
      */
     void drawBitmapFast(int16_t x, int16_t y, int16_t w, int16_t h, const uint16_t* bitmap);
     
+    /**
+     * @brief Draw a sprite, honouring its colour key
+     * @note Runs of opaque pixels are sent as one window + burst each; key-coloured
+     *       pixels are skipped, so the background shows through.
+     */
+    void drawSprite(int16_t x, int16_t y, const ili9488::Sprite& sprite);
+    
+    /**
+     * @brief Draw a run-length encoded sprite
+     * @note Each stored span is one window + burst; fully transparent rows cost nothing.
+     */
+    void drawSprite(int16_t x, int16_t y, const ili9488::RleSprite& sprite);
+    
+    /**
+     * @brief Draw a rotated/scaled sprite into a destination rectangle
+     * @param src Source sprite (colour key honoured)
+     * @param matrix Source -> destination transform
+     * @param dst_x Left edge of the area to scan
+     * @param dst_y Top edge of the area to scan
+     * @param dst_w Width of the area to scan
+     * @param dst_h Height of the area to scan
+     * @param sampling Nearest or bilinear filtering
+     * @note Inverse-mapped with Q16.16 stepping per scanline; each visible run is
+     *       sent as one row burst. Pixels of the rectangle that map outside the
+     *       source are left untouched.
+     */
+    void drawBitmapTransformed(const ili9488::Sprite& src, const ili9488::AffineMatrix& matrix,
+                               int16_t dst_x, int16_t dst_y, int16_t dst_w, int16_t dst_h,
+                               ili9488::Sampling sampling = ili9488::Sampling::Nearest);
+    
+    /**
+     * @brief Draw a rotated/scaled sprite, scanning its transformed bounding box
+     */
+    void drawBitmapTransformed(const ili9488::Sprite& src, const ili9488::AffineMatrix& matrix,
+                               ili9488::Sampling sampling = ili9488::Sampling::Nearest);
+    
     /**
      * @brief Fast RGB888 bitmap drawing
      */
     void drawBitmapRGB24Fast(int16_t x, int16_t y, int16_t w, int16_t h, const uint32_t* bitmap);
     
     /**
-     * @brief Draw a gradient rectangle
+     * @brief Draw a gradient rectangle (dithered, see fillGradient())
      */
     void drawGradient(int16_t x, int16_t y, int16_t w, int16_t h, 
                       uint32_t color1, uint32_t color2, bool horizontal = true);
@@ -97,10 +166,37 @@ public:
     
     /**
      * @brief Draw a gauge/meter
+     * @note Converts to Q16.16 once and forwards to the fixed-point overload;
+     *       value is clamped to the scale and scales beyond +-32768 are shrunk
+     *       to fit Q16.16 first.
      */
     void drawGauge(int16_t x, int16_t y, int16_t radius, 
                    float value, float min_val, float max_val,
                    uint16_t color, uint16_t bg_color);
+    
+    /**
+     * @brief Draw a gauge/meter using fixed-point values (no soft-float)
+     */
+    void drawGauge(int16_t x, int16_t y, int16_t radius, 
+                   ili9488::fixed::q16_16 value, ili9488::fixed::q16_16 min_val,
+                   ili9488::fixed::q16_16 max_val,
+                   uint16_t color, uint16_t bg_color);
+    
+    /**
+     * @brief Draw a circular arc outline
+     * @param start Start angle (binary angle, 0 = +X, clockwise on screen)
+     * @param end End angle; equal to start draws the full circle
+     */
+    void drawArc(int16_t x0, int16_t y0, int16_t r,
+                 ili9488::fixed::angle_t start, ili9488::fixed::angle_t end, uint16_t color);
+    
+    /**
+     * @brief Fill a ring segment between two radii
+     * @param r_inner Inner radius (0 draws a pie slice)
+     * @param r_outer Outer radius
+     */
+    void fillArc(int16_t x0, int16_t y0, int16_t r_inner, int16_t r_outer,
+                 ili9488::fixed::angle_t start, ili9488::fixed::angle_t end, uint16_t color);
 
 public:
     // === Text Enhancement ===
@@ -112,11 +208,24 @@ public:
                               uint16_t color, uint16_t shadow_color, 
                               int16_t shadow_offset_x = 1, int16_t shadow_offset_y = 1);
     
+    /**
+     * @brief Draw text with a drop shadow on a solid background (one burst per glyph)
+     */
+    void drawStringWithShadow(int16_t x, int16_t y, const char* str, 
+                              uint16_t color, uint16_t shadow_color, 
+                              int16_t shadow_offset_x, int16_t shadow_offset_y, uint16_t bg);
+    
     /**
      * @brief Draw outlined text
      */
     void drawStringOutlined(int16_t x, int16_t y, const char* str,
                             uint16_t color, uint16_t outline_color);
+    
+    /**
+     * @brief Draw outlined text on a solid background (one burst per glyph)
+     */
+    void drawStringOutlined(int16_t x, int16_t y, const char* str,
+                            uint16_t color, uint16_t outline_color, uint16_t bg);
 
 public:
     // === Performance Optimized Functions ===
@@ -161,6 +270,13 @@ public:
     bool supportsPartialRefresh() const;
 
 private:
+    /**
+     * @brief Write one horizontal run of RGB565 pixels, clipped to the screen
+     */
+    void writeSpan(int16_t x, int16_t y, int16_t len, const uint16_t* pixels);
+    
+    static constexpr int16_t MAX_LINE_WIDTH = 480;
+    
     Driver& driver_; ///< Reference to the underlying display driver
 };
 
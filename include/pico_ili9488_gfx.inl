@@ -1,7 +1,7 @@
 // Template implementation file for PicoILI9488GFX
 // This file should be included at the end of pico_ili9488_gfx.hpp
 
-#include <cmath>
+#include "ili9488_fixed.hpp"
 
 namespace pico_ili9488_gfx {
 
@@ -28,10 +28,177 @@ void PicoILI9488GFX<Driver>::writePixelRGB24(uint16_t x, uint16_t y, uint32_t co
     driver_.drawPixelRGB24(x, y, color);
 }
 
+template<typename Driver>
+void PicoILI9488GFX<Driver>::setAddrWindow(int16_t x, int16_t y, int16_t w, int16_t h) {
+    driver_.waitDMAComplete();
+    driver_.setWindow(x, y, x + w - 1, y + h - 1);
+}
+
+template<typename Driver>
+void PicoILI9488GFX<Driver>::writePixelData(const uint8_t* data, size_t length) {
+    driver_.waitDMAComplete();
+    driver_.writePixelData(data, length);
+}
+
+template<typename Driver>
+void PicoILI9488GFX<Driver>::writePixelDataAsync(const uint8_t* data, size_t length) {
+    driver_.waitDMAComplete();
+    if (!driver_.writeDMA(data, length)) {
+        // No DMA channel available: fall back to a blocking transfer
+        driver_.writePixelData(data, length);
+    }
+}
+
+template<typename Driver>
+void PicoILI9488GFX<Driver>::waitPixelData() {
+    driver_.waitDMAComplete();
+}
+
+template<typename Driver>
+bool PicoILI9488GFX<Driver>::setScrollMargins(int16_t top_fixed, int16_t bottom_fixed) {
+    if (top_fixed < 0 || bottom_fixed < 0) return false;
+    driver_.waitDMAComplete();
+    return driver_.setScrollMargins(top_fixed, bottom_fixed);
+}
+
+template<typename Driver>
+void PicoILI9488GFX<Driver>::scrollTo(int16_t y) {
+    if (y < 0) return;
+    driver_.waitDMAComplete();
+    driver_.scrollTo(y);
+}
+
+template<typename Driver>
+void PicoILI9488GFX<Driver>::writeSpan(int16_t x, int16_t y, int16_t len, const uint16_t* pixels) {
+    if (y < 0 || y >= HEIGHT || len <= 0) return;
+    if (x < 0) {
+        pixels -= x;
+        len += x;
+        x = 0;
+    }
+    if (x + len > WIDTH) len = WIDTH - x;
+    if (len <= 0) return;
+    
+    driver_.writePixels(x, y, x + len - 1, y, pixels, len);
+}
+
 template<typename Driver>
 void PicoILI9488GFX<Driver>::drawBitmapFast(int16_t x, int16_t y, int16_t w, int16_t h, const uint16_t* bitmap) {
-    // Simple fallback to standard bitmap drawing
-    ili9488::ILI9488_UI::drawBitmap(x, y, w, h, bitmap);
+    if (!bitmap || w <= 0 || h <= 0) return;
+    
+    // Fully visible: the whole bitmap is one window and one burst
+    if (x >= 0 && y >= 0 && x + w <= WIDTH && y + h <= HEIGHT) {
+        driver_.writePixels(x, y, x + w - 1, y + h - 1, bitmap, static_cast<size_t>(w) * h);
+        return;
+    }
+    
+    // Partially visible: one burst per clipped row
+    for (int16_t row = 0; row < h; ++row) {
+        writeSpan(x, y + row, w, bitmap + static_cast<size_t>(row) * w);
+    }
+}
+
+template<typename Driver>
+void PicoILI9488GFX<Driver>::drawSprite(int16_t x, int16_t y, const ili9488::Sprite& sprite) {
+    if (!sprite.pixels) return;
+    
+    if (!sprite.has_key) {
+        drawBitmapFast(x, y, sprite.width, sprite.height, sprite.pixels);
+        return;
+    }
+    
+    for (int16_t row = 0; row < sprite.height; ++row) {
+        const int16_t py = y + row;
+        if (py < 0) continue;
+        if (py >= HEIGHT) break;
+        
+        // Split the row into runs of non-key pixels
+        const uint16_t* line = sprite.row(row);
+        int16_t col = 0;
+        while (col < sprite.width) {
+            while (col < sprite.width && line[col] == sprite.key) ++col;
+            const int16_t start = col;
+            while (col < sprite.width && line[col] != sprite.key) ++col;
+            if (col > start) {
+                writeSpan(x + start, py, col - start, line + start);
+            }
+        }
+    }
+}
+
+template<typename Driver>
+void PicoILI9488GFX<Driver>::drawSprite(int16_t x, int16_t y, const ili9488::RleSprite& sprite) {
+    if (!sprite.isValid()) return;
+    
+    const int16_t h = sprite.height();
+    for (int16_t row = 0; row < h; ++row) {
+        const int16_t py = y + row;
+        if (py < 0) continue;
+        if (py >= HEIGHT) break;
+        
+        sprite.forEachSpan(row, [&](const ili9488::RleSprite::Span& span) {
+            writeSpan(x + span.x, py, span.length, span.pixels);
+        });
+    }
+}
+
+template<typename Driver>
+void PicoILI9488GFX<Driver>::drawBitmapTransformed(const ili9488::Sprite& src, const ili9488::AffineMatrix& matrix,
+                                                   int16_t dst_x, int16_t dst_y, int16_t dst_w, int16_t dst_h,
+                                                   ili9488::Sampling sampling) {
+    if (!src.pixels) return;
+    
+    ili9488::AffineMatrix inverse;
+    if (!matrix.inverse(inverse)) return;
+    
+    // Clip the scan area to the screen
+    if (dst_x < 0) { dst_w += dst_x; dst_x = 0; }
+    if (dst_y < 0) { dst_h += dst_y; dst_y = 0; }
+    if (dst_x + dst_w > WIDTH) dst_w = WIDTH - dst_x;
+    if (dst_y + dst_h > HEIGHT) dst_h = HEIGHT - dst_y;
+    if (dst_w <= 0 || dst_h <= 0) return;
+    
+    const ili9488::AffineSampler sampler(src, inverse, sampling);
+    
+    // The scan area is clipped to the screen, so a row always fits the line buffer.
+    // One static buffer instead of 960 bytes in every instance; draw from one core only.
+    static uint16_t line[MAX_LINE_WIDTH];
+    if (dst_w > MAX_LINE_WIDTH) dst_w = MAX_LINE_WIDTH;
+    
+    for (int16_t row = 0; row < dst_h; ++row) {
+        const int16_t py = dst_y + row;
+        int16_t first, end;
+        int32_t u, v;
+        if (!sampler.clipRow(dst_x, py, dst_w, first, end, u, v)) continue;
+        
+        // Sample the whole visible run, then send it as one burst
+        const int16_t n = end - first;
+        sampler.sample(u, v, n, line);
+        
+        if (!src.has_key) {
+            writeSpan(dst_x + first, py, n, line);
+            continue;
+        }
+        
+        // Split the row into opaque runs
+        int16_t i = 0;
+        while (i < n) {
+            while (i < n && line[i] == src.key) ++i;
+            const int16_t start = i;
+            while (i < n && line[i] != src.key) ++i;
+            if (i > start) {
+                writeSpan(dst_x + first + start, py, i - start, line + start);
+            }
+        }
+    }
+}
+
+template<typename Driver>
+void PicoILI9488GFX<Driver>::drawBitmapTransformed(const ili9488::Sprite& src, const ili9488::AffineMatrix& matrix,
+                                                   ili9488::Sampling sampling) {
+    int16_t x0, y0, x1, y1;
+    matrix.bounds(src.width, src.height, x0, y0, x1, y1);
+    drawBitmapTransformed(src, matrix, x0, y0, x1 - x0, y1 - y0, sampling);
 }
 
 template<typename Driver>
@@ -42,14 +209,20 @@ void PicoILI9488GFX<Driver>::drawBitmapRGB24Fast(int16_t x, int16_t y, int16_t w
 
 template<typename Driver>
 void PicoILI9488GFX<Driver>::clearScreenFast(uint16_t color) {
-    // Use base class method
-    ili9488::ILI9488_UI::fillScreen(color);
+    // One window, one continuous burst
+    fillRectFast(0, 0, WIDTH, HEIGHT, color);
 }
 
 template<typename Driver>
 void PicoILI9488GFX<Driver>::fillRectFast(int16_t x, int16_t y, int16_t w, int16_t h, uint16_t color) {
-    // Use base class method
-    ili9488::ILI9488_UI::fillRect(x, y, w, h, color);
+    // Clip to the visible area, then hand the whole rectangle to the driver as one window
+    if (x < 0) { w += x; x = 0; }
+    if (y < 0) { h += y; y = 0; }
+    if (x + w > WIDTH) w = WIDTH - x;
+    if (y + h > HEIGHT) h = HEIGHT - y;
+    if (w <= 0 || h <= 0) return;
+    
+    driver_.fillArea(x, y, x + w - 1, y + h - 1, color);
 }
 
 template<typename Driver>
@@ -66,13 +239,8 @@ bool PicoILI9488GFX<Driver>::supportsPartialRefresh() const {
 
 template<typename Driver>
 void PicoILI9488GFX<Driver>::writePixelsBulk(int16_t x, int16_t y, int16_t w, int16_t h, const uint16_t* colors) {
-    // Simple pixel-by-pixel drawing fallback
-    const uint16_t* color_ptr = colors;
-    for (int16_t row = 0; row < h; ++row) {
-        for (int16_t col = 0; col < w; ++col) {
-            writePixel(x + col, y + row, *color_ptr++);
-        }
-    }
+    // Same transfer path as bitmaps: one burst for the window, or per clipped row
+    drawBitmapFast(x, y, w, h, colors);
 }
 
 template<typename Driver>
@@ -114,30 +282,22 @@ void PicoILI9488GFX<Driver>::drawPixelAlpha(int16_t x, int16_t y, uint16_t color
 template<typename Driver>
 void PicoILI9488GFX<Driver>::drawProgressBar(int16_t x, int16_t y, int16_t w, int16_t h, 
                                               uint8_t progress, uint16_t fg_color, uint16_t bg_color) {
-    // Draw background
-    ili9488::ILI9488_UI::fillRect(x, y, w, h, bg_color);
-    
-    // Draw progress
+    // Paint filled and empty parts side by side (no overdraw); see ProgressBar for delta updates
+    if (progress > 100) progress = 100;
     int16_t progress_width = (w * progress) / 100;
     if (progress_width > 0) {
-        ili9488::ILI9488_UI::fillRect(x, y, progress_width, h, fg_color);
+        fillRectFast(x, y, progress_width, h, fg_color);
+    }
+    if (progress_width < w) {
+        fillRectFast(x + progress_width, y, w - progress_width, h, bg_color);
     }
 }
 
 template<typename Driver>
 void PicoILI9488GFX<Driver>::drawGradient(int16_t x, int16_t y, int16_t w, int16_t h, 
                                            uint32_t color1, uint32_t color2, bool horizontal) {
-    // Simple gradient implementation
-    for (int16_t i = 0; i < (horizontal ? w : h); i++) {
-        uint8_t alpha = (255 * i) / (horizontal ? w : h);
-        uint16_t blended = blendColors(static_cast<uint16_t>(color2), static_cast<uint16_t>(color1), alpha);
-        
-        if (horizontal) {
-            ili9488::ILI9488_UI::drawFastVLine(x + i, y, h, blended);
-        } else {
-            ili9488::ILI9488_UI::drawFastHLine(x, y + i, w, blended);
-        }
-    }
+    fillGradient(x, y, w, h, color1, color2,
+                 horizontal ? GradientShape::Horizontal : GradientShape::Vertical);
 }
 
 template<typename Driver>
@@ -156,41 +316,130 @@ template<typename Driver>
 void PicoILI9488GFX<Driver>::drawStringWithShadow(int16_t x, int16_t y, const char* str, 
                                                    uint16_t color, uint16_t shadow_color, 
                                                    int16_t shadow_offset_x, int16_t shadow_offset_y) {
-    // Draw shadow first
-    ili9488::ILI9488_UI::drawString(x + shadow_offset_x, y + shadow_offset_y, str, shadow_color, 0, 1);
-    // Draw main text
-    ili9488::ILI9488_UI::drawString(x, y, str, color, 0, 1);
+    drawStringEffect(x, y, str, TextEffect::Shadow,
+                     static_cast<int8_t>(shadow_offset_x), static_cast<int8_t>(shadow_offset_y),
+                     color, shadow_color, 0, false);
+}
+
+template<typename Driver>
+void PicoILI9488GFX<Driver>::drawStringWithShadow(int16_t x, int16_t y, const char* str, 
+                                                   uint16_t color, uint16_t shadow_color, 
+                                                   int16_t shadow_offset_x, int16_t shadow_offset_y,
+                                                   uint16_t bg) {
+    drawStringEffect(x, y, str, TextEffect::Shadow,
+                     static_cast<int8_t>(shadow_offset_x), static_cast<int8_t>(shadow_offset_y),
+                     color, shadow_color, bg, true);
 }
 
 template<typename Driver>
 void PicoILI9488GFX<Driver>::drawStringOutlined(int16_t x, int16_t y, const char* str,
                                                  uint16_t color, uint16_t outline_color) {
-    // Draw outline in 8 directions
-    for (int8_t dx = -1; dx <= 1; dx++) {
-        for (int8_t dy = -1; dy <= 1; dy++) {
-            if (dx != 0 || dy != 0) {
-                ili9488::ILI9488_UI::drawString(x + dx, y + dy, str, outline_color, 0, 1);
-            }
-        }
-    }
-    // Draw main text
-    ili9488::ILI9488_UI::drawString(x, y, str, color, 0, 1);
+    drawStringEffect(x, y, str, TextEffect::Outline, 0, 0, color, outline_color, 0, false);
+}
+
+template<typename Driver>
+void PicoILI9488GFX<Driver>::drawStringOutlined(int16_t x, int16_t y, const char* str,
+                                                 uint16_t color, uint16_t outline_color, uint16_t bg) {
+    drawStringEffect(x, y, str, TextEffect::Outline, 0, 0, color, outline_color, bg, true);
 }
 
 template<typename Driver>
 void PicoILI9488GFX<Driver>::drawGauge(int16_t x, int16_t y, int16_t radius, 
                                         float value, float min_val, float max_val,
                                         uint16_t color, uint16_t bg_color) {
+    using ili9488::fixed::q16_16;
+    // Only the position on the scale matters: clamp to it and shrink scales
+    // beyond Q16.16 (+-32768), which from_float() would wrap
+    if (value < min_val) value = min_val;
+    if (value > max_val) value = max_val;
+    const float min_mag = min_val < 0 ? -min_val : min_val;
+    const float max_mag = max_val < 0 ? -max_val : max_val;
+    const float span = min_mag > max_mag ? min_mag : max_mag;
+    if (span > 32767.0f) {
+        const float scale = 32767.0f / span;
+        value *= scale;
+        min_val *= scale;
+        max_val *= scale;
+    }
+    drawGauge(x, y, radius, q16_16::from_float(value), q16_16::from_float(min_val),
+              q16_16::from_float(max_val), color, bg_color);
+}
+
+template<typename Driver>
+void PicoILI9488GFX<Driver>::drawGauge(int16_t x, int16_t y, int16_t radius, 
+                                        ili9488::fixed::q16_16 value, ili9488::fixed::q16_16 min_val,
+                                        ili9488::fixed::q16_16 max_val,
+                                        uint16_t color, uint16_t bg_color) {
+    namespace fx = ili9488::fixed;
+    
     // Draw gauge background
     ili9488::ILI9488_UI::drawCircle(x, y, radius, bg_color);
     
-    // Calculate angle for value
-    float angle = 3.14159f * (value - min_val) / (max_val - min_val);
-    int16_t end_x = x + static_cast<int16_t>(radius * 0.8f * cos(angle));
-    int16_t end_y = y + static_cast<int16_t>(radius * 0.8f * sin(angle));
+    // Map value onto a half turn (0..ANGLE_180), clamped to the scale
+    // (64-bit: a scale spanning most of Q16.16 overflows int32)
+    const int64_t range = static_cast<int64_t>(max_val.raw()) - min_val.raw();
+    int64_t offset = static_cast<int64_t>(value.raw()) - min_val.raw();
+    if (offset < 0) offset = 0;
+    if (offset > range) offset = range;
+    const fx::angle_t angle = range > 0 ?
+        static_cast<fx::angle_t>((offset * fx::ANGLE_180) / range) : 0;
+    
+    // Needle length is 80% of the radius
+    const fx::PolarOffset tip = fx::polar((radius * 4) / 5, angle);
     
     // Draw gauge needle
-    ili9488::ILI9488_UI::drawLine(x, y, end_x, end_y, color);
+    ili9488::ILI9488_UI::drawLine(x, y, x + tip.dx, y + tip.dy, color);
+}
+
+template<typename Driver>
+void PicoILI9488GFX<Driver>::drawArc(int16_t x0, int16_t y0, int16_t r,
+                                      ili9488::fixed::angle_t start, ili9488::fixed::angle_t end,
+                                      uint16_t color) {
+    namespace fx = ili9488::fixed;
+    if (r <= 0) return;
+    
+    // Angular step of roughly 0.8 pixel along the circumference
+    const uint32_t sweep = (end == start) ? 0x10000u : static_cast<fx::angle_t>(end - start);
+    const uint32_t step = (8192u / static_cast<uint32_t>(r)) ? (8192u / static_cast<uint32_t>(r)) : 1u;
+    
+    int16_t last_x = INT16_MIN, last_y = INT16_MIN;
+    for (uint32_t a = 0; a <= sweep; a += step) {
+        const fx::PolarOffset p = fx::polar(r, static_cast<fx::angle_t>(start + a));
+        if (p.dx != last_x || p.dy != last_y) {
+            ili9488::ILI9488_UI::drawPixel(x0 + p.dx, y0 + p.dy, color);
+            last_x = p.dx;
+            last_y = p.dy;
+        }
+    }
+    
+    // Make sure the end point is always plotted
+    const fx::PolarOffset p = fx::polar(r, end);
+    ili9488::ILI9488_UI::drawPixel(x0 + p.dx, y0 + p.dy, color);
+}
+
+template<typename Driver>
+void PicoILI9488GFX<Driver>::fillArc(int16_t x0, int16_t y0, int16_t r_inner, int16_t r_outer,
+                                      ili9488::fixed::angle_t start, ili9488::fixed::angle_t end,
+                                      uint16_t color) {
+    namespace fx = ili9488::fixed;
+    if (r_inner > r_outer) swap(r_inner, r_outer);
+    if (r_outer <= 0) return;
+    if (r_inner < 0) r_inner = 0;
+    
+    // Radial spokes spaced under one pixel apart at the outer edge
+    const uint32_t sweep = (end == start) ? 0x10000u : static_cast<fx::angle_t>(end - start);
+    const uint32_t step = (8192u / static_cast<uint32_t>(r_outer)) ? (8192u / static_cast<uint32_t>(r_outer)) : 1u;
+    
+    for (uint32_t a = 0; a <= sweep; a += step) {
+        const fx::angle_t angle = static_cast<fx::angle_t>(start + a);
+        const fx::PolarOffset outer = fx::polar(r_outer, angle);
+        const fx::PolarOffset inner = fx::polar(r_inner, angle);
+        ili9488::ILI9488_UI::drawLine(x0 + inner.dx, y0 + inner.dy, x0 + outer.dx, y0 + outer.dy, color);
+    }
+    
+    const fx::PolarOffset outer = fx::polar(r_outer, end);
+    const fx::PolarOffset inner = fx::polar(r_inner, end);
+    ili9488::ILI9488_UI::drawLine(x0 + inner.dx, y0 + inner.dy, x0 + outer.dx, y0 + outer.dy, color);
 }
 
 } // namespace pico_ili9488_gfx 
\ No newline at end of file
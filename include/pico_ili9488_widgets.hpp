@@ -0,0 +1,222 @@
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+
+#include "pico_ili9488_gfx.hpp"
+#include "ili9488_fixed.hpp"
+
+namespace pico_ili9488_gfx {
+
+/**
+ * @brief Retained progress bar
+ *
+ * Remembers the last rendered fill length and only repaints the strip
+ * between the old and new value on update().
+ *
+ * @tparam Driver The underlying display driver type
+ */
+template<typename Driver>
+class ProgressBar {
+public:
+    /**
+     * @brief Fill direction
+     */
+    enum class Orientation {
+        LeftToRight,
+        BottomToTop
+    };
+
+    /**
+     * @brief Constructor
+     * @param gfx Graphics engine used for drawing
+     * @param x Left edge
+     * @param y Top edge
+     * @param w Width in pixels
+     * @param h Height in pixels
+     * @param fg_color Filled part color (RGB565)
+     * @param bg_color Empty part color (RGB565)
+     * @param max_value Value that corresponds to a full bar
+     * @param orientation Fill direction
+     */
+    ProgressBar(PicoILI9488GFX<Driver>& gfx, int16_t x, int16_t y, int16_t w, int16_t h,
+                uint16_t fg_color, uint16_t bg_color, uint16_t max_value = 100,
+                Orientation orientation = Orientation::LeftToRight);
+
+    /**
+     * @brief Set the value to display (clamped to max_value)
+     * @note Nothing is drawn until update() is called.
+     */
+    void setValue(uint16_t value);
+
+    /**
+     * @brief Get the current value
+     */
+    uint16_t value() const { return value_; }
+
+    /**
+     * @brief Change colors (forces a full repaint on the next update)
+     */
+    void setColors(uint16_t fg_color, uint16_t bg_color);
+
+    /**
+     * @brief Force a full repaint on the next update (e.g. after the screen was cleared)
+     */
+    void invalidate() { drawn_ = false; }
+
+    /**
+     * @brief Repaint whatever changed since the last update
+     * @return Number of pixels written
+     */
+    uint32_t update();
+
+private:
+    int16_t lengthFor(uint16_t value) const;
+    uint32_t fillSpan(int16_t from, int16_t to, uint16_t color);
+
+    PicoILI9488GFX<Driver>& gfx_;
+    int16_t x_, y_, w_, h_;
+    uint16_t fg_color_, bg_color_;
+    uint16_t max_value_;
+    Orientation orientation_;
+
+    uint16_t value_ = 0;
+    int16_t drawn_length_ = 0;   ///< Fill length currently on screen
+    bool drawn_ = false;
+};
+
+/**
+ * @brief Retained needle gauge
+ *
+ * The ring is drawn once; on update() only the previous needle is erased
+ * (redrawn in the background color) and the new one drawn, and nothing at
+ * all happens if the needle angle did not change.
+ *
+ * @tparam Driver The underlying display driver type
+ */
+template<typename Driver>
+class Gauge {
+public:
+    /**
+     * @brief Constructor
+     * @param gfx Graphics engine used for drawing
+     * @param cx Center X
+     * @param cy Center Y
+     * @param radius Outer ring radius
+     * @param min_val Value at the start of the scale
+     * @param max_val Value at the end of the scale
+     * @param needle_color Needle color (RGB565)
+     * @param ring_color Ring color (RGB565)
+     * @param bg_color Background color used to erase the needle (RGB565)
+     * @param start Scale start angle (binary angle, default -135°)
+     * @param sweep Scale sweep (binary angle, default 270°)
+     */
+    Gauge(PicoILI9488GFX<Driver>& gfx, int16_t cx, int16_t cy, int16_t radius,
+          int32_t min_val, int32_t max_val,
+          uint16_t needle_color, uint16_t ring_color, uint16_t bg_color,
+          ili9488::fixed::angle_t start = ili9488::fixed::deg_to_angle(-135),
+          ili9488::fixed::angle_t sweep = ili9488::fixed::deg_to_angle(270));
+
+    /**
+     * @brief Set the value to display (clamped to the scale)
+     */
+    void setValue(int32_t value);
+
+    /**
+     * @brief Get the current value
+     */
+    int32_t value() const { return value_; }
+
+    /**
+     * @brief Force a full repaint on the next update
+     */
+    void invalidate() { drawn_ = false; }
+
+    /**
+     * @brief Repaint the needle if it moved
+     * @return true if anything was drawn
+     */
+    bool update();
+
+private:
+    ili9488::fixed::angle_t angleFor(int32_t value) const;
+    void drawNeedle(ili9488::fixed::PolarOffset tip, uint16_t color);
+
+    PicoILI9488GFX<Driver>& gfx_;
+    int16_t cx_, cy_, radius_;
+    int32_t min_val_, max_val_;
+    uint16_t needle_color_, ring_color_, bg_color_;
+    ili9488::fixed::angle_t start_, sweep_;
+    int16_t needle_length_;
+
+    int32_t value_;
+    ili9488::fixed::PolarOffset drawn_tip_{0, 0};   ///< Needle tip currently on screen
+    bool drawn_ = false;
+};
+
+/**
+ * @brief Retained sweep-style sparkline (strip chart)
+ *
+ * Instead of shifting the whole plot left on every sample, a write cursor
+ * sweeps across the plot like an oscilloscope: each push() repaints only the
+ * column under the cursor (plus the cursor marker ahead of it).
+ *
+ * @tparam Driver The underlying display driver type
+ * @tparam Series Number of traces sharing the plot area
+ */
+template<typename Driver, size_t Series = 1>
+class Sparkline {
+public:
+    /**
+     * @brief Constructor
+     * @param gfx Graphics engine used for drawing
+     * @param x Left edge of the plot area
+     * @param y Top edge of the plot area
+     * @param w Width (one column per sample)
+     * @param h Height
+     * @param min_val Value mapped to the bottom row
+     * @param max_val Value mapped to the top row
+     * @param colors Trace colors (RGB565)
+     * @param bg_color Background color (RGB565)
+     * @param cursor_color Sweep cursor color (same as bg_color to hide it)
+     */
+    Sparkline(PicoILI9488GFX<Driver>& gfx, int16_t x, int16_t y, int16_t w, int16_t h,
+              int32_t min_val, int32_t max_val,
+              const std::array<uint16_t, Series>& colors,
+              uint16_t bg_color, uint16_t cursor_color);
+
+    /**
+     * @brief Append one sample per trace and repaint the affected column
+     */
+    void push(const std::array<int32_t, Series>& values);
+
+    /**
+     * @brief Append one sample (single-trace convenience)
+     */
+    void push(int32_t value) { push(std::array<int32_t, Series>{value}); }
+
+    /**
+     * @brief Clear the plot area and restart the sweep from the left edge
+     */
+    void reset();
+
+private:
+    int16_t rowFor(int32_t value) const;
+
+    PicoILI9488GFX<Driver>& gfx_;
+    int16_t x_, y_, w_, h_;
+    int32_t min_val_, max_val_;
+    std::array<uint16_t, Series> colors_;
+    uint16_t bg_color_, cursor_color_;
+
+    int16_t cursor_ = 0;                    ///< Next column to write
+    std::array<int16_t, Series> last_row_{};///< Previous sample row per trace
+    bool has_last_ = false;
+    bool cleared_ = false;
+};
+
+} // namespace pico_ili9488_gfx
+
+// Include template implementation
+#include "pico_ili9488_widgets.inl"
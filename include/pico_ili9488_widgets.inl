@@ -0,0 +1,203 @@
+// Template implementation file for the retained widgets
+// This file should be included at the end of pico_ili9488_widgets.hpp
+
+namespace pico_ili9488_gfx {
+
+// === ProgressBar ===
+
+template<typename Driver>
+ProgressBar<Driver>::ProgressBar(PicoILI9488GFX<Driver>& gfx, int16_t x, int16_t y, int16_t w, int16_t h,
+                                 uint16_t fg_color, uint16_t bg_color, uint16_t max_value,
+                                 Orientation orientation)
+    : gfx_(gfx), x_(x), y_(y), w_(w), h_(h),
+      fg_color_(fg_color), bg_color_(bg_color),
+      max_value_(max_value ? max_value : 1), orientation_(orientation) {
+}
+
+template<typename Driver>
+void ProgressBar<Driver>::setValue(uint16_t value) {
+    value_ = value > max_value_ ? max_value_ : value;
+}
+
+template<typename Driver>
+void ProgressBar<Driver>::setColors(uint16_t fg_color, uint16_t bg_color) {
+    if (fg_color != fg_color_ || bg_color != bg_color_) {
+        fg_color_ = fg_color;
+        bg_color_ = bg_color;
+        drawn_ = false;
+    }
+}
+
+template<typename Driver>
+int16_t ProgressBar<Driver>::lengthFor(uint16_t value) const {
+    const int32_t span = (orientation_ == Orientation::LeftToRight) ? w_ : h_;
+    return static_cast<int16_t>((span * value) / max_value_);
+}
+
+template<typename Driver>
+uint32_t ProgressBar<Driver>::fillSpan(int16_t from, int16_t to, uint16_t color) {
+    if (to <= from) return 0;
+
+    if (orientation_ == Orientation::LeftToRight) {
+        gfx_.fillRectFast(x_ + from, y_, to - from, h_, color);
+        return static_cast<uint32_t>(to - from) * h_;
+    }
+
+    // Bottom-to-top: length is measured upwards from the bottom edge
+    gfx_.fillRectFast(x_, y_ + h_ - to, w_, to - from, color);
+    return static_cast<uint32_t>(to - from) * w_;
+}
+
+template<typename Driver>
+uint32_t ProgressBar<Driver>::update() {
+    const int16_t length = lengthFor(value_);
+    const int16_t full = (orientation_ == Orientation::LeftToRight) ? w_ : h_;
+    uint32_t pixels = 0;
+
+    if (!drawn_) {
+        pixels += fillSpan(0, length, fg_color_);
+        pixels += fillSpan(length, full, bg_color_);
+        drawn_ = true;
+    } else if (length > drawn_length_) {
+        // Grew: only the newly filled strip
+        pixels += fillSpan(drawn_length_, length, fg_color_);
+    } else if (length < drawn_length_) {
+        // Shrank: only the strip that became empty
+        pixels += fillSpan(length, drawn_length_, bg_color_);
+    }
+
+    drawn_length_ = length;
+    return pixels;
+}
+
+// === Gauge ===
+
+template<typename Driver>
+Gauge<Driver>::Gauge(PicoILI9488GFX<Driver>& gfx, int16_t cx, int16_t cy, int16_t radius,
+                     int32_t min_val, int32_t max_val,
+                     uint16_t needle_color, uint16_t ring_color, uint16_t bg_color,
+                     ili9488::fixed::angle_t start, ili9488::fixed::angle_t sweep)
+    : gfx_(gfx), cx_(cx), cy_(cy), radius_(radius),
+      min_val_(min_val), max_val_(max_val),
+      needle_color_(needle_color), ring_color_(ring_color), bg_color_(bg_color),
+      start_(start), sweep_(sweep), value_(min_val) {
+    // Leave a small gap between the needle tip and the inner edge of the ring
+    const int16_t ring_width = radius_ / 10 > 2 ? radius_ / 10 : 2;
+    needle_length_ = radius_ - ring_width - 3;
+}
+
+template<typename Driver>
+void Gauge<Driver>::setValue(int32_t value) {
+    if (value < min_val_) value = min_val_;
+    if (value > max_val_) value = max_val_;
+    value_ = value;
+}
+
+template<typename Driver>
+ili9488::fixed::angle_t Gauge<Driver>::angleFor(int32_t value) const {
+    // 64-bit: the span of the value range can exceed int32 (e.g. INT32_MIN..INT32_MAX)
+    const int64_t range = static_cast<int64_t>(max_val_) - min_val_;
+    if (range <= 0) return start_;
+    const int64_t offset = (static_cast<int64_t>(value) - min_val_) * sweep_;
+    return static_cast<ili9488::fixed::angle_t>(start_ + offset / range);
+}
+
+template<typename Driver>
+void Gauge<Driver>::drawNeedle(ili9488::fixed::PolarOffset tip, uint16_t color) {
+    gfx_.drawLine(cx_, cy_, cx_ + tip.dx, cy_ + tip.dy, color);
+}
+
+template<typename Driver>
+bool Gauge<Driver>::update() {
+    const ili9488::fixed::PolarOffset tip = ili9488::fixed::polar(needle_length_, angleFor(value_));
+
+    if (!drawn_) {
+        const int16_t ring_width = radius_ / 10 > 2 ? radius_ / 10 : 2;
+        gfx_.fillArc(cx_, cy_, radius_ - ring_width, radius_,
+                     start_, static_cast<ili9488::fixed::angle_t>(start_ + sweep_), ring_color_);
+    } else if (tip.dx == drawn_tip_.dx && tip.dy == drawn_tip_.dy) {
+        // Same pixel endpoint: the needle would be redrawn identically
+        return false;
+    } else {
+        // Erase only the old needle
+        drawNeedle(drawn_tip_, bg_color_);
+    }
+
+    drawNeedle(tip, needle_color_);
+    gfx_.fillRectFast(cx_ - 1, cy_ - 1, 3, 3, needle_color_);   // Hub
+
+    drawn_tip_ = tip;
+    drawn_ = true;
+    return true;
+}
+
+// === Sparkline ===
+
+template<typename Driver, size_t Series>
+Sparkline<Driver, Series>::Sparkline(PicoILI9488GFX<Driver>& gfx, int16_t x, int16_t y, int16_t w, int16_t h,
+                                     int32_t min_val, int32_t max_val,
+                                     const std::array<uint16_t, Series>& colors,
+                                     uint16_t bg_color, uint16_t cursor_color)
+    : gfx_(gfx), x_(x), y_(y), w_(w), h_(h),
+      min_val_(min_val), max_val_(max_val > min_val ? max_val : min_val),
+      colors_(colors), bg_color_(bg_color), cursor_color_(cursor_color) {
+}
+
+template<typename Driver, size_t Series>
+void Sparkline<Driver, Series>::reset() {
+    gfx_.fillRectFast(x_, y_, w_, h_, bg_color_);
+    cursor_ = 0;
+    has_last_ = false;
+    cleared_ = true;
+}
+
+template<typename Driver, size_t Series>
+int16_t Sparkline<Driver, Series>::rowFor(int32_t value) const {
+    if (value < min_val_) value = min_val_;
+    if (value > max_val_) value = max_val_;
+    // Top row is max_val, bottom row is min_val (64-bit, see Gauge::angleFor)
+    const int64_t range = static_cast<int64_t>(max_val_) - min_val_;
+    if (range <= 0) return static_cast<int16_t>(y_ + h_ - 1);
+    const int32_t offset = static_cast<int32_t>(((static_cast<int64_t>(value) - min_val_) * (h_ - 1)) / range);
+    return static_cast<int16_t>(y_ + h_ - 1 - offset);
+}
+
+template<typename Driver, size_t Series>
+void Sparkline<Driver, Series>::push(const std::array<int32_t, Series>& values) {
+    if (!cleared_) {
+        reset();
+    }
+
+    const int16_t col = x_ + cursor_;
+
+    // Wipe the column under the cursor (this also removes the cursor marker)
+    gfx_.fillRectFast(col, y_, 1, h_, bg_color_);
+
+    for (size_t i = 0; i < Series; ++i) {
+        const int16_t row = rowFor(values[i]);
+        int16_t top = row;
+        int16_t bottom = row;
+
+        // Connect to the previous sample with a vertical run so steep edges stay continuous
+        if (has_last_) {
+            if (last_row_[i] < top) top = last_row_[i];
+            if (last_row_[i] > bottom) bottom = last_row_[i];
+        }
+
+        gfx_.fillRectFast(col, top, 1, bottom - top + 1, colors_[i]);
+        last_row_[i] = row;
+    }
+    has_last_ = true;
+
+    if (++cursor_ >= w_) {
+        // Wrap around: do not connect the right edge to the left edge
+        cursor_ = 0;
+        has_last_ = false;
+    }
+
+    if (cursor_color_ != bg_color_) {
+        gfx_.fillRectFast(x_ + cursor_, y_, 1, h_, cursor_color_);
+    }
+}
+
+} // namespace pico_ili9488_gfx
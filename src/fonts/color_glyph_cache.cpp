@@ -0,0 +1,172 @@
+#include "color_glyph_cache.hpp"
+#include <cstdio>
+
+namespace hybrid_font {
+
+ColorGlyphCache::ColorGlyphCache()
+    : lru_head_(NO_SLOT), lru_tail_(NO_SLOT), used_slots_(0) {
+    clear();
+}
+
+// ============================================================================
+// 哈希表与LRU链表（与FlashFontCache的字形缓存相同的结构）
+// ============================================================================
+
+uint16_t ColorGlyphCache::hash_index(uint64_t key) {
+    const uint32_t folded = static_cast<uint32_t>(key) ^ static_cast<uint32_t>(key >> 29);
+    return static_cast<uint16_t>(((folded * 2654435761u) >> 16) & (HASH_SIZE - 1));
+}
+
+uint16_t ColorGlyphCache::find_slot(uint64_t key) const {
+    for (uint16_t i = hash_index(key); ; i = (i + 1) & (HASH_SIZE - 1)) {
+        const uint16_t slot = hash_[i];
+        if (slot == NO_SLOT) {
+            return NO_SLOT;
+        }
+        if (slots_[slot].key == key) {
+            return slot;
+        }
+    }
+}
+
+void ColorGlyphCache::hash_insert(uint16_t slot) {
+    uint16_t i = hash_index(slots_[slot].key);
+    while (hash_[i] != NO_SLOT) {
+        i = (i + 1) & (HASH_SIZE - 1);
+    }
+    hash_[i] = slot;
+}
+
+// 删除后把探测链上后面的条目前移，不需要墓碑标记
+void ColorGlyphCache::hash_remove(uint64_t key) {
+    uint16_t i = hash_index(key);
+    while (hash_[i] != NO_SLOT && slots_[hash_[i]].key != key) {
+        i = (i + 1) & (HASH_SIZE - 1);
+    }
+    if (hash_[i] == NO_SLOT) {
+        return;
+    }
+    
+    uint16_t j = i;
+    while (true) {
+        j = (j + 1) & (HASH_SIZE - 1);
+        if (hash_[j] == NO_SLOT) {
+            break;
+        }
+        const uint16_t k = hash_index(slots_[hash_[j]].key);
+        const bool stays = (i <= j) ? (i < k && k <= j) : (i < k || k <= j);
+        if (!stays) {
+            hash_[i] = hash_[j];
+            i = j;
+        }
+    }
+    hash_[i] = NO_SLOT;
+}
+
+void ColorGlyphCache::lru_unlink(uint16_t slot) {
+    Slot& s = slots_[slot];
+    if (s.prev != NO_SLOT) slots_[s.prev].next = s.next; else lru_head_ = s.next;
+    if (s.next != NO_SLOT) slots_[s.next].prev = s.prev; else lru_tail_ = s.prev;
+}
+
+void ColorGlyphCache::lru_push_front(uint16_t slot) {
+    Slot& s = slots_[slot];
+    s.prev = NO_SLOT;
+    s.next = lru_head_;
+    if (lru_head_ != NO_SLOT) slots_[lru_head_].prev = slot; else lru_tail_ = slot;
+    lru_head_ = slot;
+}
+
+// ============================================================================
+// 查找与展开
+// ============================================================================
+
+ColorGlyph ColorGlyphCache::get(const IFontDataSource& source, uint32_t char_code, const BlendRamp& ramp) {
+    const uint64_t key = make_key(char_code, ramp);
+    ColorGlyph result;
+    
+    uint16_t slot = find_slot(key);
+    if (slot != NO_SLOT) {
+        stats_.hits++;
+        if (slot != lru_head_) {
+            lru_unlink(slot);
+            lru_push_front(slot);
+        }
+        result.data = pixels_[slot];
+        result.width = slots_[slot].width;
+        result.height = slots_[slot].height;
+        return result;
+    }
+    
+    GlyphView glyph = source.get_glyph(char_code);
+    if (glyph.empty() || static_cast<size_t>(glyph.width) * glyph.height * 3 > SLOT_BYTES) {
+        stats_.uncached++;
+        return result;
+    }
+    
+    // 未命中：取空闲槽，缓存满时淘汰链表尾部（最久未使用）的字形
+    stats_.misses++;
+    if (used_slots_ < SLOT_COUNT) {
+        slot = used_slots_++;
+    } else {
+        slot = lru_tail_;
+        hash_remove(slots_[slot].key);
+        lru_unlink(slot);
+        stats_.evictions++;
+    }
+    
+    expand(glyph, ramp, pixels_[slot]);
+    slots_[slot].key = key;
+    slots_[slot].width = glyph.width;
+    slots_[slot].height = glyph.height;
+    hash_insert(slot);
+    lru_push_front(slot);
+    
+    result.data = pixels_[slot];
+    result.width = glyph.width;
+    result.height = glyph.height;
+    return result;
+}
+
+void ColorGlyphCache::expand(const GlyphView& glyph, const BlendRamp& ramp, uint8_t* dst) {
+    for (int row = 0; row < glyph.height; row++) {
+        const uint8_t* line_data = glyph.row(row);
+        for (int col = 0; col < glyph.width; col++) {
+            // 覆盖度直接查色阶，1bpp的位0/1对应色阶两端
+            const uint8_t* c = (glyph.bpp == 1) ? ramp.wire[((line_data[col >> 3] >> (7 - (col & 7))) & 1) * 3]
+                                                : ramp.wire[(line_data[col >> 2] >> (6 - ((col & 3) << 1))) & 3];
+            dst[0] = c[0];
+            dst[1] = c[1];
+            dst[2] = c[2];
+            dst += 3;
+        }
+    }
+}
+
+void ColorGlyphCache::clear() {
+    for (uint16_t i = 0; i < HASH_SIZE; i++) {
+        hash_[i] = NO_SLOT;
+    }
+    lru_head_ = NO_SLOT;
+    lru_tail_ = NO_SLOT;
+    used_slots_ = 0;
+}
+
+uint32_t ColorGlyphCache::hit_rate_permille() const {
+    const uint32_t lookups = stats_.hits + stats_.misses + stats_.uncached;
+    if (lookups == 0) {
+        return 0;
+    }
+    return static_cast<uint32_t>(stats_.hits * 1000ull / lookups);
+}
+
+void ColorGlyphCache::print_stats() const {
+    const uint32_t rate = hit_rate_permille();
+    printf("[ColorGlyphCache] %u/%u 字形 (%u字节), 命中 %lu, 未命中 %lu, 淘汰 %lu, 未缓存 %lu, 命中率 %lu.%lu%%\n",
+           used_slots_, SLOT_COUNT, static_cast<unsigned>(sizeof(pixels_)),
+           (unsigned long)stats_.hits, (unsigned long)stats_.misses,
+           (unsigned long)stats_.evictions, (unsigned long)stats_.uncached,
+           (unsigned long)(rate / 10), (unsigned long)(rate % 10));
+}
+
+} // namespace hybrid_font
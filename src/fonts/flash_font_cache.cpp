@@ -3,11 +3,113 @@
 #include <cstdio>
 #include <cstring>
 
+#if defined(ILI9488_FONT_XIP_STREAM) && ILI9488_FONT_XIP_STREAM
+#include "hardware/dma.h"
+#include "hardware/structs/xip_ctrl.h"
+#include "hardware/regs/addressmap.h"
+#endif
+
 namespace ili9488_font {
 
+namespace {
+
+// 小端读取（字体文件中的索引不保证对齐，M0+不支持非对齐访问）
+inline uint16_t read_u16(const uint8_t* p) {
+    return static_cast<uint16_t>(p[0] | (p[1] << 8));
+}
+
+inline uint32_t read_u32(const uint8_t* p) {
+    return static_cast<uint32_t>(p[0]) | (static_cast<uint32_t>(p[1]) << 8) |
+           (static_cast<uint32_t>(p[2]) << 16) | (static_cast<uint32_t>(p[3]) << 24);
+}
+
+// 范围解码器（LZMA式，8位静态概率），读到记录末尾之后按0补齐
+struct RangeDecoder {
+    const uint8_t* data;
+    size_t length;
+    size_t pos;
+    uint32_t range;
+    uint32_t code;
+    
+    RangeDecoder(const uint8_t* d, size_t len) : data(d), length(len), pos(0), range(0xFFFFFFFF), code(0) {
+        for (int i = 0; i < 4; i++) {
+            code = (code << 8) | next();
+        }
+    }
+    
+    uint8_t next() {
+        return pos < length ? data[pos++] : 0;
+    }
+    
+    // p0: 位为0的概率（1/256单位，1-255）
+    uint8_t decode_bit(uint8_t p0) {
+        const uint32_t bound = (range >> 8) * p0;
+        uint8_t bit;
+        if (code < bound) {
+            range = bound;
+            bit = 0;
+        } else {
+            code -= bound;
+            range -= bound;
+            bit = 1;
+        }
+        while (range < (1u << 24)) {
+            range <<= 8;
+            code = (code << 8) | next();
+        }
+        return bit;
+    }
+};
+
+// 上下文编码的字形：每个像素的上下文是已解码的10个相邻像素是否为前景
+//   上上行 x-1..x+1（位9-7），上一行 x-2..x+2（位6-2），当前行 x-2..x-1（位1-0），字形外为0
+// 1bpp每像素一位；2bpp先解高位（模型表0），再按高位解低位（模型表1/2），高位即前景
+bool decode_context(const uint8_t* data, size_t length, int width, int height, int bpp,
+                    const uint8_t* model, uint8_t* dst, size_t stride) {
+    if (!model || width > 28) {
+        return false;
+    }
+    
+    RangeDecoder decoder(data, length);
+    uint32_t ink2 = 0;  // 前两行和当前行的前景位，像素x在位x+2
+    uint32_t ink1 = 0;
+    for (int row = 0; row < height; row++) {
+        uint32_t ink0 = 0;
+        uint8_t* line_data = dst + row * stride;
+        for (int col = 0; col < width; col++) {
+            const uint32_t context = (((ink2 >> (col + 1)) & 0x07) << 7) |
+                                     (((ink1 >> col) & 0x1F) << 2) |
+                                     ((ink0 >> col) & 0x03);
+            const uint8_t high = decoder.decode_bit(model[context]);
+            uint8_t level = high;
+            if (bpp == 2) {
+                level = static_cast<uint8_t>((high << 1) | decoder.decode_bit(model[(1 + high) * FONT_CONTEXT_COUNT + context]));
+            }
+            if (high) {
+                ink0 |= 1u << (col + 2);
+            }
+            if (level) {
+                const int bit = col * bpp;
+                line_data[bit >> 3] |= static_cast<uint8_t>(level << (8 - bpp - (bit & 7)));
+            }
+        }
+        ink2 = ink1;
+        ink1 = ink0;
+    }
+    return true;
+}
+
+} // namespace
+
 // 私有构造函数
 FlashFontCache::FlashFontCache() 
-    : flash_data_(nullptr), font_size_(0), initialized_(false) {
+    : flash_data_(nullptr), font_size_(0), initialized_(false),
+      version_(1), glyph_width_(0), glyph_height_(0), bpp_(1), glyph_bytes_(0),
+      glyph_count_(0), index_offset_(0), data_offset_(0), model_(nullptr),
+      advances_(nullptr), kerning_(nullptr), kerning_count_(0),
+      lru_head_(NO_SLOT), lru_tail_(NO_SLOT), used_slots_(0), stats_{0, 0, 0, 0},
+      prefetch_head_(0), prefetch_count_(0), prefetch_fill_(0), prefetch_in_flight_(false), prefetch_dma_(-1) {
+    clear_cache();
 }
 
 // 获取单例实例
@@ -21,6 +123,452 @@ uint32_t FlashFontCache::get_char_offset(uint32_t unicode_code) const {
     return find_unicode_offset(unicode_code);
 }
 
+// ============================================================================
+// LRU字形缓存
+// ============================================================================
+
+size_t FlashFontCache::bytes_per_char() const {
+    return glyph_bytes_;
+}
+
+// 乘法哈希，取中间位（相邻码点分散到不同桶）
+uint16_t FlashFontCache::hash_index(uint32_t unicode_code) {
+    return static_cast<uint16_t>(((unicode_code * 2654435761u) >> 16) & (HASH_SIZE - 1));
+}
+
+uint16_t FlashFontCache::find_slot(uint32_t unicode_code) const {
+    // 表的装载率不超过1/2，探测链很短
+    for (uint16_t i = hash_index(unicode_code); ; i = (i + 1) & (HASH_SIZE - 1)) {
+        const uint16_t slot = hash_[i];
+        if (slot == NO_SLOT) {
+            return NO_SLOT;
+        }
+        if (slots_[slot].code == unicode_code) {
+            return slot;
+        }
+    }
+}
+
+// 删除后把探测链上后面的条目前移，不需要墓碑标记
+void FlashFontCache::hash_remove(uint32_t unicode_code) const {
+    uint16_t i = hash_index(unicode_code);
+    while (hash_[i] != NO_SLOT && slots_[hash_[i]].code != unicode_code) {
+        i = (i + 1) & (HASH_SIZE - 1);
+    }
+    if (hash_[i] == NO_SLOT) {
+        return;
+    }
+    
+    uint16_t j = i;
+    while (true) {
+        j = (j + 1) & (HASH_SIZE - 1);
+        if (hash_[j] == NO_SLOT) {
+            break;
+        }
+        // 条目的理想位置k不在(i, j]之间时，移到空出的位置i
+        const uint16_t k = hash_index(slots_[hash_[j]].code);
+        const bool stays = (i <= j) ? (i < k && k <= j) : (i < k || k <= j);
+        if (!stays) {
+            hash_[i] = hash_[j];
+            i = j;
+        }
+    }
+    hash_[i] = NO_SLOT;
+}
+
+void FlashFontCache::lru_unlink(uint16_t slot) const {
+    GlyphSlot& s = slots_[slot];
+    if (s.prev != NO_SLOT) slots_[s.prev].next = s.next; else lru_head_ = s.next;
+    if (s.next != NO_SLOT) slots_[s.next].prev = s.prev; else lru_tail_ = s.prev;
+}
+
+void FlashFontCache::lru_push_front(uint16_t slot) const {
+    GlyphSlot& s = slots_[slot];
+    s.prev = NO_SLOT;
+    s.next = lru_head_;
+    if (lru_head_ != NO_SLOT) slots_[lru_head_].prev = slot; else lru_tail_ = slot;
+    lru_head_ = slot;
+}
+
+const uint8_t* FlashFontCache::lookup_glyph(uint32_t unicode_code) const {
+    uint16_t slot = find_slot(unicode_code);
+    if (slot != NO_SLOT) {
+        stats_.hits++;
+        if (slot != lru_head_) {
+            lru_unlink(slot);
+            lru_push_front(slot);
+        }
+        return slots_[slot].bitmap;
+    }
+    
+    // 未命中：取空闲槽，缓存满时淘汰链表尾部的字形
+    stats_.misses++;
+    slot = take_slot();
+    
+    // 获取字符在字体文件中的偏移
+    uint32_t char_offset = get_char_offset(unicode_code);
+    if (char_offset == UINT32_MAX) {
+        // 不支持的字符，返回空格字符（偏移0）
+        char_offset = 0;
+    }
+    load_glyph(char_offset, slots_[slot].bitmap);
+    insert_slot(slot, unicode_code);
+    return slots_[slot].bitmap;
+}
+
+uint16_t FlashFontCache::take_slot() const {
+    if (used_slots_ < CACHE_SLOTS) {
+        return used_slots_++;
+    }
+    const uint16_t slot = lru_tail_;
+    hash_remove(slots_[slot].code);
+    lru_unlink(slot);
+    stats_.evictions++;
+    return slot;
+}
+
+void FlashFontCache::insert_slot(uint16_t slot, uint32_t unicode_code) const {
+    slots_[slot].code = unicode_code;
+    
+    uint16_t i = hash_index(unicode_code);
+    while (hash_[i] != NO_SLOT) {
+        i = (i + 1) & (HASH_SIZE - 1);
+    }
+    hash_[i] = slot;
+    lru_push_front(slot);
+}
+
+bool FlashFontCache::glyph_record(uint32_t glyph_index, uint32_t& start, uint32_t& length) const {
+    if (version_ != 2) {
+        // 版本1: 定长未压缩位图
+        start = sizeof(FontHeader) + glyph_index * glyph_bytes_;
+        length = glyph_bytes_;
+        return true;
+    }
+    
+    if (glyph_index >= glyph_count_) {
+        glyph_index = 0;
+    }
+    
+    // 版本2: 分块索引定位字形记录
+    const uint8_t* index = flash_data_ + index_offset_;
+    const uint8_t* relative = index + ((glyph_count_ / V2_BLOCK_GLYPHS) + 1) * 4;
+    const uint32_t next_index = glyph_index + 1;
+    const uint32_t begin = read_u32(index + (glyph_index / V2_BLOCK_GLYPHS) * 4) + read_u16(relative + glyph_index * 2);
+    const uint32_t end = read_u32(index + (next_index / V2_BLOCK_GLYPHS) * 4) + read_u16(relative + next_index * 2);
+    if (end <= begin) {
+        return false;
+    }
+    start = data_offset_ + begin;
+    length = end - begin;
+    return true;
+}
+
+bool FlashFontCache::decode_record(const uint8_t* record, uint32_t length, uint8_t* dst) const {
+    if (version_ != 2) {
+        std::memcpy(dst, record, glyph_bytes_);
+        return true;
+    }
+    return decode_glyph(record, length, glyph_width_, glyph_height_, bpp_, model_, dst);
+}
+
+void FlashFontCache::load_glyph(uint32_t glyph_index, uint8_t* dst) const {
+    // 记录直接从Flash解码到缓存槽
+    uint32_t start;
+    uint32_t length;
+    if (!glyph_record(glyph_index, start, length) || !decode_record(flash_data_ + start, length, dst)) {
+        // 损坏的记录显示为空白
+        std::memset(dst, 0, glyph_bytes_);
+    }
+}
+
+// ============================================================================
+// 后台预取
+// ============================================================================
+
+bool FlashFontCache::prefetch_glyph(uint32_t unicode_code) {
+    if (!initialized_ || get_char_offset(unicode_code) == UINT32_MAX) {
+        return false;
+    }
+    
+    // 已缓存：移到最近使用端，之后预取的字形不会先把它淘汰
+    const uint16_t slot = find_slot(unicode_code);
+    if (slot != NO_SLOT) {
+        if (slot != lru_head_) {
+            lru_unlink(slot);
+            lru_push_front(slot);
+        }
+        return false;
+    }
+    
+    for (uint16_t i = 0; i < prefetch_count_; i++) {
+        if (prefetch_queue_[(prefetch_head_ + i) % PREFETCH_QUEUE] == unicode_code) {
+            return false;
+        }
+    }
+    if (prefetch_count_ >= PREFETCH_QUEUE) {
+        return false;
+    }
+    prefetch_queue_[(prefetch_head_ + prefetch_count_) % PREFETCH_QUEUE] = unicode_code;
+    prefetch_count_++;
+    return true;
+}
+
+bool FlashFontCache::start_prefetch() {
+    while (prefetch_count_ > 0) {
+        const uint32_t code = prefetch_queue_[prefetch_head_];
+        prefetch_head_ = static_cast<uint16_t>((prefetch_head_ + 1) % PREFETCH_QUEUE);
+        prefetch_count_--;
+        
+        // 排队之后可能已被绘制时的未命中读入
+        uint32_t start;
+        uint32_t length;
+        if (find_slot(code) != NO_SLOT || !glyph_record(get_char_offset(code), start, length)) {
+            continue;
+        }
+        
+        PrefetchBuffer& buffer = prefetch_buffers_[prefetch_fill_];
+        const uint8_t* source = flash_data_ + start;
+        const uint32_t skip = static_cast<uint32_t>(reinterpret_cast<uintptr_t>(source) & 3);
+        const uint32_t words = (skip + length + 3) / 4;
+        buffer.code = code;
+        buffer.length = length;
+        if (words > PREFETCH_BUFFER_WORDS) {
+            // 超长的记录（损坏的字体）在完成时直接从Flash解码
+            buffer.record = source;
+            return true;
+        }
+        buffer.record = reinterpret_cast<const uint8_t*>(buffer.words) + skip;
+        
+#if defined(ILI9488_FONT_XIP_STREAM) && ILI9488_FONT_XIP_STREAM
+        // XIP流式接口：XIP控制器在总线空闲时按字读取（绘制时的正常XIP访问优先），
+        // DMA从流FIFO搬到缓冲区；不经过XIP缓存
+        const uintptr_t address = reinterpret_cast<uintptr_t>(source) - skip;
+        if (address >= XIP_BASE && address < XIP_NOALLOC_BASE) {
+            if (prefetch_dma_ < 0) {
+                prefetch_dma_ = dma_claim_unused_channel(false);
+            }
+            if (prefetch_dma_ >= 0) {
+                while (!(xip_ctrl_hw->stat & XIP_STAT_FIFO_EMPTY_BITS)) {
+                    (void)xip_ctrl_hw->stream_fifo;
+                }
+                xip_ctrl_hw->stream_addr = address;
+                xip_ctrl_hw->stream_ctr = words;
+                
+                dma_channel_config config = dma_channel_get_default_config(prefetch_dma_);
+                channel_config_set_transfer_data_size(&config, DMA_SIZE_32);
+                channel_config_set_read_increment(&config, false);
+                channel_config_set_write_increment(&config, true);
+                channel_config_set_dreq(&config, DREQ_XIP_STREAM);
+                dma_channel_configure(prefetch_dma_, &config, buffer.words,
+                                      reinterpret_cast<const void*>(XIP_AUX_BASE), words, true);
+                return true;
+            }
+        }
+#endif
+        // 字体不在Flash中（或没有空闲DMA通道）：直接复制
+        std::memcpy(reinterpret_cast<uint8_t*>(buffer.words) + skip, source, length);
+        return true;
+    }
+    return false;
+}
+
+void FlashFontCache::wait_prefetch() {
+#if defined(ILI9488_FONT_XIP_STREAM) && ILI9488_FONT_XIP_STREAM
+    if (prefetch_dma_ >= 0) {
+        dma_channel_wait_for_finish_blocking(prefetch_dma_);
+        __compiler_memory_barrier();
+    }
+#endif
+}
+
+bool FlashFontCache::finish_prefetch(const PrefetchBuffer& buffer) {
+    if (find_slot(buffer.code) != NO_SLOT) {
+        return false;
+    }
+    
+    const uint16_t slot = take_slot();
+    if (!decode_record(buffer.record, buffer.length, slots_[slot].bitmap)) {
+        std::memset(slots_[slot].bitmap, 0, glyph_bytes_);
+    }
+    insert_slot(slot, buffer.code);
+    stats_.prefetched++;
+    return true;
+}
+
+uint16_t FlashFontCache::run_prefetch(uint16_t max_glyphs) {
+    if (!initialized_) {
+        return 0;
+    }
+    
+    if (!prefetch_in_flight_) {
+        prefetch_in_flight_ = start_prefetch();
+    }
+    
+    uint16_t loaded = 0;
+    while (prefetch_in_flight_ && loaded < max_glyphs) {
+        // 通常已传输完（一个记录几十字节）
+        wait_prefetch();
+        const uint8_t ready = prefetch_fill_;
+        prefetch_fill_ ^= 1;
+        
+        // 下一个记录的传输与这个字形的解码同时进行
+        prefetch_in_flight_ = start_prefetch();
+        if (finish_prefetch(prefetch_buffers_[ready])) {
+            loaded++;
+        }
+    }
+    return loaded;
+}
+
+bool FlashFontCache::is_prefetch_pending() const {
+    return prefetch_in_flight_ || prefetch_count_ > 0;
+}
+
+void FlashFontCache::cancel_prefetch() {
+#if defined(ILI9488_FONT_XIP_STREAM) && ILI9488_FONT_XIP_STREAM
+    if (prefetch_dma_ >= 0 && prefetch_in_flight_) {
+        dma_channel_abort(prefetch_dma_);
+        xip_ctrl_hw->stream_ctr = 0;
+        while (!(xip_ctrl_hw->stat & XIP_STAT_FIFO_EMPTY_BITS)) {
+            (void)xip_ctrl_hw->stream_fifo;
+        }
+    }
+#endif
+    prefetch_head_ = 0;
+    prefetch_count_ = 0;
+    prefetch_in_flight_ = false;
+}
+
+int FlashFontCache::get_advance(uint32_t unicode_code) const {
+    if (advances_) {
+        const uint32_t glyph_index = get_char_offset(unicode_code);
+        if (glyph_index < glyph_count_) {
+            return advances_[glyph_index];
+        }
+    }
+    return glyph_width_;
+}
+
+int FlashFontCache::get_kerning(uint32_t left_code, uint32_t right_code) const {
+    if (!kerning_ || kerning_count_ == 0) {
+        return 0;
+    }
+    
+    const uint32_t left = get_char_offset(left_code);
+    const uint32_t right = get_char_offset(right_code);
+    if (left >= glyph_count_ || right >= glyph_count_) {
+        return 0;
+    }
+    
+    // 按 (左, 右) 二分查找
+    const uint32_t key = (left << 16) | right;
+    uint32_t lo = 0;
+    uint32_t hi = kerning_count_;
+    while (lo < hi) {
+        const uint32_t mid = (lo + hi) / 2;
+        const uint8_t* pair = kerning_ + mid * sizeof(KerningPair);
+        const uint32_t pair_key = (static_cast<uint32_t>(read_u16(pair)) << 16) | read_u16(pair + 2);
+        if (pair_key == key) {
+            return static_cast<int8_t>(pair[4]);
+        }
+        if (pair_key < key) {
+            lo = mid + 1;
+        } else {
+            hi = mid;
+        }
+    }
+    return 0;
+}
+
+bool FlashFontCache::has_advances() const {
+    return advances_ != nullptr;
+}
+
+bool FlashFontCache::has_kerning() const {
+    return kerning_ != nullptr && kerning_count_ > 0;
+}
+
+bool FlashFontCache::decode_glyph(const uint8_t* record, size_t length, 
+                                  int width, int height, int bpp, 
+                                  const uint8_t* model, uint8_t* dst) {
+    if (!record || length == 0 || (bpp != 1 && bpp != 2)) {
+        return false;
+    }
+    
+    const size_t stride = static_cast<size_t>((width * bpp + 7) / 8);
+    const size_t bytes = stride * height;
+    
+    switch (record[0]) {
+        case GLYPH_EMPTY:
+            std::memset(dst, 0, bytes);
+            return true;
+        
+        case GLYPH_RAW:
+            if (length - 1 < bytes) {
+                return false;
+            }
+            std::memcpy(dst, record + 1, bytes);
+            return true;
+        
+        case GLYPH_RLE: {
+            // 游程按行连续覆盖整个字形，0值游程只需前进
+            std::memset(dst, 0, bytes);
+            const uint8_t mask = static_cast<uint8_t>((1 << bpp) - 1);
+            int row = 0;
+            int col = 0;
+            for (size_t i = 1; i < length; i++) {
+                const uint8_t value = static_cast<uint8_t>((record[i] >> 6) & mask);
+                int run = (record[i] & 0x3F) + 1;
+                while (run-- > 0) {
+                    if (row >= height) {
+                        return false;
+                    }
+                    if (value) {
+                        const int bit = col * bpp;
+                        dst[row * stride + (bit >> 3)] |= static_cast<uint8_t>(value << (8 - bpp - (bit & 7)));
+                    }
+                    if (++col == width) {
+                        col = 0;
+                        row++;
+                    }
+                }
+            }
+            return row == height && col == 0;
+        }
+        
+        case GLYPH_CONTEXT:
+            std::memset(dst, 0, bytes);
+            return decode_context(record + 1, length - 1, width, height, bpp, model, dst, stride);
+        
+        default:
+            return false;
+    }
+}
+
+void FlashFontCache::clear_cache() {
+    // 排队中的字形属于旧的字体数据
+    cancel_prefetch();
+    for (uint16_t i = 0; i < HASH_SIZE; i++) {
+        hash_[i] = NO_SLOT;
+    }
+    lru_head_ = NO_SLOT;
+    lru_tail_ = NO_SLOT;
+    used_slots_ = 0;
+}
+
+GlyphCacheStats FlashFontCache::get_cache_stats() const {
+    return stats_;
+}
+
+void FlashFontCache::reset_cache_stats() {
+    stats_ = GlyphCacheStats{0, 0, 0, 0};
+}
+
+uint16_t FlashFontCache::get_cached_glyph_count() const {
+    return used_slots_;
+}
+
 // 初始化Flash字体缓存
 bool FlashFontCache::initialize(const uint8_t* flash_addr, int font_size) {
     if (!flash_addr) {
@@ -31,8 +579,65 @@ bool FlashFontCache::initialize(const uint8_t* flash_addr, int font_size) {
         return false;
     }
     
+    // 版本2文件头自带字形格式；版本1（及未烧录的Flash）为 font_size x font_size 1bpp
+    FontHeaderV2 header;
+    std::memcpy(&header, flash_addr, sizeof(header));
+    uint16_t version = 1;
+    int width = font_size;
+    int height = font_size;
+    int bpp = 1;
+    if (header.version == 2) {
+        version = 2;
+        width = header.width;
+        height = header.height;
+        bpp = header.bpp;
+        if (width == 0 || height == 0 || (bpp != 1 && bpp != 2)) {
+            return false;
+        }
+    }
+    
+    const size_t glyph_bytes = static_cast<size_t>((width * bpp + 7) / 8) * height;
+    if (glyph_bytes > SLOT_BYTES) {
+        printf("[FlashFontCache] 字形 %dx%d %dbpp 需要 %zu 字节，缓存槽只有 %zu 字节\n",
+               width, height, bpp, glyph_bytes, SLOT_BYTES);
+        return false;
+    }
+    
+    // 字体数据或格式变化后旧的字形全部失效
+    if (flash_addr != flash_data_ || font_size != font_size_ || version != version_ ||
+        width != glyph_width_ || height != glyph_height_ || bpp != bpp_) {
+        clear_cache();
+    }
+    
     flash_data_ = flash_addr;
     font_size_ = font_size;
+    version_ = version;
+    glyph_width_ = static_cast<uint8_t>(width);
+    glyph_height_ = static_cast<uint8_t>(height);
+    bpp_ = static_cast<uint8_t>(bpp);
+    glyph_bytes_ = glyph_bytes;
+    glyph_count_ = (version == 2) ? header.glyph_count : 0;
+    index_offset_ = (version == 2) ? header.index_offset : 0;
+    data_offset_ = (version == 2) ? header.data_offset : 0;
+    
+    // 可选区段按顺序排在文件头之后
+    const uint8_t* section = flash_addr + sizeof(FontHeaderV2);
+    model_ = nullptr;
+    advances_ = nullptr;
+    kerning_ = nullptr;
+    kerning_count_ = 0;
+    if (version == 2 && (header.flags & FONT_FLAG_CONTEXT_MODEL)) {
+        model_ = section;
+        section += ((1u << bpp) - 1) * FONT_CONTEXT_COUNT;
+    }
+    if (version == 2 && (header.flags & FONT_FLAG_ADVANCES)) {
+        advances_ = section;
+        section += header.glyph_count;
+    }
+    if (version == 2 && (header.flags & FONT_FLAG_KERNING)) {
+        kerning_count_ = read_u16(section);
+        kerning_ = section + 2;
+    }
     initialized_ = true;
     
     return true;
@@ -48,33 +653,39 @@ int FlashFontCache::get_font_size() const {
     return font_size_;
 }
 
-// 从Flash中读取字符位图数据
-std::vector<uint8_t> FlashFontCache::get_char_bitmap(uint16_t char_code) const {
+int FlashFontCache::get_glyph_width() const {
+    return glyph_width_;
+}
+
+int FlashFontCache::get_glyph_height() const {
+    return glyph_height_;
+}
+
+int FlashFontCache::get_bits_per_pixel() const {
+    return bpp_;
+}
+
+int FlashFontCache::get_glyph_stride() const {
+    return (glyph_width_ * bpp_ + 7) / 8;
+}
+
+// 获取字符位图指针（从SRAM字形缓存，未命中时由缓存从Flash加载）
+const uint8_t* FlashFontCache::get_char_data(uint32_t char_code) const {
     if (!initialized_) {
-        return std::vector<uint8_t>();
+        return nullptr;
     }
     
-    // 获取字符在字体文件中的偏移
-    uint32_t char_offset = get_char_offset(static_cast<uint32_t>(char_code));
-    if (char_offset == UINT32_MAX) {
-        // 不支持的字符，返回空格字符（偏移0）
-        char_offset = 0;
-    }
-    
-    // 计算字节偏移
-    size_t bytes_per_char = (font_size_ == 16) ? BYTES_PER_CHAR_16 : BYTES_PER_CHAR_24;
-    uint32_t byte_offset = sizeof(FontHeader) + char_offset * bytes_per_char;
-    
-    // 从Flash中读取数据
-    const uint8_t* bitmap_data = flash_data_ + byte_offset;
-    std::vector<uint8_t> bitmap(bytes_per_char);
-    
-    // 复制数据
-    for (size_t i = 0; i < bytes_per_char; i++) {
-        bitmap[i] = bitmap_data[i];
+    return lookup_glyph(char_code);
+}
+
+// 读取字符位图数据（兼容接口）
+std::vector<uint8_t> FlashFontCache::get_char_bitmap(uint16_t char_code) const {
+    const uint8_t* bitmap_data = get_char_data(char_code);
+    if (!bitmap_data) {
+        return std::vector<uint8_t>();
     }
     
-    return bitmap;
+    return std::vector<uint8_t>(bitmap_data, bitmap_data + bytes_per_char());
 }
 
 // 验证Flash中的字体文件头
@@ -85,6 +696,18 @@ bool FlashFontCache::verify_font_header() const {
     
     const FontHeader* header = reinterpret_cast<const FontHeader*>(flash_data_);
     
+    // 版本2: 索引和字形记录区必须在文件头之后且互不重叠
+    if (header->version == 2) {
+        const uint32_t index_bytes = ((glyph_count_ / V2_BLOCK_GLYPHS) + 1) * 4 + (glyph_count_ + 1) * 2;
+        uint32_t sections_end = sizeof(FontHeaderV2);
+        if (model_) sections_end += ((1u << bpp_) - 1) * FONT_CONTEXT_COUNT;
+        if (advances_) sections_end += glyph_count_;
+        if (kerning_) sections_end += 2 + kerning_count_ * sizeof(KerningPair);
+        return glyph_count_ > 0 &&
+               index_offset_ >= sections_end &&
+               data_offset_ >= index_offset_ + index_bytes;
+    }
+    
     // 检查版本号
     if (header->version != 1) {
         return false;
@@ -123,6 +746,20 @@ void FlashFontCache::reset() {
     flash_data_ = nullptr;
     font_size_ = 0;
     initialized_ = false;
+    version_ = 1;
+    glyph_width_ = 0;
+    glyph_height_ = 0;
+    bpp_ = 1;
+    glyph_bytes_ = 0;
+    glyph_count_ = 0;
+    index_offset_ = 0;
+    data_offset_ = 0;
+    model_ = nullptr;
+    advances_ = nullptr;
+    kerning_ = nullptr;
+    kerning_count_ = 0;
+    clear_cache();
+    reset_cache_stats();
 }
 
 // 调试功能：打印字符位图
@@ -132,39 +769,32 @@ void FlashFontCache::print_char_bitmap(uint16_t char_code) const {
         return;
     }
     
-    std::vector<uint8_t> bitmap = get_char_bitmap(char_code);
+    const uint8_t* bitmap = get_char_data(char_code);
     
-    if (bitmap.empty()) {
+    if (!bitmap) {
         printf("[ERROR] 无法获取字符 0x%04X 的位图数据\n", char_code);
         return;
     }
     
-    printf("\n=== 字符 0x%04X 点阵数据 ===\n", char_code);
+    printf("\n=== 字符 0x%04X 点阵数据 (%dx%d %dbpp) ===\n", char_code, glyph_width_, glyph_height_, bpp_);
     
-    if (font_size_ == 16) {
-        // 16x16字体，每行2字节
-        for (int row = 0; row < 16; row++) {
-            uint16_t row_data = (bitmap[row * 2] << 8) | bitmap[row * 2 + 1];
-            printf("%02d: ", row);
-            
-            for (int col = 0; col < 16; col++) {
-                char pixel = (row_data & (0x8000 >> col)) ? '#' : '.';
-                printf("%c", pixel);
-            }
-            printf(" (0x%04X)\n", row_data);
-        }
-    } else if (font_size_ == 24) {
-        // 24x24字体，每行3字节
-        for (int row = 0; row < 24; row++) {
-            uint32_t row_data = (bitmap[row * 3] << 16) | (bitmap[row * 3 + 1] << 8) | bitmap[row * 3 + 2];
-            printf("%02d: ", row);
-            
-            for (int col = 0; col < 24; col++) {
-                char pixel = (row_data & (0x800000 >> col)) ? '#' : '.';
-                printf("%c", pixel);
-            }
-            printf(" (0x%06lX)\n", row_data);
+    // 1bpp: '.'/'#'；2bpp按覆盖度: ' ' '.' '+' '#'
+    static const char LEVEL_CHARS[2][4] = {{'.', '#', '#', '#'}, {' ', '.', '+', '#'}};
+    const int stride = get_glyph_stride();
+    for (int row = 0; row < glyph_height_; row++) {
+        const uint8_t* line_data = bitmap + row * stride;
+        printf("%02d: ", row);
+        
+        for (int col = 0; col < glyph_width_; col++) {
+            const int bit = col * bpp_;
+            const int level = (line_data[bit >> 3] >> (8 - bpp_ - (bit & 7))) & ((1 << bpp_) - 1);
+            printf("%c", LEVEL_CHARS[bpp_ - 1][level]);
+        }
+        printf(" (0x");
+        for (int b = 0; b < stride; b++) {
+            printf("%02X", line_data[b]);
         }
+        printf(")\n");
     }
     
     printf("========================\n");
@@ -184,6 +814,7 @@ void FlashFontCache::print_font_info() const {
     
     printf("Flash地址: %p\n", flash_data_);
     printf("字体大小: %dx%d\n", font_size_, font_size_);
+    printf("字形格式: %dx%d %dbpp%s\n", glyph_width_, glyph_height_, bpp_, version_ == 2 ? (model_ ? " (压缩, 上下文模型)" : " (压缩)") : "");
     
     // 显示字体文件头信息
     if (verify_font_header()) {
@@ -191,7 +822,11 @@ void FlashFontCache::print_font_info() const {
         printf("文件头验证: 通过\n");
         printf("版本号: %d\n", header.version);
         printf("字符总数: %d\n", header.char_count);
-        printf("每字符字节数: %zu\n", (font_size_ == 16) ? BYTES_PER_CHAR_16 : BYTES_PER_CHAR_24);
+        printf("每字符字节数: %zu\n", glyph_bytes_);
+        if (version_ == 2) {
+            printf("索引偏移: %lu, 字形数据偏移: %lu\n", (unsigned long)index_offset_, (unsigned long)data_offset_);
+            printf("前进宽度表: %s, 字距调整对: %u\n", advances_ ? "有" : "无", kerning_count_);
+        }
     } else {
         printf("文件头验证: 失败\n");
     }
@@ -231,4 +866,20 @@ void FlashFontCache::print_unicode_ranges() const {
     printf("======================\n");
 }
 
-} // namespace ili9488_font 
\ No newline at end of file
+// 调试功能：打印字形缓存命中率
+void FlashFontCache::print_cache_stats() const {
+    const uint32_t lookups = stats_.hits + stats_.misses;
+    printf("\n=== 字形缓存 ===\n");
+    printf("已缓存: %u/%u 字形 (%zu字节SRAM)\n", used_slots_, CACHE_SLOTS, sizeof(slots_) + sizeof(hash_));
+    printf("命中: %lu, 未命中: %lu, 淘汰: %lu, 预取: %lu\n",
+           (unsigned long)stats_.hits, (unsigned long)stats_.misses, (unsigned long)stats_.evictions,
+           (unsigned long)stats_.prefetched);
+    if (lookups > 0) {
+        printf("命中率: %lu.%lu%%\n",
+               (unsigned long)(stats_.hits * 1000ull / lookups / 10),
+               (unsigned long)(stats_.hits * 1000ull / lookups % 10));
+    }
+    printf("================\n");
+}
+
+} // namespace ili9488_font
\ No newline at end of file
@@ -0,0 +1,130 @@
+#include "glyph_metrics.hpp"
+#include "hybrid_font_renderer.hpp"
+#include <cstdio>
+
+namespace hybrid_font {
+
+GlyphMetrics::GlyphMetrics(std::shared_ptr<IFontDataSource> font_source)
+    : font_source_(font_source), has_kerning_(false), used_blocks_(0) {
+    clear();
+}
+
+void GlyphMetrics::set_font_source(std::shared_ptr<IFontDataSource> font_source) {
+    font_source_ = font_source;
+    clear();
+}
+
+void GlyphMetrics::clear() {
+    for (uint16_t& state : page_state_) {
+        state = PAGE_UNKNOWN;
+    }
+    used_blocks_ = 0;
+    has_kerning_ = font_source_ && font_source_->has_kerning();
+}
+
+int GlyphMetrics::source_advance(uint32_t char_code) const {
+    return font_source_ ? font_source_->get_advance(char_code) : 0;
+}
+
+uint16_t GlyphMetrics::load_page(uint32_t page) {
+    if (!font_source_ || !font_source_->is_valid()) {
+        return PAGE_UNCACHED;
+    }
+    
+    const uint32_t base = page << 8;
+    uint8_t widths[256];
+    bool uniform = true;
+    for (uint32_t i = 0; i < 256; i++) {
+        const int advance = source_advance(base + i);
+        if (advance < 0 || advance > 0xFF) {
+            return PAGE_UNCACHED;
+        }
+        widths[i] = static_cast<uint8_t>(advance);
+        uniform = uniform && widths[i] == widths[0];
+    }
+    
+    if (uniform) {
+        return static_cast<uint16_t>(PAGE_UNIFORM | widths[0]);
+    }
+    if (used_blocks_ >= BLOCK_COUNT) {
+        return PAGE_UNCACHED;
+    }
+    
+    const int block = used_blocks_++;
+    for (int i = 0; i < 256; i++) {
+        blocks_[block][i] = widths[i];
+    }
+    return static_cast<uint16_t>(PAGE_BLOCK | block);
+}
+
+int GlyphMetrics::advance(uint32_t char_code) {
+    // 只缓存BMP，其他平面的字符很少出现
+    if (char_code > 0xFFFF) {
+        return source_advance(char_code);
+    }
+    
+    const uint32_t page = char_code >> 8;
+    uint16_t state = page_state_[page];
+    if (state == PAGE_UNKNOWN) {
+        state = load_page(page);
+        page_state_[page] = state;
+    }
+    
+    switch (state & PAGE_KIND_MASK) {
+        case PAGE_UNIFORM:
+            return state & 0xFF;
+        case PAGE_BLOCK:
+            return blocks_[state & 0xFF][char_code & 0xFF];
+        default:
+            return source_advance(char_code);
+    }
+}
+
+int GlyphMetrics::kerning(uint32_t left_code, uint32_t right_code) const {
+    if (!has_kerning_ || left_code == 0) {
+        return 0;
+    }
+    return font_source_->get_kerning(left_code, right_code);
+}
+
+GlyphMetrics::LineWidth GlyphMetrics::append(LineWidth line, uint32_t char_code) {
+    line.width += kerning(line.last, char_code) + advance(char_code);
+    line.last = char_code;
+    return line;
+}
+
+GlyphMetrics::LineWidth GlyphMetrics::append(LineWidth line, const char* text) {
+    if (!text) {
+        return line;
+    }
+    
+    while (*text) {
+        const uint32_t char_code = decode_utf8(text);
+        if (char_code == 0) {
+            break;
+        }
+        line = append(line, char_code);
+    }
+    return line;
+}
+
+int GlyphMetrics::string_width(const char* text) {
+    return append(LineWidth(), text).width;
+}
+
+void GlyphMetrics::print_stats() const {
+    int uniform = 0;
+    int uncached = 0;
+    for (uint16_t state : page_state_) {
+        if ((state & PAGE_KIND_MASK) == PAGE_UNIFORM) {
+            uniform++;
+        } else if (state == PAGE_UNCACHED) {
+            uncached++;
+        }
+    }
+    
+    printf("[GlyphMetrics] 宽度缓存: 统一宽度页 %d, 逐字符页 %d/%d, 未缓存页 %d, 字距调整: %s\n",
+           uniform, used_blocks_, BLOCK_COUNT, uncached, has_kerning_ ? "有" : "无");
+}
+
+} // namespace hybrid_font
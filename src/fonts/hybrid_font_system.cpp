@@ -4,6 +4,41 @@
 
 namespace hybrid_font {
 
+// ============================================================================
+// IFontDataSource 兼容接口
+// ============================================================================
+
+std::vector<uint8_t> IFontDataSource::get_char_bitmap(uint32_t char_code) const {
+    GlyphView glyph = get_glyph(char_code);
+    if (glyph.empty()) {
+        return std::vector<uint8_t>();
+    }
+    
+    return std::vector<uint8_t>(glyph.data, glyph.data + glyph.size());
+}
+
+int IFontDataSource::get_advance(uint32_t char_code) const {
+    GlyphView glyph = get_glyph(char_code);
+    if (!glyph.empty()) {
+        return glyph.width;
+    }
+    
+    if (char_code >= FontConfig::ASCII_START && char_code <= FontConfig::ASCII_END) {
+        return FontConfig::ASCII_FONT_WIDTH;
+    }
+    return FontConfig::FLASH_FONT_WIDTH;
+}
+
+int IFontDataSource::get_kerning(uint32_t left_code, uint32_t right_code) const {
+    (void)left_code;
+    (void)right_code;
+    return 0;
+}
+
+bool IFontDataSource::has_kerning() const {
+    return false;
+}
+
 // ============================================================================
 // ASCIIFontSource 实现
 // ============================================================================
@@ -12,25 +47,30 @@ ASCIIFontSource::ASCIIFontSource() : initialized_(true) {
     // ASCII字体数据源总是可用的，使用内置字体
 }
 
-std::vector<uint8_t> ASCIIFontSource::get_char_bitmap(uint32_t char_code) const {
-    if (!is_char_supported(char_code)) {
-        return std::vector<uint8_t>();
-    }
+GlyphView ASCIIFontSource::get_glyph(uint32_t char_code) const {
+    GlyphView glyph;
     
-    const uint8_t* font_data = get_ascii_font_data(static_cast<uint8_t>(char_code));
-    if (!font_data) {
-        return std::vector<uint8_t>();
+    // 直接指向内置字库，不复制
+    glyph.data = get_ascii_font_data(static_cast<uint8_t>(char_code));
+    if (!is_char_supported(char_code) || !glyph.data) {
+        return GlyphView();
     }
     
-    // 将字体数据复制到vector中
-    std::vector<uint8_t> bitmap(font_data, font_data + FontConfig::ASCII_BYTES_PER_CHAR);
-    return bitmap;
+    glyph.width = FontConfig::ASCII_FONT_WIDTH;
+    glyph.height = FontConfig::ASCII_FONT_HEIGHT;
+    glyph.stride = 1;
+    return glyph;
 }
 
 bool ASCIIFontSource::is_char_supported(uint32_t char_code) const {
     return char_code >= FontConfig::ASCII_START && char_code <= FontConfig::ASCII_END;
 }
 
+int ASCIIFontSource::get_advance(uint32_t char_code) const {
+    (void)char_code;
+    return FontConfig::ASCII_FONT_WIDTH;
+}
+
 int ASCIIFontSource::get_font_width() const {
     return FontConfig::ASCII_FONT_WIDTH;
 }
@@ -73,12 +113,23 @@ FlashFontSource::FlashFontSource(uint32_t flash_address, int font_size)
     initialize(flash_address, font_size);
 }
 
-std::vector<uint8_t> FlashFontSource::get_char_bitmap(uint32_t char_code) const {
+GlyphView FlashFontSource::get_glyph(uint32_t char_code) const {
     if (!initialized_) {
-        return std::vector<uint8_t>();
+        return GlyphView();
     }
     
-    return cache_.get_char_bitmap(static_cast<uint16_t>(char_code));
+    // 指向SRAM字形缓存中的位图（未命中时从Flash加载一次）
+    GlyphView glyph;
+    glyph.data = cache_.get_char_data(char_code);
+    if (!glyph.data) {
+        return GlyphView();
+    }
+    
+    glyph.width = static_cast<uint8_t>(cache_.get_glyph_width());
+    glyph.height = static_cast<uint8_t>(cache_.get_glyph_height());
+    glyph.stride = static_cast<uint8_t>(cache_.get_glyph_stride());
+    glyph.bpp = static_cast<uint8_t>(cache_.get_bits_per_pixel());
+    return glyph;
 }
 
 bool FlashFontSource::is_char_supported(uint32_t char_code) const {
@@ -89,12 +140,34 @@ bool FlashFontSource::is_char_supported(uint32_t char_code) const {
     return cache_.is_char_supported(char_code);
 }
 
+int FlashFontSource::get_advance(uint32_t char_code) const {
+    if (!initialized_) {
+        return FontConfig::FLASH_FONT_WIDTH;
+    }
+    
+    // 版本2字体可带逐字形宽度表，否则为字形宽度
+    return cache_.get_advance(char_code);
+}
+
+int FlashFontSource::get_kerning(uint32_t left_code, uint32_t right_code) const {
+    if (!initialized_) {
+        return 0;
+    }
+    
+    return cache_.get_kerning(left_code, right_code);
+}
+
+bool FlashFontSource::has_kerning() const {
+    return initialized_ && cache_.has_kerning();
+}
+
 int FlashFontSource::get_font_width() const {
-    return FontConfig::FLASH_FONT_WIDTH;
+    // 加载后报告字体文件中的实际字形尺寸
+    return initialized_ ? cache_.get_glyph_width() : FontConfig::FLASH_FONT_WIDTH;
 }
 
 int FlashFontSource::get_font_height() const {
-    return FontConfig::FLASH_FONT_HEIGHT;
+    return initialized_ ? cache_.get_glyph_height() : FontConfig::FLASH_FONT_HEIGHT;
 }
 
 int FlashFontSource::get_bytes_per_char() const {
@@ -153,15 +226,15 @@ HybridFontSource::HybridFontSource(uint32_t flash_address) : initialized_(false)
     initialize(flash_address);
 }
 
-std::vector<uint8_t> HybridFontSource::get_char_bitmap(uint32_t char_code) const {
+GlyphView HybridFontSource::get_glyph(uint32_t char_code) const {
     if (!initialized_) {
-        return std::vector<uint8_t>();
+        return GlyphView();
     }
     
     if (should_use_ascii_font(char_code)) {
-        return ascii_source_->get_char_bitmap(char_code);
+        return ascii_source_->get_glyph(char_code);
     } else {
-        return flash_source_->get_char_bitmap(char_code);
+        return flash_source_->get_glyph(char_code);
     }
 }
 
@@ -177,14 +250,42 @@ bool HybridFontSource::is_char_supported(uint32_t char_code) const {
     }
 }
 
+int HybridFontSource::get_advance(uint32_t char_code) const {
+    if (should_use_ascii_font(char_code)) {
+        return ascii_source_->get_advance(char_code);
+    } else {
+        return flash_source_->get_advance(char_code);
+    }
+}
+
+int HybridFontSource::get_kerning(uint32_t left_code, uint32_t right_code) const {
+    if (!initialized_) {
+        return 0;
+    }
+    
+    // 字距表属于Flash字体，内置ASCII字体的字符不参与
+    if (should_use_ascii_font(left_code) || should_use_ascii_font(right_code)) {
+        return 0;
+    }
+    return flash_source_->get_kerning(left_code, right_code);
+}
+
+bool HybridFontSource::has_kerning() const {
+    return initialized_ && flash_source_->has_kerning();
+}
+
 int HybridFontSource::get_font_width() const {
-    // 混合字体系统返回最大宽度
-    return FontConfig::FLASH_FONT_WIDTH;
+    // 混合字体系统返回两种字体中的最大宽度（Flash字体按实际加载的尺寸）
+    const int ascii_width = ascii_source_->get_font_width();
+    const int flash_width = flash_source_->get_font_width();
+    return ascii_width > flash_width ? ascii_width : flash_width;
 }
 
 int HybridFontSource::get_font_height() const {
-    // 混合字体系统返回最大高度
-    return FontConfig::FLASH_FONT_HEIGHT;
+    // 混合字体系统返回最高字形的高度：ASCII 16 与Flash字体字形高度取大
+    const int ascii_height = ascii_source_->get_font_height();
+    const int flash_height = flash_source_->get_font_height();
+    return ascii_height > flash_height ? ascii_height : flash_height;
 }
 
 int HybridFontSource::get_bytes_per_char() const {
@@ -245,6 +346,10 @@ const FlashFontSource& HybridFontSource::get_flash_source() const {
     return *flash_source_;
 }
 
+FlashFontSource& HybridFontSource::get_flash_source() {
+    return *flash_source_;
+}
+
 bool HybridFontSource::should_use_ascii_font(uint32_t char_code) const {
     // ASCII字符范围使用ASCII字体
     return char_code >= FontConfig::ASCII_START && char_code <= FontConfig::ASCII_END;
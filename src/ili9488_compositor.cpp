@@ -0,0 +1,193 @@
+/**
+ * @file ili9488_compositor.cpp
+ * @brief Scanline compositor implementation
+ */
+
+#include "ili9488_compositor.hpp"
+#include "ili9488_colors.hpp"
+
+#include <cstring>
+#include "pico/time.h"
+
+namespace ili9488 {
+
+namespace {
+
+inline int32_t wrapCoordinate(int32_t value, int32_t period) {
+    const int32_t r = value % period;
+    return r < 0 ? r + period : r;
+}
+
+inline void fillLine(uint16_t* line, int32_t count, uint16_t color) {
+    while (count-- > 0) *line++ = color;
+}
+
+} // namespace
+
+// === Scene setup ===
+
+bool ScanlineCompositor::setTileMap(const TileAtlas* atlas, const uint8_t* map, uint16_t columns, uint16_t rows) {
+    const bool valid = atlas && atlas->pixels && atlas->tile_count > 0 &&
+                       atlas->tile_width > 0 && atlas->tile_height > 0 &&
+                       map && columns > 0 && rows > 0;
+    atlas_ = valid ? atlas : nullptr;
+    map_ = valid ? map : nullptr;
+    map_columns_ = valid ? columns : 0;
+    map_rows_ = valid ? rows : 0;
+    return valid;
+}
+
+void ScanlineCompositor::clearTileMap() {
+    setTileMap(nullptr, nullptr, 0, 0);
+}
+
+int ScanlineCompositor::addSprite(const Sprite& sprite, int16_t x, int16_t y) {
+    for (int i = 0; i < MAX_SPRITES; ++i) {
+        if (!sprites_[i].used) {
+            sprites_[i].sprite = sprite;
+            sprites_[i].x = x;
+            sprites_[i].y = y;
+            sprites_[i].used = true;
+            sprites_[i].visible = true;
+            return i;
+        }
+    }
+    return -1;
+}
+
+void ScanlineCompositor::moveSprite(int handle, int16_t x, int16_t y) {
+    if (handle < 0 || handle >= MAX_SPRITES) return;
+    sprites_[handle].x = x;
+    sprites_[handle].y = y;
+}
+
+void ScanlineCompositor::setSpriteImage(int handle, const Sprite& sprite) {
+    if (handle < 0 || handle >= MAX_SPRITES) return;
+    sprites_[handle].sprite = sprite;
+}
+
+void ScanlineCompositor::showSprite(int handle, bool visible) {
+    if (handle < 0 || handle >= MAX_SPRITES) return;
+    sprites_[handle].visible = visible;
+}
+
+void ScanlineCompositor::removeSprite(int handle) {
+    if (handle < 0 || handle >= MAX_SPRITES) return;
+    sprites_[handle] = SpriteSlot();
+}
+
+void ScanlineCompositor::clearSprites() {
+    for (auto& slot : sprites_) {
+        slot = SpriteSlot();
+    }
+}
+
+// === Line composition ===
+
+void ScanlineCompositor::composeBackground(uint16_t* line, int16_t x0, int16_t w, int16_t y) const {
+    if (!map_) {
+        fillLine(line, w, background_);
+        return;
+    }
+
+    const int32_t tw = atlas_->tile_width;
+    const int32_t th = atlas_->tile_height;
+    const int32_t my = wrapCoordinate(y + scroll_y_, static_cast<int32_t>(map_rows_) * th);
+    const int32_t mx = wrapCoordinate(x0 + scroll_x_, static_cast<int32_t>(map_columns_) * tw);
+    const uint8_t* map_row = map_ + static_cast<size_t>(my / th) * map_columns_;
+    const uint8_t tile_row = static_cast<uint8_t>(my % th);
+
+    // Copy one tile row segment at a time; only the first segment starts mid-tile
+    int32_t column = mx / tw;
+    int32_t offset = mx % tw;
+    for (int32_t out = 0; out < w;) {
+        const int32_t n = (tw - offset) < (w - out) ? (tw - offset) : (w - out);
+        const uint8_t tile = map_row[column];
+        if (tile < atlas_->tile_count) {
+            std::memcpy(line + out, atlas_->tileRow(tile, tile_row) + offset, static_cast<size_t>(n) * 2);
+        } else {
+            fillLine(line + out, n, background_);
+        }
+        out += n;
+        offset = 0;
+        if (++column == map_columns_) column = 0;
+    }
+}
+
+uint32_t ScanlineCompositor::composeSprites(uint16_t* line, int16_t x0, int16_t w, int16_t y,
+                                            const uint8_t* active, uint8_t active_count) const {
+    uint32_t spans = 0;
+    for (uint8_t i = 0; i < active_count; ++i) {
+        const SpriteSlot& slot = sprites_[active[i]];
+        const Sprite& sprite = slot.sprite;
+        const int32_t row = y - slot.y;
+        if (row < 0 || row >= sprite.height) continue;
+
+        const int32_t left = slot.x > x0 ? slot.x : x0;
+        const int32_t right = (slot.x + sprite.width) < (x0 + w) ? (slot.x + sprite.width) : (x0 + w);
+        if (left >= right) continue;
+
+        const uint16_t* src = sprite.row(static_cast<int16_t>(row)) + (left - slot.x);
+        uint16_t* dst = line + (left - x0);
+        const int32_t count = right - left;
+        if (!sprite.has_key) {
+            std::memcpy(dst, src, static_cast<size_t>(count) * 2);
+        } else {
+            const uint16_t key = sprite.key;
+            for (int32_t j = 0; j < count; ++j) {
+                if (src[j] != key) dst[j] = src[j];
+            }
+        }
+        ++spans;
+    }
+    return spans;
+}
+
+// === Output ===
+
+void ScanlineCompositor::render(ILI9488_UI& display) {
+    render(display, 0, 0, display.width(), display.height());
+}
+
+void ScanlineCompositor::render(ILI9488_UI& display, int16_t x, int16_t y, int16_t w, int16_t h) {
+    // Clip the region to the display
+    int32_t x0 = x, y0 = y, x1 = x + w, y1 = y + h;
+    if (x0 < 0) x0 = 0;
+    if (y0 < 0) y0 = 0;
+    if (x1 > display.width()) x1 = display.width();
+    if (y1 > display.height()) y1 = display.height();
+    if (x1 - x0 > MAX_LINE_WIDTH) x1 = x0 + MAX_LINE_WIDTH;
+    stats_ = Stats();
+    if (x0 >= x1 || y0 >= y1) return;
+
+    const uint64_t start = time_us_64();
+    const int16_t cw = static_cast<int16_t>(x1 - x0);
+
+    // Sprites that can touch the region this frame, in drawing order
+    uint8_t active[MAX_SPRITES];
+    uint8_t active_count = 0;
+    for (uint8_t i = 0; i < MAX_SPRITES; ++i) {
+        const SpriteSlot& slot = sprites_[i];
+        if (!slot.used || !slot.visible || !slot.sprite.pixels) continue;
+        if (slot.x + slot.sprite.width <= x0 || slot.x >= x1) continue;
+        if (slot.y + slot.sprite.height <= y0 || slot.y >= y1) continue;
+        active[active_count++] = i;
+    }
+
+    display.setAddrWindow(static_cast<int16_t>(x0), static_cast<int16_t>(y0), cw, static_cast<int16_t>(y1 - y0));
+    for (int32_t line_y = y0; line_y < y1; ++line_y) {
+        const int16_t ly = static_cast<int16_t>(line_y);
+        composeBackground(compose_, static_cast<int16_t>(x0), cw, ly);
+        stats_.sprite_spans += composeSprites(compose_, static_cast<int16_t>(x0), cw, ly, active, active_count);
+
+        // This buffer last held line N-2, whose transfer ended before line N-1 started
+        uint8_t* wire = lines_[line_y & 1];
+        ili9488_colors::rgb565_to_wire(compose_, wire, cw);
+        display.writePixelDataAsync(wire, static_cast<size_t>(cw) * 3);
+        ++stats_.lines;
+    }
+    display.waitPixelData();
+    stats_.last_frame_us = static_cast<uint32_t>(time_us_64() - start);
+}
+
+} // namespace ili9488
@@ -0,0 +1,334 @@
+/**
+ * @file ili9488_console.cpp
+ * @brief Text-mode console implementation
+ */
+
+#include "ili9488_console.hpp"
+#include "ili9488_colors.hpp"
+
+#include <cstdarg>
+#include <cstdio>
+#include <cstring>
+#include "pico/time.h"
+
+namespace ili9488 {
+
+namespace {
+
+using ili9488_colors::color565;
+using ili9488_colors::rgb565_to_wire;
+
+// Standard 16-colour VGA text palette
+constexpr uint16_t DEFAULT_PALETTE[TextConsole::PALETTE_SIZE] = {
+    color565(0x00, 0x00, 0x00), color565(0x00, 0x00, 0xAA), color565(0x00, 0xAA, 0x00), color565(0x00, 0xAA, 0xAA),
+    color565(0xAA, 0x00, 0x00), color565(0xAA, 0x00, 0xAA), color565(0xAA, 0x55, 0x00), color565(0xAA, 0xAA, 0xAA),
+    color565(0x55, 0x55, 0x55), color565(0x55, 0x55, 0xFF), color565(0x55, 0xFF, 0x55), color565(0x55, 0xFF, 0xFF),
+    color565(0xFF, 0x55, 0x55), color565(0xFF, 0x55, 0xFF), color565(0xFF, 0xFF, 0x55), color565(0xFF, 0xFF, 0xFF)
+};
+
+} // namespace
+
+// === Setup ===
+
+bool TextConsole::begin(ILI9488_UI& display, int16_t top, uint16_t rows) {
+    display_ = nullptr;
+    if (top < 0 || top >= display.height()) return false;
+    const int16_t available = static_cast<int16_t>(display.height() - top);
+    if (rows == 0) rows = static_cast<uint16_t>(available / CELL_HEIGHT);
+    if (rows == 0 || rows > MAX_ROWS || rows * CELL_HEIGHT > available) return false;
+
+    display_ = &display;
+    top_ = top;
+    rows_ = rows;
+    columns_ = static_cast<uint16_t>(display.width() / CELL_WIDTH);
+    if (columns_ > MAX_COLUMNS) columns_ = MAX_COLUMNS;
+
+    std::memcpy(palette_, DEFAULT_PALETTE, sizeof(palette_));
+    for (auto& attr : table_attr_) attr = -1;
+    cursor_column_ = cursor_row_ = 0;
+    scroll_row_ = shown_scroll_row_ = 0;
+    head_.store(0, std::memory_order_relaxed);
+    tail_.store(0, std::memory_order_relaxed);
+    resetStats();
+
+    // The scroll area is exactly the console band
+    hardware_scroll_ = display.setScrollMargins(top, static_cast<int16_t>(available - rows * CELL_HEIGHT));
+
+    for (uint16_t row = 0; row < rows_; ++row) {
+        for (uint16_t column = 0; column < columns_; ++column) {
+            cells_[row][column] = Cell{' ', attr_};
+        }
+    }
+    markAllDirty();
+    return true;
+}
+
+void TextConsole::setPalette(uint8_t index, uint16_t color) {
+    if (index >= PALETTE_SIZE || palette_[index] == color) return;
+    palette_[index] = color;
+    for (auto& attr : table_attr_) attr = -1;
+
+    for (uint16_t row = 0; row < rows_; ++row) {
+        for (uint16_t column = 0; column < columns_; ++column) {
+            const uint8_t attr = cells_[row][column].attr;
+            if ((attr >> 4) == index || (attr & 0x0F) == index) {
+                dirty_[row] |= 1ull << column;
+            }
+        }
+    }
+}
+
+void TextConsole::markAllDirty() {
+    const uint64_t all = columns_ >= 64 ? ~0ull : (1ull << columns_) - 1;
+    for (uint16_t row = 0; row < MAX_ROWS; ++row) {
+        dirty_[row] = row < rows_ ? all : 0;
+    }
+}
+
+// === Writing ===
+
+size_t TextConsole::write(const char* text, size_t length) {
+    if (!text) return 0;
+    const uint32_t head = head_.load(std::memory_order_relaxed);
+    const uint32_t tail = tail_.load(std::memory_order_acquire);
+    const uint32_t room = QUEUE_SIZE - (head - tail);
+    const size_t n = length < room ? length : room;
+
+    const uint16_t attr = static_cast<uint16_t>(attr_ << 8);
+    for (size_t i = 0; i < n; ++i) {
+        queue_[(head + i) & (QUEUE_SIZE - 1)] = static_cast<uint16_t>(attr | static_cast<uint8_t>(text[i]));
+    }
+    head_.store(head + static_cast<uint32_t>(n), std::memory_order_release);
+
+    // Single producer: load + store is enough (no read-modify-write atomics on the M0+)
+    queued_.store(queued_.load(std::memory_order_relaxed) + static_cast<uint32_t>(n), std::memory_order_relaxed);
+    if (n < length) {
+        dropped_.store(dropped_.load(std::memory_order_relaxed) + static_cast<uint32_t>(length - n),
+                       std::memory_order_relaxed);
+    }
+    return n;
+}
+
+size_t TextConsole::write(const char* text) {
+    return text ? write(text, std::strlen(text)) : 0;
+}
+
+// === Statistics ===
+
+TextConsole::Stats TextConsole::stats() const {
+    Stats snapshot = stats_;
+    snapshot.queued = queued_.load(std::memory_order_relaxed);
+    snapshot.dropped = dropped_.load(std::memory_order_relaxed);
+    return snapshot;
+}
+
+void TextConsole::resetStats() {
+    stats_ = Stats();
+    queued_.store(0, std::memory_order_relaxed);
+    dropped_.store(0, std::memory_order_relaxed);
+}
+
+int TextConsole::printf(const char* format, ...) {
+    char buffer[256];
+    va_list args;
+    va_start(args, format);
+    const int length = vsnprintf(buffer, sizeof(buffer), format, args);
+    va_end(args);
+    if (length <= 0) return length;
+    const size_t n = static_cast<size_t>(length) < sizeof(buffer) ? static_cast<size_t>(length) : sizeof(buffer) - 1;
+    return static_cast<int>(write(buffer, n));
+}
+
+// === Grid ===
+
+void TextConsole::putCell(uint16_t column, uint16_t row, uint8_t ch, uint8_t attr) {
+    Cell& cell = cells_[row][column];
+    if (cell.ch != ch || cell.attr != attr) {
+        cell.ch = ch;
+        cell.attr = attr;
+        dirty_[row] |= 1ull << column;
+    }
+}
+
+void TextConsole::clearRow(uint16_t row, uint8_t attr) {
+    for (uint16_t column = 0; column < columns_; ++column) {
+        putCell(column, row, ' ', attr);
+    }
+}
+
+void TextConsole::newline(uint8_t attr) {
+    cursor_column_ = 0;
+    if (cursor_row_ + 1 < rows_) {
+        ++cursor_row_;
+        return;
+    }
+
+    // Bottom row: the oldest physical row becomes the new bottom row
+    scroll_row_ = static_cast<uint16_t>((scroll_row_ + 1) % rows_);
+    clearRow(physicalRow(rows_ - 1), attr);
+    if (hardware_scroll_) {
+        ++stats_.hardware_scrolls;
+    } else {
+        ++stats_.redraw_scrolls;
+    }
+}
+
+void TextConsole::apply(uint8_t ch, uint8_t attr) {
+    switch (ch) {
+        case '\n':
+            newline(attr);
+            ++stats_.lines;
+            return;
+        case '\r':
+            cursor_column_ = 0;
+            return;
+        case '\t':
+            do {
+                apply(' ', attr);
+            } while (cursor_column_ % 8 != 0 && cursor_column_ < columns_);
+            return;
+        case '\b':
+            if (cursor_column_ > 0) --cursor_column_;
+            return;
+        case '\f':
+            for (uint16_t row = 0; row < rows_; ++row) {
+                clearRow(row, attr);
+            }
+            cursor_column_ = cursor_row_ = 0;
+            return;
+        default:
+            break;
+    }
+
+    // Wrap lazily so that a full line followed by '\n' does not leave a blank row
+    if (cursor_column_ >= columns_) newline(attr);
+    putCell(cursor_column_, physicalRow(cursor_row_), ch, attr);
+    ++cursor_column_;
+}
+
+// === Output ===
+
+uint8_t TextConsole::tableSlot(uint8_t attr, uint8_t claimed) {
+    for (uint8_t i = 0; i < TABLE_CACHE; ++i) {
+        if (table_attr_[i] == attr) return i;
+    }
+
+    // Round-robin replacement, never a slot the current run already uses
+    uint8_t slot = table_next_;
+    while (claimed & (1u << slot)) slot = static_cast<uint8_t>((slot + 1) % TABLE_CACHE);
+    table_next_ = static_cast<uint8_t>((slot + 1) % TABLE_CACHE);
+
+    uint8_t fg[3], bg[3];
+    rgb565_to_wire(palette_[attr >> 4], fg);
+    rgb565_to_wire(palette_[attr & 0x0F], bg);
+    for (uint8_t n = 0; n < 16; ++n) {
+        for (uint8_t bit = 0; bit < 4; ++bit) {
+            std::memcpy(&tables_[slot][n][bit * 3], (n & (0x8 >> bit)) ? fg : bg, 3);
+        }
+    }
+    table_attr_[slot] = attr;
+    return slot;
+}
+
+uint16_t TextConsole::drawRun(uint16_t physical_row, uint16_t column, uint16_t count) {
+    const Cell* cells = &cells_[physical_row][column];
+
+    // One expansion table per attribute; the run ends early rather than exceed the cache
+    const uint8_t* glyphs[MAX_COLUMNS];
+    const uint8_t* tables[MAX_COLUMNS];
+    uint8_t attrs[TABLE_CACHE];
+    uint8_t slots[TABLE_CACHE];
+    uint8_t attr_count = 0;
+    uint8_t claimed = 0;
+    uint16_t n = 0;
+    for (; n < count; ++n) {
+        const uint8_t attr = cells[n].attr;
+        uint8_t k = 0;
+        while (k < attr_count && attrs[k] != attr) ++k;
+        if (k == attr_count) {
+            if (attr_count == TABLE_CACHE) break;
+            attrs[k] = attr;
+            slots[k] = tableSlot(attr, claimed);
+            claimed |= static_cast<uint8_t>(1u << slots[k]);
+            ++attr_count;
+        }
+        glyphs[n] = font::get_char_data(static_cast<char>(cells[n].ch));
+        tables[n] = &tables_[slots[k]][0][0];
+    }
+
+    // With hardware scrolling rows stay put in frame memory; otherwise they are drawn where they are seen
+    const uint16_t slot_row = hardware_scroll_ ? physical_row
+                                               : static_cast<uint16_t>((physical_row + rows_ - scroll_row_) % rows_);
+    const int32_t line_bytes = n * CELL_WIDTH * 3;
+    display_->setAddrWindow(static_cast<int16_t>(column * CELL_WIDTH), static_cast<int16_t>(top_ + slot_row * CELL_HEIGHT),
+                            static_cast<int16_t>(n * CELL_WIDTH), CELL_HEIGHT);
+
+    // Whole glyph lines per transfer, as many as fit in a buffer
+    const int32_t lines_per_chunk = static_cast<int32_t>(sizeof(lines_[0])) / line_bytes;
+    for (int32_t line = 0; line < CELL_HEIGHT;) {
+        const int32_t chunk = (CELL_HEIGHT - line) < lines_per_chunk ? (CELL_HEIGHT - line) : lines_per_chunk;
+        uint8_t* wire = lines_[current_];
+        uint8_t* out = wire;
+        for (int32_t j = 0; j < chunk; ++j, ++line) {
+            for (uint16_t i = 0; i < n; ++i) {
+                const uint8_t bits = glyphs[i][line];
+                std::memcpy(out, tables[i] + (bits >> 4) * 12, 12);
+                std::memcpy(out + 12, tables[i] + (bits & 0x0F) * 12, 12);
+                out += 24;
+            }
+        }
+        // This buffer was last used two transfers ago, which has completed
+        display_->writePixelDataAsync(wire, static_cast<size_t>(out - wire));
+        current_ ^= 1;
+    }
+
+    stats_.last_cells += n;
+    stats_.last_bytes += static_cast<uint32_t>(line_bytes) * CELL_HEIGHT;
+    return n;
+}
+
+void TextConsole::flush() {
+    if (!display_) return;
+    const uint64_t start = time_us_64();
+    stats_.last_cells = stats_.last_bytes = 0;
+
+    // Apply everything queued so far; text that scrolls away here is never drawn
+    uint32_t tail = tail_.load(std::memory_order_relaxed);
+    const uint32_t head = head_.load(std::memory_order_acquire);
+    while (tail != head) {
+        const uint16_t entry = queue_[tail & (QUEUE_SIZE - 1)];
+        apply(static_cast<uint8_t>(entry & 0xFF), static_cast<uint8_t>(entry >> 8));
+        ++tail;
+    }
+    tail_.store(tail, std::memory_order_release);
+
+    if (scroll_row_ != shown_scroll_row_) {
+        if (hardware_scroll_) {
+            display_->scrollTo(static_cast<int16_t>(top_ + scroll_row_ * CELL_HEIGHT));
+        } else {
+            markAllDirty();
+        }
+        shown_scroll_row_ = scroll_row_;
+    }
+
+    // Runs of damaged cells, one window each
+    for (uint16_t row = 0; row < rows_; ++row) {
+        uint64_t mask = dirty_[row];
+        uint16_t column = 0;
+        while (mask >> column) {
+            while (!((mask >> column) & 1)) ++column;
+            uint16_t end = column;
+            while (end < columns_ && ((mask >> end) & 1)) ++end;
+            while (column < end) {
+                column = static_cast<uint16_t>(column + drawRun(row, column, static_cast<uint16_t>(end - column)));
+            }
+            if (column >= 64) break;
+        }
+        dirty_[row] = 0;
+    }
+
+    display_->waitPixelData();
+    stats_.last_flush_us = static_cast<uint32_t>(time_us_64() - start);
+}
+
+} // namespace ili9488
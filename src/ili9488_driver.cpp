@@ -33,6 +33,8 @@ namespace Commands {
     constexpr uint8_t PTLON   = 0x12;
     constexpr uint8_t PTLOFF  = 0x13;
     constexpr uint8_t PTLAR   = 0x30;
+    constexpr uint8_t VSCRDEF = 0x33;
+    constexpr uint8_t VSCRSADD = 0x37;
 }
 
 struct ILI9488Driver::Impl {
@@ -52,6 +54,10 @@ struct ILI9488Driver::Impl {
     FontLayout font_layout_ = FontLayout::Vertical;
     bool partial_mode_ = false;
     
+    // Hardware scroll area (screen lines, current rotation)
+    uint16_t scroll_top_fixed_ = 0;
+    uint16_t scroll_bottom_fixed_ = 0;
+    
     // DMA support
     int dma_channel_ = -1;
     volatile bool dma_busy_ = false;
@@ -113,8 +119,38 @@ struct ILI9488Driver::Impl {
         setCS(true);
     }
     
+    // Stream one pixel value repeatedly with CS held low for the whole run
+    void writeRepeatedPixel(const uint8_t* pixel, uint32_t count) {
+        if (count == 0) return;
+        
+        constexpr uint32_t CHUNK_PIXELS = 128;
+        uint8_t chunk[CHUNK_PIXELS * 3];
+        const uint32_t fill_pixels = std::min(count, CHUNK_PIXELS);
+        for (uint32_t i = 0; i < fill_pixels; ++i) {
+            chunk[i * 3 + 0] = pixel[0];
+            chunk[i * 3 + 1] = pixel[1];
+            chunk[i * 3 + 2] = pixel[2];
+        }
+        
+        setCS(false);
+        setDC(true);   // Data mode
+        
+        while (count > 0) {
+            const uint32_t n = std::min(count, CHUNK_PIXELS);
+            spi_write_blocking(spi_inst_, chunk, n * 3);
+            count -= n;
+        }
+        
+        setCS(true);
+    }
+    
     // DMA completion callback
     void dmaCompleteHandler() {
+        // The channel finishes when the last byte enters the SPI FIFO; keep CS
+        // low until it has actually been shifted out
+        while (spi_is_busy(spi_inst_)) {
+            tight_loop_contents();
+        }
         setCS(true);
         dma_busy_ = false;
         dma_channel_acknowledge_irq0(dma_channel_);
@@ -451,6 +487,16 @@ void ILI9488Driver::writePixels(uint16_t x0, uint16_t y0, uint16_t x1, uint16_t
     }
 }
 
+// Open a drawing window for raw pixel streaming
+void ILI9488Driver::setWindow(uint16_t x0, uint16_t y0, uint16_t x1, uint16_t y1) {
+    pImpl_->setWindow(x0, y0, x1, y1);
+}
+
+// Stream wire-format pixel data into the open window
+void ILI9488Driver::writePixelData(const uint8_t* data, size_t length) {
+    pImpl_->writeDataBuffer(data, length);
+}
+
 // Fill rectangular area (RGB565)
 void ILI9488Driver::fillArea(uint16_t x0, uint16_t y0, uint16_t x1, uint16_t y1, uint16_t color) {
     if (x0 > x1 || y0 > y1) return;
@@ -461,10 +507,7 @@ void ILI9488Driver::fillArea(uint16_t x0, uint16_t y0, uint16_t x1, uint16_t y1,
     pImpl_->rgb565ToRGB666Bytes(color, rgb666_bytes);
     
     uint32_t pixel_count = (x1 - x0 + 1) * (y1 - y0 + 1);
-    
-    for (uint32_t i = 0; i < pixel_count; ++i) {
-        pImpl_->writeDataBuffer(rgb666_bytes, 3);
-    }
+    pImpl_->writeRepeatedPixel(rgb666_bytes, pixel_count);
 }
 
 // Fill rectangular area (RGB666 native - no conversion needed)
@@ -480,10 +523,7 @@ void ILI9488Driver::fillAreaRGB666(uint16_t x0, uint16_t y0, uint16_t x1, uint16
     rgb666_bytes[2] = color666 & 0xFC;          // 蓝色分量，保留高6位
     
     uint32_t pixel_count = (x1 - x0 + 1) * (y1 - y0 + 1);
-    
-    for (uint32_t i = 0; i < pixel_count; ++i) {
-        pImpl_->writeDataBuffer(rgb666_bytes, 3);
-    }
+    pImpl_->writeRepeatedPixel(rgb666_bytes, pixel_count);
 }
 
 // Fill entire screen (RGB565)
@@ -556,6 +596,55 @@ void ILI9488Driver::setPartialArea(uint16_t /* x0 */, uint16_t y0, uint16_t /* x
     pImpl_->writeData(y1 & 0xFF);
 }
 
+// Define the hardware vertical scroll area
+bool ILI9488Driver::setScrollMargins(uint16_t top_fixed, uint16_t bottom_fixed) {
+    const Rotation rotation = pImpl_->current_rotation_;
+    if (rotation == Rotation::Landscape_90 || rotation == Rotation::Landscape_270 ||
+        top_fixed + bottom_fixed >= LCD_HEIGHT) {
+        return false;
+    }
+    
+    // Portrait_180 sets MY: frame memory lines run bottom-up, so the fixed areas swap
+    const bool flipped = rotation == Rotation::Portrait_180;
+    const uint16_t tfa = flipped ? bottom_fixed : top_fixed;
+    const uint16_t bfa = flipped ? top_fixed : bottom_fixed;
+    const uint16_t vsa = LCD_HEIGHT - top_fixed - bottom_fixed;
+    
+    pImpl_->writeCommand(Commands::VSCRDEF);
+    pImpl_->writeData(tfa >> 8);
+    pImpl_->writeData(tfa & 0xFF);
+    pImpl_->writeData(vsa >> 8);
+    pImpl_->writeData(vsa & 0xFF);
+    pImpl_->writeData(bfa >> 8);
+    pImpl_->writeData(bfa & 0xFF);
+    
+    pImpl_->scroll_top_fixed_ = top_fixed;
+    pImpl_->scroll_bottom_fixed_ = bottom_fixed;
+    scrollTo(top_fixed);
+    return true;
+}
+
+// Show a line at the top of the scroll area
+void ILI9488Driver::scrollTo(uint16_t line) {
+    const uint16_t top = pImpl_->scroll_top_fixed_;
+    const uint16_t bottom = pImpl_->scroll_bottom_fixed_;
+    const uint16_t vsa = LCD_HEIGHT - top - bottom;
+    const uint16_t offset = static_cast<uint16_t>((line + vsa - top % vsa) % vsa);  // Line within the area
+    
+    // The panel shows memory line VSCRSADD first and continues downwards in
+    // memory; with MY set the screen runs the other way through memory
+    uint16_t start;
+    if (pImpl_->current_rotation_ == Rotation::Portrait_180) {
+        start = static_cast<uint16_t>(bottom + (vsa - offset) % vsa);
+    } else {
+        start = static_cast<uint16_t>(top + offset);
+    }
+    
+    pImpl_->writeCommand(Commands::VSCRSADD);
+    pImpl_->writeData(start >> 8);
+    pImpl_->writeData(start & 0xFF);
+}
+
 // Write data using DMA (non-blocking)
 bool ILI9488Driver::writeDMA(const uint8_t* data, size_t length) {
     if (!data || length == 0 || pImpl_->dma_channel_ < 0 || pImpl_->dma_busy_) {
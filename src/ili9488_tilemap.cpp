@@ -0,0 +1,238 @@
+/**
+ * @file ili9488_tilemap.cpp
+ * @brief Dirty-cell tile map implementation
+ */
+
+#include "ili9488_tilemap.hpp"
+#include "ili9488_colors.hpp"
+
+#include <cstring>
+#include "pico/time.h"
+
+namespace ili9488 {
+
+namespace {
+
+void fillWire(uint8_t* dst, int32_t count, uint16_t color) {
+    ili9488_colors::rgb565_to_wire(color, dst);
+    for (int32_t i = 1; i < count; ++i) {
+        std::memcpy(dst + i * 3, dst, 3);
+    }
+}
+
+} // namespace
+
+// === Setup ===
+
+bool TileMap::begin(const TileAtlas* atlas, uint16_t columns, uint16_t rows, int16_t x, int16_t y) {
+    atlas_ = nullptr;
+    columns_ = rows_ = 0;
+    dirty_count_ = 0;
+    std::memset(dirty_, 0, sizeof(dirty_));
+    if (!atlas || !atlas->pixels || atlas->tile_width == 0 || atlas->tile_height == 0 ||
+        atlas->tile_width > MAX_LINE_WIDTH || columns == 0 || rows == 0 ||
+        static_cast<uint32_t>(columns) * rows > MAX_CELLS) {
+        return false;
+    }
+
+    atlas_ = atlas;
+    columns_ = columns;
+    rows_ = rows;
+    x_ = x;
+    y_ = y;
+    std::memset(tiles_, 0, static_cast<size_t>(columns) * rows);
+    invalidateAll();
+    return true;
+}
+
+// === Cells ===
+
+void TileMap::markDirty(uint32_t cell) {
+    uint32_t& word = dirty_[cell >> 5];
+    const uint32_t bit = 1u << (cell & 31);
+    if (!(word & bit)) {
+        word |= bit;
+        ++dirty_count_;
+    }
+}
+
+void TileMap::clearDirty(uint32_t cell) {
+    uint32_t& word = dirty_[cell >> 5];
+    const uint32_t bit = 1u << (cell & 31);
+    if (word & bit) {
+        word &= ~bit;
+        --dirty_count_;
+    }
+}
+
+void TileMap::setTile(uint16_t column, uint16_t row, uint8_t tile) {
+    if (column >= columns_ || row >= rows_) return;
+    const uint32_t cell = static_cast<uint32_t>(row) * columns_ + column;
+    if (tiles_[cell] != tile) {
+        tiles_[cell] = tile;
+        markDirty(cell);
+    }
+}
+
+uint8_t TileMap::tile(uint16_t column, uint16_t row) const {
+    if (column >= columns_ || row >= rows_) return 0;
+    return tiles_[static_cast<uint32_t>(row) * columns_ + column];
+}
+
+void TileMap::fillRect(uint16_t column, uint16_t row, uint16_t w, uint16_t h, uint8_t tile) {
+    const uint32_t c1 = static_cast<uint32_t>(column) + w < columns_ ? column + w : columns_;
+    const uint32_t r1 = static_cast<uint32_t>(row) + h < rows_ ? row + h : rows_;
+    for (uint32_t r = row; r < r1; ++r) {
+        for (uint32_t c = column; c < c1; ++c) {
+            setTile(static_cast<uint16_t>(c), static_cast<uint16_t>(r), tile);
+        }
+    }
+}
+
+// === Dirty tracking ===
+
+void TileMap::invalidate(uint16_t column, uint16_t row) {
+    if (column >= columns_ || row >= rows_) return;
+    markDirty(static_cast<uint32_t>(row) * columns_ + column);
+}
+
+void TileMap::invalidateArea(int16_t x, int16_t y, int16_t w, int16_t h) {
+    if (!atlas_ || w <= 0 || h <= 0) return;
+    const int32_t tw = atlas_->tile_width;
+    const int32_t th = atlas_->tile_height;
+
+    // Grid-relative pixel range, then the cells it touches
+    int32_t left = x - x_, top = y - y_;
+    int32_t right = left + w, bottom = top + h;
+    if (left < 0) left = 0;
+    if (top < 0) top = 0;
+    if (right > columns_ * tw) right = columns_ * tw;
+    if (bottom > rows_ * th) bottom = rows_ * th;
+    if (left >= right || top >= bottom) return;
+
+    for (int32_t r = top / th; r <= (bottom - 1) / th; ++r) {
+        for (int32_t c = left / tw; c <= (right - 1) / tw; ++c) {
+            markDirty(static_cast<uint32_t>(r) * columns_ + c);
+        }
+    }
+}
+
+void TileMap::invalidateAll() {
+    const uint32_t cells = static_cast<uint32_t>(columns_) * rows_;
+    std::memset(dirty_, 0, sizeof(dirty_));
+    for (uint32_t i = 0; i < cells / 32; ++i) {
+        dirty_[i] = 0xFFFFFFFFu;
+    }
+    if (cells % 32) {
+        dirty_[cells / 32] = (1u << (cells % 32)) - 1;
+    }
+    dirty_count_ = cells;
+}
+
+uint32_t TileMap::nextDirty(uint32_t from, uint32_t end) const {
+    while (from < end) {
+        const uint32_t word = dirty_[from >> 5] >> (from & 31);
+        if (word == 0) {
+            from = (from | 31) + 1;         // Rest of this word is clean
+            continue;
+        }
+        if (word & 1) return from;
+        ++from;
+    }
+    return end;
+}
+
+// === Output ===
+
+void TileMap::sendBurst(ILI9488_UI& display, uint16_t row, uint16_t column, uint16_t count) {
+    const int32_t tw = atlas_->tile_width;
+    const int32_t th = atlas_->tile_height;
+    const int32_t line_bytes = count * tw * 3;
+    const uint8_t* cells = tiles_ + static_cast<uint32_t>(row) * columns_ + column;
+
+    display.setAddrWindow(static_cast<int16_t>(x_ + column * tw), static_cast<int16_t>(y_ + row * th),
+                          static_cast<int16_t>(count * tw), static_cast<int16_t>(th));
+
+    // The window is row-major, so as many whole lines as fit go out in one transfer
+    const int32_t lines_per_chunk = static_cast<int32_t>(sizeof(lines_[0])) / line_bytes;
+    for (int32_t line = 0; line < th;) {
+        const int32_t n = (th - line) < lines_per_chunk ? (th - line) : lines_per_chunk;
+        uint8_t* wire = lines_[current_];
+        uint8_t* out = wire;
+        for (int32_t i = 0; i < n; ++i, ++line) {
+            for (uint16_t c = 0; c < count; ++c) {
+                const uint8_t t = cells[c];
+                if (t < atlas_->tile_count) {
+                    ili9488_colors::rgb565_to_wire(atlas_->tileRow(t, static_cast<uint8_t>(line)), out, tw);
+                } else {
+                    fillWire(out, tw, background_);
+                }
+                out += tw * 3;
+            }
+        }
+        // This buffer was last used two transfers ago, which has completed
+        display.writePixelDataAsync(wire, static_cast<size_t>(out - wire));
+        current_ ^= 1;
+    }
+
+    const uint32_t bytes = static_cast<uint32_t>(line_bytes) * th;
+    stats_.last_bytes += bytes;
+    stats_.last_cells += count;
+    ++stats_.last_bursts;
+}
+
+uint32_t TileMap::flush(ILI9488_UI& display) {
+    stats_.last_cells = stats_.last_bursts = stats_.last_bytes = 0;
+    if (!atlas_ || dirty_count_ == 0) {
+        stats_.last_flush_us = 0;
+        return 0;
+    }
+
+    const uint64_t start = time_us_64();
+    const int32_t tw = atlas_->tile_width;
+    const int32_t th = atlas_->tile_height;
+    const int32_t max_run = MAX_LINE_WIDTH / tw;
+
+    // Cells that lie completely on the display
+    int32_t first_column = x_ < 0 ? (-x_ + tw - 1) / tw : 0;
+    int32_t first_row = y_ < 0 ? (-y_ + th - 1) / th : 0;
+    int32_t end_column = (display.width() - x_) / tw;
+    int32_t end_row = (display.height() - y_) / th;
+    if (end_column > columns_) end_column = columns_;
+    if (end_row > rows_) end_row = rows_;
+
+    for (uint32_t row = 0; row < rows_ && dirty_count_ != 0; ++row) {
+        const uint32_t row_start = row * columns_;
+        const uint32_t row_end = row_start + columns_;
+        const bool visible_row = static_cast<int32_t>(row) >= first_row && static_cast<int32_t>(row) < end_row;
+
+        for (uint32_t cell = nextDirty(row_start, row_end); cell < row_end; cell = nextDirty(cell, row_end)) {
+            // Extend the run over neighbouring dirty cells
+            const uint32_t run_start = cell;
+            while (cell < row_end && isDirty(cell) && static_cast<int32_t>(cell - run_start) < max_run) {
+                clearDirty(cell);
+                ++cell;
+            }
+            if (!visible_row) continue;
+
+            int32_t c0 = static_cast<int32_t>(run_start - row_start);
+            int32_t c1 = static_cast<int32_t>(cell - row_start);
+            if (c0 < first_column) c0 = first_column;
+            if (c1 > end_column) c1 = end_column;
+            if (c0 < c1) {
+                sendBurst(display, static_cast<uint16_t>(row), static_cast<uint16_t>(c0), static_cast<uint16_t>(c1 - c0));
+            }
+        }
+    }
+
+    display.waitPixelData();
+    if (stats_.last_cells) {
+        ++stats_.flushes;
+        stats_.cells += stats_.last_cells;
+        stats_.bytes += stats_.last_bytes;
+    }
+    stats_.last_flush_us = static_cast<uint32_t>(time_us_64() - start);
+    return stats_.last_bytes;
+}
+
+} // namespace ili9488
@@ -6,12 +6,148 @@
 
 #include "ili9488_ui.hpp"
 #include "ili9488_colors.hpp"
+#include "ili9488_font.hpp"
+#include "ili9488_fixed.hpp"
 
 #include <algorithm>
 #include <cmath>
+#include <cstring>
 
 namespace ili9488 {
 
+namespace {
+
+inline uint8_t reverseBits(uint8_t b) {
+    b = static_cast<uint8_t>((b & 0xF0) >> 4 | (b & 0x0F) << 4);
+    b = static_cast<uint8_t>((b & 0xCC) >> 2 | (b & 0x33) << 2);
+    b = static_cast<uint8_t>((b & 0xAA) >> 1 | (b & 0x55) << 1);
+    return b;
+}
+
+/**
+ * 256-entry byte -> 8 wire pixels table for one (fg, bg) pair (6 KB).
+ * Rebuilt only when the colour pair changes; built from a 16-entry nibble
+ * table so a rebuild is 512 small copies.
+ */
+struct ExpandTable {
+    static constexpr size_t BYTES_PER_ENTRY = 8 * 3;
+    
+    bool valid = false;
+    uint16_t fg = 0;
+    uint16_t bg = 0;
+    uint8_t entries[256][BYTES_PER_ENTRY];
+    
+    const uint8_t* get(uint16_t fg_color, uint16_t bg_color) {
+        if (!valid || fg_color != fg || bg_color != bg) {
+            uint8_t fg_wire[3], bg_wire[3];
+            ili9488_colors::rgb565_to_wire(fg_color, fg_wire);
+            ili9488_colors::rgb565_to_wire(bg_color, bg_wire);
+            
+            uint8_t nibbles[16][12];
+            for (uint8_t n = 0; n < 16; ++n) {
+                for (uint8_t bit = 0; bit < 4; ++bit) {
+                    std::memcpy(&nibbles[n][bit * 3], (n & (0x8 >> bit)) ? fg_wire : bg_wire, 3);
+                }
+            }
+            for (uint16_t b = 0; b < 256; ++b) {
+                std::memcpy(&entries[b][0], nibbles[b >> 4], 12);
+                std::memcpy(&entries[b][12], nibbles[b & 0x0F], 12);
+            }
+            
+            fg = fg_color;
+            bg = bg_color;
+            valid = true;
+        }
+        return &entries[0][0];
+    }
+};
+
+ExpandTable g_expand_table;
+
+// 4x4 Bayer matrix (0..15)
+constexpr uint8_t BAYER_4X4[4][4] = {
+    { 0,  8,  2, 10},
+    {12,  4, 14,  6},
+    { 3, 11,  1,  9},
+    {15,  7, 13,  5}
+};
+
+// Two scanlines for fillGradient(): one is built while the other is on the bus
+constexpr int16_t GRADIENT_MAX_LINE = 480;
+uint8_t g_gradient_lines[2][GRADIENT_MAX_LINE * 3];
+
+/**
+ * Outline/shadow mask of one 8x16 glyph inside a frame that adds a margin on
+ * each side. Row bits are MSB-first: bit 31 is frame column 0.
+ */
+struct EffectMask {
+    static constexpr int8_t MAX_MARGIN = 8;
+    static constexpr int16_t MAX_ROWS = font::FONT_HEIGHT + 2 * MAX_MARGIN;
+    
+    uint8_t left, top, right, bottom;
+    uint32_t rows[MAX_ROWS];
+};
+
+/**
+ * Small direct-mapped cache of effect masks keyed by (glyph, effect, dx, dy).
+ * HUD strings reuse a handful of glyphs, so dilation is paid once per glyph.
+ */
+class EffectMaskCache {
+public:
+    const EffectMask& get(unsigned char c, ILI9488_UI::TextEffect effect, int8_t dx, int8_t dy) {
+        const uint32_t key = (static_cast<uint32_t>(c) << 24) |
+                             (static_cast<uint32_t>(effect) << 16) |
+                             (static_cast<uint32_t>(static_cast<uint8_t>(dx)) << 8) |
+                             static_cast<uint8_t>(dy);
+        Entry& entry = entries_[(c ^ (dx * 7) ^ (dy * 13)) & (ENTRIES - 1)];
+        if (!entry.valid || entry.key != key) {
+            build(entry.mask, c, effect, dx, dy);
+            entry.key = key;
+            entry.valid = true;
+        }
+        return entry.mask;
+    }
+    
+private:
+    static constexpr size_t ENTRIES = 32;
+    
+    struct Entry {
+        bool valid = false;
+        uint32_t key = 0;
+        EffectMask mask;
+    };
+    
+    static void build(EffectMask& m, unsigned char c, ILI9488_UI::TextEffect effect, int8_t dx, int8_t dy) {
+        const bool outline = (effect == ILI9488_UI::TextEffect::Outline);
+        m.left   = outline ? 1 : static_cast<uint8_t>(dx < 0 ? -dx : 0);
+        m.right  = outline ? 1 : static_cast<uint8_t>(dx > 0 ? dx : 0);
+        m.top    = outline ? 1 : static_cast<uint8_t>(dy < 0 ? -dy : 0);
+        m.bottom = outline ? 1 : static_cast<uint8_t>(dy > 0 ? dy : 0);
+        std::memset(m.rows, 0, sizeof(m.rows));
+        
+        const uint8_t* glyph = font::get_char_data(static_cast<char>(c));
+        for (int16_t gr = 0; gr < font::FONT_HEIGHT; ++gr) {
+            const uint32_t placed = (static_cast<uint32_t>(glyph[gr]) << 24) >> m.left;
+            if (!placed) continue;
+            
+            if (outline) {
+                const uint32_t wide = placed | (placed << 1) | (placed >> 1);
+                for (int16_t oy = -1; oy <= 1; ++oy) {
+                    m.rows[gr + m.top + oy] |= wide;
+                }
+            } else {
+                m.rows[gr + m.top + dy] |= dx >= 0 ? (placed >> dx) : (placed << -dx);
+            }
+        }
+    }
+    
+    Entry entries_[ENTRIES];
+};
+
+EffectMaskCache g_effect_cache;
+
+} // namespace
+
 // Constructor
 ILI9488_UI::ILI9488_UI(int16_t width, int16_t height) 
     : _width(width), _height(height), WIDTH(width), HEIGHT(height), rotation_(0) {
@@ -20,6 +156,69 @@ ILI9488_UI::ILI9488_UI(int16_t width, int16_t height)
 // Destructor  
 ILI9488_UI::~ILI9488_UI() = default;
 
+// Default bulk hooks: software window, one pixel at a time
+
+void ILI9488_UI::setAddrWindow(int16_t x, int16_t y, int16_t w, int16_t h) {
+    win_x_ = x;
+    win_y_ = y;
+    win_w_ = w;
+    win_h_ = h;
+    win_cx_ = x;
+    win_cy_ = y;
+}
+
+void ILI9488_UI::writePixelData(const uint8_t* data, size_t length) {
+    for (size_t i = 0; i + 2 < length; i += 3) {
+        if (win_cy_ >= win_y_ + win_h_) return;
+        
+        const uint32_t rgb = (static_cast<uint32_t>(data[i]) << 16) |
+                             (static_cast<uint32_t>(data[i + 1]) << 8) | data[i + 2];
+        writePixelRGB24(static_cast<uint16_t>(win_cx_), static_cast<uint16_t>(win_cy_), rgb);
+        
+        if (++win_cx_ >= win_x_ + win_w_) {
+            win_cx_ = win_x_;
+            ++win_cy_;
+        }
+    }
+}
+
+void ILI9488_UI::writePixelDataAsync(const uint8_t* data, size_t length) {
+    writePixelData(data, length);
+}
+
+void ILI9488_UI::waitPixelData() {
+}
+
+bool ILI9488_UI::setScrollMargins(int16_t /*top_fixed*/, int16_t /*bottom_fixed*/) {
+    return false;
+}
+
+void ILI9488_UI::scrollTo(int16_t /*y*/) {
+}
+
+void ILI9488_UI::fillWindow(int16_t x, int16_t y, int16_t w, int16_t h, uint16_t color) {
+    if (x < 0) { w += x; x = 0; }
+    if (y < 0) { h += y; y = 0; }
+    if (x + w > WIDTH) w = WIDTH - x;
+    if (y + h > HEIGHT) h = HEIGHT - y;
+    if (w <= 0 || h <= 0) return;
+    
+    // One chunk of the colour in wire format, reused for the whole burst
+    constexpr int32_t RUN_PIXELS = 64;
+    uint8_t run[RUN_PIXELS * 3];
+    ili9488_colors::rgb565_to_wire(color, run);
+    for (int32_t i = 1; i < RUN_PIXELS; ++i) {
+        std::memcpy(&run[i * 3], run, 3);
+    }
+    
+    setAddrWindow(x, y, w, h);
+    const int32_t total = static_cast<int32_t>(w) * h;
+    for (int32_t done = 0; done < total; done += RUN_PIXELS) {
+        const int32_t n = std::min<int32_t>(RUN_PIXELS, total - done);
+        writePixelData(run, static_cast<size_t>(n) * 3);
+    }
+}
+
 // Drawing primitives with Adafruit GFX compatibility
 
 void ILI9488_UI::drawPixel(int16_t x, int16_t y, uint16_t color) {
@@ -306,39 +505,293 @@ void ILI9488_UI::drawChar(int16_t x, int16_t y, unsigned char c, uint16_t color,
 }
 
 void ILI9488_UI::drawChar(int16_t x, int16_t y, unsigned char c, uint16_t color, uint16_t bg, uint8_t size_x, uint8_t size_y) {
-    if ((x >= WIDTH) || (y >= HEIGHT) ||
-        ((x + 6 * size_x - 1) < 0) || ((y + 8 * size_y - 1) < 0))
+    if (size_x == 0 || size_y == 0) return;
+    
+    const int16_t char_w = font::FONT_WIDTH * size_x;
+    const int16_t char_h = font::FONT_HEIGHT * size_y;
+    if ((x >= WIDTH) || (y >= HEIGHT) || ((x + char_w - 1) < 0) || ((y + char_h - 1) < 0))
         return;
     
-    // For now, just draw a simple character placeholder
-    // This would need to be replaced with actual font rendering
-    fillRect(x, y, 6 * size_x, 8 * size_y, bg);
+    const uint8_t* glyph = font::get_char_data(static_cast<char>(c));
     
-    // Simple 5x7 font rendering would go here
-    // For demonstration, just draw a filled rectangle
-    if (c >= ' ') {
-        fillRect(x + size_x, y + size_y, 4 * size_x, 6 * size_y, color);
+    if (bg == color) {
+        // Transparent: one window per (scaled) run of set pixels
+        for (int16_t row = 0; row < font::FONT_HEIGHT; ++row) {
+            const uint8_t bits = glyph[row];
+            int16_t col = 0;
+            while (col < font::FONT_WIDTH) {
+                if (!(bits & (0x80 >> col))) {
+                    ++col;
+                    continue;
+                }
+                const int16_t start = col;
+                while (col < font::FONT_WIDTH && (bits & (0x80 >> col))) ++col;
+                fillWindow(x + start * size_x, y + row * size_y, (col - start) * size_x, size_y, color);
+            }
+        }
+        return;
+    }
+    
+    if (size_x == 1 && size_y == 1) {
+        drawBitmap1bpp(x, y, font::FONT_WIDTH, font::FONT_HEIGHT, glyph, color, bg);
+        return;
+    }
+    
+    // Opaque, scaled: one window for the visible part of the glyph, rows replicated
+    const int16_t col0 = x < 0 ? -x : 0;
+    const int16_t row0 = y < 0 ? -y : 0;
+    const int16_t col1 = (x + char_w > WIDTH) ? WIDTH - x : char_w;
+    const int16_t row1 = (y + char_h > HEIGHT) ? HEIGHT - y : char_h;
+    
+    uint8_t fg_wire[3], bg_wire[3];
+    ili9488_colors::rgb565_to_wire(color, fg_wire);
+    ili9488_colors::rgb565_to_wire(bg, bg_wire);
+    
+    constexpr int16_t CHUNK_PIXELS = 128;
+    uint8_t line[CHUNK_PIXELS * 3];
+    const bool single_chunk = (col1 - col0) <= CHUNK_PIXELS;
+    int16_t built_row = -1;
+    
+    setAddrWindow(x + col0, y + row0, col1 - col0, row1 - row0);
+    
+    for (int16_t py = row0; py < row1; ++py) {
+        const int16_t src_row = py / size_y;
+        const uint8_t bits = glyph[src_row];
+        
+        for (int16_t px = col0; px < col1; px += CHUNK_PIXELS) {
+            const int16_t n = std::min<int16_t>(CHUNK_PIXELS, col1 - px);
+            // Narrow glyphs: each font row is expanded once and sent size_y times
+            if (!single_chunk || built_row != src_row) {
+                for (int16_t i = 0; i < n; ++i) {
+                    const bool on = bits & (0x80 >> ((px + i) / size_x));
+                    std::memcpy(&line[i * 3], on ? fg_wire : bg_wire, 3);
+                }
+                built_row = src_row;
+            }
+            writePixelData(line, static_cast<size_t>(n) * 3);
+        }
     }
 }
 
+void ILI9488_UI::fillGradient(int16_t x, int16_t y, int16_t w, int16_t h,
+                              uint32_t color1, uint32_t color2,
+                              GradientShape shape, bool dither) {
+    if (w <= 0 || h <= 0) return;
+    
+    // Visible part; the gradient itself is laid out over the unclipped rectangle
+    const int16_t col0 = x < 0 ? -x : 0;
+    const int16_t row0 = y < 0 ? -y : 0;
+    const int16_t col1 = (x + w > WIDTH) ? WIDTH - x : w;
+    const int16_t row1 = (y + h > HEIGHT) ? HEIGHT - y : h;
+    if (col0 >= col1 || row0 >= row1 || col1 - col0 > GRADIENT_MAX_LINE) return;
+    
+    // Channel start values and deltas; the interpolation parameter t is 0..65536
+    const int32_t c1[3] = {
+        static_cast<int32_t>((color1 >> 16) & 0xFF),
+        static_cast<int32_t>((color1 >> 8) & 0xFF),
+        static_cast<int32_t>(color1 & 0xFF)
+    };
+    const int32_t delta[3] = {
+        static_cast<int32_t>((color2 >> 16) & 0xFF) - c1[0],
+        static_cast<int32_t>((color2 >> 8) & 0xFF) - c1[1],
+        static_cast<int32_t>(color2 & 0xFF) - c1[2]
+    };
+    
+    // Linear shapes: t = (i * step_x + j * step_y) in Q16
+    int32_t step_x = 0, step_y = 0;
+    switch (shape) {
+        case GradientShape::Horizontal:
+            step_x = w > 1 ? 65536 / (w - 1) : 0;
+            break;
+        case GradientShape::Vertical:
+            step_y = h > 1 ? 65536 / (h - 1) : 0;
+            break;
+        case GradientShape::Diagonal:
+            step_x = step_y = (w + h > 2) ? 65536 / (w + h - 2) : 0;
+            break;
+        case GradientShape::Radial:
+            break;
+    }
+    
+    // Radial: distances from the centre in 1/64 half-pixel units, normalised by the
+    // corner distance with a reciprocal instead of a per-pixel divide. Scaled squared
+    // distances fit in 32 bits for anything panel-sized (up to about 720x720); larger
+    // rectangles take the 64-bit root
+    const uint64_t corner_sq = (static_cast<uint64_t>(w - 1) * (w - 1) +
+                                static_cast<uint64_t>(h - 1) * (h - 1)) << 12;
+    const bool wide = corner_sq > UINT32_MAX;
+    const uint32_t radius = wide ? ili9488::fixed::isqrt64(corner_sq)
+                                 : ili9488::fixed::isqrt(static_cast<uint32_t>(corner_sq));
+    const uint32_t inv_radius = radius ? (1u << 30) / radius : 0;
+    
+    const int16_t line_w = col1 - col0;
+    setAddrWindow(x + col0, y + row0, line_w, row1 - row0);
+    
+    for (int16_t j = row0; j < row1; ++j) {
+        uint8_t* line = g_gradient_lines[j & 1];
+        uint8_t* out = line;
+        const uint8_t* bayer_row = BAYER_4X4[(y + j) & 3];
+        const int32_t dy2 = 2 * j - (h - 1);
+        
+        for (int16_t i = col0; i < col1; ++i) {
+            int32_t t;
+            if (shape == GradientShape::Radial) {
+                const int32_t dx2 = 2 * i - (w - 1);
+                uint32_t d;
+                if (wide) {
+                    d = ili9488::fixed::isqrt64((static_cast<uint64_t>(static_cast<int64_t>(dx2) * dx2) +
+                                                 static_cast<uint64_t>(static_cast<int64_t>(dy2) * dy2)) << 12);
+                } else {
+                    d = ili9488::fixed::isqrt(static_cast<uint32_t>(dx2 * dx2 + dy2 * dy2) << 12);
+                }
+                t = static_cast<int32_t>((d * inv_radius) >> 14);
+            } else {
+                t = i * step_x + j * step_y;
+            }
+            if (t > 65536) t = 65536;
+            
+            // Threshold in 8.8: one RGB666 step is 4 levels = 1024, split into 16 Bayer
+            // steps centred in their interval; without dithering round to nearest
+            const int32_t bias = dither ? (2 * bayer_row[(x + i) & 3] + 1) * 32 : 512;
+            for (int ch = 0; ch < 3; ++ch) {
+                int32_t v = (c1[ch] << 8) + ((delta[ch] * t) >> 8) + bias;
+                v >>= 8;
+                if (v > 255) v = 255;
+                *out++ = static_cast<uint8_t>(v) & 0xFC;
+            }
+        }
+        
+        writePixelDataAsync(line, static_cast<size_t>(line_w) * 3);
+    }
+    
+    waitPixelData();
+}
+
 void ILI9488_UI::drawString(int16_t x, int16_t y, const char* str, uint16_t color, uint16_t bg, uint8_t size) {
     int16_t cursor_x = x;
     int16_t cursor_y = y;
     
     while (*str) {
         if (*str == '\n') {
-            cursor_y += size * 8;
+            cursor_y += size * font::FONT_HEIGHT;
             cursor_x = x;
         } else if (*str == '\r') {
             cursor_x = x;
         } else {
             drawChar(cursor_x, cursor_y, *str, color, bg, size);
-            cursor_x += size * 6;
+            cursor_x += size * font::FONT_WIDTH;
         }
         str++;
     }
 }
 
+void ILI9488_UI::drawStringEffect(int16_t x, int16_t y, const char* str, TextEffect effect, int8_t dx, int8_t dy,
+                                  uint16_t color, uint16_t effect_color, uint16_t bg, bool opaque) {
+    if (!str) return;
+    dx = std::max<int8_t>(-EffectMask::MAX_MARGIN, std::min<int8_t>(EffectMask::MAX_MARGIN, dx));
+    dy = std::max<int8_t>(-EffectMask::MAX_MARGIN, std::min<int8_t>(EffectMask::MAX_MARGIN, dy));
+    
+    uint8_t fg_wire[3], fx_wire[3], bg_wire[3];
+    ili9488_colors::rgb565_to_wire(color, fg_wire);
+    ili9488_colors::rgb565_to_wire(effect_color, fx_wire);
+    ili9488_colors::rgb565_to_wire(bg, bg_wire);
+    
+    // Widest glyph region: 8 + both margins
+    constexpr int16_t MAX_REGION_W = font::FONT_WIDTH + 2 * EffectMask::MAX_MARGIN;
+    uint8_t line[MAX_REGION_W * 3];
+    uint8_t kind[MAX_REGION_W];     // 0 = background, 1 = effect, 2 = glyph
+    
+    // Masks of the previous, current and next glyph; margins never exceed one
+    // cell, so only direct neighbours can spill into a glyph's columns
+    EffectMask masks[3];
+    
+    int16_t line_y = y;
+    while (*str) {
+        const char* end = str;
+        while (*end && *end != '\n') ++end;
+        const int16_t count = static_cast<int16_t>(end - str);
+        
+        if (count > 0) {
+            masks[1] = g_effect_cache.get(static_cast<unsigned char>(str[0]), effect, dx, dy);
+            const int16_t left = masks[1].left;
+            const int16_t top = masks[1].top;
+            const int16_t right = masks[1].right;
+            const int16_t rows = font::FONT_HEIGHT + top + masks[1].bottom;
+            
+            for (int16_t i = 0; i < count; ++i) {
+                const bool has_prev = i > 0;
+                const bool has_next = i + 1 < count;
+                if (has_next) {
+                    masks[2] = g_effect_cache.get(static_cast<unsigned char>(str[i + 1]), effect, dx, dy);
+                }
+                const uint8_t* glyph = font::get_char_data(str[i]);
+                
+                // Region of this glyph in frame columns: its own 8 columns, plus the
+                // outer margins at either end of the line
+                const int16_t cell_x = x + i * font::FONT_WIDTH;
+                int16_t f0 = has_prev ? left : 0;
+                int16_t f1 = has_next ? left + font::FONT_WIDTH : left + font::FONT_WIDTH + right;
+                int16_t r0 = 0;
+                int16_t r1 = rows;
+                
+                // Clip against the screen
+                const int16_t frame_x = cell_x - left;
+                const int16_t frame_y = line_y - top;
+                if (frame_x + f0 < 0) f0 = -frame_x;
+                if (frame_x + f1 > WIDTH) f1 = WIDTH - frame_x;
+                if (frame_y < 0) r0 = -frame_y;
+                if (frame_y + r1 > HEIGHT) r1 = HEIGHT - frame_y;
+                
+                if (f0 < f1 && r0 < r1) {
+                    const int16_t region_w = f1 - f0;
+                    if (opaque) {
+                        setAddrWindow(frame_x + f0, frame_y + r0, region_w, r1 - r0);
+                    }
+                    
+                    for (int16_t r = r0; r < r1; ++r) {
+                        uint32_t fx_bits = masks[1].rows[r];
+                        if (has_prev) fx_bits |= masks[0].rows[r] << font::FONT_WIDTH;
+                        if (has_next) fx_bits |= masks[2].rows[r] >> font::FONT_WIDTH;
+                        
+                        const int16_t gr = r - top;
+                        const uint32_t glyph_bits = (gr >= 0 && gr < font::FONT_HEIGHT)
+                            ? (static_cast<uint32_t>(glyph[gr]) << 24) >> left : 0;
+                        
+                        for (int16_t f = f0; f < f1; ++f) {
+                            const uint32_t bit = 0x80000000u >> f;
+                            const uint8_t k = (glyph_bits & bit) ? 2 : (fx_bits & bit) ? 1 : 0;
+                            kind[f - f0] = k;
+                            std::memcpy(&line[(f - f0) * 3], k == 2 ? fg_wire : k == 1 ? fx_wire : bg_wire, 3);
+                        }
+                        
+                        if (opaque) {
+                            writePixelData(line, static_cast<size_t>(region_w) * 3);
+                            continue;
+                        }
+                        
+                        // Transparent: one burst per run of glyph/effect pixels
+                        int16_t c = 0;
+                        while (c < region_w) {
+                            if (!kind[c]) { ++c; continue; }
+                            const int16_t start = c;
+                            while (c < region_w && kind[c]) ++c;
+                            setAddrWindow(frame_x + f0 + start, frame_y + r, c - start, 1);
+                            writePixelData(&line[start * 3], static_cast<size_t>(c - start) * 3);
+                        }
+                    }
+                }
+                
+                masks[0] = masks[1];
+                masks[1] = masks[2];
+            }
+        }
+        
+        if (!*end) break;
+        str = end + 1;
+        line_y += font::FONT_HEIGHT;
+    }
+}
+
 void ILI9488_UI::setRotation(uint8_t rotation) {
     rotation_ = rotation & 3;
     switch (rotation_) {
@@ -389,6 +842,103 @@ void ILI9488_UI::drawBitmapRGB24(int16_t x, int16_t y, int16_t w, int16_t h, con
     }
 }
 
+void ILI9488_UI::drawBitmap1bpp(int16_t x, int16_t y, int16_t w, int16_t h, const uint8_t* bits,
+                                uint16_t fg, uint16_t bg, BitOrder order) {
+    if (!bits || w <= 0 || h <= 0) return;
+    
+    // Visible part of the bitmap
+    const int16_t col0 = x < 0 ? -x : 0;
+    const int16_t row0 = y < 0 ? -y : 0;
+    const int16_t col1 = (x + w > WIDTH) ? WIDTH - x : w;
+    const int16_t row1 = (y + h > HEIGHT) ? HEIGHT - y : h;
+    if (col0 >= col1 || row0 >= row1) return;
+    
+    const uint8_t* table = g_expand_table.get(fg, bg);
+    const size_t stride = (static_cast<size_t>(w) + 7) / 8;
+    const bool reverse = (order == BitOrder::LsbFirst);
+    
+    constexpr int16_t CHUNK_BYTES = 16;     // 128 pixels, 384 bytes of stack
+    uint8_t line[CHUNK_BYTES * ExpandTable::BYTES_PER_ENTRY];
+    
+    setAddrWindow(x + col0, y + row0, col1 - col0, row1 - row0);
+    
+    for (int16_t row = row0; row < row1; ++row) {
+        const uint8_t* src = bits + static_cast<size_t>(row) * stride;
+        int16_t col = col0;
+        
+        while (col < col1) {
+            const int16_t first_byte = col >> 3;
+            const int16_t last_byte = (col1 - 1) >> 3;
+            const int16_t n_bytes = std::min<int16_t>(CHUNK_BYTES, last_byte - first_byte + 1);
+            
+            for (int16_t i = 0; i < n_bytes; ++i) {
+                uint8_t b = src[first_byte + i];
+                if (reverse) b = reverseBits(b);
+                std::memcpy(&line[i * ExpandTable::BYTES_PER_ENTRY],
+                            table + b * ExpandTable::BYTES_PER_ENTRY, ExpandTable::BYTES_PER_ENTRY);
+            }
+            
+            // Trim the partial bytes at either end of the visible run
+            const int16_t px_start = col - first_byte * 8;
+            const int16_t px_end = std::min<int16_t>(n_bytes * 8, col1 - first_byte * 8);
+            writePixelData(&line[px_start * 3], static_cast<size_t>(px_end - px_start) * 3);
+            
+            col = first_byte * 8 + px_end;
+        }
+    }
+}
+
+void ILI9488_UI::drawMask1bpp(int16_t x, int16_t y, int16_t w, int16_t h, const uint8_t* bits,
+                              uint16_t fg, BitOrder order) {
+    if (!bits || w <= 0 || h <= 0) return;
+    
+    const int16_t col0 = x < 0 ? -x : 0;
+    const int16_t row0 = y < 0 ? -y : 0;
+    const int16_t col1 = (x + w > WIDTH) ? WIDTH - x : w;
+    const int16_t row1 = (y + h > HEIGHT) ? HEIGHT - y : h;
+    if (col0 >= col1 || row0 >= row1) return;
+    
+    const size_t stride = (static_cast<size_t>(w) + 7) / 8;
+    const bool lsb_first = (order == BitOrder::LsbFirst);
+    
+    for (int16_t row = row0; row < row1; ++row) {
+        const uint8_t* src = bits + static_cast<size_t>(row) * stride;
+        auto bitAt = [&](int16_t col) -> bool {
+            const uint8_t b = src[col >> 3];
+            return lsb_first ? ((b >> (col & 7)) & 1) != 0 : ((b << (col & 7)) & 0x80) != 0;
+        };
+        
+        int16_t col = col0;
+        while (col < col1) {
+            // Skip whole empty bytes quickly
+            if ((col & 7) == 0 && src[col >> 3] == 0) {
+                col += 8;
+                continue;
+            }
+            if (!bitAt(col)) {
+                ++col;
+                continue;
+            }
+            
+            const int16_t start = col;
+            while (col < col1 && bitAt(col)) {
+                // Whole 0xFF bytes extend the run eight pixels at a time
+                if ((col & 7) == 0 && col + 8 <= col1 && src[col >> 3] == 0xFF) {
+                    col += 8;
+                } else {
+                    ++col;
+                }
+            }
+            
+            fillWindow(x + start, y + row, col - start, 1, fg);
+        }
+    }
+}
+
+void ILI9488_UI::drawXBitmap(int16_t x, int16_t y, const uint8_t* bitmap, int16_t w, int16_t h, uint16_t color) {
+    drawMask1bpp(x, y, w, h, bitmap, color, BitOrder::LsbFirst);
+}
+
 
 
 } // namespace ili9488 
\ No newline at end of file
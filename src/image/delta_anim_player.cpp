@@ -0,0 +1,305 @@
+/**
+ * @file delta_anim_player.cpp
+ * @brief Delta-encoded animation player with one frame of read-ahead
+ */
+
+#include "delta_anim_player.hpp"
+
+#include <cstring>
+#include "pico/time.h"
+
+namespace ili9488_image {
+
+namespace {
+
+constexpr uint8_t ANIM_VERSION = 1;
+constexpr size_t KEYFRAME_ENTRY_SIZE = 8;
+
+inline uint16_t readLE16(const uint8_t* p) {
+    return static_cast<uint16_t>(p[0] | (p[1] << 8));
+}
+
+inline uint32_t readLE32(const uint8_t* p) {
+    return static_cast<uint32_t>(p[0]) | (static_cast<uint32_t>(p[1]) << 8) |
+           (static_cast<uint32_t>(p[2]) << 16) | (static_cast<uint32_t>(p[3]) << 24);
+}
+
+} // namespace
+
+size_t DeltaAnimPlayer::readFully(uint8_t* dst, size_t length) {
+    size_t total = 0;
+    while (total < length) {
+        const size_t n = source_->read(dst + total, length - total);
+        if (n == 0) break;
+        total += n;
+    }
+    return total;
+}
+
+// === Header ===
+
+ImageStatus DeltaAnimPlayer::open(ImageSource& source) {
+    source_ = &source;
+    info_ = Info();
+    stats_ = Stats();
+    
+    uint8_t header[HEADER_SIZE];
+    if (readFully(header, HEADER_SIZE) != HEADER_SIZE) {
+        return ImageStatus::ReadError;
+    }
+    if (std::memcmp(header, "DANM", 4) != 0) {
+        return ImageStatus::BadHeader;
+    }
+    if (header[4] != ANIM_VERSION) {
+        return ImageStatus::Unsupported;
+    }
+    
+    info_.header_size = readLE16(header + 6);
+    info_.x = static_cast<int16_t>(readLE16(header + 8));
+    info_.y = static_cast<int16_t>(readLE16(header + 10));
+    info_.width = readLE16(header + 12);
+    info_.height = readLE16(header + 14);
+    info_.frame_count = readLE16(header + 16);
+    info_.fps = readLE16(header + 18);
+    info_.total_ticks = readLE16(header + 20);
+    const uint16_t keyframe_count = readLE16(header + 22);
+    
+    if (info_.width == 0 || info_.height == 0 || info_.frame_count == 0 ||
+        info_.header_size < HEADER_SIZE + keyframe_count * KEYFRAME_ENTRY_SIZE) {
+        return ImageStatus::BadHeader;
+    }
+    
+    // Keyframe table: only the first MAX_KEYFRAMES are kept as drop targets
+    uint32_t position = HEADER_SIZE;
+    for (uint16_t i = 0; i < keyframe_count; ++i) {
+        uint8_t entry[KEYFRAME_ENTRY_SIZE];
+        if (readFully(entry, KEYFRAME_ENTRY_SIZE) != KEYFRAME_ENTRY_SIZE) {
+            return ImageStatus::ReadError;
+        }
+        position += KEYFRAME_ENTRY_SIZE;
+        if (info_.keyframe_count < MAX_KEYFRAMES) {
+            Keyframe& key = keyframes_[info_.keyframe_count++];
+            key.frame = readLE16(entry);
+            key.tick = readLE16(entry + 2);
+            key.offset = readLE32(entry + 4);
+        }
+    }
+    
+    // Skip to the first frame record
+    if (position < info_.header_size && !source.seek(info_.header_size)) {
+        for (uint32_t left = info_.header_size - position; left > 0;) {
+            const size_t n = left < FRAME_BUFFER_SIZE ? left : FRAME_BUFFER_SIZE;
+            if (readFully(slots_[0], n) != n) return ImageStatus::ReadError;
+            left -= static_cast<uint32_t>(n);
+        }
+    }
+    return ImageStatus::Ok;
+}
+
+// === Frame records ===
+
+ImageStatus DeltaAnimPlayer::beginRecord(Record& record, uint8_t* slot) {
+    record = Record();
+    if (readFully(slot, RECORD_HEADER_SIZE) != RECORD_HEADER_SIZE) {
+        return ImageStatus::ReadError;
+    }
+    record.size = readLE32(slot);
+    record.tick = readLE16(slot + 4);
+    record.rect_count = readLE16(slot + 6);
+    record.filled = RECORD_HEADER_SIZE;
+    record.resident = record.size <= FRAME_BUFFER_SIZE;
+    return record.size < RECORD_HEADER_SIZE ? ImageStatus::BadHeader : ImageStatus::Ok;
+}
+
+ImageStatus DeltaAnimPlayer::readAhead(Record& record, uint8_t* slot, uint32_t budget) {
+    if (!record.resident) return ImageStatus::Ok;
+    const uint32_t left = record.size - record.filled;
+    const uint32_t n = left < budget ? left : budget;
+    if (readFully(slot + record.filled, n) != n) {
+        return ImageStatus::ReadError;
+    }
+    record.filled += n;
+    return ImageStatus::Ok;
+}
+
+bool DeltaAnimPlayer::rectInWindow(uint16_t x, uint16_t y, uint16_t w, uint16_t h) const {
+    return w > 0 && h > 0 && x + w <= info_.width && y + h <= info_.height;
+}
+
+ImageStatus DeltaAnimPlayer::drawResident(ili9488::ILI9488_UI& display, const Record& record,
+                                          const uint8_t* slot, Record* next, uint8_t* next_slot) {
+    // The read-ahead slot may still be on DMA from the previous frame
+    display.waitPixelData();
+    
+    const uint8_t* p = slot + RECORD_HEADER_SIZE;
+    const uint8_t* end = slot + record.size;
+    for (uint16_t i = 0; i < record.rect_count; ++i) {
+        if (end - p < static_cast<ptrdiff_t>(RECT_HEADER_SIZE)) return ImageStatus::BadHeader;
+        const uint16_t x = readLE16(p), y = readLE16(p + 2), w = readLE16(p + 4), h = readLE16(p + 6);
+        const uint32_t bytes = static_cast<uint32_t>(w) * h * 3;
+        p += RECT_HEADER_SIZE;
+        if (!rectInWindow(x, y, w, h) || static_cast<uint32_t>(end - p) < bytes) {
+            display.waitPixelData();
+            return ImageStatus::BadHeader;
+        }
+        
+        display.setAddrWindow(static_cast<int16_t>(info_.x + x), static_cast<int16_t>(info_.y + y),
+                              static_cast<int16_t>(w), static_cast<int16_t>(h));
+        display.writePixelDataAsync(p, bytes);
+        p += bytes;
+        stats_.bytes += bytes;
+        
+        // Read about as much of the next frame as this rectangle takes on the wire
+        if (next) {
+            ImageStatus status = next->filled ? ImageStatus::Ok : beginRecord(*next, next_slot);
+            if (status == ImageStatus::Ok) status = readAhead(*next, next_slot, bytes);
+            if (status != ImageStatus::Ok) {
+                display.waitPixelData();
+                return status;
+            }
+        }
+    }
+    return ImageStatus::Ok;
+}
+
+ImageStatus DeltaAnimPlayer::drawStreamed(ili9488::ILI9488_UI& display, const Record& record) {
+    // Both slots become chunk buffers: wait for anything still reading from them
+    display.waitPixelData();
+    
+    constexpr size_t CHUNK = FRAME_BUFFER_SIZE - FRAME_BUFFER_SIZE % 3;
+    uint32_t left = record.size - RECORD_HEADER_SIZE;
+    uint8_t current = 0;
+    ImageStatus status = ImageStatus::Ok;
+    
+    for (uint16_t i = 0; i < record.rect_count && status == ImageStatus::Ok; ++i) {
+        uint8_t rect[RECT_HEADER_SIZE];
+        if (left < RECT_HEADER_SIZE) {
+            status = ImageStatus::BadHeader;
+            break;
+        }
+        if (readFully(rect, RECT_HEADER_SIZE) != RECT_HEADER_SIZE) {
+            status = ImageStatus::ReadError;
+            break;
+        }
+        left -= RECT_HEADER_SIZE;
+        const uint16_t x = readLE16(rect), y = readLE16(rect + 2), w = readLE16(rect + 4), h = readLE16(rect + 6);
+        uint32_t bytes = static_cast<uint32_t>(w) * h * 3;
+        if (!rectInWindow(x, y, w, h) || bytes > left) {
+            status = ImageStatus::BadHeader;
+            break;
+        }
+        
+        display.setAddrWindow(static_cast<int16_t>(info_.x + x), static_cast<int16_t>(info_.y + y),
+                              static_cast<int16_t>(w), static_cast<int16_t>(h));
+        while (bytes > 0) {
+            const size_t n = bytes < CHUNK ? bytes : CHUNK;
+            if (readFully(slots_[current], n) != n) {
+                status = ImageStatus::ReadError;
+                break;
+            }
+            display.writePixelDataAsync(slots_[current], n);
+            current ^= 1;
+            bytes -= static_cast<uint32_t>(n);
+            left -= static_cast<uint32_t>(n);
+            stats_.bytes += static_cast<uint32_t>(n);
+        }
+    }
+    
+    display.waitPixelData();
+    if (status == ImageStatus::Ok && left != 0) {
+        status = ImageStatus::BadHeader;
+    }
+    ++stats_.streamed_frames;
+    return status;
+}
+
+// === Playback ===
+
+const DeltaAnimPlayer::Keyframe* DeltaAnimPlayer::keyframeToDropTo(uint16_t frame, uint32_t tick) const {
+    const Keyframe* target = nullptr;
+    for (uint16_t i = 0; i < info_.keyframe_count; ++i) {
+        const Keyframe& key = keyframes_[i];
+        if (key.frame > frame && key.frame < info_.frame_count && key.tick <= tick) {
+            target = &key;
+        }
+    }
+    return target;
+}
+
+ImageStatus DeltaAnimPlayer::play(ili9488::ILI9488_UI& display, uint16_t loops) {
+    if (!source_) {
+        return ImageStatus::BadHeader;
+    }
+    if (info_.x < 0 || info_.y < 0 ||
+        info_.x + info_.width > display.width() || info_.y + info_.height > display.height()) {
+        return ImageStatus::TooLarge;
+    }
+    
+    FramePacer pacer(info_.fps);
+    Record records[2];
+    uint8_t current = 0;
+    ImageStatus status = ImageStatus::Ok;
+    pacer.start();
+    
+    for (uint16_t loop = 0; loop < loops && status == ImageStatus::Ok; ++loop) {
+        if (loop > 0) {
+            // Fall through to the final wait: the last frame may still be on the bus
+            if (!source_->seek(info_.header_size)) {
+                status = ImageStatus::Unsupported;
+                break;
+            }
+            pacer.advance(info_.total_ticks);
+        }
+        status = beginRecord(records[current], slots_[current]);
+        if (status == ImageStatus::Ok) status = readAhead(records[current], slots_[current], UINT32_MAX);
+        
+        uint16_t frame = 0;
+        while (status == ImageStatus::Ok && frame < info_.frame_count) {
+            Record& record = records[current];
+            Record& next = records[current ^ 1];
+            
+            // More than a tick behind: jump to the latest keyframe already due
+            if (pacer.fps() != 0 && pacer.currentTick() > record.tick) {
+                const Keyframe* key = keyframeToDropTo(frame, pacer.currentTick());
+                if (key && source_->seek(key->offset)) {
+                    stats_.dropped_frames += key->frame - frame;
+                    frame = key->frame;
+                    status = beginRecord(record, slots_[current]);
+                    if (status == ImageStatus::Ok) status = readAhead(record, slots_[current], UINT32_MAX);
+                    continue;
+                }
+            }
+            
+            if (!pacer.waitForTick(record.tick)) {
+                ++stats_.late_frames;
+            }
+            
+            const bool has_next = frame + 1 < info_.frame_count;
+            next = Record();
+            const uint64_t start = time_us_64();
+            if (record.resident) {
+                status = drawResident(display, record, slots_[current], has_next ? &next : nullptr,
+                                      slots_[current ^ 1]);
+            } else {
+                status = drawStreamed(display, record);
+            }
+            stats_.last_frame_us = static_cast<uint32_t>(time_us_64() - start);
+            
+            // Finish loading the next frame while this one is held
+            if (status == ImageStatus::Ok && has_next) {
+                if (next.filled == 0) status = beginRecord(next, slots_[current ^ 1]);
+                if (status == ImageStatus::Ok) status = readAhead(next, slots_[current ^ 1], UINT32_MAX);
+            }
+            if (status == ImageStatus::Ok) {
+                ++stats_.frames;
+                ++frame;
+                current ^= 1;
+            }
+        }
+    }
+    
+    display.waitPixelData();
+    return status;
+}
+
+} // namespace ili9488_image
@@ -0,0 +1,690 @@
+/**
+ * @file jpeg_decoder.cpp
+ * @brief Baseline JPEG decoder (ITU-T T.81), streaming MCU rows to the panel
+ */
+
+#include "jpeg_decoder.hpp"
+
+#include <cstring>
+
+namespace ili9488_image {
+
+namespace {
+
+// JPEG markers
+constexpr uint8_t M_SOF0 = 0xC0;    // Baseline
+constexpr uint8_t M_SOF1 = 0xC1;    // Extended sequential, Huffman
+constexpr uint8_t M_DHT  = 0xC4;
+constexpr uint8_t M_RST0 = 0xD0;
+constexpr uint8_t M_RST7 = 0xD7;
+constexpr uint8_t M_SOI  = 0xD8;
+constexpr uint8_t M_EOI  = 0xD9;
+constexpr uint8_t M_SOS  = 0xDA;
+constexpr uint8_t M_DQT  = 0xDB;
+constexpr uint8_t M_DRI  = 0xDD;
+
+// Zig-zag scan position -> natural (row-major) index
+constexpr uint8_t ZIGZAG[64] = {
+     0,  1,  8, 16,  9,  2,  3, 10,
+    17, 24, 32, 25, 18, 11,  4,  5,
+    12, 19, 26, 33, 40, 48, 41, 34,
+    27, 20, 13,  6,  7, 14, 21, 28,
+    35, 42, 49, 56, 57, 50, 43, 36,
+    29, 22, 15, 23, 30, 37, 44, 51,
+    58, 59, 52, 45, 38, 31, 39, 46,
+    53, 60, 61, 54, 47, 55, 62, 63
+};
+
+// AAN scale factors, 16384 * f(u) * f(v) with f(0) = 1, f(k) = sqrt(2) * cos(k*pi/16)
+constexpr uint16_t AAN_SCALES[64] = {
+    16384, 22725, 21407, 19266, 16384, 12873,  8867,  4520,
+    22725, 31521, 29692, 26722, 22725, 17855, 12299,  6270,
+    21407, 29692, 27969, 25172, 21407, 16819, 11585,  5906,
+    19266, 26722, 25172, 22654, 19266, 15137, 10426,  5315,
+    16384, 22725, 21407, 19266, 16384, 12873,  8867,  4520,
+    12873, 17855, 16819, 15137, 12873, 10114,  6967,  3552,
+     8867, 12299, 11585, 10426,  8867,  6967,  4799,  2446,
+     4520,  6270,  5906,  5315,  4520,  3552,  2446,  1247
+};
+
+// AAN IDCT: dequantised input carries PASS1_BITS of extra precision, constants are Q8
+constexpr int PASS1_BITS = 2;
+constexpr int32_t FIX_1_082392200 = 277;
+constexpr int32_t FIX_1_414213562 = 362;
+constexpr int32_t FIX_1_847759065 = 473;
+constexpr int32_t FIX_2_613125930 = 669;
+
+inline int32_t aanMultiply(int32_t value, int32_t constant) {
+    return (value * constant) >> 8;
+}
+
+// Reduced IDCT bases, Q13: 0.5 * C(u) * cos((2x + 1) * u * pi / (2N)) for N = 4, 2, 1
+constexpr int16_t REDUCED_4[4][4] = {
+    {2896,  3784,  2896,  1567},
+    {2896,  1567, -2896, -3784},
+    {2896, -1567, -2896,  3784},
+    {2896, -3784,  2896, -1567}
+};
+constexpr int16_t REDUCED_2[2][2] = {
+    {2896,  2896},
+    {2896, -2896}
+};
+constexpr int16_t REDUCED_1 = 2896;
+
+inline uint8_t clampSample(int32_t value) {
+    return value < 0 ? 0 : (value > 255 ? 255 : static_cast<uint8_t>(value));
+}
+
+} // namespace
+
+// === Marker parsing ===
+
+uint16_t JpegDecoder::readU16() {
+    const uint16_t hi = in_->next();
+    return static_cast<uint16_t>((hi << 8) | in_->next());
+}
+
+bool JpegDecoder::skipSegment() {
+    uint16_t length = readU16();
+    if (length < 2) return false;
+    for (length -= 2; length > 0 && !in_->eof(); --length) {
+        in_->next();
+    }
+    return !in_->eof();
+}
+
+bool JpegDecoder::readDQT() {
+    int32_t length = static_cast<int32_t>(readU16()) - 2;
+    while (length > 0) {
+        const uint8_t pq_tq = in_->next();
+        const uint8_t precision = pq_tq >> 4;
+        const uint8_t id = pq_tq & 0x0F;
+        if (id > 3 || precision > 1) return false;
+
+        for (uint8_t i = 0; i < 64; ++i) {
+            quant_[id][ZIGZAG[i]] = precision ? readU16() : in_->next();
+        }
+        quant_defined_[id] = true;
+        length -= 1 + 64 * (precision + 1);
+    }
+    return length == 0 && !in_->eof();
+}
+
+void JpegDecoder::buildHuffTable(HuffTable& table, const uint8_t* counts) {
+    std::memset(table.lookup, 0, sizeof(table.lookup));
+
+    int32_t code = 0;
+    int32_t k = 0;
+    for (uint8_t length = 1; length <= 16; ++length) {
+        table.valoffset[length] = k - code;
+        for (uint8_t i = 0; i < counts[length - 1]; ++i, ++k, ++code) {
+            if (length <= 8) {
+                // Every 8-bit prefix starting with this code resolves to it
+                const int32_t first = code << (8 - length);
+                const int32_t span = 1 << (8 - length);
+                for (int32_t j = 0; j < span; ++j) {
+                    table.lookup[first + j] = static_cast<uint16_t>((length << 8) | table.values[k]);
+                }
+            }
+        }
+        table.maxcode[length] = counts[length - 1] ? code - 1 : -1;
+        code <<= 1;
+    }
+    table.maxcode[17] = 0x7FFFFFFF;     // Sentinel: stops the slow path
+    table.defined = true;
+}
+
+bool JpegDecoder::readDHT() {
+    int32_t length = static_cast<int32_t>(readU16()) - 2;
+    while (length > 0) {
+        const uint8_t tc_th = in_->next();
+        const uint8_t table_class = tc_th >> 4;
+        const uint8_t id = tc_th & 0x0F;
+        if (table_class > 1 || id > 3) return false;
+
+        uint8_t counts[16];
+        uint16_t total = 0;
+        for (uint8_t i = 0; i < 16; ++i) {
+            counts[i] = in_->next();
+            total += counts[i];
+        }
+        if (total > 256) return false;
+
+        HuffTable& table = table_class ? ac_tables_[id] : dc_tables_[id];
+        if (!in_->read(table.values, total)) return false;
+        buildHuffTable(table, counts);
+        length -= 17 + total;
+    }
+    return length == 0 && !in_->eof();
+}
+
+ImageStatus JpegDecoder::readSOF() {
+    readU16();                                  // Length
+    if (in_->next() != 8) return ImageStatus::Unsupported;     // 12-bit precision
+    info_.height = readU16();
+    info_.width = readU16();
+    num_comps_ = in_->next();
+    info_.components = num_comps_;
+
+    if (info_.width == 0 || info_.height == 0) return ImageStatus::BadHeader;
+    if (num_comps_ != 1 && num_comps_ != 3) return ImageStatus::Unsupported;
+    if (info_.width > MAX_WIDTH) return ImageStatus::TooLarge;
+
+    hmax_ = vmax_ = 1;
+    for (uint8_t i = 0; i < num_comps_; ++i) {
+        Component& comp = comps_[i];
+        comp.id = in_->next();
+        const uint8_t hv = in_->next();
+        comp.h = hv >> 4;
+        comp.v = hv & 0x0F;
+        comp.tq = in_->next() & 0x03;
+        if (comp.h < 1 || comp.h > 2 || comp.v < 1 || comp.v > 2) return ImageStatus::Unsupported;
+        if (comp.h > hmax_) hmax_ = comp.h;
+        if (comp.v > vmax_) vmax_ = comp.v;
+    }
+
+    if (num_comps_ == 1) {
+        // A single-component scan is never interleaved: one block per MCU
+        comps_[0].h = comps_[0].v = 1;
+        hmax_ = vmax_ = 1;
+    } else {
+        // Chroma must be 1x1 (4:4:4, 4:2:2, 4:2:0 with full-resolution luma)
+        for (uint8_t i = 1; i < 3; ++i) {
+            if (comps_[i].h != 1 || comps_[i].v != 1) return ImageStatus::Unsupported;
+        }
+    }
+    return in_->eof() ? ImageStatus::ReadError : ImageStatus::Ok;
+}
+
+ImageStatus JpegDecoder::readSOS() {
+    readU16();                                  // Length
+    const uint8_t count = in_->next();
+    if (count != num_comps_) return ImageStatus::Unsupported;  // Non-interleaved scans
+
+    for (uint8_t i = 0; i < count; ++i) {
+        const uint8_t id = in_->next();
+        const uint8_t tables = in_->next();
+        Component* comp = nullptr;
+        for (uint8_t c = 0; c < num_comps_; ++c) {
+            if (comps_[c].id == id) comp = &comps_[c];
+        }
+        if (!comp) return ImageStatus::BadHeader;
+        comp->td = tables >> 4;
+        comp->ta = tables & 0x0F;
+        if (comp->td > 3 || comp->ta > 3) return ImageStatus::BadHeader;
+        if (!dc_tables_[comp->td].defined || !ac_tables_[comp->ta].defined || !quant_defined_[comp->tq]) {
+            return ImageStatus::BadHeader;
+        }
+    }
+
+    // Spectral selection / successive approximation (fixed for baseline)
+    in_->next();
+    in_->next();
+    in_->next();
+    return in_->eof() ? ImageStatus::ReadError : ImageStatus::Ok;
+}
+
+ImageStatus JpegDecoder::readMarkers() {
+    bool have_frame = false;
+
+    while (true) {
+        // Find the next marker, skipping fill bytes
+        uint8_t byte = in_->next();
+        while (byte != 0xFF && !in_->eof()) byte = in_->next();
+        uint8_t marker = in_->next();
+        while (marker == 0xFF) marker = in_->next();
+        if (in_->eof()) return ImageStatus::ReadError;
+
+        switch (marker) {
+            case M_SOF0:
+            case M_SOF1: {
+                const ImageStatus status = readSOF();
+                if (status != ImageStatus::Ok) return status;
+                have_frame = true;
+                break;
+            }
+            case M_DHT:
+                if (!readDHT()) return ImageStatus::BadHeader;
+                break;
+            case M_DQT:
+                if (!readDQT()) return ImageStatus::BadHeader;
+                break;
+            case M_DRI:
+                readU16();
+                restart_interval_ = readU16();
+                break;
+            case M_SOS:
+                if (!have_frame) return ImageStatus::BadHeader;
+                return readSOS();
+            case M_EOI:
+                return ImageStatus::BadHeader;
+            default:
+                // Other SOFn: progressive, lossless or arithmetic coding
+                if (marker >= 0xC2 && marker <= 0xCF && marker != M_DHT && marker != 0xC8 && marker != 0xCC) {
+                    return ImageStatus::Unsupported;
+                }
+                // APPn, COM, DNL, ...
+                if (!skipSegment()) return ImageStatus::ReadError;
+                break;
+        }
+    }
+}
+
+// === Entropy decoding ===
+
+inline uint8_t JpegDecoder::readScanByte() {
+    if (marker_) return 0;      // Pad with zeros once a marker is reached
+
+    const uint8_t byte = in_->next();
+    if (byte != 0xFF) return byte;
+
+    uint8_t next = in_->next();
+    while (next == 0xFF) next = in_->next();
+    if (next == 0x00) return 0xFF;      // Stuffed byte
+
+    marker_ = next;
+    return 0;
+}
+
+inline void JpegDecoder::fillBits() {
+    while (bitcnt_ <= 24) {
+        bitbuf_ |= static_cast<uint32_t>(readScanByte()) << (24 - bitcnt_);
+        bitcnt_ += 8;
+    }
+}
+
+inline int32_t JpegDecoder::getBits(uint8_t count) {
+    // Read count bits and sign-extend them per T.81 F.2.2.1 (EXTEND)
+    if (count == 0) return 0;
+    fillBits();
+    const int32_t value = static_cast<int32_t>(bitbuf_ >> (32 - count));
+    bitbuf_ <<= count;
+    bitcnt_ -= count;
+    return value < (1 << (count - 1)) ? value - (1 << count) + 1 : value;
+}
+
+inline uint8_t JpegDecoder::decodeHuffman(const HuffTable& table) {
+    fillBits();
+
+    const uint16_t entry = table.lookup[bitbuf_ >> 24];
+    if (entry) {
+        const uint8_t length = entry >> 8;
+        bitbuf_ <<= length;
+        bitcnt_ -= length;
+        return static_cast<uint8_t>(entry);
+    }
+
+    // Codes longer than 8 bits
+    uint8_t length = 9;
+    int32_t code = static_cast<int32_t>(bitbuf_ >> 23);
+    while (code > table.maxcode[length]) {
+        ++length;
+        code = static_cast<int32_t>(bitbuf_ >> (32 - length));
+    }
+    if (length > 16) {
+        // Corrupt data: drop a byte and carry on
+        bitbuf_ <<= 8;
+        bitcnt_ -= 8;
+        return 0;
+    }
+    bitbuf_ <<= length;
+    bitcnt_ -= length;
+    return table.values[(code + table.valoffset[length]) & 0xFF];
+}
+
+bool JpegDecoder::decodeBlock(Component& comp, int16_t* block) {
+    std::memset(block, 0, 64 * sizeof(int16_t));
+
+    const uint8_t dc_size = decodeHuffman(dc_tables_[comp.td]);
+    comp.dc_pred = static_cast<int16_t>(comp.dc_pred + getBits(dc_size));
+    block[0] = comp.dc_pred;
+
+    const HuffTable& ac = ac_tables_[comp.ta];
+    for (uint8_t k = 1; k < 64; ) {
+        const uint8_t rs = decodeHuffman(ac);
+        const uint8_t run = rs >> 4;
+        const uint8_t size = rs & 0x0F;
+
+        if (size == 0) {
+            if (run != 15) break;   // EOB
+            k += 16;                // ZRL
+            continue;
+        }
+        k += run;
+        if (k > 63) return false;
+        block[ZIGZAG[k++]] = static_cast<int16_t>(getBits(size));
+    }
+    return true;
+}
+
+void JpegDecoder::processRestart() {
+    // Byte-align and consume the RSTn marker
+    bitbuf_ = 0;
+    bitcnt_ = 0;
+    while (!marker_ && !in_->eof()) {
+        readScanByte();
+    }
+    if (marker_ >= M_RST0 && marker_ <= M_RST7) {
+        marker_ = 0;
+    }
+
+    for (uint8_t c = 0; c < num_comps_; ++c) {
+        comps_[c].dc_pred = 0;
+    }
+    restarts_left_ = restart_interval_;
+}
+
+// === Reconstruction ===
+
+void JpegDecoder::prepareDequant(Scale scale) {
+    for (uint8_t c = 0; c < num_comps_; ++c) {
+        const uint16_t* quant = quant_[comps_[c].tq];
+        for (uint8_t i = 0; i < 64; ++i) {
+            if (scale == Scale::Full) {
+                // Fold the AAN output scaling into the quantiser, keeping PASS1_BITS
+                dequant_[c][i] = static_cast<int32_t>(
+                    (static_cast<uint32_t>(quant[i]) * AAN_SCALES[i] + (1u << (13 - PASS1_BITS))) >> (14 - PASS1_BITS));
+            } else {
+                dequant_[c][i] = quant[i];
+            }
+        }
+    }
+}
+
+void JpegDecoder::idctFull(const int16_t* block, const int32_t* dequant, uint8_t* out, uint16_t stride) {
+    int32_t ws[64];
+
+    // Pass 1: columns
+    for (uint8_t col = 0; col < 8; ++col) {
+        const int16_t* in = block + col;
+        const int32_t* q = dequant + col;
+        int32_t* w = ws + col;
+
+        if (!in[8] && !in[16] && !in[24] && !in[32] && !in[40] && !in[48] && !in[56]) {
+            // DC only: the column is flat
+            const int32_t dc = in[0] * q[0];
+            for (uint8_t r = 0; r < 8; ++r) w[r * 8] = dc;
+            continue;
+        }
+
+        // Even part
+        int32_t tmp0 = in[0] * q[0];
+        int32_t tmp1 = in[16] * q[16];
+        int32_t tmp2 = in[32] * q[32];
+        int32_t tmp3 = in[48] * q[48];
+
+        int32_t tmp10 = tmp0 + tmp2;
+        int32_t tmp11 = tmp0 - tmp2;
+        int32_t tmp13 = tmp1 + tmp3;
+        int32_t tmp12 = aanMultiply(tmp1 - tmp3, FIX_1_414213562) - tmp13;
+
+        tmp0 = tmp10 + tmp13;
+        tmp3 = tmp10 - tmp13;
+        tmp1 = tmp11 + tmp12;
+        tmp2 = tmp11 - tmp12;
+
+        // Odd part
+        int32_t tmp4 = in[8] * q[8];
+        int32_t tmp5 = in[24] * q[24];
+        int32_t tmp6 = in[40] * q[40];
+        int32_t tmp7 = in[56] * q[56];
+
+        const int32_t z13 = tmp6 + tmp5;
+        const int32_t z10 = tmp6 - tmp5;
+        const int32_t z11 = tmp4 + tmp7;
+        const int32_t z12 = tmp4 - tmp7;
+
+        tmp7 = z11 + z13;
+        tmp11 = aanMultiply(z11 - z13, FIX_1_414213562);
+        const int32_t z5 = aanMultiply(z10 + z12, FIX_1_847759065);
+        tmp10 = aanMultiply(z12, FIX_1_082392200) - z5;
+        tmp12 = aanMultiply(z10, -FIX_2_613125930) + z5;
+
+        tmp6 = tmp12 - tmp7;
+        tmp5 = tmp11 - tmp6;
+        tmp4 = tmp10 + tmp5;
+
+        w[0]  = tmp0 + tmp7;
+        w[56] = tmp0 - tmp7;
+        w[8]  = tmp1 + tmp6;
+        w[48] = tmp1 - tmp6;
+        w[16] = tmp2 + tmp5;
+        w[40] = tmp2 - tmp5;
+        w[32] = tmp3 + tmp4;
+        w[24] = tmp3 - tmp4;
+    }
+
+    // Pass 2: rows, descale by PASS1_BITS + 3 and level-shift
+    constexpr int32_t SHIFT = PASS1_BITS + 3;
+    constexpr int32_t BIAS = (128 << SHIFT) + (1 << (SHIFT - 1));
+    for (uint8_t row = 0; row < 8; ++row) {
+        const int32_t* w = ws + row * 8;
+        uint8_t* o = out + row * stride;
+
+        int32_t tmp10 = w[0] + w[4];
+        int32_t tmp11 = w[0] - w[4];
+        int32_t tmp13 = w[2] + w[6];
+        int32_t tmp12 = aanMultiply(w[2] - w[6], FIX_1_414213562) - tmp13;
+
+        const int32_t tmp0 = tmp10 + tmp13;
+        const int32_t tmp3 = tmp10 - tmp13;
+        const int32_t tmp1 = tmp11 + tmp12;
+        const int32_t tmp2 = tmp11 - tmp12;
+
+        const int32_t z13 = w[5] + w[3];
+        const int32_t z10 = w[5] - w[3];
+        const int32_t z11 = w[1] + w[7];
+        const int32_t z12 = w[1] - w[7];
+
+        const int32_t tmp7 = z11 + z13;
+        tmp11 = aanMultiply(z11 - z13, FIX_1_414213562);
+        const int32_t z5 = aanMultiply(z10 + z12, FIX_1_847759065);
+        tmp10 = aanMultiply(z12, FIX_1_082392200) - z5;
+        tmp12 = aanMultiply(z10, -FIX_2_613125930) + z5;
+
+        const int32_t tmp6 = tmp12 - tmp7;
+        const int32_t tmp5 = tmp11 - tmp6;
+        const int32_t tmp4 = tmp10 + tmp5;
+
+        o[0] = clampSample((tmp0 + tmp7 + BIAS) >> SHIFT);
+        o[7] = clampSample((tmp0 - tmp7 + BIAS) >> SHIFT);
+        o[1] = clampSample((tmp1 + tmp6 + BIAS) >> SHIFT);
+        o[6] = clampSample((tmp1 - tmp6 + BIAS) >> SHIFT);
+        o[2] = clampSample((tmp2 + tmp5 + BIAS) >> SHIFT);
+        o[5] = clampSample((tmp2 - tmp5 + BIAS) >> SHIFT);
+        o[4] = clampSample((tmp3 + tmp4 + BIAS) >> SHIFT);
+        o[3] = clampSample((tmp3 - tmp4 + BIAS) >> SHIFT);
+    }
+}
+
+void JpegDecoder::idctReduced(const int16_t* block, const int32_t* dequant, uint8_t* out, uint16_t stride, uint8_t size) {
+    // Inverse transform of the top-left size x size coefficients onto a size x size
+    // grid: equivalent to decoding at full size and box-filtering, at a fraction of the cost
+    if (size == 1) {
+        const int32_t dc = block[0] * dequant[0];
+        const int32_t pass1 = (REDUCED_1 * dc + (1 << 10)) >> 11;
+        out[0] = clampSample(((REDUCED_1 * pass1 + (1 << 14)) >> 15) + 128);
+        return;
+    }
+
+    const int16_t* basis = (size == 4) ? &REDUCED_4[0][0] : &REDUCED_2[0][0];
+    int32_t ws[4][4];
+
+    // Pass 1: each coefficient row v -> spatial columns x (2 extra fraction bits)
+    for (uint8_t v = 0; v < size; ++v) {
+        for (uint8_t x = 0; x < size; ++x) {
+            int32_t sum = 0;
+            for (uint8_t u = 0; u < size; ++u) {
+                sum += basis[x * size + u] * (block[v * 8 + u] * dequant[v * 8 + u]);
+            }
+            ws[v][x] = (sum + (1 << 10)) >> 11;
+        }
+    }
+
+    // Pass 2: coefficient rows -> spatial rows
+    for (uint8_t y = 0; y < size; ++y) {
+        for (uint8_t x = 0; x < size; ++x) {
+            int32_t sum = 0;
+            for (uint8_t v = 0; v < size; ++v) {
+                sum += basis[y * size + v] * ws[v][x];
+            }
+            out[y * stride + x] = clampSample(((sum + (1 << 14)) >> 15) + 128);
+        }
+    }
+}
+
+void JpegDecoder::emitRows(ili9488::ILI9488_UI& display, int16_t x, int16_t y, int32_t out_row0, int32_t rows) {
+    // Visible part of this MCU row
+    const int32_t screen_y0 = y + out_row0;
+    const int32_t row_first = screen_y0 < 0 ? -screen_y0 : 0;
+    const int32_t row_last = (screen_y0 + rows > display.height()) ? display.height() - screen_y0 : rows;
+    const int32_t col_first = x < 0 ? -x : 0;
+    const int32_t col_last = (x + info_.out_width > display.width()) ? display.width() - x : info_.out_width;
+    if (row_first >= row_last || col_first >= col_last) return;
+
+    display.setAddrWindow(static_cast<int16_t>(x + col_first), static_cast<int16_t>(screen_y0 + row_first),
+                          static_cast<int16_t>(col_last - col_first), static_cast<int16_t>(row_last - row_first));
+
+    const Component& luma = comps_[0];
+    const uint8_t* y_plane = planes_ + luma.plane_offset;
+    const uint8_t sh_x = hmax_ / luma.h - 1;  // 0 or 1: luma is normally full resolution
+    const uint8_t sh_y = vmax_ / luma.v - 1;
+
+    for (int32_t r = row_first; r < row_last; ++r) {
+        uint8_t* line = lines_[r & 1];
+        uint8_t* o = line;
+        const uint8_t* y_row = y_plane + (r >> sh_y) * luma.plane_stride;
+
+        if (num_comps_ == 1) {
+            for (int32_t c = col_first; c < col_last; ++c) {
+                const uint8_t v = y_row[c] & 0xFC;
+                o[0] = v;
+                o[1] = v;
+                o[2] = v;
+                o += 3;
+            }
+        } else {
+            // Chroma is 1x1: replicate each sample over hmax_ x vmax_ pixels
+            const uint8_t cx = hmax_ - 1;
+            const uint8_t cy = vmax_ - 1;
+            const uint8_t* cb_row = planes_ + comps_[1].plane_offset + (r >> cy) * comps_[1].plane_stride;
+            const uint8_t* cr_row = planes_ + comps_[2].plane_offset + (r >> cy) * comps_[2].plane_stride;
+
+            for (int32_t c = col_first; c < col_last; ++c) {
+                const int32_t yy = y_row[c >> sh_x];
+                const int32_t cb = cb_row[c >> cx] - 128;
+                const int32_t cr = cr_row[c >> cx] - 128;
+
+                // ITU-R BT.601 full range, Q16
+                o[0] = clampSample(yy + ((91881 * cr + 32768) >> 16)) & 0xFC;
+                o[1] = clampSample(yy - ((22554 * cb + 46802 * cr - 32768) >> 16)) & 0xFC;
+                o[2] = clampSample(yy + ((116130 * cb + 32768) >> 16)) & 0xFC;
+                o += 3;
+            }
+        }
+
+        display.writePixelDataAsync(line, static_cast<size_t>(o - line));
+    }
+    display.waitPixelData();
+}
+
+// === Top level ===
+
+ImageStatus JpegDecoder::decode(ImageSource& source, ili9488::ILI9488_UI& display, int16_t x, int16_t y, Scale scale) {
+    ChunkReader<CHUNK_SIZE> reader(source);
+    in_ = &reader;
+    info_ = Info();
+    restart_interval_ = 0;
+    marker_ = 0;
+    bitbuf_ = 0;
+    bitcnt_ = 0;
+    std::memset(quant_defined_, 0, sizeof(quant_defined_));
+    for (uint8_t i = 0; i < 4; ++i) {
+        dc_tables_[i].defined = ac_tables_[i].defined = false;
+    }
+
+    if (in_->next() != 0xFF || in_->next() != M_SOI) {
+        return ImageStatus::BadHeader;
+    }
+
+    const ImageStatus header_status = readMarkers();
+    if (header_status != ImageStatus::Ok) {
+        return header_status;
+    }
+
+    // Output geometry
+    const uint8_t shift = static_cast<uint8_t>(scale);
+    block_size_ = static_cast<uint8_t>(8 >> shift);
+    info_.out_width = static_cast<uint16_t>((info_.width + (1 << shift) - 1) >> shift);
+    info_.out_height = static_cast<uint16_t>((info_.height + (1 << shift) - 1) >> shift);
+
+    const uint16_t mcu_w = 8 * hmax_;
+    const uint16_t mcu_h = 8 * vmax_;
+    const uint16_t mcus_x = static_cast<uint16_t>((info_.width + mcu_w - 1) / mcu_w);
+    const uint16_t mcus_y = static_cast<uint16_t>((info_.height + mcu_h - 1) / mcu_h);
+    const uint16_t out_mcu_h = static_cast<uint16_t>(vmax_ * block_size_);
+
+    // Lay out one MCU row of each component in planes_
+    uint32_t offset = 0;
+    for (uint8_t c = 0; c < num_comps_; ++c) {
+        comps_[c].plane_offset = offset;
+        comps_[c].plane_stride = static_cast<uint16_t>(mcus_x * comps_[c].h * block_size_);
+        comps_[c].dc_pred = 0;
+        offset += static_cast<uint32_t>(comps_[c].plane_stride) * comps_[c].v * block_size_;
+    }
+
+    prepareDequant(scale);
+    restarts_left_ = restart_interval_;
+
+    // Rows past the bottom of the screen need not be decoded
+    int32_t last_mcu_row = mcus_y;
+    const int32_t visible_rows = display.height() - y;
+    if (visible_rows <= 0) return ImageStatus::Ok;
+    if (visible_rows < info_.out_height) {
+        last_mcu_row = (visible_rows + out_mcu_h - 1) / out_mcu_h;
+    }
+
+    int16_t block[64];
+    for (int32_t my = 0; my < last_mcu_row; ++my) {
+        for (uint16_t mx = 0; mx < mcus_x; ++mx) {
+            if (restart_interval_) {
+                if (restarts_left_ == 0) processRestart();
+                --restarts_left_;
+            }
+
+            for (uint8_t c = 0; c < num_comps_; ++c) {
+                Component& comp = comps_[c];
+                for (uint8_t by = 0; by < comp.v; ++by) {
+                    for (uint8_t bx = 0; bx < comp.h; ++bx) {
+                        if (!decodeBlock(comp, block)) {
+                            in_ = nullptr;
+                            return ImageStatus::BadHeader;
+                        }
+                        uint8_t* out = planes_ + comp.plane_offset +
+                                       static_cast<uint32_t>(by * block_size_) * comp.plane_stride +
+                                       (mx * comp.h + bx) * block_size_;
+                        if (block_size_ == 8) {
+                            idctFull(block, dequant_[c], out, comp.plane_stride);
+                        } else {
+                            idctReduced(block, dequant_[c], out, comp.plane_stride, block_size_);
+                        }
+                    }
+                }
+            }
+        }
+
+        if (in_->eof()) {
+            in_ = nullptr;
+            return ImageStatus::ReadError;
+        }
+
+        const int32_t out_row0 = my * out_mcu_h;
+        const int32_t rows = (out_row0 + out_mcu_h > info_.out_height) ? info_.out_height - out_row0 : out_mcu_h;
+        emitRows(display, x, y, out_row0, rows);
+    }
+
+    in_ = nullptr;
+    return ImageStatus::Ok;
+}
+
+} // namespace ili9488_image
@@ -0,0 +1,144 @@
+/**
+ * @file qoi_decoder.cpp
+ * @brief Streaming QOI decoder (https://qoiformat.org/qoi-specification.pdf)
+ */
+
+#include "qoi_decoder.hpp"
+
+#include <cstring>
+
+namespace ili9488_image {
+
+namespace {
+
+constexpr uint8_t QOI_OP_INDEX = 0x00;  // 00xxxxxx
+constexpr uint8_t QOI_OP_DIFF  = 0x40;  // 01xxxxxx
+constexpr uint8_t QOI_OP_LUMA  = 0x80;  // 10xxxxxx
+constexpr uint8_t QOI_OP_RUN   = 0xC0;  // 11xxxxxx
+constexpr uint8_t QOI_OP_RGB   = 0xFE;
+constexpr uint8_t QOI_OP_RGBA  = 0xFF;
+constexpr uint8_t QOI_MASK_2   = 0xC0;
+
+constexpr size_t HEADER_SIZE = 14;
+
+inline uint32_t readBE32(const uint8_t* p) {
+    return (static_cast<uint32_t>(p[0]) << 24) | (static_cast<uint32_t>(p[1]) << 16) |
+           (static_cast<uint32_t>(p[2]) << 8) | p[3];
+}
+
+inline uint8_t colorHash(uint32_t rgba) {
+    const uint32_t r = (rgba >> 16) & 0xFF, g = (rgba >> 8) & 0xFF, b = rgba & 0xFF, a = rgba >> 24;
+    return static_cast<uint8_t>((r * 3 + g * 5 + b * 7 + a * 11) & 63);
+}
+
+} // namespace
+
+ImageStatus QoiDecoder::decode(ImageSource& source, ili9488::ILI9488_UI& display, int16_t x, int16_t y) {
+    ChunkReader<CHUNK_SIZE> in(source);
+    bytes_read_ = 0;
+    pixels_decoded_ = 0;
+    
+    uint8_t header[HEADER_SIZE];
+    if (!in.read(header, HEADER_SIZE)) {
+        return ImageStatus::ReadError;
+    }
+    if (std::memcmp(header, "qoif", 4) != 0) {
+        return ImageStatus::BadHeader;
+    }
+    info_.width = readBE32(header + 4);
+    info_.height = readBE32(header + 8);
+    info_.channels = header[12];
+    info_.colorspace = header[13];
+    if (info_.width == 0 || info_.height == 0 || info_.channels < 3 || info_.channels > 4) {
+        return ImageStatus::BadHeader;
+    }
+    if (info_.width > MAX_WIDTH) {
+        return ImageStatus::TooLarge;
+    }
+    
+    const int32_t w = static_cast<int32_t>(info_.width);
+    const int32_t h = static_cast<int32_t>(info_.height);
+    
+    // Visible part of the image
+    const int32_t col0 = x < 0 ? -x : 0;
+    const int32_t row0 = y < 0 ? -y : 0;
+    const int32_t col1 = (x + w > display.width()) ? display.width() - x : w;
+    const int32_t row1 = (y + h > display.height()) ? display.height() - y : h;
+    const bool visible = col0 < col1 && row0 < row1;
+    if (visible) {
+        display.setAddrWindow(static_cast<int16_t>(x + col0), static_cast<int16_t>(y + row0),
+                              static_cast<int16_t>(col1 - col0), static_cast<int16_t>(row1 - row0));
+    }
+    
+    std::memset(index_, 0, sizeof(index_));
+    uint32_t px = 0xFF000000u;      // Opaque black
+    uint32_t run = 0;
+    
+    const int32_t last_row = visible ? row1 : 0;
+    for (int32_t row = 0; row < last_row; ++row) {
+        uint8_t* line = lines_[row & 1];
+        uint8_t* out = line;
+        const bool row_visible = row >= row0;
+        
+        for (int32_t col = 0; col < w; ++col) {
+            if (run > 0) {
+                --run;
+            } else {
+                const uint8_t b1 = in.next();
+                if (b1 == QOI_OP_RGB) {
+                    const uint32_t r = in.next(), g = in.next(), b = in.next();
+                    px = (px & 0xFF000000u) | (r << 16) | (g << 8) | b;
+                } else if (b1 == QOI_OP_RGBA) {
+                    const uint32_t r = in.next(), g = in.next(), b = in.next(), a = in.next();
+                    px = (a << 24) | (r << 16) | (g << 8) | b;
+                } else if ((b1 & QOI_MASK_2) == QOI_OP_INDEX) {
+                    px = index_[b1];
+                } else if ((b1 & QOI_MASK_2) == QOI_OP_DIFF) {
+                    const uint32_t r = ((px >> 16) + ((b1 >> 4) & 3) - 2) & 0xFF;
+                    const uint32_t g = ((px >> 8) + ((b1 >> 2) & 3) - 2) & 0xFF;
+                    const uint32_t b = (px + (b1 & 3) - 2) & 0xFF;
+                    px = (px & 0xFF000000u) | (r << 16) | (g << 8) | b;
+                } else if ((b1 & QOI_MASK_2) == QOI_OP_LUMA) {
+                    const uint8_t b2 = in.next();
+                    const int32_t dg = static_cast<int32_t>(b1 & 0x3F) - 32;
+                    const int32_t dr = dg - 8 + ((b2 >> 4) & 0x0F);
+                    const int32_t db = dg - 8 + (b2 & 0x0F);
+                    const uint32_t r = static_cast<uint32_t>(static_cast<int32_t>((px >> 16) & 0xFF) + dr) & 0xFF;
+                    const uint32_t g = static_cast<uint32_t>(static_cast<int32_t>((px >> 8) & 0xFF) + dg) & 0xFF;
+                    const uint32_t b = static_cast<uint32_t>(static_cast<int32_t>(px & 0xFF) + db) & 0xFF;
+                    px = (px & 0xFF000000u) | (r << 16) | (g << 8) | b;
+                } else {
+                    // QOI_OP_RUN: this pixel plus (b1 & 0x3F) more
+                    run = b1 & 0x3F;
+                }
+                index_[colorHash(px)] = px;
+                
+                if (in.eof()) {
+                    bytes_read_ = in.bytesRead();
+                    if (visible) display.waitPixelData();
+                    return ImageStatus::ReadError;
+                }
+            }
+            
+            if (row_visible && col >= col0 && col < col1) {
+                out[0] = static_cast<uint8_t>(px >> 16) & 0xFC;
+                out[1] = static_cast<uint8_t>(px >> 8) & 0xFC;
+                out[2] = static_cast<uint8_t>(px) & 0xFC;
+                out += 3;
+            }
+        }
+        
+        pixels_decoded_ += static_cast<uint32_t>(w);
+        if (row_visible) {
+            display.writePixelDataAsync(line, static_cast<size_t>(out - line));
+        }
+    }
+    
+    if (visible) {
+        display.waitPixelData();
+    }
+    bytes_read_ = in.bytesRead();
+    return ImageStatus::Ok;
+}
+
+} // namespace ili9488_image
@@ -0,0 +1,160 @@
+/**
+ * @file raw666_player.cpp
+ * @brief Pre-rendered RGB666 image/animation player (SD -> display, no pixel work)
+ */
+
+#include "raw666_player.hpp"
+
+#include <cstring>
+#include "frame_pacer.hpp"
+#include "pico/time.h"
+
+namespace ili9488_image {
+
+namespace {
+
+constexpr uint8_t RAW666_VERSION = 1;
+
+inline uint16_t readLE16(const uint8_t* p) {
+    return static_cast<uint16_t>(p[0] | (p[1] << 8));
+}
+
+inline uint32_t readLE32(const uint8_t* p) {
+    return static_cast<uint32_t>(p[0]) | (static_cast<uint32_t>(p[1]) << 8) |
+           (static_cast<uint32_t>(p[2]) << 16) | (static_cast<uint32_t>(p[3]) << 24);
+}
+
+} // namespace
+
+size_t Raw666Player::readFully(uint8_t* dst, size_t length) {
+    size_t total = 0;
+    while (total < length) {
+        const size_t n = source_->read(dst + total, length - total);
+        if (n == 0) break;
+        total += n;
+    }
+    return total;
+}
+
+ImageStatus Raw666Player::open(ImageSource& source) {
+    source_ = &source;
+    info_ = Info();
+    stats_ = Stats();
+    next_frame_ = 0;
+    
+    uint8_t* header = buffers_[0];
+    if (readFully(header, HEADER_SIZE) != HEADER_SIZE) {
+        return ImageStatus::ReadError;
+    }
+    if (std::memcmp(header, "R666", 4) != 0) {
+        return ImageStatus::BadHeader;
+    }
+    if (header[4] != RAW666_VERSION) {
+        return ImageStatus::Unsupported;
+    }
+    
+    info_.header_size = readLE16(header + 6);
+    info_.x = static_cast<int16_t>(readLE16(header + 8));
+    info_.y = static_cast<int16_t>(readLE16(header + 10));
+    info_.width = readLE16(header + 12);
+    info_.height = readLE16(header + 14);
+    info_.frame_count = readLE16(header + 16);
+    info_.fps = readLE16(header + 18);
+    info_.frame_stride = readLE32(header + 20);
+    
+    const uint32_t frame_bytes = static_cast<uint32_t>(info_.width) * info_.height * 3;
+    if (info_.header_size < HEADER_SIZE || info_.width == 0 || info_.height == 0 ||
+        info_.frame_count == 0 || info_.frame_stride < frame_bytes) {
+        return ImageStatus::BadHeader;
+    }
+    
+    // Skip the header padding; a seek avoids reading it when the source allows
+    const uint32_t padding = info_.header_size - HEADER_SIZE;
+    if (padding > 0 && !source.seek(info_.header_size)) {
+        for (uint32_t left = padding; left > 0;) {
+            const size_t n = left < BUFFER_SIZE ? left : BUFFER_SIZE;
+            if (readFully(buffers_[0], n) != n) return ImageStatus::ReadError;
+            left -= static_cast<uint32_t>(n);
+        }
+    }
+    return ImageStatus::Ok;
+}
+
+ImageStatus Raw666Player::streamFrame(ili9488::ILI9488_UI& display) {
+    uint32_t stride_left = info_.frame_stride;
+    uint32_t pixels_left = static_cast<uint32_t>(info_.width) * info_.height * 3;
+    uint8_t current = 0;
+    
+    display.setAddrWindow(info_.x, info_.y, static_cast<int16_t>(info_.width), static_cast<int16_t>(info_.height));
+    while (stride_left > 0) {
+        // Fill one buffer from the card while the other one is on its way to the panel
+        const size_t want = stride_left < BUFFER_SIZE ? stride_left : BUFFER_SIZE;
+        uint8_t* buffer = buffers_[current];
+        if (readFully(buffer, want) != want) {
+            display.waitPixelData();
+            return ImageStatus::ReadError;
+        }
+        stride_left -= static_cast<uint32_t>(want);
+        
+        const size_t send = want < pixels_left ? want : pixels_left;
+        if (send > 0) {
+            display.writePixelDataAsync(buffer, send);
+            pixels_left -= static_cast<uint32_t>(send);
+            stats_.bytes += static_cast<uint32_t>(send);
+            current ^= 1;
+        }
+    }
+    display.waitPixelData();
+    return ImageStatus::Ok;
+}
+
+ImageStatus Raw666Player::drawNext(ili9488::ILI9488_UI& display) {
+    return drawFrame(display, next_frame_ < info_.frame_count ? next_frame_ : 0);
+}
+
+ImageStatus Raw666Player::drawFrame(ili9488::ILI9488_UI& display, uint16_t index) {
+    if (!source_ || index >= info_.frame_count) {
+        return ImageStatus::BadHeader;
+    }
+    if (info_.x < 0 || info_.y < 0 ||
+        info_.x + info_.width > display.width() || info_.y + info_.height > display.height()) {
+        return ImageStatus::TooLarge;   // Wire bytes cannot be clipped; render for this orientation
+    }
+    if (index != next_frame_) {
+        const uint32_t offset = info_.header_size + static_cast<uint32_t>(index) * info_.frame_stride;
+        if (!source_->seek(offset)) return ImageStatus::Unsupported;
+    }
+    
+    const uint64_t start = time_us_64();
+    const ImageStatus status = streamFrame(display);
+    stats_.last_frame_us = static_cast<uint32_t>(time_us_64() - start);
+    if (status != ImageStatus::Ok) {
+        next_frame_ = info_.frame_count;    // Position unknown: force a seek next time
+        return status;
+    }
+    
+    ++stats_.frames;
+    next_frame_ = static_cast<uint16_t>(index + 1);
+    return ImageStatus::Ok;
+}
+
+ImageStatus Raw666Player::play(ili9488::ILI9488_UI& display, uint16_t loops, uint16_t fps) {
+    FramePacer pacer(fps ? fps : info_.fps);
+    uint32_t tick = 0;
+    pacer.start();
+    
+    for (uint16_t loop = 0; loop < loops; ++loop) {
+        for (uint16_t frame = 0; frame < info_.frame_count; ++frame, ++tick) {
+            // Hold the previous frame until this slot; an overrun restarts the schedule
+            if (!pacer.waitForTick(tick)) {
+                ++stats_.late_frames;
+                pacer.rebase(tick);
+            }
+            const ImageStatus status = drawFrame(display, frame);
+            if (status != ImageStatus::Ok) return status;
+        }
+    }
+    return ImageStatus::Ok;
+}
+
+} // namespace ili9488_image
@@ -646,6 +646,20 @@ Result<std::vector<uint8_t>> RWSD::FileHandle::read(size_t size) {
     return Result<std::vector<uint8_t>>(data);
 }
 
+Result<size_t> RWSD::FileHandle::read(uint8_t* buffer, size_t size) {
+    if (!is_open_ || !buffer) {
+        return Result<size_t>(ErrorCode::INVALID_PARAMETER);
+    }
+    
+    UINT bytes_read;
+    FRESULT fr = f_read(&file_, buffer, size, &bytes_read);
+    if (fr != FR_OK) {
+        return Result<size_t>(static_cast<ErrorCode>(fr));
+    }
+    
+    return Result<size_t>(static_cast<size_t>(bytes_read));
+}
+
 Result<size_t> RWSD::FileHandle::read_text(std::string& text, size_t max_size) {
     auto result = read(max_size);
     if (!result.is_ok()) {
@@ -0,0 +1,77 @@
+#!/usr/bin/env python3
+"""
+make_jpeg_fixtures.py - Regenerate the JPEG fixtures used by tests/test_jpeg.cpp
+
+Writes a small smooth test card as baseline JPEGs with 4:4:4, 4:2:2 and 4:2:0
+sampling, a 4:2:0 file with restart markers every 3 MCUs, a greyscale file,
+and for each one the reference decode as raw RGB888 (.rgb, row-major). The
+references come from libjpeg through Pillow, so the test compares the
+decoder against an independent implementation.
+
+The size (72x40) is deliberately not a multiple of the MCU so that partial
+MCUs at the right and bottom edges are exercised.
+
+Usage:
+    python3 tests/data/make_jpeg_fixtures.py
+
+Requires Pillow (pip install pillow).
+"""
+
+import math
+import os
+import sys
+
+try:
+    from PIL import Image
+except ImportError:
+    sys.stderr.write("make_jpeg_fixtures.py: Pillow is required (pip install pillow)\n")
+    sys.exit(1)
+
+WIDTH = 72
+HEIGHT = 40
+QUALITY = 90
+
+# name -> save options
+FIXTURES = {
+    "jpeg_444": {"subsampling": 0},
+    "jpeg_422": {"subsampling": 1},
+    "jpeg_420": {"subsampling": 2},
+    "jpeg_420_rst": {"subsampling": 2, "restart_marker_blocks": 3},
+}
+
+
+def test_card():
+    """Smooth colour ramps plus a soft disc: chroma varies slowly, so the
+    decoder's sample replication and libjpeg's fancy upsampling stay close."""
+    img = Image.new("RGB", (WIDTH, HEIGHT))
+    px = img.load()
+    for y in range(HEIGHT):
+        for x in range(WIDTH):
+            r = 40 + 180 * x // (WIDTH - 1)
+            g = 200 - 150 * y // (HEIGHT - 1)
+            d = math.hypot(x - WIDTH * 0.6, y - HEIGHT * 0.45) / 18.0
+            b = int(60 + 150 * max(0.0, 1.0 - d * d))
+            px[x, y] = (r, g, b)
+    return img
+
+
+def save(img, name, options):
+    here = os.path.dirname(os.path.abspath(__file__))
+    jpg = os.path.join(here, name + ".jpg")
+    img.save(jpg, "JPEG", quality=QUALITY, optimize=False, progressive=False, **options)
+    with Image.open(jpg) as decoded:
+        ref = decoded.convert("RGB").tobytes()
+    with open(os.path.join(here, name + ".rgb"), "wb") as f:
+        f.write(ref)
+    print(f"{name}.jpg: {os.path.getsize(jpg)} bytes")
+
+
+def main():
+    card = test_card()
+    for name, options in FIXTURES.items():
+        save(card, name, options)
+    save(card.convert("L"), "jpeg_grey", {})
+
+
+if __name__ == "__main__":
+    main()
@@ -0,0 +1,52 @@
+/**
+ * @file host_test.hpp
+ * @brief Minimal check helpers for the host tests (no framework dependency)
+ * @note Each test is a plain executable that returns non-zero on failure; ctest
+ *       runs them, see tests/CMakeLists.txt.
+ */
+
+#pragma once
+
+#include <cstdio>
+
+namespace host_test {
+
+inline int& failures() {
+    static int count = 0;
+    return count;
+}
+
+inline bool check(bool condition, const char* expression, const char* file, int line) {
+    if (!condition) {
+        printf("%s:%d: check failed: %s\n", file, line, expression);
+        failures()++;
+    }
+    return condition;
+}
+
+// Prints a one-line summary and returns the process exit code
+inline int finish(const char* name) {
+    if (failures() == 0) {
+        printf("%s: ok\n", name);
+        return 0;
+    }
+    printf("%s: %d check(s) failed\n", name, failures());
+    return 1;
+}
+
+} // namespace host_test
+
+#define CHECK(condition) host_test::check((condition), #condition, __FILE__, __LINE__)
+
+// Checks |actual - expected| <= tolerance and reports the values on failure
+#define CHECK_NEAR(actual, expected, tolerance)                                            \
+    do {                                                                                   \
+        const double check_a_ = (actual);                                                  \
+        const double check_e_ = (expected);                                                \
+        if (!host_test::check(check_a_ - check_e_ <= (tolerance) &&                        \
+                              check_e_ - check_a_ <= (tolerance),                          \
+                              #actual " ~ " #expected, __FILE__, __LINE__)) {              \
+            printf("    actual %.9g, expected %.9g, tolerance %.9g\n",                     \
+                   check_a_, check_e_, static_cast<double>(tolerance));                    \
+        }                                                                                  \
+    } while (0)
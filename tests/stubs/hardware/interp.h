@@ -0,0 +1,111 @@
+/**
+ * @file interp.h
+ * @brief Host stand-in for the Pico SDK interpolator API (interp0 only)
+ * @note Models the parts of the RP2040 interpolator the library uses: per-lane
+ *       SHIFT / MASK / ADD_RAW, BASE0..2 and the POP_FULL read, so code written
+ *       against hardware/interp.h can be run on the host. BASE2 is pointer
+ *       sized here so that pixel addresses survive on 64-bit hosts.
+ */
+
+#pragma once
+
+#include <cstdint>
+
+typedef struct {
+    uint32_t shift;
+    uint32_t mask_lsb;
+    uint32_t mask_msb;
+    bool add_raw;
+} interp_config;
+
+struct interp_hw_t;
+
+namespace host_interp {
+
+// POP_FULL: returns BASE2 + both lane results and writes RESULT0/1 back to the accumulators
+struct PopPort {
+    uintptr_t operator[](int lane) const;
+};
+
+} // namespace host_interp
+
+struct interp_hw_t {
+    uint32_t accum[2];
+    uintptr_t base[3];
+    host_interp::PopPort pop;
+    interp_config lane[2];
+};
+
+typedef struct {
+    uint32_t accum[2];
+    uintptr_t base[3];
+    interp_config lane[2];
+} interp_hw_save_t;
+
+inline interp_hw_t* host_interp0() {
+    static interp_hw_t hw = {};
+    return &hw;
+}
+
+#define interp0 (host_interp0())
+
+namespace host_interp {
+
+inline uint32_t lane_shift_mask(const interp_hw_t* hw, int lane) {
+    const interp_config& c = hw->lane[lane];
+    const uint32_t width = c.mask_msb - c.mask_lsb + 1;
+    const uint32_t mask = (width >= 32 ? 0xFFFFFFFFu : ((1u << width) - 1)) << c.mask_lsb;
+    return (hw->accum[lane] >> c.shift) & mask;
+}
+
+inline uint32_t lane_result(const interp_hw_t* hw, int lane) {
+    const uint32_t raw = hw->lane[lane].add_raw ? hw->accum[lane] : lane_shift_mask(hw, lane);
+    return static_cast<uint32_t>(hw->base[lane]) + raw;
+}
+
+inline uintptr_t PopPort::operator[](int lane) const {
+    interp_hw_t* hw = host_interp0();
+    const uintptr_t full = hw->base[2] + lane_shift_mask(hw, 0) + lane_shift_mask(hw, 1);
+    const uint32_t result0 = lane_result(hw, 0);
+    const uint32_t result1 = lane_result(hw, 1);
+    hw->accum[0] = result0;
+    hw->accum[1] = result1;
+    return lane == 2 ? full : (lane == 0 ? result0 : result1);
+}
+
+} // namespace host_interp
+
+inline interp_config interp_default_config() {
+    interp_config c = {};
+    c.mask_msb = 31;
+    return c;
+}
+
+inline void interp_config_set_shift(interp_config* c, unsigned shift) { c->shift = shift; }
+
+inline void interp_config_set_mask(interp_config* c, unsigned mask_lsb, unsigned mask_msb) {
+    c->mask_lsb = mask_lsb;
+    c->mask_msb = mask_msb;
+}
+
+inline void interp_config_set_add_raw(interp_config* c, bool add_raw) { c->add_raw = add_raw; }
+
+inline void interp_set_config(interp_hw_t* interp, unsigned lane, interp_config* config) {
+    interp->lane[lane] = *config;
+}
+
+inline void interp_save(interp_hw_t* interp, interp_hw_save_t* saver) {
+    for (int i = 0; i < 2; i++) {
+        saver->accum[i] = interp->accum[i];
+        saver->lane[i] = interp->lane[i];
+    }
+    for (int i = 0; i < 3; i++) saver->base[i] = interp->base[i];
+}
+
+inline void interp_restore(interp_hw_t* interp, interp_hw_save_t* saver) {
+    for (int i = 0; i < 2; i++) {
+        interp->accum[i] = saver->accum[i];
+        interp->lane[i] = saver->lane[i];
+    }
+    for (int i = 0; i < 3; i++) interp->base[i] = saver->base[i];
+}
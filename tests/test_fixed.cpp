@@ -0,0 +1,105 @@
+/**
+ * @file test_fixed.cpp
+ * @brief Host test: ili9488_fixed.hpp trigonometry and square roots against <cmath>
+ */
+
+#include "ili9488_fixed.hpp"
+#include "host_test.hpp"
+
+#include <cmath>
+
+using namespace ili9488::fixed;
+
+namespace {
+
+constexpr double PI = 3.14159265358979323846;
+
+// Error bounds (measured maximum: sin/cos 4.47e-5, atan2 0.0057°)
+constexpr double SIN_TOLERANCE = 5e-5;
+constexpr double ATAN2_TOLERANCE_DEG = 0.007;
+
+double angle_to_radians(uint32_t angle) {
+    return angle * 2.0 * PI / 65536.0;
+}
+
+void test_sin_cos() {
+    double max_sin = 0;
+    double max_cos = 0;
+    for (uint32_t a = 0; a < 65536; a++) {
+        const angle_t angle = static_cast<angle_t>(a);
+        const double r = angle_to_radians(a);
+        max_sin = std::fmax(max_sin, std::fabs(sin_raw(angle) / 32768.0 - std::sin(r)));
+        max_cos = std::fmax(max_cos, std::fabs(cos_raw(angle) / 32768.0 - std::cos(r)));
+        CHECK_NEAR(sin_q16(angle).to_float(), std::sin(r), SIN_TOLERANCE);
+        CHECK_NEAR(cos_q15(angle).to_float(), std::cos(r), SIN_TOLERANCE);
+    }
+    CHECK_NEAR(max_sin, 0, SIN_TOLERANCE);
+    CHECK_NEAR(max_cos, 0, SIN_TOLERANCE);
+
+    // Exact at the quadrant boundaries
+    CHECK(sin_raw(ANGLE_0) == 0);
+    CHECK(sin_raw(ANGLE_90) == 32768);
+    CHECK(sin_raw(ANGLE_180) == 0);
+    CHECK(sin_raw(ANGLE_270) == -32768);
+    CHECK(sin_q16(ANGLE_90) == q16_16::from_int(1));
+    CHECK(sin_q15(ANGLE_90).raw() == 0x7FFF);
+}
+
+void test_atan2() {
+    double max_error = 0;
+    for (int32_t y = -300; y <= 300; y++) {
+        for (int32_t x = -300; x <= 300; x++) {
+            if (x == 0 && y == 0) {
+                continue;
+            }
+            double error = atan2(y, x) * 360.0 / 65536.0 - std::atan2(y, x) * 180.0 / PI;
+            error = std::fmod(error + 540.0, 360.0) - 180.0;    // wrap to -180..180
+            max_error = std::fmax(max_error, std::fabs(error));
+        }
+    }
+    CHECK_NEAR(max_error, 0, ATAN2_TOLERANCE_DEG);
+
+    // Large magnitudes and the axes
+    CHECK(atan2(0, 0) == 0);
+    CHECK(atan2(0, 1000000) == ANGLE_0);
+    CHECK(atan2(1000000, 0) == ANGLE_90);
+    CHECK(atan2(0, -1000000) == ANGLE_180);
+    CHECK(atan2(-1000000, 0) == ANGLE_270);
+    CHECK(atan2(INT32_MIN, INT32_MIN) == deg_to_angle(225));
+    CHECK_NEAR(atan2(2000000000, 2000000000) * 360.0 / 65536.0, 45.0, ATAN2_TOLERANCE_DEG);
+}
+
+void test_sqrt() {
+    // isqrt is exact: floor(sqrt(v))
+    for (uint64_t v = 0; v <= 0xFFFFFFFFull; v += (v < 70000) ? 1 : 65521) {
+        const uint64_t r = isqrt(static_cast<uint32_t>(v));
+        CHECK(r * r <= v && (r + 1) * (r + 1) > v);
+    }
+    CHECK(isqrt(0xFFFFFFFFu) == 65535);
+
+    for (uint64_t v = 1; v < (1ull << 62); v = v * 3 + 7) {
+        const uint64_t r = isqrt64(v);
+        CHECK(r * r <= v && (r + 1) * (r + 1) > v);
+    }
+
+    for (int32_t dy = -2000; dy <= 2000; dy += 37) {
+        for (int32_t dx = -2000; dx <= 2000; dx += 41) {
+            CHECK(hypot(dx, dy) == static_cast<uint32_t>(std::floor(std::hypot(dx, dy) + 1e-9)));
+        }
+    }
+    CHECK(hypot(INT32_MIN, INT32_MIN) == static_cast<uint32_t>(std::floor(std::hypot(2147483648.0, 2147483648.0))));
+
+    for (double v = 0.0; v < 30000.0; v = v * 1.37 + 0.01) {
+        CHECK_NEAR(sqrt(q16_16::from_float(static_cast<float>(v))).to_float(), std::sqrt(v),
+                   std::sqrt(v) * 1e-4 + 2.0 / 65536.0);
+    }
+}
+
+} // namespace
+
+int main() {
+    test_sin_cos();
+    test_atan2();
+    test_sqrt();
+    return host_test::finish("test_fixed");
+}
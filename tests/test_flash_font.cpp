@@ -0,0 +1,286 @@
+/**
+ * @file test_flash_font.cpp
+ * @brief Host test: FlashFontCache::decode_glyph() against a reference encoder
+ * @note Glyphs are encoded here as RAW / RLE / EMPTY / CONTEXT records (the
+ *       formats written by tools/font_v2_pack.py and tools/font_compiler),
+ *       decoded with the firmware decoder and compared pixel for pixel.
+ */
+
+#include "flash_font_cache.hpp"
+#include "host_test.hpp"
+
+#include <cstring>
+#include <vector>
+
+using ili9488_font::FlashFontCache;
+
+namespace {
+
+constexpr size_t CONTEXTS = ili9488_font::FONT_CONTEXT_COUNT;
+
+struct Shape {
+    int width;
+    int height;
+    int bpp;
+};
+
+// One pixel level (0 .. 2^bpp-1) per byte, row by row
+using Pixels = std::vector<uint8_t>;
+
+uint32_t g_seed = 12345;
+
+uint32_t next_random() {
+    g_seed = g_seed * 1103515245u + 12345u;
+    return g_seed >> 16;
+}
+
+// A ring with anti-aliased edges: long runs and structured contexts
+Pixels ring(const Shape& s) {
+    Pixels pixels(static_cast<size_t>(s.width) * s.height);
+    const int cx = s.width / 2;
+    const int cy = s.height / 2;
+    const int outer = (s.width / 2 - 1) * (s.width / 2 - 1);
+    const int inner = (s.width / 4) * (s.width / 4);
+    const int max_level = (1 << s.bpp) - 1;
+    for (int y = 0; y < s.height; y++) {
+        for (int x = 0; x < s.width; x++) {
+            const int d = (x - cx) * (x - cx) + (y - cy) * (y - cy);
+            int level = (d <= outer && d >= inner) ? max_level : 0;
+            if (level && s.bpp == 2 && (d > outer - s.width || d < inner + s.width)) {
+                level = 1 + (x + y) % 2;
+            }
+            pixels[static_cast<size_t>(y) * s.width + x] = static_cast<uint8_t>(level);
+        }
+    }
+    return pixels;
+}
+
+// Noise: short runs, every context, and carries in the range coder
+Pixels noise(const Shape& s) {
+    Pixels pixels(static_cast<size_t>(s.width) * s.height);
+    for (uint8_t& p : pixels) {
+        p = static_cast<uint8_t>(next_random() & ((1 << s.bpp) - 1));
+    }
+    return pixels;
+}
+
+std::vector<uint8_t> pack_rows(const Shape& s, const Pixels& pixels) {
+    const int stride = (s.width * s.bpp + 7) / 8;
+    std::vector<uint8_t> out(static_cast<size_t>(stride) * s.height, 0);
+    for (int row = 0; row < s.height; row++) {
+        for (int col = 0; col < s.width; col++) {
+            const int bit = col * s.bpp;
+            out[static_cast<size_t>(row) * stride + (bit >> 3)] |=
+                static_cast<uint8_t>(pixels[static_cast<size_t>(row) * s.width + col] << (8 - s.bpp - (bit & 7)));
+        }
+    }
+    return out;
+}
+
+std::vector<uint8_t> encode_raw(const Shape& s, const Pixels& pixels) {
+    std::vector<uint8_t> record = {ili9488_font::GLYPH_RAW};
+    const std::vector<uint8_t> rows = pack_rows(s, pixels);
+    record.insert(record.end(), rows.begin(), rows.end());
+    return record;
+}
+
+std::vector<uint8_t> encode_rle(const Pixels& pixels) {
+    std::vector<uint8_t> record = {ili9488_font::GLYPH_RLE};
+    for (size_t i = 0; i < pixels.size();) {
+        size_t run = 1;
+        while (i + run < pixels.size() && pixels[i + run] == pixels[i] && run < 64) {
+            run++;
+        }
+        record.push_back(static_cast<uint8_t>((pixels[i] << 6) | (run - 1)));
+        i += run;
+    }
+    return record;
+}
+
+// LZMA-style range encoder, the counterpart of RangeDecoder in flash_font_cache.cpp
+class RangeEncoder {
+public:
+    void encode(int bit, uint8_t p0) {
+        const uint32_t bound = (range_ >> 8) * p0;
+        if (bit) {
+            low_ += bound;
+            range_ -= bound;
+        } else {
+            range_ = bound;
+        }
+        while (range_ < (1u << 24)) {
+            range_ <<= 8;
+            shift_low();
+        }
+    }
+
+    // Flushes all of low; the first byte out of the carry logic is always 0
+    std::vector<uint8_t> finish() {
+        for (int i = 0; i < 5; i++) {
+            shift_low();
+        }
+        return std::vector<uint8_t>(bytes_.begin() + 1, bytes_.end());
+    }
+
+private:
+    void shift_low() {
+        if (static_cast<uint32_t>(low_) < 0xFF000000u || (low_ >> 32) != 0) {
+            const uint8_t carry = static_cast<uint8_t>(low_ >> 32);
+            uint8_t pending = cache_;
+            do {
+                bytes_.push_back(static_cast<uint8_t>(pending + carry));
+                pending = 0xFF;
+            } while (--cache_size_ != 0);
+            cache_ = static_cast<uint8_t>(low_ >> 24);
+        }
+        cache_size_++;
+        low_ = (low_ & 0x00FFFFFFu) << 8;
+    }
+
+    uint64_t low_ = 0;
+    uint32_t range_ = 0xFFFFFFFFu;
+    uint8_t cache_ = 0;
+    uint64_t cache_size_ = 1;
+    std::vector<uint8_t> bytes_;
+};
+
+// Same context as decode_context(): rows -2 (x-1..x+1), -1 (x-2..x+2), 0 (x-2..x-1)
+std::vector<uint8_t> encode_context(const Shape& s, const Pixels& pixels, const std::vector<uint8_t>& model) {
+    RangeEncoder encoder;
+    uint32_t ink2 = 0;
+    uint32_t ink1 = 0;
+    for (int row = 0; row < s.height; row++) {
+        uint32_t ink0 = 0;
+        for (int col = 0; col < s.width; col++) {
+            const uint32_t context = (((ink2 >> (col + 1)) & 0x07) << 7) |
+                                     (((ink1 >> col) & 0x1F) << 2) |
+                                     ((ink0 >> col) & 0x03);
+            const uint8_t level = pixels[static_cast<size_t>(row) * s.width + col];
+            const int high = level >> (s.bpp - 1);
+            encoder.encode(high, model[context]);
+            if (s.bpp == 2) {
+                encoder.encode(level & 1, model[(1 + high) * CONTEXTS + context]);
+            }
+            if (high) {
+                ink0 |= 1u << (col + 2);
+            }
+        }
+        ink2 = ink1;
+        ink1 = ink0;
+    }
+    std::vector<uint8_t> record = {ili9488_font::GLYPH_CONTEXT};
+    const std::vector<uint8_t> bits = encoder.finish();
+    record.insert(record.end(), bits.begin(), bits.end());
+    return record;
+}
+
+// Any probability 1..255 decodes correctly; spread them so both extremes are used
+std::vector<uint8_t> make_model(int bpp) {
+    std::vector<uint8_t> model(((1u << bpp) - 1) * CONTEXTS);
+    for (size_t i = 0; i < model.size(); i++) {
+        model[i] = static_cast<uint8_t>(1 + (i * 37 + (i >> 5)) % 255);
+    }
+    model[0] = 250;     // all-background context: mostly 0 as in real fonts
+    return model;
+}
+
+bool decodes_to(const Shape& s, const std::vector<uint8_t>& record, const std::vector<uint8_t>& model,
+                const Pixels& pixels) {
+    const std::vector<uint8_t> expected = pack_rows(s, pixels);
+    std::vector<uint8_t> dst(expected.size(), 0xA5);    // decoder must clear what it does not set
+    if (!FlashFontCache::decode_glyph(record.data(), record.size(), s.width, s.height, s.bpp,
+                                      model.data(), dst.data())) {
+        return false;
+    }
+    return dst == expected;
+}
+
+void test_round_trip(const Shape& s) {
+    const std::vector<uint8_t> model = make_model(s.bpp);
+    const Pixels blank(static_cast<size_t>(s.width) * s.height, 0);
+    const std::vector<uint8_t> empty = {ili9488_font::GLYPH_EMPTY};
+    CHECK(decodes_to(s, empty, model, blank));
+
+    for (int i = 0; i < 8; i++) {
+        const Pixels pixels = (i == 0) ? ring(s) : noise(s);
+        CHECK(decodes_to(s, encode_raw(s, pixels), model, pixels));
+        CHECK(decodes_to(s, encode_rle(pixels), model, pixels));
+        CHECK(decodes_to(s, encode_context(s, pixels, model), model, pixels));
+    }
+
+    // Full-coverage glyph: a single colour, encoded with context records as well
+    const Pixels solid(blank.size(), static_cast<uint8_t>((1 << s.bpp) - 1));
+    CHECK(decodes_to(s, encode_rle(solid), model, solid));
+    CHECK(decodes_to(s, encode_context(s, solid, model), model, solid));
+    CHECK(decodes_to(s, encode_context(s, blank, model), model, blank));
+}
+
+void test_bad_records() {
+    const Shape s = {16, 16, 2};
+    const std::vector<uint8_t> model = make_model(s.bpp);
+    const Pixels pixels = ring(s);
+    std::vector<uint8_t> dst(pack_rows(s, pixels).size());
+
+    // Unknown encoding byte and invalid bpp
+    const std::vector<uint8_t> unknown = {7, 0, 0, 0};
+    CHECK(!FlashFontCache::decode_glyph(unknown.data(), unknown.size(), s.width, s.height, s.bpp,
+                                        model.data(), dst.data()));
+    const std::vector<uint8_t> raw = encode_raw(s, pixels);
+    CHECK(!FlashFontCache::decode_glyph(raw.data(), raw.size(), s.width, s.height, 3,
+                                        model.data(), dst.data()));
+    CHECK(!FlashFontCache::decode_glyph(raw.data(), 0, s.width, s.height, s.bpp,
+                                        model.data(), dst.data()));
+
+    // Truncated RAW and RLE records, and runs past the end of the glyph
+    CHECK(!FlashFontCache::decode_glyph(raw.data(), raw.size() - 1, s.width, s.height, s.bpp,
+                                        model.data(), dst.data()));
+    std::vector<uint8_t> rle = encode_rle(pixels);
+    CHECK(!FlashFontCache::decode_glyph(rle.data(), rle.size() - 1, s.width, s.height, s.bpp,
+                                        model.data(), dst.data()));
+    rle.push_back(0x3F);
+    CHECK(!FlashFontCache::decode_glyph(rle.data(), rle.size(), s.width, s.height, s.bpp,
+                                        model.data(), dst.data()));
+
+    // Context records need the model
+    const std::vector<uint8_t> coded = encode_context(s, pixels, model);
+    CHECK(!FlashFontCache::decode_glyph(coded.data(), coded.size(), s.width, s.height, s.bpp,
+                                        nullptr, dst.data()));
+}
+
+std::vector<uint8_t> make_header(int width, int height, int bpp) {
+    ili9488_font::FontHeaderV2 header = {};
+    header.version = 2;
+    header.glyph_count = 1;
+    header.width = static_cast<uint8_t>(width);
+    header.height = static_cast<uint8_t>(height);
+    header.bpp = static_cast<uint8_t>(bpp);
+    header.index_offset = sizeof(header);
+    header.data_offset = sizeof(header) + 8;
+    std::vector<uint8_t> file(64, 0);
+    std::memcpy(file.data(), &header, sizeof(header));
+    return file;
+}
+
+void test_bad_header() {
+    FlashFontCache& cache = FlashFontCache::get_instance();
+    CHECK(cache.initialize(make_header(16, 16, 2).data(), 16));
+    CHECK(cache.get_bits_per_pixel() == 2);
+
+    CHECK(!cache.initialize(make_header(16, 16, 3).data(), 16));    // bpp must be 1 or 2
+    CHECK(!cache.initialize(make_header(0, 16, 1).data(), 16));     // empty glyph
+    CHECK(!cache.initialize(make_header(32, 32, 2).data(), 16));    // larger than a cache slot
+    CHECK(!cache.initialize(make_header(16, 16, 1).data(), 20));    // only 16 and 24 are supported
+    CHECK(!cache.initialize(nullptr, 16));
+}
+
+} // namespace
+
+int main() {
+    test_round_trip({16, 16, 1});
+    test_round_trip({16, 16, 2});
+    test_round_trip({24, 24, 1});
+    test_round_trip({12, 16, 2});
+    test_bad_records();
+    test_bad_header();
+    return host_test::finish("test_flash_font");
+}
@@ -0,0 +1,185 @@
+/**
+ * @file test_jpeg.cpp
+ * @brief Host test: JpegDecoder output against libjpeg reference decodes
+ * @note Fixtures live in tests/data and are produced by make_jpeg_fixtures.py:
+ *       a 72x40 test card (partial MCUs on both edges) at 4:4:4, 4:2:2 and
+ *       4:2:0, 4:2:0 with restart markers, and greyscale.
+ */
+
+#include "jpeg_decoder.hpp"
+#include "host_test.hpp"
+
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <iterator>
+#include <vector>
+
+using namespace ili9488_image;
+
+namespace {
+
+constexpr int16_t IMAGE_W = 72;
+constexpr int16_t IMAGE_H = 40;
+
+// Error bounds per channel against libjpeg (measured maximum / mean in brackets).
+// The panel keeps 6 bits (up to 3 levels lost) and the AAN IDCT rounds a little
+// differently from libjpeg's; subsampled chroma is replicated here where libjpeg
+// interpolates, which adds a few levels on this smooth card.
+struct Tolerance {
+    int max_error;
+    double mean_error;
+};
+constexpr Tolerance FULL_CHROMA = {6, 1.6};     // 4:4:4 and greyscale (5 / 1.51)
+constexpr Tolerance SUBSAMPLED = {16, 2.5};     // 4:2:2 and 4:2:0 (15 / 2.21)
+
+/**
+ * @brief Display that records what the default bulk hooks plot
+ */
+class FrameBuffer : public ili9488::ILI9488_UI {
+public:
+    FrameBuffer(int16_t w, int16_t h) : ILI9488_UI(w, h), pixels_(static_cast<size_t>(w) * h, 0xFFFFFFFF) {}
+
+    void writePixel(uint16_t x, uint16_t y, uint16_t color) override {}
+
+    void writePixelRGB24(uint16_t x, uint16_t y, uint32_t color) override {
+        if (x < width() && y < height()) pixels_[static_cast<size_t>(y) * width() + x] = color;
+    }
+
+    uint32_t at(int16_t x, int16_t y) const { return pixels_[static_cast<size_t>(y) * width() + x]; }
+
+private:
+    std::vector<uint32_t> pixels_;
+};
+
+JpegDecoder g_decoder;
+
+std::vector<uint8_t> load(const char* path) {
+    std::ifstream file(path, std::ios::binary);
+    if (!file) printf("cannot open %s\n", path);
+    return std::vector<uint8_t>(std::istreambuf_iterator<char>(file), std::istreambuf_iterator<char>());
+}
+
+/**
+ * @brief Decode @p jpeg at (x, y) and compare the visible part with the reference
+ */
+void check_decode(const char* name, const std::vector<uint8_t>& jpeg, const std::vector<uint8_t>& ref,
+                  const Tolerance& tolerance, int16_t x, int16_t y, int16_t display_w, int16_t display_h) {
+    if (!CHECK(!jpeg.empty() && ref.size() == static_cast<size_t>(IMAGE_W) * IMAGE_H * 3)) return;
+
+    FrameBuffer fb(display_w, display_h);
+    MemorySource source(jpeg.data(), jpeg.size());
+    const ImageStatus status = g_decoder.decode(source, fb, x, y);
+    if (!CHECK(status == ImageStatus::Ok)) {
+        printf("    %s: %s\n", name, statusName(status));
+        return;
+    }
+    CHECK(g_decoder.info().width == IMAGE_W && g_decoder.info().height == IMAGE_H);
+
+    int max_error = 0;
+    long total_error = 0;
+    long samples = 0;
+    long untouched = 0;
+    for (int16_t sy = 0; sy < display_h; sy++) {
+        for (int16_t sx = 0; sx < display_w; sx++) {
+            const int16_t ix = sx - x;
+            const int16_t iy = sy - y;
+            const bool inside = ix >= 0 && iy >= 0 && ix < IMAGE_W && iy < IMAGE_H;
+            const uint32_t got = fb.at(sx, sy);
+            if (!inside) {
+                // Nothing may be drawn outside the image
+                if (got != 0xFFFFFFFF) untouched++;
+                continue;
+            }
+            if (got == 0xFFFFFFFF) {
+                untouched++;
+                continue;
+            }
+            const uint8_t* expected = &ref[(static_cast<size_t>(iy) * IMAGE_W + ix) * 3];
+            for (int ch = 0; ch < 3; ch++) {
+                const int value = (got >> (16 - 8 * ch)) & 0xFF;
+                const int error = std::abs(value - expected[ch]);
+                if (error > max_error) max_error = error;
+                total_error += error;
+                samples++;
+            }
+        }
+    }
+
+    const double mean_error = samples ? static_cast<double>(total_error) / samples : 0;
+    printf("%s at (%d, %d): max error %d, mean %.2f\n", name, x, y, max_error, mean_error);
+    CHECK(untouched == 0);
+    CHECK(max_error <= tolerance.max_error);
+    CHECK(mean_error <= tolerance.mean_error);
+}
+
+void test_fixture(const char* name, const Tolerance& tolerance) {
+    char path[64];
+    snprintf(path, sizeof(path), "data/%s.jpg", name);
+    const std::vector<uint8_t> jpeg = load(path);
+    snprintf(path, sizeof(path), "data/%s.rgb", name);
+    const std::vector<uint8_t> ref = load(path);
+
+    check_decode(name, jpeg, ref, tolerance, 0, 0, IMAGE_W, IMAGE_H);
+    // Clipped on all four sides
+    check_decode(name, jpeg, ref, tolerance, -5, -3, IMAGE_W - 12, IMAGE_H - 9);
+    // Placed inside a larger display
+    check_decode(name, jpeg, ref, tolerance, 11, 7, IMAGE_W + 20, IMAGE_H + 16);
+}
+
+/**
+ * @brief Rewrite a baseline file as SOF1 with its Huffman tables in slots 2 and 3
+ */
+std::vector<uint8_t> to_extended_tables(std::vector<uint8_t> jpeg) {
+    size_t pos = 2;
+    while (pos + 4 <= jpeg.size() && jpeg[pos] == 0xFF) {
+        const uint8_t marker = jpeg[pos + 1];
+        const size_t length = (jpeg[pos + 2] << 8) | jpeg[pos + 3];
+        const size_t body = pos + 4;
+        const size_t end = pos + 2 + length;
+
+        if (marker == 0xC0) {
+            jpeg[pos + 1] = 0xC1;
+        } else if (marker == 0xC4) {
+            for (size_t p = body; p < end;) {
+                jpeg[p] |= 0x02;                    // Th 0/1 -> 2/3
+                size_t total = 0;
+                for (int i = 1; i <= 16; i++) total += jpeg[p + i];
+                p += 17 + total;
+            }
+        } else if (marker == 0xDA) {
+            const uint8_t count = jpeg[body];
+            for (uint8_t i = 0; i < count; i++) jpeg[body + 2 + 2 * i] |= 0x22;
+            break;
+        }
+        pos = end;
+    }
+    return jpeg;
+}
+
+void test_extended_tables() {
+    const std::vector<uint8_t> jpeg = to_extended_tables(load("data/jpeg_444.jpg"));
+    const std::vector<uint8_t> ref = load("data/jpeg_444.rgb");
+    check_decode("jpeg_444 as SOF1, tables 2/3", jpeg, ref, FULL_CHROMA, 0, 0, IMAGE_W, IMAGE_H);
+}
+
+void test_truncated() {
+    std::vector<uint8_t> jpeg = load("data/jpeg_420.jpg");
+    jpeg.resize(jpeg.size() - 200);            // Cut inside the scan
+    FrameBuffer fb(IMAGE_W, IMAGE_H);
+    MemorySource source(jpeg.data(), jpeg.size());
+    CHECK(g_decoder.decode(source, fb, 0, 0) == ImageStatus::ReadError);
+}
+
+} // namespace
+
+int main() {
+    test_fixture("jpeg_444", FULL_CHROMA);
+    test_fixture("jpeg_422", SUBSAMPLED);
+    test_fixture("jpeg_420", SUBSAMPLED);
+    test_fixture("jpeg_420_rst", SUBSAMPLED);
+    test_fixture("jpeg_grey", FULL_CHROMA);
+    test_extended_tables();
+    test_truncated();
+    return host_test::finish("test_jpeg");
+}
@@ -0,0 +1,175 @@
+#!/usr/bin/env python3
+"""
+anim_pack.py - Pack frames into delta-encoded .anm files for ili9488_image::DeltaAnimPlayer
+
+Each frame is compared with the previous one (in RGB666, after dropping the
+two bits the panel ignores) on a grid of tiles; changed tiles are merged into
+rectangles and only those are stored, as RGB666 wire bytes. Unchanged frames
+are not stored at all - the previous frame is held until the next change.
+Every --keyframe-interval frames a full-window keyframe is written so the
+player can drop forward to it when it falls behind.
+
+File layout (little-endian, see include/image/delta_anim_player.hpp):
+    "DANM", version, reserved, header_size, x, y, width, height,
+    frame_count, fps, total_ticks, keyframe_count,
+    keyframe_count x { frame, tick, offset },
+    frame records: size, tick, rect_count, rect_count x { x, y, w, h, pixels }
+
+Usage:
+    python3 tools/anim_pack.py spinner.gif --fps 30 --x 128 --y 208 -o spinner.anm
+    python3 tools/anim_pack.py boot_*.png --fps 15 --keyframe-interval 15 -o boot.anm
+
+Requires Pillow (pip install pillow).
+"""
+
+import argparse
+import struct
+import sys
+
+try:
+    from PIL import Image, ImageSequence
+except ImportError:
+    sys.stderr.write("anim_pack.py: Pillow is required (pip install pillow)\n")
+    sys.exit(1)
+
+MAGIC = b"DANM"
+VERSION = 1
+HEADER_SIZE = 24
+KEYFRAME_ENTRY = 8
+RECORD_HEADER = 8
+RECT_HEADER = 8
+
+
+def load_frames(paths, fps):
+    """Return a list of (wire_bytes, ticks) with ticks = how long the frame stays up."""
+    frames = []
+    for path in paths:
+        img = Image.open(path)
+        for frame in ImageSequence.Iterator(img):
+            duration = frame.info.get("duration")
+            ticks = max(1, round(duration * fps / 1000.0)) if duration and fps else 1
+            rgb = frame.convert("RGB")
+            frames.append((rgb.size, bytes(b & 0xFC for b in rgb.tobytes()), ticks))
+    return frames
+
+
+def changed_tiles(prev, cur, width, height, tile):
+    cols = (width + tile - 1) // tile
+    rows = (height + tile - 1) // tile
+    grid = [[False] * cols for _ in range(rows)]
+    for y in range(height):
+        a = prev[y * width * 3:(y + 1) * width * 3]
+        b = cur[y * width * 3:(y + 1) * width * 3]
+        if a == b:
+            continue
+        row = grid[y // tile]
+        for tx in range(cols):
+            x0 = tx * tile * 3
+            x1 = min(width, (tx + 1) * tile) * 3
+            if not row[tx] and a[x0:x1] != b[x0:x1]:
+                row[tx] = True
+    return grid
+
+
+def merge_rects(grid, width, height, tile):
+    """Runs of changed tiles per tile row, merged downwards when the spans match."""
+    rects = []
+    open_rects = {}
+    for ty, row in enumerate(grid):
+        spans = []
+        tx = 0
+        while tx < len(row):
+            if row[tx]:
+                start = tx
+                while tx < len(row) and row[tx]:
+                    tx += 1
+                spans.append((start, tx))
+            else:
+                tx += 1
+        next_open = {}
+        for span in spans:
+            if span in open_rects:
+                rect = open_rects.pop(span)
+                rect[3] += 1
+            else:
+                rect = [span[0], ty, span[1] - span[0], 1]
+                rects.append(rect)
+            next_open[span] = rect
+        open_rects = next_open
+
+    result = []
+    for tx, ty, tw, th in rects:
+        x, y = tx * tile, ty * tile
+        result.append((x, y, min(tw * tile, width - x), min(th * tile, height - y)))
+    return result
+
+
+def crop(pixels, width, rect):
+    x, y, w, h = rect
+    return b"".join(pixels[((y + j) * width + x) * 3:((y + j) * width + x + w) * 3] for j in range(h))
+
+
+def main():
+    parser = argparse.ArgumentParser(description="Pack frames into ILI9488 delta animations (.anm)")
+    parser.add_argument("inputs", nargs="+", help="images; each frame of each file becomes one frame")
+    parser.add_argument("-o", "--output", required=True, help="output .anm file")
+    parser.add_argument("--x", type=int, default=0, help="window x on screen (default 0)")
+    parser.add_argument("--y", type=int, default=0, help="window y on screen (default 0)")
+    parser.add_argument("--fps", type=int, default=30, help="tick rate (default 30)")
+    parser.add_argument("--tile", type=int, default=16, help="change detection tile size (default 16)")
+    parser.add_argument("--keyframe-interval", type=int, default=0,
+                        help="write a full keyframe every N stored frames (default 0: first frame only)")
+    args = parser.parse_args()
+
+    frames = load_frames(args.inputs, args.fps)
+    (width, height) = frames[0][0]
+    for size, _, _ in frames:
+        if size != (width, height):
+            parser.error("all frames must be %dx%d (got %dx%d)" % (width, height, *size))
+
+    records = []    # (tick, is_key, rects, pixels)
+    prev = None
+    tick = 0
+    for index, (_, pixels, ticks) in enumerate(frames):
+        key = prev is None or (args.keyframe_interval and len(records) % args.keyframe_interval == 0)
+        if key:
+            rects = [(0, 0, width, height)]
+        else:
+            rects = merge_rects(changed_tiles(prev, pixels, width, height, args.tile), width, height, args.tile)
+        if rects:
+            records.append((tick, key, [(r, crop(pixels, width, r)) for r in rects]))
+        prev = pixels
+        tick += ticks
+    total_ticks = tick
+    if total_ticks > 0xFFFF or len(records) > 0xFFFF:
+        parser.error("animation too long (%d ticks, %d frames)" % (total_ticks, len(records)))
+
+    keyframes = [i for i, record in enumerate(records) if record[1]]
+    header_size = HEADER_SIZE + KEYFRAME_ENTRY * len(keyframes)
+
+    body = []
+    offsets = []
+    offset = header_size
+    for tick, _, rects in records:
+        data = b"".join(struct.pack("<HHHH", *r) + px for r, px in rects)
+        record = struct.pack("<IHH", RECORD_HEADER + len(data), tick, len(rects)) + data
+        offsets.append(offset)
+        offset += len(record)
+        body.append(record)
+
+    header = MAGIC + struct.pack("<BBHhhHHHHHH", VERSION, 0, header_size, args.x, args.y, width, height,
+                                 len(records), args.fps, total_ticks, len(keyframes))
+    table = b"".join(struct.pack("<HHI", i, records[i][0], offsets[i]) for i in keyframes)
+    with open(args.output, "wb") as f:
+        f.write(header + table)
+        for record in body:
+            f.write(record)
+
+    raw = width * height * 3 * len(frames)
+    print("%s: %dx%d, %d frames -> %d records (%d keyframes), %d bytes vs %d raw (%.0f%%), largest record %d"
+          % (args.output, width, height, len(frames), len(records), len(keyframes), offset, raw,
+             100.0 * offset / max(raw, 1), max(len(r) for r in body)))
+
+
+if __name__ == "__main__":
+    main()
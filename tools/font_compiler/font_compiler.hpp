@@ -0,0 +1,80 @@
+/**
+ * @file font_compiler.hpp
+ * @brief Host font compiler: shared types of the loaders and writers
+ * @note Not part of the Pico build, see tools/font_compiler/CMakeLists.txt.
+ */
+
+#pragma once
+
+#include <cstdint>
+#include <set>
+#include <string>
+#include <vector>
+
+namespace font_compiler {
+
+// One glyph in the output cell, pixels row-major, values 0..(1 << bpp) - 1
+struct Glyph {
+    uint32_t code = 0;
+    int advance = 0;                // pen advance in pixels as designed by the font
+    std::vector<uint8_t> pixels;
+};
+
+// Left glyph code, right glyph code, adjustment in pixels
+struct Kerning {
+    uint32_t left;
+    uint32_t right;
+    int adjust;
+};
+
+struct GlyphSet {
+    int width = 0;
+    int height = 0;
+    int bpp = 1;
+    std::vector<Glyph> glyphs;      // sorted by code, the glyph index is the position
+    std::vector<Kerning> kerning;   // only filled when asked for
+    std::vector<uint32_t> missing;  // requested code points the font does not have
+};
+
+struct LoadOptions {
+    int size = 16;                  // cell width and height in pixels
+    int bpp = 1;                    // 2 = anti-aliased coverage (outline fonts only)
+    bool kerning = false;           // collect kerning pairs (outline fonts only)
+    uint32_t kerning_end = 0x2E80;  // only pairs of code points below this
+};
+
+// Code points used by a UTF-8 file (invalid sequences and controls are skipped)
+bool collect_text(const std::string& path, std::set<uint32_t>& codes, std::string& error);
+
+// BDF bitmap font, 1bpp, glyphs placed on the font baseline
+bool load_bdf(const std::string& path, const std::set<uint32_t>& codes, const LoadOptions& options,
+              GlyphSet& out, std::string& error);
+
+// TrueType/OpenType via FreeType (returns false with a message when built without it)
+bool load_outline(const std::string& path, const std::set<uint32_t>& codes, const LoadOptions& options,
+                  GlyphSet& out, std::string& error);
+
+struct ContainerOptions {
+    bool model = true;              // train and use the context model
+    bool advances = false;          // write the per-glyph advance table
+    uint32_t proportional_end = 0x2E80;     // code points at or above keep the full width
+};
+
+struct ContainerStats {
+    size_t raw_bytes = 0;           // size of the same glyphs as a version 1 font
+    size_t bytes = 0;
+    int encodings[4] = {0, 0, 0, 0};
+    int narrow = 0;                 // glyphs with an advance below the cell width
+    int kerning_pairs = 0;
+};
+
+// Version 2 container (FontHeaderV2 in include/fonts/flash_font_cache.hpp);
+// every record is decoded again with FlashFontCache::decode_glyph and compared
+bool build_container(const GlyphSet& set, const ContainerOptions& options, std::vector<uint8_t>& out,
+                     ContainerStats& stats, std::string& error);
+
+// unicode_ranges.h for the glyph order of the set (same layout as tools/unicode_ranges_gen.py)
+bool build_ranges_header(const GlyphSet& set, const std::string& source, std::string& out,
+                         std::string& error);
+
+} // namespace font_compiler
@@ -0,0 +1,343 @@
+/**
+ * @file font_container.cpp
+ * @brief Host font compiler: version 2 flash font container
+ *
+ * Same encoder as tools/font_v2_pack.py (context model trained on the font,
+ * smallest of RAW / RLE / EMPTY / CONTEXT per glyph), written against the
+ * structures in flash_font_cache.hpp so the layout cannot drift from the reader.
+ */
+
+#include "font_compiler.hpp"
+#include "flash_font_cache.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+#include <map>
+
+namespace font_compiler {
+
+using ili9488_font::FlashFontCache;
+
+namespace {
+
+constexpr int MAX_RUN = 64;
+constexpr size_t BLOCK_GLYPHS = 32;     // FlashFontCache::V2_BLOCK_GLYPHS
+constexpr size_t CONTEXTS = ili9488_font::FONT_CONTEXT_COUNT;
+
+void put_u16(std::vector<uint8_t>& out, uint32_t value) {
+    out.push_back(static_cast<uint8_t>(value));
+    out.push_back(static_cast<uint8_t>(value >> 8));
+}
+
+void put_u32(std::vector<uint8_t>& out, uint32_t value) {
+    put_u16(out, value & 0xFFFF);
+    put_u16(out, value >> 16);
+}
+
+int stride_of(const GlyphSet& set) {
+    return (set.width * set.bpp + 7) / 8;
+}
+
+std::vector<uint8_t> pack_rows(const GlyphSet& set, const Glyph& glyph) {
+    const int stride = stride_of(set);
+    std::vector<uint8_t> out(static_cast<size_t>(stride) * set.height, 0);
+    for (int row = 0; row < set.height; row++) {
+        for (int col = 0; col < set.width; col++) {
+            const int bit = col * set.bpp;
+            out[static_cast<size_t>(row) * stride + (bit >> 3)] |=
+                static_cast<uint8_t>(glyph.pixels[static_cast<size_t>(row) * set.width + col] << (8 - set.bpp - (bit & 7)));
+        }
+    }
+    return out;
+}
+
+std::vector<uint8_t> encode_rle(const std::vector<uint8_t>& pixels) {
+    std::vector<uint8_t> out;
+    for (size_t i = 0; i < pixels.size();) {
+        const uint8_t value = pixels[i];
+        int run = 1;
+        while (i + run < pixels.size() && pixels[i + run] == value && run < MAX_RUN) {
+            run++;
+        }
+        out.push_back(static_cast<uint8_t>((value << 6) | (run - 1)));
+        i += run;
+    }
+    return out;
+}
+
+// Every binary decision of a glyph in decode order: (table, context, bit)
+template<typename Visit>
+void decisions(const GlyphSet& set, const std::vector<uint8_t>& pixels, Visit visit) {
+    uint32_t ink2 = 0;
+    uint32_t ink1 = 0;
+    for (int row = 0; row < set.height; row++) {
+        uint32_t ink0 = 0;
+        for (int col = 0; col < set.width; col++) {
+            const uint32_t context = (((ink2 >> (col + 1)) & 0x07) << 7) |
+                                     (((ink1 >> col) & 0x1F) << 2) |
+                                     ((ink0 >> col) & 0x03);
+            const uint8_t level = pixels[static_cast<size_t>(row) * set.width + col];
+            const int high = level >> (set.bpp - 1);
+            visit(0, context, high);
+            if (set.bpp == 2) {
+                visit(1 + high, context, level & 1);
+            }
+            if (high) {
+                ink0 |= 1u << (col + 2);
+            }
+        }
+        ink2 = ink1;
+        ink1 = ink0;
+    }
+}
+
+std::vector<uint8_t> train_model(const GlyphSet& set) {
+    const int tables = (1 << set.bpp) - 1;
+    std::vector<uint32_t> counts(static_cast<size_t>(tables) * CONTEXTS * 2, 0);
+    for (const Glyph& glyph : set.glyphs) {
+        decisions(set, glyph.pixels, [&](int table, uint32_t context, int bit) {
+            counts[(table * CONTEXTS + context) * 2 + bit]++;
+        });
+    }
+
+    std::vector<uint8_t> model(static_cast<size_t>(tables) * CONTEXTS);
+    for (size_t i = 0; i < model.size(); i++) {
+        const double zeros = counts[i * 2];
+        const double ones = counts[i * 2 + 1];
+        const long p0 = std::lround(256.0 * (zeros + 0.4) / (zeros + ones + 0.8));
+        model[i] = static_cast<uint8_t>(std::min(255L, std::max(1L, p0)));
+    }
+    return model;
+}
+
+// LZMA-style range encoder matching RangeDecoder in flash_font_cache.cpp
+class RangeEncoder {
+public:
+    void encode(int bit, uint8_t p0) {
+        const uint32_t bound = (range_ >> 8) * p0;
+        if (bit) {
+            low_ += bound;
+            range_ -= bound;
+        } else {
+            range_ = bound;
+        }
+        while (range_ < (1u << 24)) {
+            range_ <<= 8;
+            shift_low();
+        }
+    }
+
+    // Any value in [low, low + range) decodes the same: take the one with the
+    // most trailing zero bytes, the decoder reads zeros past the end
+    std::vector<uint8_t> finish() {
+        for (int k = 4; k >= 0; k--) {
+            const uint64_t step = 1ull << (8 * k);
+            const uint64_t value = (low_ + step - 1) / step * step;
+            if (value < low_ + range_) {
+                low_ = value;
+                break;
+            }
+        }
+        for (int i = 0; i < 5; i++) {
+            shift_low();
+        }
+        // The first byte out of the carry logic is always 0 and not stored
+        std::vector<uint8_t> out(bytes_.begin() + 1, bytes_.end());
+        while (!out.empty() && out.back() == 0) {
+            out.pop_back();
+        }
+        return out;
+    }
+
+private:
+    void shift_low() {
+        if (static_cast<uint32_t>(low_) < 0xFF000000u || (low_ >> 32) != 0) {
+            const uint8_t carry = static_cast<uint8_t>(low_ >> 32);
+            uint8_t pending = cache_;
+            do {
+                bytes_.push_back(static_cast<uint8_t>(pending + carry));
+                pending = 0xFF;
+            } while (--cache_size_ != 0);
+            cache_ = static_cast<uint8_t>(low_ >> 24);
+        }
+        cache_size_++;
+        low_ = (low_ & 0x00FFFFFFu) << 8;
+    }
+
+    uint64_t low_ = 0;
+    uint32_t range_ = 0xFFFFFFFFu;
+    uint8_t cache_ = 0;
+    uint64_t cache_size_ = 1;
+    std::vector<uint8_t> bytes_;
+};
+
+std::vector<uint8_t> encode_context(const GlyphSet& set, const std::vector<uint8_t>& pixels,
+                                    const std::vector<uint8_t>& model) {
+    RangeEncoder encoder;
+    decisions(set, pixels, [&](int table, uint32_t context, int bit) {
+        encoder.encode(bit, model[table * CONTEXTS + context]);
+    });
+    return encoder.finish();
+}
+
+std::vector<uint8_t> encode_glyph(const GlyphSet& set, const Glyph& glyph, const std::vector<uint8_t>& model) {
+    if (std::all_of(glyph.pixels.begin(), glyph.pixels.end(), [](uint8_t p) { return p == 0; })) {
+        return {ili9488_font::GLYPH_EMPTY};
+    }
+
+    std::vector<uint8_t> best = {ili9488_font::GLYPH_RAW};
+    const std::vector<uint8_t> raw = pack_rows(set, glyph);
+    best.insert(best.end(), raw.begin(), raw.end());
+
+    std::vector<uint8_t> rle = {ili9488_font::GLYPH_RLE};
+    const std::vector<uint8_t> runs = encode_rle(glyph.pixels);
+    rle.insert(rle.end(), runs.begin(), runs.end());
+    if (rle.size() < best.size()) {
+        best = rle;
+    }
+
+    if (!model.empty()) {
+        std::vector<uint8_t> coded = {ili9488_font::GLYPH_CONTEXT};
+        const std::vector<uint8_t> bits = encode_context(set, glyph.pixels, model);
+        coded.insert(coded.end(), bits.begin(), bits.end());
+        if (coded.size() < best.size()) {
+            best = coded;
+        }
+    }
+    return best;
+}
+
+} // namespace
+
+bool build_container(const GlyphSet& set, const ContainerOptions& options, std::vector<uint8_t>& out,
+                     ContainerStats& stats, std::string& error) {
+    const size_t count = set.glyphs.size();
+    const int stride = stride_of(set);
+    const size_t glyph_bytes = static_cast<size_t>(stride) * set.height;
+    if (count == 0 || count > 0xFFFF) {
+        error = "glyph count must be 1..65535";
+        return false;
+    }
+    if (glyph_bytes > ILI9488_GLYPH_CACHE_SLOT_BYTES) {
+        fprintf(stderr, "font_compiler: %zu-byte glyphs need ILI9488_GLYPH_CACHE_SLOT_BYTES >= %zu on the device\n",
+                glyph_bytes, glyph_bytes);
+    }
+
+    // The decoder keeps the context bits of a row in 32 bits
+    std::vector<uint8_t> model;
+    if (options.model && set.width <= 28) {
+        model = train_model(set);
+    }
+
+    stats = ContainerStats();
+    std::vector<std::vector<uint8_t>> records;
+    records.reserve(count);
+    std::vector<uint8_t> decoded(glyph_bytes);
+    for (const Glyph& glyph : set.glyphs) {
+        std::vector<uint8_t> record = encode_glyph(set, glyph, model);
+
+        // Read it back the way the device will
+        std::fill(decoded.begin(), decoded.end(), 0);
+        if (!FlashFontCache::decode_glyph(record.data(), record.size(), set.width, set.height, set.bpp,
+                                          model.empty() ? nullptr : model.data(), decoded.data()) ||
+            decoded != pack_rows(set, glyph)) {
+            char code[16];
+            snprintf(code, sizeof(code), "U+%04X", static_cast<unsigned>(glyph.code));
+            error = std::string("record of ") + code + " does not decode back to the glyph";
+            return false;
+        }
+
+        stats.encodings[record[0]]++;
+        records.push_back(std::move(record));
+    }
+
+    // Optional sections: advances, then kerning pairs by glyph index
+    std::vector<uint8_t> sections = model;
+    uint8_t flags = model.empty() ? 0 : ili9488_font::FONT_FLAG_CONTEXT_MODEL;
+    std::vector<int> advances(count, set.width);
+    if (options.advances) {
+        flags |= ili9488_font::FONT_FLAG_ADVANCES;
+        for (size_t i = 0; i < count; i++) {
+            if (set.glyphs[i].code < options.proportional_end) {
+                advances[i] = std::min(std::max(set.glyphs[i].advance, 1), std::min(set.width, 255));
+            }
+            stats.narrow += advances[i] < set.width;
+            sections.push_back(static_cast<uint8_t>(advances[i]));
+        }
+    }
+
+    std::map<uint32_t, size_t> index_of;
+    for (size_t i = 0; i < count; i++) {
+        index_of[set.glyphs[i].code] = i;
+    }
+    std::map<uint32_t, int> pairs;
+    for (const Kerning& kerning : set.kerning) {
+        const auto left = index_of.find(kerning.left);
+        const auto right = index_of.find(kerning.right);
+        if (left == index_of.end() || right == index_of.end()) {
+            continue;
+        }
+        // The left glyph still advances at least 1 pixel
+        const int adjust = std::min(127, std::max({kerning.adjust, 1 - advances[left->second], -128}));
+        if (adjust != 0) {
+            pairs[static_cast<uint32_t>(left->second << 16 | right->second)] = adjust;
+        }
+    }
+    if (!pairs.empty()) {
+        if (pairs.size() > 0xFFFF) {
+            error = "too many kerning pairs";
+            return false;
+        }
+        flags |= ili9488_font::FONT_FLAG_KERNING;
+        put_u16(sections, static_cast<uint32_t>(pairs.size()));
+        for (const auto& pair : pairs) {
+            put_u16(sections, pair.first >> 16);
+            put_u16(sections, pair.first & 0xFFFF);
+            sections.push_back(static_cast<uint8_t>(static_cast<int8_t>(pair.second)));
+            sections.push_back(0);
+        }
+        stats.kerning_pairs = static_cast<int>(pairs.size());
+    }
+
+    // Block index: uint32 base per V2_BLOCK_GLYPHS glyphs, uint16 offset inside the block
+    const size_t blocks = count / BLOCK_GLYPHS + 1;
+    std::vector<uint32_t> offsets(1, 0);
+    for (const auto& record : records) {
+        offsets.push_back(offsets.back() + static_cast<uint32_t>(record.size()));
+    }
+
+    const uint32_t index_offset = static_cast<uint32_t>(sizeof(ili9488_font::FontHeaderV2) + sections.size());
+    const uint32_t data_offset = static_cast<uint32_t>(index_offset + blocks * 4 + (count + 1) * 2);
+
+    out.clear();
+    put_u16(out, 2);
+    put_u16(out, static_cast<uint32_t>(count));
+    out.push_back(static_cast<uint8_t>(set.width));
+    out.push_back(static_cast<uint8_t>(set.height));
+    out.push_back(static_cast<uint8_t>(set.bpp));
+    out.push_back(flags);
+    put_u32(out, index_offset);
+    put_u32(out, data_offset);
+    out.insert(out.end(), sections.begin(), sections.end());
+    for (size_t block = 0; block < blocks; block++) {
+        put_u32(out, offsets[block * BLOCK_GLYPHS]);
+    }
+    for (size_t i = 0; i <= count; i++) {
+        const uint32_t relative = offsets[i] - offsets[i / BLOCK_GLYPHS * BLOCK_GLYPHS];
+        if (relative > 0xFFFF) {
+            error = "a block of " + std::to_string(BLOCK_GLYPHS) + " glyphs exceeds 64 KB";
+            return false;
+        }
+        put_u16(out, relative);
+    }
+    for (const auto& record : records) {
+        out.insert(out.end(), record.begin(), record.end());
+    }
+
+    stats.raw_bytes = 4 + count * glyph_bytes;
+    stats.bytes = out.size();
+    return true;
+}
+
+} // namespace font_compiler
@@ -0,0 +1,366 @@
+/**
+ * @file font_sources.cpp
+ * @brief Host font compiler: UTF-8 text scanning, BDF loader and FreeType rasteriser
+ */
+
+#include "font_compiler.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <fstream>
+#include <map>
+#include <sstream>
+
+#ifdef FONT_COMPILER_HAVE_FREETYPE
+#include <ft2build.h>
+#include FT_FREETYPE_H
+#endif
+
+namespace font_compiler {
+
+namespace {
+
+// Puts a glyph bitmap into the cell, clipping what falls outside
+void plot(Glyph& glyph, int size, int x, int y, uint8_t value) {
+    if (x >= 0 && y >= 0 && x < size && y < size && value) {
+        glyph.pixels[static_cast<size_t>(y) * size + x] = value;
+    }
+}
+
+int hex_digit(char c) {
+    if (c >= '0' && c <= '9') return c - '0';
+    if (c >= 'a' && c <= 'f') return c - 'a' + 10;
+    if (c >= 'A' && c <= 'F') return c - 'A' + 10;
+    return -1;
+}
+
+bool wanted(const std::set<uint32_t>& codes, uint32_t code) {
+    return code <= 0xFFFF && (codes.empty() || codes.count(code) != 0);
+}
+
+void add_missing(const std::set<uint32_t>& codes, GlyphSet& out) {
+    std::set<uint32_t> found;
+    for (const Glyph& glyph : out.glyphs) {
+        found.insert(glyph.code);
+    }
+    for (uint32_t code : codes) {
+        if (!found.count(code)) {
+            out.missing.push_back(code);
+        }
+    }
+}
+
+} // namespace
+
+// ============================================================================
+// UTF-8 text
+// ============================================================================
+
+bool collect_text(const std::string& path, std::set<uint32_t>& codes, std::string& error) {
+    std::ifstream file(path, std::ios::binary);
+    if (!file) {
+        error = "cannot open " + path;
+        return false;
+    }
+    const std::string text((std::istreambuf_iterator<char>(file)), std::istreambuf_iterator<char>());
+
+    size_t pos = 0;
+    while (pos < text.size()) {
+        const uint8_t lead = static_cast<uint8_t>(text[pos]);
+        int length = 1;
+        uint32_t code = lead;
+        if (lead >= 0xF0 && lead < 0xF8) {
+            length = 4;
+            code = lead & 0x07;
+        } else if (lead >= 0xE0) {
+            length = 3;
+            code = lead & 0x0F;
+        } else if (lead >= 0xC0) {
+            length = 2;
+            code = lead & 0x1F;
+        } else if (lead >= 0x80) {
+            pos++;          // stray continuation byte
+            continue;
+        }
+
+        bool valid = pos + length <= text.size();
+        for (int i = 1; valid && i < length; i++) {
+            const uint8_t next = static_cast<uint8_t>(text[pos + i]);
+            valid = (next & 0xC0) == 0x80;
+            code = (code << 6) | (next & 0x3F);
+        }
+        if (!valid) {
+            pos++;
+            continue;
+        }
+        pos += length;
+
+        if (code >= 0x20 && code != 0x7F && code != 0xFEFF) {
+            codes.insert(code);
+        }
+    }
+    return true;
+}
+
+// ============================================================================
+// BDF
+// ============================================================================
+
+bool load_bdf(const std::string& path, const std::set<uint32_t>& codes, const LoadOptions& options,
+              GlyphSet& out, std::string& error) {
+    std::ifstream file(path);
+    if (!file) {
+        error = "cannot open " + path;
+        return false;
+    }
+    if (options.bpp != 1) {
+        error = "BDF fonts are 1bpp, --bpp 2 needs an outline font";
+        return false;
+    }
+
+    const int size = options.size;
+    out = GlyphSet();
+    out.width = out.height = size;
+    out.bpp = 1;
+
+    int ascent = -1;
+    int descent = -1;
+    int box_height = 0;
+    int box_yoff = 0;
+    int top = 0;                    // rows above the font ascent when the font is smaller than the cell
+
+    std::string line;
+    std::string keyword;
+    bool in_char = false;
+    Glyph glyph;
+    int bbx_w = 0, bbx_h = 0, bbx_x = 0, bbx_y = 0;
+    bool keep = false;
+
+    while (std::getline(file, line)) {
+        std::istringstream fields(line);
+        fields >> keyword;
+
+        if (!in_char) {
+            if (keyword == "FONTBOUNDINGBOX") {
+                int w;
+                int x;
+                fields >> w >> box_height >> x >> box_yoff;
+            } else if (keyword == "FONT_ASCENT") {
+                fields >> ascent;
+            } else if (keyword == "FONT_DESCENT") {
+                fields >> descent;
+            } else if (keyword == "STARTCHAR") {
+                if (ascent < 0) {
+                    ascent = box_height + box_yoff;
+                }
+                if (descent < 0) {
+                    descent = -box_yoff;
+                }
+                top = std::max(0, (size - ascent - descent) / 2);
+                in_char = true;
+                glyph = Glyph();
+                keep = false;
+                bbx_w = bbx_h = bbx_x = bbx_y = 0;
+            }
+            continue;
+        }
+
+        if (keyword == "ENCODING") {
+            long code = -1;
+            fields >> code;
+            keep = code >= 0 && wanted(codes, static_cast<uint32_t>(code));
+            glyph.code = static_cast<uint32_t>(code);
+            glyph.pixels.assign(static_cast<size_t>(size) * size, 0);
+        } else if (keyword == "DWIDTH") {
+            fields >> glyph.advance;
+        } else if (keyword == "BBX") {
+            fields >> bbx_w >> bbx_h >> bbx_x >> bbx_y;
+        } else if (keyword == "BITMAP") {
+            const int y0 = top + ascent - (bbx_y + bbx_h);
+            for (int row = 0; row < bbx_h && std::getline(file, line); row++) {
+                for (int col = 0; col < bbx_w && static_cast<size_t>(col / 4) < line.size(); col++) {
+                    const int nibble = hex_digit(line[col / 4]);
+                    if (nibble > 0 && keep && (nibble & (8 >> (col & 3)))) {
+                        plot(glyph, size, bbx_x + col, y0 + row, 1);
+                    }
+                }
+            }
+        } else if (keyword == "ENDCHAR") {
+            if (keep) {
+                if (glyph.advance <= 0) {
+                    glyph.advance = bbx_x + bbx_w;
+                }
+                out.glyphs.push_back(glyph);
+            }
+            in_char = false;
+        }
+    }
+
+    if (ascent + descent > size) {
+        fprintf(stderr, "font_compiler: %s is %d px high, clipped to %d\n", path.c_str(), ascent + descent, size);
+    }
+
+    std::sort(out.glyphs.begin(), out.glyphs.end(),
+              [](const Glyph& a, const Glyph& b) { return a.code < b.code; });
+    out.glyphs.erase(std::unique(out.glyphs.begin(), out.glyphs.end(),
+                                 [](const Glyph& a, const Glyph& b) { return a.code == b.code; }),
+                     out.glyphs.end());
+    add_missing(codes, out);
+    if (options.kerning) {
+        fprintf(stderr, "font_compiler: BDF fonts have no kerning, --kerning ignored\n");
+    }
+    return true;
+}
+
+// ============================================================================
+// TrueType / OpenType
+// ============================================================================
+
+#ifdef FONT_COMPILER_HAVE_FREETYPE
+
+bool load_outline(const std::string& path, const std::set<uint32_t>& codes, const LoadOptions& options,
+                  GlyphSet& out, std::string& error) {
+    FT_Library library;
+    if (FT_Init_FreeType(&library)) {
+        error = "FreeType initialisation failed";
+        return false;
+    }
+
+    FT_Face face;
+    if (FT_New_Face(library, path.c_str(), 0, &face)) {
+        FT_Done_FreeType(library);
+        error = "cannot load " + path;
+        return false;
+    }
+    FT_Select_Charmap(face, FT_ENCODING_UNICODE);
+
+    const int size = options.size;
+    if (FT_Set_Pixel_Sizes(face, 0, static_cast<FT_UInt>(size))) {
+        FT_Done_Face(face);
+        FT_Done_FreeType(library);
+        error = path + " cannot be scaled to " + std::to_string(size) + " px";
+        return false;
+    }
+
+    out = GlyphSet();
+    out.width = out.height = size;
+    out.bpp = options.bpp;
+
+    // Baseline so that ascender + descender fill the cell
+    int baseline = size * 7 / 8;
+    if (face->ascender > 0 && face->ascender - face->descender > 0) {
+        baseline = static_cast<int>(std::lround(static_cast<double>(size) * face->ascender /
+                                                (face->ascender - face->descender)));
+    }
+
+    std::vector<uint32_t> todo;
+    if (codes.empty()) {
+        FT_UInt index;
+        for (FT_ULong code = FT_Get_First_Char(face, &index); index != 0; code = FT_Get_Next_Char(face, code, &index)) {
+            if (code >= 0x20 && code <= 0xFFFF) {
+                todo.push_back(static_cast<uint32_t>(code));
+            }
+        }
+    } else {
+        for (uint32_t code : codes) {
+            if (code <= 0xFFFF) {
+                todo.push_back(code);
+            }
+        }
+    }
+
+    const FT_Int32 load_flags = FT_LOAD_RENDER | (options.bpp == 1 ? FT_LOAD_TARGET_MONO : FT_LOAD_TARGET_NORMAL);
+    std::map<uint32_t, FT_UInt> indices;
+    for (uint32_t code : todo) {
+        const FT_UInt index = FT_Get_Char_Index(face, code);
+        if (index == 0 || FT_Load_Glyph(face, index, load_flags)) {
+            out.missing.push_back(code);
+            continue;
+        }
+
+        const FT_GlyphSlot slot = face->glyph;
+        const FT_Bitmap& bitmap = slot->bitmap;
+        const int w = static_cast<int>(bitmap.width);
+        const int h = static_cast<int>(bitmap.rows);
+
+        Glyph glyph;
+        glyph.code = code;
+        glyph.advance = static_cast<int>((slot->advance.x + 32) >> 6);
+        glyph.pixels.assign(static_cast<size_t>(size) * size, 0);
+
+        // Keep the glyph inside the cell horizontally, clip vertically
+        int x0 = slot->bitmap_left;
+        if (x0 + w > size) {
+            x0 = size - w;
+        }
+        if (x0 < 0) {
+            x0 = 0;
+        }
+        const int y0 = baseline - slot->bitmap_top;
+
+        for (int row = 0; row < h; row++) {
+            const int pitch = bitmap.pitch;
+            const uint8_t* src = bitmap.buffer + (pitch >= 0 ? row * pitch : (h - 1 - row) * -pitch);
+            for (int col = 0; col < w; col++) {
+                uint8_t value;
+                if (bitmap.pixel_mode == FT_PIXEL_MODE_MONO) {
+                    value = (src[col >> 3] >> (7 - (col & 7))) & 1;
+                    value = options.bpp == 2 ? static_cast<uint8_t>(value * 3) : value;
+                } else {
+                    const int gray = src[col] * 255 / std::max(1, static_cast<int>(bitmap.num_grays) - 1);
+                    value = options.bpp == 2 ? static_cast<uint8_t>((gray * 3 + 127) / 255)
+                                             : static_cast<uint8_t>(gray >= 128);
+                }
+                plot(glyph, size, x0 + col, y0 + row, value);
+            }
+        }
+
+        indices[code] = index;
+        out.glyphs.push_back(glyph);
+    }
+
+    if (options.kerning) {
+        if (!FT_HAS_KERNING(face)) {
+            fprintf(stderr, "font_compiler: %s has no 'kern' table, no kerning written\n", path.c_str());
+        } else {
+            std::vector<std::pair<uint32_t, FT_UInt>> latin;
+            for (const auto& entry : indices) {
+                if (entry.first < options.kerning_end) {
+                    latin.push_back(entry);
+                }
+            }
+            for (const auto& left : latin) {
+                for (const auto& right : latin) {
+                    FT_Vector delta;
+                    if (FT_Get_Kerning(face, left.second, right.second, FT_KERNING_DEFAULT, &delta) == 0) {
+                        const int adjust = static_cast<int>(std::lround(delta.x / 64.0));
+                        if (adjust != 0) {
+                            out.kerning.push_back(Kerning{left.first, right.first, adjust});
+                        }
+                    }
+                }
+            }
+        }
+    }
+
+    FT_Done_Face(face);
+    FT_Done_FreeType(library);
+    return true;
+}
+
+#else
+
+bool load_outline(const std::string& path, const std::set<uint32_t>& codes, const LoadOptions& options,
+                  GlyphSet& out, std::string& error) {
+    (void)codes;
+    (void)options;
+    (void)out;
+    error = path + ": built without FreeType, only BDF fonts can be read";
+    return false;
+}
+
+#endif
+
+} // namespace font_compiler
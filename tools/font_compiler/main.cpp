@@ -0,0 +1,203 @@
+/**
+ * @file main.cpp
+ * @brief Host font compiler: rasterise a TTF/OTF or BDF font into the flash font
+ *        container and the matching unicode_ranges.h
+ * @note Not part of the Pico build, see tools/font_compiler/CMakeLists.txt.
+ *
+ *   font_compiler NotoSansSC-Regular.otf --size 16 --text book.txt --text examples/ILI9488_TextReader.cpp \
+ *       --proportional --kerning -o font16.bin --header include/fonts/unicode_ranges.h
+ *   picotool load -o 0x10100000 font16.bin    (FontConfig::FLASH_FONT_ADDRESS)
+ *
+ * Without --text/--range every BMP glyph of the font is compiled. With them only
+ * the code points used (plus printable ASCII unless --no-ascii) are, which is what
+ * a per-book font wants: a few thousand glyphs instead of the whole CJK block.
+ */
+
+#include "font_compiler.hpp"
+
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <string>
+
+namespace {
+
+void usage() {
+    fprintf(stderr,
+            "usage: font_compiler FONT.{ttf,otf,ttc,bdf} -o FONT.bin [options]\n"
+            "  --size N          glyph cell, 16 or 24 (default 16)\n"
+            "  --bpp N           1, or 2 for anti-aliased glyphs (outline fonts, default 1)\n"
+            "  --text FILE       subset to the code points of a UTF-8 file (repeatable)\n"
+            "  --range A-B       add a code point range, e.g. 0x4E00-0x9FA5 (repeatable)\n"
+            "  --no-ascii        do not add U+0020..U+007E to a subset\n"
+            "  --proportional    write per-glyph advances (below U+2E80)\n"
+            "  --kerning         write kerning pairs from the font's 'kern' table\n"
+            "  --no-model        RAW/RLE/EMPTY records only\n"
+            "  --header FILE     write the matching unicode_ranges.h\n");
+}
+
+bool ends_with(const std::string& text, const char* suffix) {
+    const size_t length = strlen(suffix);
+    if (text.size() < length) {
+        return false;
+    }
+    for (size_t i = 0; i < length; i++) {
+        if (tolower(static_cast<unsigned char>(text[text.size() - length + i])) != suffix[i]) {
+            return false;
+        }
+    }
+    return true;
+}
+
+bool parse_range(const char* text, uint32_t& start, uint32_t& end) {
+    char* rest;
+    start = static_cast<uint32_t>(strtoul(text, &rest, 0));
+    if (*rest != '-') {
+        return false;
+    }
+    end = static_cast<uint32_t>(strtoul(rest + 1, &rest, 0));
+    return *rest == 0 && start <= end && end <= 0xFFFF;
+}
+
+std::string base_name(const std::string& path) {
+    const size_t slash = path.find_last_of("/\\");
+    return slash == std::string::npos ? path : path.substr(slash + 1);
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+    using namespace font_compiler;
+
+    std::string font_path;
+    std::string output_path;
+    std::string header_path;
+    std::vector<std::string> texts;
+    std::set<uint32_t> codes;
+    LoadOptions load;
+    ContainerOptions container;
+    bool ascii = true;
+
+    for (int i = 1; i < argc; i++) {
+        const std::string arg = argv[i];
+        const bool has_value = i + 1 < argc;
+        if (arg == "-o" && has_value) {
+            output_path = argv[++i];
+        } else if (arg == "--header" && has_value) {
+            header_path = argv[++i];
+        } else if (arg == "--size" && has_value) {
+            load.size = atoi(argv[++i]);
+        } else if (arg == "--bpp" && has_value) {
+            load.bpp = atoi(argv[++i]);
+        } else if (arg == "--text" && has_value) {
+            texts.push_back(argv[++i]);
+        } else if (arg == "--range" && has_value) {
+            uint32_t start;
+            uint32_t end;
+            if (!parse_range(argv[++i], start, end)) {
+                fprintf(stderr, "font_compiler: bad range '%s'\n", argv[i]);
+                return 1;
+            }
+            for (uint32_t code = start; code <= end; code++) {
+                codes.insert(code);
+            }
+        } else if (arg == "--no-ascii") {
+            ascii = false;
+        } else if (arg == "--proportional") {
+            container.advances = true;
+        } else if (arg == "--kerning") {
+            load.kerning = true;
+        } else if (arg == "--no-model") {
+            container.model = false;
+        } else if (arg[0] != '-' && font_path.empty()) {
+            font_path = arg;
+        } else {
+            usage();
+            return 1;
+        }
+    }
+
+    if (font_path.empty() || output_path.empty()) {
+        usage();
+        return 1;
+    }
+    if (load.size != 16 && load.size != 24) {
+        fprintf(stderr, "font_compiler: --size must be 16 or 24\n");
+        return 1;
+    }
+    if (load.bpp != 1 && load.bpp != 2) {
+        fprintf(stderr, "font_compiler: --bpp must be 1 or 2\n");
+        return 1;
+    }
+
+    std::string error;
+    for (const std::string& text : texts) {
+        if (!collect_text(text, codes, error)) {
+            fprintf(stderr, "font_compiler: %s\n", error.c_str());
+            return 1;
+        }
+    }
+    if (!codes.empty() && ascii) {
+        for (uint32_t code = 0x20; code <= 0x7E; code++) {
+            codes.insert(code);
+        }
+    }
+
+    GlyphSet set;
+    const bool loaded = ends_with(font_path, ".bdf") ? load_bdf(font_path, codes, load, set, error)
+                                                     : load_outline(font_path, codes, load, set, error);
+    if (!loaded) {
+        fprintf(stderr, "font_compiler: %s\n", error.c_str());
+        return 1;
+    }
+    if (set.glyphs.empty()) {
+        fprintf(stderr, "font_compiler: %s has none of the requested glyphs\n", font_path.c_str());
+        return 1;
+    }
+
+    std::vector<uint8_t> font;
+    ContainerStats stats;
+    if (!build_container(set, container, font, stats, error)) {
+        fprintf(stderr, "font_compiler: %s\n", error.c_str());
+        return 1;
+    }
+
+    std::ofstream out(output_path, std::ios::binary);
+    out.write(reinterpret_cast<const char*>(font.data()), static_cast<std::streamsize>(font.size()));
+    if (!out) {
+        fprintf(stderr, "font_compiler: cannot write %s\n", output_path.c_str());
+        return 1;
+    }
+
+    printf("%s: %zu glyphs %dx%d %dbpp, %zu bytes (%.1f%% of uncompressed), raw %d / rle %d / empty %d / context %d\n",
+           output_path.c_str(), set.glyphs.size(), set.width, set.height, set.bpp, stats.bytes,
+           100.0 * static_cast<double>(stats.bytes) / static_cast<double>(stats.raw_bytes),
+           stats.encodings[0], stats.encodings[1], stats.encodings[2], stats.encodings[3]);
+    if (container.advances) {
+        printf("  proportional: %d glyphs narrower than %d\n", stats.narrow, set.width);
+    }
+    if (load.kerning) {
+        printf("  kerning: %d pairs\n", stats.kerning_pairs);
+    }
+    if (!set.missing.empty()) {
+        printf("  %zu code points not in the font (first U+%04X)\n", set.missing.size(),
+               static_cast<unsigned>(set.missing.front()));
+    }
+
+    if (!header_path.empty()) {
+        std::string header;
+        if (!build_ranges_header(set, base_name(font_path), header, error)) {
+            fprintf(stderr, "font_compiler: %s\n", error.c_str());
+            return 1;
+        }
+        std::ofstream file(header_path, std::ios::binary);
+        file << header;
+        if (!file) {
+            fprintf(stderr, "font_compiler: cannot write %s\n", header_path.c_str());
+            return 1;
+        }
+        printf("%s: written\n", header_path.c_str());
+    }
+    return 0;
+}
@@ -0,0 +1,240 @@
+/**
+ * @file ranges_header.cpp
+ * @brief Host font compiler: unicode_ranges.h for a compiled font
+ *
+ * Consecutive code points become one range, the glyph index is the position
+ * in the font. The page table is built the same way as tools/unicode_ranges_gen.py.
+ */
+
+#include "font_compiler.hpp"
+
+#include <cstdio>
+#include <ctime>
+#include <map>
+
+namespace font_compiler {
+
+namespace {
+
+constexpr uint32_t NO_GLYPH = 0xFFFF;
+
+struct Range {
+    uint32_t start;
+    uint32_t end;
+    uint32_t offset;
+};
+
+std::string format(const char* fmt, unsigned a, unsigned b = 0) {
+    char buffer[64];
+    snprintf(buffer, sizeof(buffer), fmt, a, b);
+    return buffer;
+}
+
+} // namespace
+
+bool build_ranges_header(const GlyphSet& set, const std::string& source, std::string& out,
+                         std::string& error) {
+    if (set.glyphs.size() + 256 >= NO_GLYPH) {
+        error = "glyph offsets must stay below 0xFF00";
+        return false;
+    }
+
+    std::vector<Range> ranges;
+    std::map<uint32_t, uint32_t> glyphs;
+    for (uint32_t i = 0; i < set.glyphs.size(); i++) {
+        const uint32_t code = set.glyphs[i].code;
+        if (code > 0xFFFF) {
+            error = "only the BMP (<= 0xFFFF) is supported";
+            return false;
+        }
+        if (!ranges.empty() && ranges.back().end + 1 == code) {
+            ranges.back().end = code;
+        } else {
+            ranges.push_back(Range{code, code, i});
+        }
+        glyphs[code] = i;
+    }
+
+    // Page table: whole page linear, empty, or a 256-entry block
+    std::vector<std::pair<uint32_t, uint32_t>> pages;
+    std::vector<std::vector<uint32_t>> blocks;
+    for (uint32_t page = 0; page < 256; page++) {
+        std::vector<uint32_t> offsets(256, NO_GLYPH);
+        for (uint32_t low = 0; low < 256; low++) {
+            const auto it = glyphs.find(page << 8 | low);
+            if (it != glyphs.end()) {
+                offsets[low] = it->second;
+            }
+        }
+        const uint32_t base = offsets[0];
+        bool empty = true;
+        bool linear = base != NO_GLYPH;
+        for (uint32_t low = 0; low < 256; low++) {
+            empty = empty && offsets[low] == NO_GLYPH;
+            linear = linear && offsets[low] == base + low;
+        }
+        if (empty) {
+            pages.emplace_back(NO_GLYPH, 0);
+        } else if (linear) {
+            pages.emplace_back(base, 0);
+        } else {
+            blocks.push_back(offsets);
+            pages.emplace_back(NO_GLYPH, static_cast<uint32_t>(blocks.size()));
+        }
+    }
+    if (blocks.size() > 255) {
+        error = "too many mixed pages";
+        return false;
+    }
+
+    char stamp[32];
+    const std::time_t now = std::time(nullptr);
+    std::strftime(stamp, sizeof(stamp), "%Y-%m-%d %H:%M:%S", std::localtime(&now));
+
+    std::string s;
+    auto w = [&s](const std::string& line) { s += line; s += "\n"; };
+    w("// 自动生成的Unicode范围查找表");
+    w(std::string("// 生成时间: ") + stamp);
+    w("// 源文件: " + source);
+    w("// ");
+    w("// 警告: 此文件由脚本自动生成，请勿手动修改！");
+    w("// 生成工具: tools/font_compiler");
+    w("");
+    w("#pragma once");
+    w("");
+    w("#include <stdint.h>");
+    w("#include <cstdio>");
+    w("");
+    w("// Unicode范围结构体");
+    w("struct UnicodeRangeEntry {");
+    w("    const char* name;           // 范围名称");
+    w("    bool enabled;              // 是否启用");
+    w("    uint32_t start;            // 起始码点");
+    w("    uint32_t end;              // 结束码点");
+    w("    uint32_t count;            // 字符数量");
+    w("    uint32_t offset;           // 在字体文件中的偏移位置");
+    w("};");
+    w("");
+    w("// Unicode范围查找表");
+    w("static const UnicodeRangeEntry unicode_ranges[] = {");
+    for (size_t i = 0; i < ranges.size(); i++) {
+        const Range& r = ranges[i];
+        w("    {");
+        w(format("        \"U+%04X-U+%04X\",", r.start, r.end));
+        w("        true,");
+        w(format("        0x%04X,", r.start));
+        w(format("        0x%04X,", r.end));
+        w(format("        %u,", r.end - r.start + 1));
+        w(format("        %u", r.offset));
+        w(i + 1 < ranges.size() ? "    }," : "    }");
+    }
+    w("};");
+    w("");
+    w("// 范围总数");
+    w("static const int unicode_ranges_count = sizeof(unicode_ranges) / sizeof(unicode_ranges[0]);");
+    w("");
+    w("// 总字符数");
+    w(format("static const uint32_t total_unicode_chars = %u;", static_cast<unsigned>(set.glyphs.size())));
+    w("");
+    w("// 两级页表：码点高字节 -> 页，低字节 -> 偏移（O(1)查找）");
+    w("// block == 0: 整页线性 (offset = base + 低字节) 或整页不支持 (base == UNICODE_NO_GLYPH)");
+    w("// block != 0: 混合页，查 unicode_page_blocks[block - 1][低字节]");
+    w("struct UnicodePage {");
+    w("    uint16_t base;             // 低字节0对应的偏移");
+    w("    uint8_t block;             // 二级表编号+1，0 = 无二级表");
+    w("};");
+    w("");
+    w(format("static constexpr uint16_t UNICODE_NO_GLYPH = 0x%04X;", NO_GLYPH));
+    w("");
+    w("static constexpr UnicodePage unicode_pages[256] = {");
+    for (uint32_t row = 0; row < 256; row += 8) {
+        std::string line = "    ";
+        for (uint32_t p = row; p < row + 8; p++) {
+            line += format("{0x%04X, %u}", pages[p].first, pages[p].second);
+            line += p + 1 < row + 8 ? ", " : ",";
+        }
+        w(line + format("  // 0x%02X", row));
+    }
+    w("};");
+    w("");
+    w(format("static constexpr uint16_t unicode_page_blocks[%u][256] = {",
+             static_cast<unsigned>(blocks.empty() ? 1 : blocks.size())));
+    if (blocks.empty()) {
+        w("    {}");
+    }
+    for (size_t i = 0; i < blocks.size(); i++) {
+        uint32_t page = 0;
+        while (pages[page].second != i + 1) {
+            page++;
+        }
+        w(format("    {   // 0x%02X00", page));
+        for (uint32_t row = 0; row < 256; row += 16) {
+            std::string line = "        ";
+            for (uint32_t low = row; low < row + 16; low++) {
+                line += format("0x%04X", blocks[i][low]);
+                line += low + 1 < row + 16 ? ", " : ",";
+            }
+            w(line);
+        }
+        w(i + 1 < blocks.size() ? "    }," : "    }");
+    }
+    w("};");
+    w("");
+    w("// 查找Unicode字符在字体文件中的偏移位置");
+    w("inline uint32_t find_unicode_offset(uint32_t unicode_code) {");
+    w("    if (unicode_code > 0xFFFF) {");
+    w("        return UINT32_MAX; // 未找到");
+    w("    }");
+    w("    const UnicodePage& page = unicode_pages[unicode_code >> 8];");
+    w("    uint16_t offset;");
+    w("    if (page.block) {");
+    w("        offset = unicode_page_blocks[page.block - 1][unicode_code & 0xFF];");
+    w("    } else if (page.base != UNICODE_NO_GLYPH) {");
+    w("        offset = static_cast<uint16_t>(page.base + (unicode_code & 0xFF));");
+    w("    } else {");
+    w("        return UINT32_MAX;");
+    w("    }");
+    w("    return offset == UNICODE_NO_GLYPH ? UINT32_MAX : offset;");
+    w("}");
+    w("");
+    w("// 逐个范围查找（与页表结果相同，用于校验和性能对比）");
+    w("inline uint32_t find_unicode_offset_linear(uint32_t unicode_code) {");
+    w("    for (int i = 0; i < unicode_ranges_count; i++) {");
+    w("        const UnicodeRangeEntry& range = unicode_ranges[i];");
+    w("        if (range.enabled && unicode_code >= range.start && unicode_code <= range.end) {");
+    w("            // 在范围内，计算偏移");
+    w("            uint32_t relative_offset = unicode_code - range.start;");
+    w("            return range.offset + relative_offset;");
+    w("        }");
+    w("    }");
+    w("    return UINT32_MAX; // 未找到");
+    w("}");
+    w("");
+    w("// 检查Unicode字符是否受支持");
+    w("inline bool is_unicode_supported(uint32_t unicode_code) {");
+    w("    return find_unicode_offset(unicode_code) != UINT32_MAX;");
+    w("}");
+    w("");
+    w("// 获取指定索引的Unicode范围信息（用于调试）");
+    w("inline const UnicodeRangeEntry* get_unicode_range(int index) {");
+    w("    if (index >= 0 && index < unicode_ranges_count) {");
+    w("        return &unicode_ranges[index];");
+    w("    }");
+    w("    return nullptr;");
+    w("}");
+    w("");
+    w("// 打印所有Unicode范围信息（用于调试）");
+    w("inline void print_unicode_ranges() {");
+    w("    for (int i = 0; i < unicode_ranges_count; i++) {");
+    w("        const UnicodeRangeEntry& range = unicode_ranges[i];");
+    w("        printf(\"[%d] %s: 0x%04lX-0x%04lX (%ld chars, offset %ld) %s\\n\", ");
+    w("               i, range.name, range.start, range.end, range.count, range.offset,");
+    w("               range.enabled ? \"✓\" : \"✗\");");
+    w("    }");
+    w("}");
+
+    out = s;
+    return true;
+}
+
+} // namespace font_compiler
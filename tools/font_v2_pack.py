@@ -0,0 +1,349 @@
+#!/usr/bin/env python3
+"""
+font_v2_pack.py - Convert a version 1 flash font (.bin) to the compressed version 2 container
+
+Version 1 is a 4-byte header (version=1, char_count) followed by fixed-size
+1bpp glyphs. Version 2 (see FontHeaderV2 in include/fonts/flash_font_cache.hpp):
+
+    header   16 bytes: version=2, glyph_count, width, height, bpp, flags,
+             index_offset, data_offset (little endian)
+    model    if flags & 1: ((1 << bpp) - 1) x 1024 bytes, P(bit == 0) in 1/256
+    advances if flags & 2: uint8 advance[glyph_count], pixels the pen moves
+             after the glyph (without it every glyph advances by width)
+    kerning  if flags & 4: uint16 pair_count, then pair_count x 6 bytes
+             {uint16 left, uint16 right, int8 adjust, uint8 0} sorted by
+             (left, right); left/right are glyph indices, adjust is added
+             to the pen before drawing the right glyph
+    index    uint32 block_base[glyph_count / 32 + 1]
+             uint16 relative[glyph_count + 1]
+             record i = data + block_base[i / 32] + relative[i], up to record i + 1
+    records  encoding byte + payload:
+             0 RAW    unpacked rows, (width * bpp + 7) / 8 bytes each
+             1 RLE    one byte per run: value << 6 | (length - 1), row-major
+             2 EMPTY  all pixels 0
+             3 CONTEXT binary range coder (LZMA style, 8-bit probabilities);
+                      each pixel is coded with the probability the model
+                      gives its context: whether the 10 previously decoded
+                      neighbours are ink (row y-2: x-1..x+1 -> bits 9-7,
+                      row y-1: x-2..x+2 -> bits 6-2, row y: x-2..x-1 ->
+                      bits 1-0). 2bpp codes the high bit (table 0), then
+                      the low bit (table 1 + high); ink means high bit set.
+                      Trailing zero bytes are dropped, the decoder reads
+                      zeros past the end of the record.
+
+The model is trained on the font itself. RLE rarely beats RAW on 1bpp CJK
+strokes; the context coder is what makes those smaller. The smallest
+encoding is chosen per glyph, so no glyph gets bigger than RAW + 1 byte.
+Glyph indices are unchanged, so unicode_ranges.h still applies.
+
+--aa halves a large source font into 2bpp anti-aliased glyphs: each 2x2 block
+of source pixels becomes one pixel whose coverage is the ink count (0-4,
+3 and 4 both map to 3). A 32x32 font gives 16x16 2bpp.
+
+--proportional gives glyphs below U+2E80 (Latin, Greek, Cyrillic, punctuation
+before the CJK blocks) their own advance: rightmost ink column + 2, or a third
+of the em for blank glyphs. CJK and everything above keeps the full width.
+Glyph bitmaps are not shifted, so this suits fonts whose narrow glyphs are
+drawn from the left edge. --kerning reads pairs, one per line:
+
+    U+0041 U+0056 -2      # A V
+    U+0054 U+006F -1      # T o
+
+Adjustments are clamped so the left glyph still advances at least 1 pixel.
+Both options need --ranges (the unicode_ranges.h or range export the font
+was built with) to map code points to glyph indices.
+
+Usage:
+    python3 tools/font_v2_pack.py font16.bin --size 16 -o font16_v2.bin
+    python3 tools/font_v2_pack.py font32.bin --size 32 --aa -o font16_aa.bin
+    python3 tools/font_v2_pack.py font16.bin --size 16 --ranges include/fonts/unicode_ranges.h \
+        --proportional --kerning kerning.txt -o font16_prop.bin
+"""
+
+import argparse
+import os
+import struct
+import sys
+
+sys.path.insert(0, os.path.dirname(os.path.abspath(__file__)))
+from unicode_ranges_gen import build_map, load_ranges  # noqa: E402
+
+BLOCK_GLYPHS = 32
+RAW, RLE, EMPTY, CONTEXT = 0, 1, 2, 3
+MAX_RUN = 64
+CONTEXTS = 1024
+FLAG_CONTEXT_MODEL = 0x01
+FLAG_ADVANCES = 0x02
+FLAG_KERNING = 0x04
+PROPORTIONAL_END = 0x2E80
+
+
+def unpack_glyph(data, width, height, bpp):
+    """Row-major list of pixel values"""
+    stride = (width * bpp + 7) // 8
+    mask = (1 << bpp) - 1
+    pixels = []
+    for row in range(height):
+        line = data[row * stride:(row + 1) * stride]
+        for col in range(width):
+            bit = col * bpp
+            pixels.append((line[bit >> 3] >> (8 - bpp - (bit & 7))) & mask)
+    return pixels
+
+
+def pack_glyph(pixels, width, height, bpp):
+    stride = (width * bpp + 7) // 8
+    out = bytearray(stride * height)
+    for i, value in enumerate(pixels):
+        row, col = divmod(i, width)
+        bit = col * bpp
+        out[row * stride + (bit >> 3)] |= value << (8 - bpp - (bit & 7))
+    return bytes(out)
+
+
+def downsample(pixels, width, height):
+    """2x2 box filter of a 1bpp glyph to 2bpp coverage"""
+    out = []
+    for row in range(0, height - 1, 2):
+        for col in range(0, width - 1, 2):
+            ink = (pixels[row * width + col] + pixels[row * width + col + 1] +
+                   pixels[(row + 1) * width + col] + pixels[(row + 1) * width + col + 1])
+            out.append(min(ink, 3))
+    return out
+
+
+def encode_rle(pixels):
+    out = bytearray()
+    i = 0
+    while i < len(pixels):
+        value = pixels[i]
+        run = 1
+        while i + run < len(pixels) and pixels[i + run] == value and run < MAX_RUN:
+            run += 1
+        out.append((value << 6) | (run - 1))
+        i += run
+    return bytes(out)
+
+
+def decisions(pixels, width, height, bpp):
+    """(table, context, bit) for every binary decision, in decode order"""
+    ink2 = ink1 = 0
+    for row in range(height):
+        ink0 = 0
+        for col in range(width):
+            context = (((ink2 >> (col + 1)) & 0x07) << 7) | (((ink1 >> col) & 0x1F) << 2) | ((ink0 >> col) & 0x03)
+            level = pixels[row * width + col]
+            high = level >> (bpp - 1)
+            yield 0, context, high
+            if bpp == 2:
+                yield 1 + high, context, level & 1
+            if high:
+                ink0 |= 1 << (col + 2)
+        ink2, ink1 = ink1, ink0
+
+
+def train_model(glyphs, width, height, bpp):
+    tables = (1 << bpp) - 1
+    counts = [[[0, 0] for _ in range(CONTEXTS)] for _ in range(tables)]
+    for pixels in glyphs:
+        for table, context, bit in decisions(pixels, width, height, bpp):
+            counts[table][context][bit] += 1
+    model = bytearray()
+    for table in counts:
+        for zeros, ones in table:
+            p0 = int(round(256.0 * (zeros + 0.4) / (zeros + ones + 0.8)))
+            model.append(min(max(p0, 1), 255))
+    return bytes(model)
+
+
+def encode_context(pixels, width, height, bpp, model):
+    low = 0
+    rng = 0xFFFFFFFF
+    shifts = 0
+    for table, context, bit in decisions(pixels, width, height, bpp):
+        bound = (rng >> 8) * model[table * CONTEXTS + context]
+        if bit:
+            low += bound
+            rng -= bound
+        else:
+            rng = bound
+        while rng < (1 << 24):
+            rng <<= 8
+            low <<= 8
+            shifts += 1
+
+    # Any value in [low, low + rng) decodes the same; take the one with the most trailing zero bytes
+    total = shifts + 4
+    for k in range(total, -1, -1):
+        step = 1 << (8 * k)
+        value = -(-low // step) * step
+        if value < low + rng:
+            break
+    return value.to_bytes(total, "big").rstrip(b"\0")
+
+
+def encode_glyph(pixels, width, height, bpp, model):
+    if not any(pixels):
+        return bytes([EMPTY])
+    candidates = [bytes([RAW]) + pack_glyph(pixels, width, height, bpp),
+                  bytes([RLE]) + encode_rle(pixels)]
+    if model:
+        candidates.append(bytes([CONTEXT]) + encode_context(pixels, width, height, bpp, model))
+    return min(candidates, key=len)
+
+
+def proportional_advances(glyphs, width, height, index_to_cp):
+    """Advance per glyph: rightmost ink + 2 below PROPORTIONAL_END, full width above"""
+    advances = []
+    for i, pixels in enumerate(glyphs):
+        cp = index_to_cp.get(i)
+        if cp is None or cp >= PROPORTIONAL_END:
+            advances.append(width)
+            continue
+        right = -1
+        for row in range(height):
+            for col in range(width - 1, right, -1):
+                if pixels[row * width + col]:
+                    right = col
+                    break
+        advances.append(min(right + 2, width) if right >= 0 else max(width // 3, 1))
+    return advances
+
+
+def load_kerning(path, cp_to_index, advances):
+    """Sorted (left, right, adjust) glyph index triples"""
+    pairs = {}
+    with open(path, "r", encoding="utf-8") as f:
+        for number, line in enumerate(f, 1):
+            fields = line.split("#", 1)[0].split()
+            if not fields:
+                continue
+            if len(fields) != 3:
+                raise ValueError("%s:%d: expected 'U+XXXX U+YYYY adjust'" % (path, number))
+            left_cp, right_cp = (int(field[2:] if field.upper().startswith("U+") else field, 16)
+                                 for field in fields[:2])
+            left = cp_to_index.get(left_cp)
+            right = cp_to_index.get(right_cp)
+            if left is None or right is None:
+                sys.stderr.write("font_v2_pack.py: %s:%d: U+%04X/U+%04X not in the font, skipped\n" %
+                                 (path, number, left_cp, right_cp))
+                continue
+            adjust = max(int(fields[2]), 1 - advances[left], -128)
+            adjust = min(adjust, 127)
+            if adjust:
+                pairs[(left, right)] = adjust
+    return [(left, right, adjust) for (left, right), adjust in sorted(pairs.items())]
+
+
+def build_container(records, width, height, bpp, model, advances=None, kerning=None):
+    count = len(records)
+    blocks = count // BLOCK_GLYPHS + 1
+
+    offsets = [0]
+    for record in records:
+        offsets.append(offsets[-1] + len(record))
+
+    bases = [offsets[b * BLOCK_GLYPHS] for b in range(blocks)]
+    relative = []
+    for i in range(count + 1):
+        rel = offsets[i] - bases[i // BLOCK_GLYPHS]
+        if rel > 0xFFFF:
+            raise ValueError("glyph block %d exceeds 64 KB" % (i // BLOCK_GLYPHS))
+        relative.append(rel)
+
+    flags = FLAG_CONTEXT_MODEL if model else 0
+    sections = model
+    if advances:
+        flags |= FLAG_ADVANCES
+        sections += bytes(advances)
+    if kerning:
+        if len(kerning) > 0xFFFF:
+            raise ValueError("too many kerning pairs (%d)" % len(kerning))
+        flags |= FLAG_KERNING
+        sections += struct.pack("<H", len(kerning))
+        sections += b"".join(struct.pack("<HHbB", left, right, adjust, 0) for left, right, adjust in kerning)
+
+    index_offset = 16 + len(sections)
+    data_offset = index_offset + blocks * 4 + (count + 1) * 2
+    header = struct.pack("<HHBBBBII", 2, count, width, height, bpp, flags, index_offset, data_offset)
+    index = struct.pack("<%dI" % blocks, *bases) + struct.pack("<%dH" % (count + 1), *relative)
+    return header + sections + index + b"".join(records)
+
+
+def main():
+    parser = argparse.ArgumentParser(description="Pack a version 1 flash font into the compressed version 2 container")
+    parser.add_argument("input", help="version 1 font .bin")
+    parser.add_argument("--size", type=int, default=16, help="glyph size of the input font (default 16)")
+    parser.add_argument("--aa", action="store_true", help="downsample 2x into 2bpp anti-aliased glyphs")
+    parser.add_argument("--no-model", action="store_true", help="RAW/RLE/EMPTY only, no context model")
+    parser.add_argument("--ranges", help="unicode_ranges.h or range export, needed by --proportional/--kerning")
+    parser.add_argument("--proportional", action="store_true", help="per-glyph advances below U+2E80")
+    parser.add_argument("--kerning", help="kerning pairs file ('U+XXXX U+YYYY adjust' per line)")
+    parser.add_argument("-o", "--output", required=True, help="output .bin")
+    args = parser.parse_args()
+
+    with open(args.input, "rb") as f:
+        data = f.read()
+
+    version, count = struct.unpack_from("<HH", data, 0)
+    if version != 1:
+        sys.stderr.write("font_v2_pack.py: %s is not a version 1 font (version %d)\n" % (args.input, version))
+        return 1
+
+    size = args.size
+    glyph_bytes = (size + 7) // 8 * size
+    if 4 + count * glyph_bytes > len(data):
+        sys.stderr.write("font_v2_pack.py: %s is too short for %d glyphs of %dx%d\n" % (args.input, count, size, size))
+        return 1
+
+    width = height = size // 2 if args.aa else size
+    bpp = 2 if args.aa else 1
+    glyphs = []
+    for i in range(count):
+        glyph = data[4 + i * glyph_bytes:4 + (i + 1) * glyph_bytes]
+        pixels = unpack_glyph(glyph, size, size, 1)
+        glyphs.append(downsample(pixels, size, size) if args.aa else pixels)
+
+    # The decoder keeps the context bits of a row in 32 bits
+    model = b""
+    if not args.no_model and width <= 28:
+        model = train_model(glyphs, width, height, bpp)
+
+    records = []
+    encodings = [0, 0, 0, 0]
+    for pixels in glyphs:
+        record = encode_glyph(pixels, width, height, bpp, model)
+        encodings[record[0]] += 1
+        records.append(record)
+
+    advances = None
+    kerning = None
+    if args.proportional or args.kerning:
+        if not args.ranges:
+            sys.stderr.write("font_v2_pack.py: --proportional and --kerning need --ranges\n")
+            return 1
+        cp_to_index = {cp: index for cp, index in build_map(load_ranges(args.ranges)).items() if index < count}
+        index_to_cp = {}
+        for cp, index in sorted(cp_to_index.items()):
+            index_to_cp.setdefault(index, cp)
+        if args.proportional:
+            advances = proportional_advances(glyphs, width, height, index_to_cp)
+        if args.kerning:
+            kerning = load_kerning(args.kerning, cp_to_index, advances or [width] * count)
+
+    out = build_container(records, width, height, bpp, model, advances, kerning)
+    with open(args.output, "wb") as f:
+        f.write(out)
+
+    print("%s: %d glyphs %dx%d %dbpp, %d -> %d bytes (%.1f%%), raw %d / rle %d / empty %d / context %d" %
+          (args.output, count, width, height, bpp, len(data), len(out), 100.0 * len(out) / len(data),
+           encodings[RAW], encodings[RLE], encodings[EMPTY], encodings[CONTEXT]))
+    if advances:
+        print("  proportional: %d glyphs narrower than %d" % (sum(1 for a in advances if a < width), width))
+    if kerning:
+        print("  kerning: %d pairs" % len(kerning))
+    return 0
+
+
+if __name__ == "__main__":
+    sys.exit(main())
@@ -0,0 +1,88 @@
+#!/usr/bin/env python3
+"""
+raw666_pack.py - Pack images into .r666 files for ili9488_image::Raw666Player
+
+Pixels are stored as the panel's RGB666 wire bytes (R, G, B with the low two
+bits cleared), so the player copies them from SD to the display untouched.
+Several inputs, or the frames of an animated GIF/PNG, become an animation.
+
+File layout (little-endian, see include/image/raw666_player.hpp):
+    "R666", version, reserved, header_size, x, y, width, height,
+    frame_count, fps, frame_stride, zero padding up to header_size,
+    then frame_count x frame_stride bytes (width * height * 3, zero padded)
+
+Usage:
+    python3 tools/raw666_pack.py splash.png -o splash.r666
+    python3 tools/raw666_pack.py spinner.gif --x 128 --y 208 --fps 20 -o spin.r666
+    python3 tools/raw666_pack.py f0.png f1.png f2.png --fps 12 -o anim.r666
+
+Requires Pillow (pip install pillow).
+"""
+
+import argparse
+import struct
+import sys
+
+try:
+    from PIL import Image, ImageSequence
+except ImportError:
+    sys.stderr.write("raw666_pack.py: Pillow is required (pip install pillow)\n")
+    sys.exit(1)
+
+MAGIC = b"R666"
+VERSION = 1
+SECTOR = 512
+
+
+def align(value, alignment):
+    return (value + alignment - 1) // alignment * alignment
+
+
+def load_frames(paths):
+    frames = []
+    for path in paths:
+        img = Image.open(path)
+        for frame in ImageSequence.Iterator(img):
+            frames.append(frame.convert("RGB"))
+    return frames
+
+
+def wire_bytes(img):
+    """RGB666 left-aligned, exactly what RAMWR expects in 18-bit mode."""
+    return bytes(b & 0xFC for b in img.tobytes())
+
+
+def main():
+    parser = argparse.ArgumentParser(description="Pack images into ILI9488 raw RGB666 (.r666) files")
+    parser.add_argument("inputs", nargs="+", help="images; each frame of each file becomes one frame")
+    parser.add_argument("-o", "--output", required=True, help="output .r666 file")
+    parser.add_argument("--x", type=int, default=0, help="window x on screen (default 0)")
+    parser.add_argument("--y", type=int, default=0, help="window y on screen (default 0)")
+    parser.add_argument("--fps", type=int, default=0, help="playback rate, 0 = unpaced (default)")
+    args = parser.parse_args()
+
+    frames = load_frames(args.inputs)
+    width, height = frames[0].size
+    for frame in frames:
+        if frame.size != (width, height):
+            parser.error("all frames must be %dx%d (got %dx%d)" % (width, height, *frame.size))
+    if len(frames) > 0xFFFF:
+        parser.error("too many frames (%d)" % len(frames))
+
+    frame_bytes = width * height * 3
+    stride = align(frame_bytes, SECTOR)
+
+    header = MAGIC + struct.pack("<BBHhhHHHHI", VERSION, 0, SECTOR, args.x, args.y,
+                                 width, height, len(frames), args.fps, stride)
+    with open(args.output, "wb") as f:
+        f.write(header.ljust(SECTOR, b"\0"))
+        for frame in frames:
+            f.write(wire_bytes(frame).ljust(stride, b"\0"))
+
+    total = SECTOR + stride * len(frames)
+    print("%s: %dx%d at (%d, %d), %d frame(s), %d bytes"
+          % (args.output, width, height, args.x, args.y, len(frames), total))
+
+
+if __name__ == "__main__":
+    main()
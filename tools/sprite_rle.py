@@ -0,0 +1,169 @@
+#!/usr/bin/env python3
+"""
+sprite_rle.py - Convert PNG images to RLE sprites for ili9488::RleSprite
+
+Transparent pixels (alpha below the threshold, or matching --key) are dropped;
+each remaining horizontal run is stored as an opaque span. Output is a C++
+header that can be drawn with PicoILI9488GFX::drawSprite().
+
+Stream layout (uint16_t words, see include/ili9488_sprite.hpp):
+    magic 0x5253, width, height, row offsets[height],
+    per row: span_count, then span_count x { x, length, pixels[length] }
+
+Usage:
+    python3 tools/sprite_rle.py player.png -o include/sprites/player.hpp
+    python3 tools/sprite_rle.py walk.png --frame-width 16 --name walk -o walk.hpp
+    python3 tools/sprite_rle.py tiles.png --key ff00ff -o tiles.hpp
+
+Requires Pillow (pip install pillow).
+"""
+
+import argparse
+import os
+import re
+import sys
+
+try:
+    from PIL import Image
+except ImportError:
+    sys.stderr.write("sprite_rle.py: Pillow is required (pip install pillow)\n")
+    sys.exit(1)
+
+RLE_MAGIC = 0x5253
+MAX_WORDS = 0xFFFF
+
+
+def rgb565(r, g, b):
+    return ((r & 0xF8) << 8) | ((g & 0xFC) << 3) | (b >> 3)
+
+
+def encode_frame(img, key, alpha_threshold):
+    """Encode one RGBA image into a list of uint16 words."""
+    w, h = img.size
+    px = img.load()
+
+    header = [RLE_MAGIC, w, h] + [0] * h
+    body = []
+
+    for y in range(h):
+        spans = []
+        x = 0
+        while x < w:
+            # Skip transparent pixels
+            while x < w and is_transparent(px[x, y], key, alpha_threshold):
+                x += 1
+            start = x
+            while x < w and not is_transparent(px[x, y], key, alpha_threshold):
+                x += 1
+            if x > start:
+                spans.append((start, [rgb565(*px[i, y][:3]) for i in range(start, x)]))
+
+        if not spans:
+            continue  # Offset 0 marks a fully transparent row
+
+        header[3 + y] = len(header) + len(body)
+        body.append(len(spans))
+        for start, pixels in spans:
+            body.extend([start, len(pixels)])
+            body.extend(pixels)
+
+        if len(header) + len(body) > MAX_WORDS:
+            raise ValueError("sprite too large for 16-bit row offsets (%d words)" % (len(header) + len(body)))
+
+    return header + body
+
+
+def is_transparent(pixel, key, alpha_threshold):
+    if pixel[3] < alpha_threshold:
+        return True
+    return key is not None and pixel[:3] == key
+
+
+def split_frames(img, frame_width, frame_height):
+    w, h = img.size
+    fw = frame_width or w
+    fh = frame_height or h
+    if w % fw or h % fh:
+        raise ValueError("image %dx%d is not a multiple of the frame size %dx%d" % (w, h, fw, fh))
+    frames = []
+    for fy in range(0, h, fh):
+        for fx in range(0, w, fw):
+            frames.append(img.crop((fx, fy, fx + fw, fy + fh)))
+    return frames
+
+
+def c_identifier(text):
+    ident = re.sub(r"[^0-9A-Za-z_]", "_", text)
+    return ident if not ident[0].isdigit() else "_" + ident
+
+
+def format_words(words, indent="    ", per_line=12):
+    lines = []
+    for i in range(0, len(words), per_line):
+        lines.append(indent + ", ".join("0x%04X" % v for v in words[i:i + per_line]) + ",")
+    return "\n".join(lines)
+
+
+def main():
+    parser = argparse.ArgumentParser(description="Convert PNG images to ILI9488 RLE sprites")
+    parser.add_argument("inputs", nargs="+", help="PNG files (each file, or each frame of a sheet, becomes one sprite)")
+    parser.add_argument("-o", "--output", required=True, help="output C++ header")
+    parser.add_argument("--name", help="symbol name (default: derived from the first input file)")
+    parser.add_argument("--key", help="RGB colour key in hex (e.g. ff00ff) treated as transparent")
+    parser.add_argument("--alpha-threshold", type=int, default=128, help="alpha below this is transparent (default 128)")
+    parser.add_argument("--frame-width", type=int, help="split a sprite sheet into frames of this width")
+    parser.add_argument("--frame-height", type=int, help="split a sprite sheet into frames of this height")
+    args = parser.parse_args()
+
+    key = None
+    if args.key:
+        value = int(args.key, 16)
+        key = ((value >> 16) & 0xFF, (value >> 8) & 0xFF, value & 0xFF)
+
+    name = c_identifier(args.name or os.path.splitext(os.path.basename(args.inputs[0]))[0])
+
+    frames = []
+    for path in args.inputs:
+        img = Image.open(path).convert("RGBA")
+        frames.extend(split_frames(img, args.frame_width, args.frame_height))
+
+    out = []
+    out.append("// Generated by tools/sprite_rle.py - do not edit")
+    out.append("// Source: %s" % ", ".join(os.path.basename(p) for p in args.inputs))
+    out.append("#pragma once")
+    out.append("")
+    out.append("#include <cstdint>")
+    out.append('#include "ili9488_sprite.hpp"')
+    out.append("")
+
+    total_words = 0
+    for index, frame in enumerate(frames):
+        words = encode_frame(frame, key, args.alpha_threshold)
+        total_words += len(words)
+        suffix = "_%d" % index if len(frames) > 1 else ""
+        out.append("// %dx%d, %d words" % (frame.size[0], frame.size[1], len(words)))
+        out.append("inline constexpr uint16_t %s%s_rle[] = {" % (name, suffix))
+        out.append(format_words(words))
+        out.append("};")
+        out.append("")
+
+    if len(frames) > 1:
+        out.append("inline const ili9488::RleSprite %s_frames[] = {" % name)
+        for index in range(len(frames)):
+            out.append("    ili9488::RleSprite(%s_%d_rle)," % (name, index))
+        out.append("};")
+        out.append("inline constexpr size_t %s_frame_count = %d;" % (name, len(frames)))
+    else:
+        out.append("inline const ili9488::RleSprite %s(%s_rle);" % (name, name))
+    out.append("")
+
+    with open(args.output, "w", newline="\n") as f:
+        f.write("\n".join(out))
+
+    raw_words = sum(fr.size[0] * fr.size[1] for fr in frames)
+    print("%s: %d frame(s), %d words RLE vs %d words raw (%.0f%%)"
+          % (args.output, len(frames), total_words, raw_words, 100.0 * total_words / max(raw_words, 1)))
+
+
+if __name__ == "__main__":
+    main()
@@ -0,0 +1,76 @@
+/**
+ * @file unicode_lookup_bench.cpp
+ * @brief Host benchmark: page-table vs linear Unicode -> glyph offset lookup
+ * @note Not part of the Pico build. Checks that both lookups agree for every
+ *       code point, then times them on a Chinese-text-like mix. Registered as
+ *       the host test test_unicode_lookup (tests/CMakeLists.txt); only the
+ *       agreement check decides the result, the timing is informational.
+ *
+ *   g++ -std=c++17 -O2 -Iinclude/fonts -Itests tools/unicode_lookup_bench.cpp -o unicode_lookup_bench
+ *   ./unicode_lookup_bench
+ */
+
+#include "unicode_ranges.h"
+#include "host_test.hpp"
+
+#include <chrono>
+#include <cstdio>
+#include <vector>
+
+namespace {
+
+// Mostly CJK with some ASCII, punctuation and fullwidth forms
+std::vector<uint32_t> makeText(size_t count) {
+    std::vector<uint32_t> text(count);
+    uint32_t seed = 12345;
+    for (size_t i = 0; i < count; ++i) {
+        seed = seed * 1664525u + 1013904223u;
+        const uint32_t r = seed >> 8;
+        switch (r % 10) {
+            case 0:  text[i] = 0x20 + r % 95; break;
+            case 1:  text[i] = 0x3000 + r % 0x40; break;
+            case 2:  text[i] = 0xFF00 + r % 0xF0; break;
+            default: text[i] = 0x4E00 + r % 20902; break;
+        }
+    }
+    return text;
+}
+
+template<typename Lookup>
+double lookupsPerSecond(const std::vector<uint32_t>& text, int rounds, Lookup lookup, uint32_t& checksum) {
+    const auto start = std::chrono::steady_clock::now();
+    for (int round = 0; round < rounds; ++round) {
+        for (uint32_t cp : text) {
+            checksum += lookup(cp);
+        }
+    }
+    const double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    return static_cast<double>(text.size()) * rounds / seconds;
+}
+
+} // namespace
+
+int main() {
+    uint32_t mismatches = 0;
+    for (uint32_t cp = 0; cp <= 0x10FFFF; ++cp) {
+        if (find_unicode_offset(cp) != find_unicode_offset_linear(cp)) {
+            if (mismatches++ < 8) {
+                std::printf("mismatch at U+%04X: page table %u, linear %u\n", cp,
+                            find_unicode_offset(cp), find_unicode_offset_linear(cp));
+            }
+        }
+    }
+    CHECK(mismatches == 0);
+
+    const std::vector<uint32_t> text = makeText(1 << 16);
+    const int rounds = 200;
+    uint32_t checksum_table = 0, checksum_linear = 0;
+    const double table = lookupsPerSecond(text, rounds, find_unicode_offset, checksum_table);
+    const double linear = lookupsPerSecond(text, rounds, find_unicode_offset_linear, checksum_linear);
+
+    std::printf("page table: %8.1f M lookups/s\n", table / 1e6);
+    std::printf("linear:     %8.1f M lookups/s\n", linear / 1e6);
+    std::printf("speedup:    %8.1fx\n", table / linear);
+    CHECK(checksum_table == checksum_linear);
+    return host_test::finish("test_unicode_lookup");
+}
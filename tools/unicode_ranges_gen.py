@@ -0,0 +1,267 @@
+#!/usr/bin/env python3
+"""
+unicode_ranges_gen.py - Generate include/fonts/unicode_ranges.h
+
+The header maps a Unicode code point to its glyph index in the flash font
+(see FlashFontCache). Besides the range table it contains a two-level page
+table so that find_unicode_offset() is O(1):
+
+    unicode_pages[cp >> 8]        one entry per 256-code-point page:
+        block == 0, base != NO_GLYPH   whole page is one linear run:
+                                       offset = base + (cp & 0xFF)
+        block == 0, base == NO_GLYPH   page has no glyphs
+        block != 0                     mixed page, look up
+                                       unicode_page_blocks[block - 1][cp & 0xFF]
+
+Pages covered by several ranges (or partly) get a 256-entry block; in the
+shipped font that is 7 pages, so the whole index is about 4.5 KB of flash.
+Overlapping ranges keep the old first-match semantics.
+
+Input is either the range export (JSON list of objects with name, enabled,
+start, end and optionally count/offset; start/end may be ints or "0x..."
+strings) or an existing unicode_ranges.h. Missing offsets are assigned in
+table order over the enabled ranges.
+
+Usage:
+    python3 tools/unicode_ranges_gen.py unicode_export_tbl.json -o include/fonts/unicode_ranges.h
+    python3 tools/unicode_ranges_gen.py include/fonts/unicode_ranges.h -o include/fonts/unicode_ranges.h
+"""
+
+import argparse
+import datetime
+import json
+import os
+import re
+import sys
+
+NO_GLYPH = 0xFFFF
+HEADER_RE = re.compile(
+    r'\{\s*"([^"]+)",\s*(true|false),\s*(0x[0-9A-Fa-f]+|\d+),\s*(0x[0-9A-Fa-f]+|\d+),'
+    r'\s*(\d+),\s*(\d+)\s*\}')
+
+
+def parse_int(value):
+    if isinstance(value, str):
+        return int(value, 0)
+    return int(value)
+
+
+def load_ranges(path):
+    with open(path, "r", encoding="utf-8") as f:
+        text = f.read()
+
+    if path.endswith((".h", ".hpp")):
+        ranges = []
+        for name, enabled, start, end, count, offset in HEADER_RE.findall(text):
+            ranges.append({
+                "name": name,
+                "enabled": enabled == "true",
+                "start": parse_int(start),
+                "end": parse_int(end),
+                "count": int(count),
+                "offset": int(offset),
+            })
+        return ranges
+
+    data = json.loads(text)
+    if isinstance(data, dict):
+        data = data.get("ranges", [])
+    ranges = []
+    next_offset = 0
+    for item in data:
+        start = parse_int(item["start"])
+        end = parse_int(item["end"])
+        enabled = bool(item.get("enabled", True))
+        count = int(item.get("count", end - start + 1))
+        offset = int(item["offset"]) if "offset" in item else next_offset
+        if enabled:
+            next_offset = offset + count
+        ranges.append({"name": item["name"], "enabled": enabled, "start": start,
+                       "end": end, "count": count, "offset": offset})
+    return ranges
+
+
+def build_map(ranges):
+    """Code point -> glyph offset, first enabled range wins"""
+    glyphs = {}
+    for r in ranges:
+        if not r["enabled"]:
+            continue
+        if r["end"] > 0xFFFF:
+            raise ValueError("%s: only the BMP (<= 0xFFFF) is supported" % r["name"])
+        for cp in range(r["start"], r["end"] + 1):
+            glyphs.setdefault(cp, r["offset"] + cp - r["start"])
+    if glyphs and max(glyphs.values()) + 256 >= NO_GLYPH:
+        raise ValueError("glyph offsets must stay below 0x%X" % (NO_GLYPH - 256))
+    return glyphs
+
+
+def build_pages(glyphs):
+    pages = []
+    blocks = []
+    for page in range(256):
+        offsets = [glyphs.get((page << 8) | low, NO_GLYPH) for low in range(256)]
+        base = offsets[0]
+        if base == NO_GLYPH and all(o == NO_GLYPH for o in offsets):
+            pages.append((NO_GLYPH, 0))
+        elif base != NO_GLYPH and all(o == base + low for low, o in enumerate(offsets)):
+            pages.append((base, 0))
+        else:
+            blocks.append(offsets)
+            pages.append((NO_GLYPH, len(blocks)))
+    if len(blocks) > 255:
+        raise ValueError("too many mixed pages")
+    return pages, blocks
+
+
+def emit(ranges, pages, blocks, source, total):
+    out = []
+    w = out.append
+    w("// 自动生成的Unicode范围查找表")
+    w("// 生成时间: %s" % datetime.datetime.now().strftime("%Y-%m-%d %H:%M:%S"))
+    w("// 源文件: %s" % source)
+    w("// ")
+    w("// 警告: 此文件由脚本自动生成，请勿手动修改！")
+    w("// 生成脚本: tools/unicode_ranges_gen.py")
+    w("")
+    w("#pragma once")
+    w("")
+    w("#include <stdint.h>")
+    w("#include <cstdio>")
+    w("")
+    w("// Unicode范围结构体")
+    w("struct UnicodeRangeEntry {")
+    w("    const char* name;           // 范围名称")
+    w("    bool enabled;              // 是否启用")
+    w("    uint32_t start;            // 起始码点")
+    w("    uint32_t end;              // 结束码点")
+    w("    uint32_t count;            // 字符数量")
+    w("    uint32_t offset;           // 在字体文件中的偏移位置")
+    w("};")
+    w("")
+    w("// Unicode范围查找表")
+    w("static const UnicodeRangeEntry unicode_ranges[] = {")
+    for i, r in enumerate(ranges):
+        w("    {")
+        w('        "%s",' % r["name"])
+        w("        %s," % ("true" if r["enabled"] else "false"))
+        w("        0x%04X," % r["start"])
+        w("        0x%04X," % r["end"])
+        w("        %d," % r["count"])
+        w("        %d" % r["offset"])
+        w("    }" + ("," if i + 1 < len(ranges) else ""))
+    w("};")
+    w("")
+    w("// 范围总数")
+    w("static const int unicode_ranges_count = sizeof(unicode_ranges) / sizeof(unicode_ranges[0]);")
+    w("")
+    w("// 总字符数")
+    w("static const uint32_t total_unicode_chars = %d;" % total)
+    w("")
+    w("// 两级页表：码点高字节 -> 页，低字节 -> 偏移（O(1)查找）")
+    w("// block == 0: 整页线性 (offset = base + 低字节) 或整页不支持 (base == UNICODE_NO_GLYPH)")
+    w("// block != 0: 混合页，查 unicode_page_blocks[block - 1][低字节]")
+    w("struct UnicodePage {")
+    w("    uint16_t base;             // 低字节0对应的偏移")
+    w("    uint8_t block;             // 二级表编号+1，0 = 无二级表")
+    w("};")
+    w("")
+    w("static constexpr uint16_t UNICODE_NO_GLYPH = 0x%04X;" % NO_GLYPH)
+    w("")
+    w("static constexpr UnicodePage unicode_pages[256] = {")
+    for row in range(0, 256, 8):
+        cells = ", ".join("{0x%04X, %d}" % pages[p] for p in range(row, row + 8))
+        w("    %s,  // 0x%02X" % (cells, row))
+    w("};")
+    w("")
+    w("static constexpr uint16_t unicode_page_blocks[%d][256] = {" % max(len(blocks), 1))
+    if not blocks:
+        w("    {}")
+    for i, block in enumerate(blocks):
+        page = [p for p, (_, b) in enumerate(pages) if b == i + 1][0]
+        w("    {   // 0x%02X00" % page)
+        for row in range(0, 256, 16):
+            w("        %s," % ", ".join("0x%04X" % o for o in block[row:row + 16]))
+        w("    }" + ("," if i + 1 < len(blocks) else ""))
+    w("};")
+    w("")
+    w("// 查找Unicode字符在字体文件中的偏移位置")
+    w("inline uint32_t find_unicode_offset(uint32_t unicode_code) {")
+    w("    if (unicode_code > 0xFFFF) {")
+    w("        return UINT32_MAX; // 未找到")
+    w("    }")
+    w("    const UnicodePage& page = unicode_pages[unicode_code >> 8];")
+    w("    uint16_t offset;")
+    w("    if (page.block) {")
+    w("        offset = unicode_page_blocks[page.block - 1][unicode_code & 0xFF];")
+    w("    } else if (page.base != UNICODE_NO_GLYPH) {")
+    w("        offset = static_cast<uint16_t>(page.base + (unicode_code & 0xFF));")
+    w("    } else {")
+    w("        return UINT32_MAX;")
+    w("    }")
+    w("    return offset == UNICODE_NO_GLYPH ? UINT32_MAX : offset;")
+    w("}")
+    w("")
+    w("// 逐个范围查找（与页表结果相同，用于校验和性能对比）")
+    w("inline uint32_t find_unicode_offset_linear(uint32_t unicode_code) {")
+    w("    for (int i = 0; i < unicode_ranges_count; i++) {")
+    w("        const UnicodeRangeEntry& range = unicode_ranges[i];")
+    w("        if (range.enabled && unicode_code >= range.start && unicode_code <= range.end) {")
+    w("            // 在范围内，计算偏移")
+    w("            uint32_t relative_offset = unicode_code - range.start;")
+    w("            return range.offset + relative_offset;")
+    w("        }")
+    w("    }")
+    w("    return UINT32_MAX; // 未找到")
+    w("}")
+    w("")
+    w("// 检查Unicode字符是否受支持")
+    w("inline bool is_unicode_supported(uint32_t unicode_code) {")
+    w("    return find_unicode_offset(unicode_code) != UINT32_MAX;")
+    w("}")
+    w("")
+    w("// 获取指定索引的Unicode范围信息（用于调试）")
+    w("inline const UnicodeRangeEntry* get_unicode_range(int index) {")
+    w("    if (index >= 0 && index < unicode_ranges_count) {")
+    w("        return &unicode_ranges[index];")
+    w("    }")
+    w("    return nullptr;")
+    w("}")
+    w("")
+    w("// 打印所有Unicode范围信息（用于调试）")
+    w("inline void print_unicode_ranges() {")
+    w("    for (int i = 0; i < unicode_ranges_count; i++) {")
+    w("        const UnicodeRangeEntry& range = unicode_ranges[i];")
+    w('        printf("[%d] %s: 0x%04lX-0x%04lX (%ld chars, offset %ld) %s\\n", ')
+    w("               i, range.name, range.start, range.end, range.count, range.offset,")
+    w('               range.enabled ? "✓" : "✗");')
+    w("    }")
+    w("}")
+    return "\n".join(out) + "\n"
+
+
+def main():
+    parser = argparse.ArgumentParser(description="Generate the Unicode -> glyph offset header")
+    parser.add_argument("input", help="range export (.json) or an existing unicode_ranges.h")
+    parser.add_argument("-o", "--output", required=True, help="output header")
+    args = parser.parse_args()
+
+    ranges = load_ranges(args.input)
+    if not ranges:
+        sys.stderr.write("unicode_ranges_gen.py: no ranges found in %s\n" % args.input)
+        return 1
+
+    glyphs = build_map(ranges)
+    pages, blocks = build_pages(glyphs)
+    total = sum(r["count"] for r in ranges if r["enabled"])
+    text = emit(ranges, pages, blocks, os.path.basename(args.input), total)
+
+    with open(args.output, "w", encoding="utf-8", newline="\n") as f:
+        f.write(text)
+    print("%s: %d ranges, %d code points, %d mixed pages (%d bytes of index)" %
+          (args.output, len(ranges), len(glyphs), len(blocks), 256 * 4 + len(blocks) * 512))
+    return 0
+
+
+if __name__ == "__main__":
+    sys.exit(main())